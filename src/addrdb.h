@@ -8,13 +8,15 @@
 
 #include <fs.h>
 #include <serialize.h>
+#include <support/allocators/zeroafterfree.h>
 
 #include <string>
 #include <map>
 
 class CSubNet;
 class CAddrMan;
-class CDataStream;
+template <typename SerializeData> class CBaseDataStream;
+typedef CBaseDataStream<CSerializeData> CDataStream;
 
 typedef enum BanReason
 {
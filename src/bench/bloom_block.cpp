@@ -0,0 +1,74 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+
+#include <bloom.h>
+#include <merkleblock.h>
+#include <random.h>
+#include <streams.h>
+#include <version.h>
+
+namespace block_bench {
+#include <bench/data/block413567.raw.h>
+} // namespace block_bench
+
+// LitecoinCash: BloomBatch: What serving one filtered block costs per light client, with and without the block's
+// data elements prepared beforehand
+
+static CBlock LoadBlock()
+{
+    CDataStream stream((const char*)block_bench::block413567,
+            (const char*)&block_bench::block413567[sizeof(block_bench::block413567)],
+            SER_NETWORK, PROTOCOL_VERSION);
+    CBlock block;
+    stream >> block;
+    return block;
+}
+
+/** Like a light wallet's filter: a few hundred keys, none of them in the block */
+static CBloomFilter WalletFilter()
+{
+    FastRandomContext rng(true);
+    CBloomFilter filter(500, 0.0001, rng.rand32(), BLOOM_UPDATE_ALL);
+    for (int i = 0; i < 300; i++)
+        filter.insert(rng.randbytes(20));
+    return filter;
+}
+
+static void BloomMatchBlock(benchmark::State& state)
+{
+    const CBlock block = LoadBlock();
+    const CBloomFilter filter = WalletFilter();
+    while (state.KeepRunning()) {
+        CBloomFilter filterCopy(filter);
+        CMerkleBlock merkleBlock(block, filterCopy);
+        assert(merkleBlock.vMatchedTxn.size() < block.vtx.size());
+    }
+}
+
+static void BloomMatchPreparedBlock(benchmark::State& state)
+{
+    const CBlock block = LoadBlock();
+    const CBloomFilter filter = WalletFilter();
+    const CBloomBlockElements elements(block);
+    while (state.KeepRunning()) {
+        CBloomFilter filterCopy(filter);
+        CMerkleBlock merkleBlock(block, filterCopy, elements);
+        assert(merkleBlock.vMatchedTxn.size() < block.vtx.size());
+    }
+}
+
+static void BloomPrepareBlock(benchmark::State& state)
+{
+    const CBlock block = LoadBlock();
+    while (state.KeepRunning()) {
+        CBloomBlockElements elements(block);
+        assert(elements.size() == block.vtx.size());
+    }
+}
+
+BENCHMARK(BloomMatchBlock, 50);
+BENCHMARK(BloomMatchPreparedBlock, 200);
+BENCHMARK(BloomPrepareBlock, 50);
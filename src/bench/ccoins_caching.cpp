@@ -84,4 +84,22 @@ static void CCoinsCaching(benchmark::State& state)
     }
 }
 
+// LitecoinCash: PoolAllocator: Fill a cache with fresh coins and flush it, as the tip cache does during
+// IBD and reindex.
+static void CCoinsCacheFill(benchmark::State& state)
+{
+    CCoinsView coinsDummy;
+    const Coin coin(CTxOut(1 * CENT, CScript() << OP_DUP << OP_HASH160 << std::vector<unsigned char>(20, 1) << OP_EQUALVERIFY << OP_CHECKSIG), 1, false);
+    uint256 txid;
+    while (state.KeepRunning()) {
+        CCoinsViewCache cache(&coinsDummy);
+        for (uint32_t n = 0; n < 10000; ++n) {
+            *(uint32_t*)txid.begin() = n;
+            cache.AddCoin(COutPoint(txid, n), Coin(coin), false);
+        }
+        cache.Flush();
+    }
+}
+
 BENCHMARK(CCoinsCaching, 170 * 1000);
+BENCHMARK(CCoinsCacheFill, 100);
@@ -6,6 +6,7 @@
 #include <util.h>
 #include <validation.h>
 #include <checkqueue.h>
+#include <hash.h>
 #include <prevector.h>
 #include <vector>
 #include <boost/thread/thread.hpp>
@@ -60,3 +61,47 @@ static void CCheckQueueSpeedPrevectorJob(benchmark::State& state)
     tg.join_all();
 }
 BENCHMARK(CCheckQueueSpeedPrevectorJob, 1400);
+
+// LitecoinCash: WorkStealing: How verification scales with -par, using checks that take a few dozen
+// microseconds each, like a signature check does
+static void CCheckQueueScaling(benchmark::State& state, int nPar)
+{
+    struct HashJob {
+        uint256 hash;
+        bool operator()()
+        {
+            for (int i = 0; i < 64; i++)
+                hash = Hash(hash.begin(), hash.end());
+            return true;
+        }
+        void swap(HashJob& x) { std::swap(hash, x.hash); };
+    };
+    CCheckQueue<HashJob> queue {QUEUE_BATCH_SIZE};
+    boost::thread_group tg;
+    // -par counts the master thread too
+    for (auto x = 0; x < nPar - 1; ++x) {
+       tg.create_thread([&]{queue.Thread();});
+    }
+    while (state.KeepRunning()) {
+        CCheckQueueControl<HashJob> control(&queue);
+        for (size_t i = 0; i < BATCHES; ++i) {
+            std::vector<HashJob> vChecks(BATCH_SIZE);
+            control.Add(vChecks);
+        }
+        control.Wait();
+    }
+    tg.interrupt_all();
+    tg.join_all();
+}
+
+static void CCheckQueueScalingPar1(benchmark::State& state) { CCheckQueueScaling(state, 1); }
+static void CCheckQueueScalingPar2(benchmark::State& state) { CCheckQueueScaling(state, 2); }
+static void CCheckQueueScalingPar4(benchmark::State& state) { CCheckQueueScaling(state, 4); }
+static void CCheckQueueScalingPar8(benchmark::State& state) { CCheckQueueScaling(state, 8); }
+static void CCheckQueueScalingPar16(benchmark::State& state) { CCheckQueueScaling(state, 16); }
+
+BENCHMARK(CCheckQueueScalingPar1, 10);
+BENCHMARK(CCheckQueueScalingPar2, 10);
+BENCHMARK(CCheckQueueScalingPar4, 10);
+BENCHMARK(CCheckQueueScalingPar8, 10);
+BENCHMARK(CCheckQueueScalingPar16, 10);
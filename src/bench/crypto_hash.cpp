@@ -11,6 +11,7 @@
 #include <uint256.h>
 #include <utiltime.h>
 #include <crypto/ripemd160.h>
+#include <crypto/scrypt.h>
 #include <crypto/sha1.h>
 #include <crypto/sha256.h>
 #include <crypto/sha512.h>
@@ -52,6 +53,33 @@ static void SHA256_32b(benchmark::State& state)
     }
 }
 
+static void SHA256D64_1024(benchmark::State& state)
+{
+    std::vector<uint8_t> in(64 * 1024, 0);
+    while (state.KeepRunning()) {
+        SHA256D64(in.data(), in.data(), 1024);
+    }
+}
+
+static void Scrypt(benchmark::State& state)
+{
+    std::vector<char> in(80, 0);
+    uint256 hash;
+    while (state.KeepRunning()) {
+        scrypt_1024_1_1_256(in.data(), (char*)hash.begin());
+    }
+}
+
+static void Scrypt_Batch8(benchmark::State& state)
+{
+    std::vector<char> in(8 * 80, 0);
+    std::vector<uint256> hashes(8);
+    scrypt_detect_batch();
+    while (state.KeepRunning()) {
+        scrypt_1024_1_1_256_batch(in.data(), (char*)hashes[0].begin(), 8);
+    }
+}
+
 static void SHA512(benchmark::State& state)
 {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
@@ -69,6 +97,18 @@ static void SipHash_32b(benchmark::State& state)
     }
 }
 
+static void SipHash_32b_Batch(benchmark::State& state)
+{
+    std::vector<uint256> in(256);
+    std::vector<uint64_t> out(256);
+    for (size_t i = 0; i < in.size(); i++)
+        *((uint64_t*)in[i].begin()) = i;
+    uint64_t k1 = 0;
+    while (state.KeepRunning()) {
+        SipHashUint256Batch(0, ++k1, in.data(), in.size(), out.data());
+    }
+}
+
 static void FastRandom_32bit(benchmark::State& state)
 {
     FastRandomContext rng(true);
@@ -93,6 +133,10 @@ BENCHMARK(SHA256, 340);
 BENCHMARK(SHA512, 330);
 
 BENCHMARK(SHA256_32b, 4700 * 1000);
+BENCHMARK(SHA256D64_1024, 7400);
+BENCHMARK(Scrypt, 500);
+BENCHMARK(Scrypt_Batch8, 60);
 BENCHMARK(SipHash_32b, 40 * 1000 * 1000);
+BENCHMARK(SipHash_32b_Batch, 160 * 1000); // LitecoinCash: CompactBlocks
 BENCHMARK(FastRandom_32bit, 110 * 1000 * 1000);
 BENCHMARK(FastRandom_1bit, 440 * 1000 * 1000);
@@ -111,4 +111,44 @@ static void MempoolEviction(benchmark::State& state)
     }
 }
 
+// LitecoinCash: ClusterMempool: Eviction from a mempool of many small
+// clusters, each a parent spent by a few children paying varied fees.
+static void MempoolClusterEviction(benchmark::State& state)
+{
+    const int nClusters = 50;
+    const int nChildren = 4;
+    std::vector<std::pair<CTransaction, CAmount>> vTxs;
+    for (int i = 0; i < nClusters; i++) {
+        CMutableTransaction parent = CMutableTransaction();
+        parent.vin.resize(1);
+        parent.vin[0].scriptSig = CScript() << i;
+        parent.vout.resize(nChildren);
+        for (int j = 0; j < nChildren; j++) {
+            parent.vout[j].scriptPubKey = CScript() << OP_1 << OP_EQUAL;
+            parent.vout[j].nValue = 10 * COIN;
+        }
+        vTxs.emplace_back(parent, 1000LL * (i % 7));
+        for (int j = 0; j < nChildren; j++) {
+            CMutableTransaction child = CMutableTransaction();
+            child.vin.resize(1);
+            child.vin[0].prevout = COutPoint(parent.GetHash(), j);
+            child.vin[0].scriptSig = CScript() << OP_2;
+            child.vout.resize(1);
+            child.vout[0].scriptPubKey = CScript() << OP_2 << OP_EQUAL;
+            child.vout[0].nValue = 10 * COIN;
+            vTxs.emplace_back(child, 1000LL * ((i * nChildren + j) % 11));
+        }
+    }
+
+    CTxMemPool pool;
+
+    while (state.KeepRunning()) {
+        for (const auto& tx : vTxs)
+            AddTx(tx.first, tx.second, pool);
+        pool.TrimToSize(pool.DynamicMemoryUsage() * 3 / 4);
+        pool.TrimToSize(0);
+    }
+}
+
 BENCHMARK(MempoolEviction, 41000);
+BENCHMARK(MempoolClusterEviction, 100);
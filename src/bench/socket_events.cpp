@@ -0,0 +1,117 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <compat.h>
+
+#include <assert.h>
+#include <vector>
+
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
+// LitecoinCash: SocketEvents: How long it takes the socket handler to find the one peer out of many
+// connected over loopback that sent something, with select() and with epoll
+
+#ifndef WIN32
+namespace {
+
+/** Connected loopback TCP sockets, the accepted ends in vServer */
+struct LoopbackPeers
+{
+    std::vector<SOCKET> vClient, vServer;
+
+    explicit LoopbackPeers(size_t count)
+    {
+        SOCKET hListen = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        assert(hListen != INVALID_SOCKET);
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof(addr);
+        assert(bind(hListen, (struct sockaddr*)&addr, len) == 0);
+        assert(listen(hListen, SOMAXCONN) == 0);
+        assert(getsockname(hListen, (struct sockaddr*)&addr, &len) == 0);
+        for (size_t i = 0; i < count; i++) {
+            SOCKET hClient = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            assert(hClient != INVALID_SOCKET);
+            assert(connect(hClient, (struct sockaddr*)&addr, len) == 0);
+            SOCKET hServer = accept(hListen, nullptr, nullptr);
+            assert(hServer != INVALID_SOCKET);
+            vClient.push_back(hClient);
+            vServer.push_back(hServer);
+        }
+        close(hListen);
+    }
+
+    ~LoopbackPeers()
+    {
+        for (SOCKET hSocket : vClient)
+            close(hSocket);
+        for (SOCKET hSocket : vServer)
+            close(hSocket);
+    }
+};
+
+const size_t LOOPBACK_PEERS = 400;
+
+}
+
+static void SocketEventsSelect(benchmark::State& state)
+{
+    LoopbackPeers peers(LOOPBACK_PEERS);
+    size_t nNext = 0;
+    char buf = 0;
+    while (state.KeepRunning()) {
+        assert(send(peers.vClient[nNext], &buf, 1, 0) == 1);
+        nNext = (nNext + 7) % LOOPBACK_PEERS;
+
+        fd_set fdsetRecv;
+        FD_ZERO(&fdsetRecv);
+        SOCKET hSocketMax = 0;
+        for (SOCKET hSocket : peers.vServer) {
+            FD_SET(hSocket, &fdsetRecv);
+            hSocketMax = std::max(hSocketMax, hSocket);
+        }
+        struct timeval timeout = {1, 0};
+        assert(select(hSocketMax + 1, &fdsetRecv, nullptr, nullptr, &timeout) == 1);
+        for (SOCKET hSocket : peers.vServer) {
+            if (FD_ISSET(hSocket, &fdsetRecv))
+                assert(recv(hSocket, &buf, 1, 0) == 1);
+        }
+    }
+}
+
+BENCHMARK(SocketEventsSelect, 40 * 1000);
+
+#ifdef USE_EPOLL
+static void SocketEventsEpoll(benchmark::State& state)
+{
+    LoopbackPeers peers(LOOPBACK_PEERS);
+    int epollfd = epoll_create1(0);
+    assert(epollfd != -1);
+    for (SOCKET hSocket : peers.vServer) {
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLET;
+        event.data.fd = hSocket;
+        assert(epoll_ctl(epollfd, EPOLL_CTL_ADD, hSocket, &event) == 0);
+    }
+    size_t nNext = 0;
+    char buf = 0;
+    while (state.KeepRunning()) {
+        assert(send(peers.vClient[nNext], &buf, 1, 0) == 1);
+        nNext = (nNext + 7) % LOOPBACK_PEERS;
+
+        epoll_event events[16];
+        int nEvents = epoll_wait(epollfd, events, 16, 1000);
+        assert(nEvents == 1);
+        assert(recv(events[0].data.fd, &buf, 1, 0) == 1);
+    }
+    close(epollfd);
+}
+
+BENCHMARK(SocketEventsEpoll, 200 * 1000);
+#endif
+#endif
@@ -0,0 +1,112 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <blockcache.h>
+
+#include <memusage.h>
+#include <primitives/block.h>
+#include <streams.h>
+#include <version.h>
+
+#include <memory>
+
+CSerializedBlockCache serializedBlockCache;
+
+CSerializedBlockCache::CSerializedBlockCache(size_t nMaxBytesIn) : nBytes(0), nMaxBytes(nMaxBytesIn), nHits(0), nMisses(0) {}
+
+size_t CSerializedBlockCache::EntryUsage(const CRawBlock& block)
+{
+    // The data with its vector and shared_ptr control block, plus a list node and a map node
+    return memusage::MallocUsage(block.size()) + memusage::MallocUsage(sizeof(std::vector<unsigned char>) + 2 * sizeof(void*)) +
+        memusage::MallocUsage(sizeof(std::pair<Key, CRawBlock>) + 2 * sizeof(void*)) +
+        memusage::MallocUsage(sizeof(std::pair<const Key, List::iterator>) + 4 * sizeof(void*));
+}
+
+void CSerializedBlockCache::Trim()
+{
+    while (nBytes > nMaxBytes && !listEntries.empty()) {
+        nBytes -= EntryUsage(listEntries.front().second);
+        mapEntries.erase(listEntries.front().first);
+        listEntries.pop_front();
+    }
+}
+
+void CSerializedBlockCache::SetMaxBytes(size_t nMaxBytesIn)
+{
+    LOCK(cs);
+    nMaxBytes = nMaxBytesIn;
+    Trim();
+}
+
+bool CSerializedBlockCache::IsEnabled() const
+{
+    LOCK(cs);
+    return nMaxBytes > 0;
+}
+
+bool CSerializedBlockCache::Get(const uint256& hash, bool fWitness, CRawBlock& block)
+{
+    LOCK(cs);
+    if (nMaxBytes == 0)
+        return false;
+    auto it = mapEntries.find(Key(hash, fWitness));
+    if (it == mapEntries.end()) {
+        nMisses++;
+        return false;
+    }
+    nHits++;
+    listEntries.splice(listEntries.end(), listEntries, it->second);
+    block = it->second->second;
+    return true;
+}
+
+CRawBlock CSerializedBlockCache::Insert(const uint256& hash, bool fWitness, std::vector<unsigned char>&& vData)
+{
+    std::shared_ptr<const std::vector<unsigned char>> data = std::make_shared<const std::vector<unsigned char>>(std::move(vData));
+    return Insert(hash, fWitness, CRawBlock(std::shared_ptr<const unsigned char>(data, data->data()), data->size()));
+}
+
+CRawBlock CSerializedBlockCache::Insert(const uint256& hash, bool fWitness, const CRawBlock& block)
+{
+    LOCK(cs);
+    const size_t nUsage = EntryUsage(block);
+    if (nUsage > nMaxBytes)
+        return block;
+    const Key key(hash, fWitness);
+    if (mapEntries.count(key))
+        return block;
+    listEntries.emplace_back(key, block);
+    mapEntries.emplace(key, std::prev(listEntries.end()));
+    nBytes += nUsage;
+    Trim();
+    return block;
+}
+
+CRawBlock CSerializedBlockCache::Insert(const CBlock& block, bool fWitness)
+{
+    std::vector<unsigned char> vData;
+    vData.reserve(::GetSerializeSize(block, SER_NETWORK, PROTOCOL_VERSION | (fWitness ? 0 : SERIALIZE_TRANSACTION_NO_WITNESS)));
+    CVectorWriter(SER_NETWORK, PROTOCOL_VERSION | (fWitness ? 0 : SERIALIZE_TRANSACTION_NO_WITNESS), vData, 0, block);
+    return Insert(block.GetHash(), fWitness, std::move(vData));
+}
+
+void CSerializedBlockCache::Clear()
+{
+    LOCK(cs);
+    listEntries.clear();
+    mapEntries.clear();
+    nBytes = 0;
+}
+
+SerializedBlockCacheStats CSerializedBlockCache::GetStats() const
+{
+    LOCK(cs);
+    SerializedBlockCacheStats stats;
+    stats.nHits = nHits;
+    stats.nMisses = nMisses;
+    stats.nEntries = listEntries.size();
+    stats.nBytes = nBytes;
+    stats.nMaxBytes = nMaxBytes;
+    return stats;
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef LITECOINCASH_BLOCKCACHE_H
+#define LITECOINCASH_BLOCKCACHE_H
+
+#include <sync.h>
+#include <uint256.h>
+#include <validation.h>
+
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+/** LitecoinCash: BlockCache: Default for -blockservecache, in MiB (0 disables the cache) */
+static const int64_t DEFAULT_BLOCK_SERVE_CACHE = 32;
+
+/** LitecoinCash: BlockCache: Counters since startup */
+struct SerializedBlockCacheStats {
+    uint64_t nHits = 0;         //!< Lookups served from the cache
+    uint64_t nMisses = 0;       //!< Lookups that had to go to disk
+    size_t nEntries = 0;        //!< Serialized blocks held
+    size_t nBytes = 0;          //!< Memory used by the serialized blocks held
+    size_t nMaxBytes = 0;       //!< Memory budget
+};
+
+/**
+ * LitecoinCash: BlockCache: Byte budgeted LRU cache of blocks as they go over the wire, keyed by block hash
+ * and by whether witness data is included.
+ *
+ * Peers that are catching up, or that follow the tip, tend to ask for the same recent blocks. Serving those
+ * from here saves reading, deserializing and serializing the block again for each of them. Blocks are
+ * immutable once their hash is known, so entries never go stale; they only get pushed out by newer ones.
+ */
+class CSerializedBlockCache
+{
+private:
+    typedef std::pair<uint256, bool> Key;
+    typedef std::list<std::pair<Key, CRawBlock>> List;
+
+    mutable CCriticalSection cs;
+    //! Least recently used first
+    List listEntries;
+    std::map<Key, List::iterator> mapEntries;
+    size_t nBytes;
+    size_t nMaxBytes;
+    uint64_t nHits;
+    uint64_t nMisses;
+
+    static size_t EntryUsage(const CRawBlock& block);
+    void Trim();
+
+public:
+    explicit CSerializedBlockCache(size_t nMaxBytesIn = 0);
+
+    /** Change the memory budget, dropping the oldest entries if needed. 0 disables the cache. */
+    void SetMaxBytes(size_t nMaxBytesIn);
+    bool IsEnabled() const;
+
+    /** Look up a serialized block, counting a hit or a miss. */
+    bool Get(const uint256& hash, bool fWitness, CRawBlock& block);
+
+    /** Add a serialized block. The returned CRawBlock refers to it, whether or not it fits in the cache. */
+    CRawBlock Insert(const uint256& hash, bool fWitness, std::vector<unsigned char>&& vData);
+
+    /**
+     * Add a serialized block without copying it. Keeping the CRawBlock keeps whatever backs it alive, such as
+     * the mapping of a block file; its size is charged to the budget all the same.
+     */
+    CRawBlock Insert(const uint256& hash, bool fWitness, const CRawBlock& block);
+
+    /** Serialize block and add it. */
+    CRawBlock Insert(const CBlock& block, bool fWitness);
+
+    void Clear();
+    SerializedBlockCacheStats GetStats() const;
+};
+
+/** LitecoinCash: BlockCache: Blocks served to peers */
+extern CSerializedBlockCache serializedBlockCache;
+
+#endif // LITECOINCASH_BLOCKCACHE_H
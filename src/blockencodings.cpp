@@ -9,11 +9,11 @@
 #include <hash.h>
 #include <random.h>
 #include <streams.h>
+#include <sync.h>
 #include <txmempool.h>
 #include <validation.h>
 #include <util.h>
-
-#include <unordered_map>
+#include <utiltime.h>
 
 CBlockHeaderAndShortTxIDs::CBlockHeaderAndShortTxIDs(const CBlock& block, bool fUseWTXID) :
         nonce(GetRand(std::numeric_limits<uint64_t>::max())),
@@ -43,7 +43,98 @@ uint64_t CBlockHeaderAndShortTxIDs::GetShortID(const uint256& txhash) const {
     return SipHashUint256(shorttxidk0, shorttxidk1, txhash) & 0xffffffffffffL;
 }
 
+void CBlockHeaderAndShortTxIDs::GetShortIDs(const uint256* txhashes, size_t count, uint64_t* out) const {
+    static_assert(SHORTTXIDS_LENGTH == 6, "shorttxids calculation assumes 6-byte shorttxids");
+    SipHashUint256Batch(shorttxidk0, shorttxidk1, txhashes, count, out);
+    for (size_t i = 0; i < count; i++)
+        out[i] &= 0xffffffffffffL;
+}
+
+namespace {
+
+/** LitecoinCash: CompactBlocks: Mempool witness hashes are turned into short IDs this many at a time */
+const size_t SHORTID_BATCH_SIZE = 256;
+
+/** LitecoinCash: CompactBlocks: How far past its slot a short ID may be placed */
+const size_t SHORTID_MAX_PROBES = 48;
+/** LitecoinCash: CompactBlocks: Marks a free slot, short IDs are only 48 bits */
+const uint64_t SHORTID_EMPTY = ~(uint64_t)0;
+
+/**
+ * LitecoinCash: CompactBlocks: Open addressing table from short ID to position in the block. Each thread
+ * that reconstructs blocks keeps one and reuses its memory. Where an entry goes is a multiplicative hash
+ * of the short ID with a random odd salt, so a peer can't pick short IDs that pile up in one place, and
+ * an entry is never placed more than SHORTID_MAX_PROBES slots after that.
+ */
+class ShortIdTable
+{
+    std::vector<uint64_t> vKeys;
+    std::vector<uint16_t> vValues;
+    const uint64_t nSalt;
+    int nShift;
+    size_t nMask;
+    size_t nEntries;
+
+    size_t Slot(uint64_t key) const { return (key * nSalt) >> nShift; }
+
+public:
+    ShortIdTable() : nSalt(GetRand(std::numeric_limits<uint64_t>::max()) | 1) { Reset(0); }
+
+    /** Empty the table, with room for count entries at a load of at most 1/4 */
+    void Reset(size_t count)
+    {
+        int nBits = 6;
+        while (((size_t)1 << nBits) < 4 * count)
+            nBits++;
+        nShift = 64 - nBits;
+        nMask = ((size_t)1 << nBits) - 1;
+        vKeys.assign(nMask + 1, SHORTID_EMPTY);
+        vValues.resize(nMask + 1);
+        nEntries = 0;
+    }
+
+    /** Fails if the key is already in, or there's no free slot close enough to where it goes */
+    bool Insert(uint64_t key, uint16_t value)
+    {
+        size_t pos = Slot(key);
+        for (size_t i = 0; i < SHORTID_MAX_PROBES; i++, pos = (pos + 1) & nMask) {
+            if (vKeys[pos] == SHORTID_EMPTY) {
+                vKeys[pos] = key;
+                vValues[pos] = value;
+                nEntries++;
+                return true;
+            }
+            if (vKeys[pos] == key)
+                return false;
+        }
+        return false;
+    }
 
+    const uint16_t* Find(uint64_t key) const
+    {
+        size_t pos = Slot(key);
+        for (size_t i = 0; i < SHORTID_MAX_PROBES; i++, pos = (pos + 1) & nMask) {
+            if (vKeys[pos] == key)
+                return &vValues[pos];
+            if (vKeys[pos] == SHORTID_EMPTY)
+                return nullptr;
+        }
+        return nullptr;
+    }
+
+    size_t size() const { return nEntries; }
+};
+
+CCriticalSection cs_compact_block_stats;
+CompactBlockStats compactBlockStats;
+
+}
+
+CompactBlockStats GetCompactBlockStats()
+{
+    LOCK(cs_compact_block_stats);
+    return compactBlockStats;
+}
 
 ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& cmpctblock, const std::vector<std::pair<uint256, CTransactionRef>>& extra_txn) {
     if (cmpctblock.header.IsNull() || (cmpctblock.shorttxids.empty() && cmpctblock.prefilledtxn.empty()))
@@ -51,6 +142,7 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     if (cmpctblock.shorttxids.size() + cmpctblock.prefilledtxn.size() > MAX_BLOCK_WEIGHT / MIN_SERIALIZABLE_TRANSACTION_WEIGHT)
         return READ_STATUS_INVALID;
 
+    const int64_t nTimeStart = GetTimeMicros();
     assert(header.IsNull() && txn_available.empty());
     header = cmpctblock.header;
     txn_available.resize(cmpctblock.BlockTxCount());
@@ -74,70 +166,65 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
     prefilled_count = cmpctblock.prefilledtxn.size();
 
     // Calculate map of txids -> positions and check mempool to see what we have (or don't)
+    // LitecoinCash: CompactBlocks: The probe table keeps entries within SHORTID_MAX_PROBES slots of where they hash to.
     // Because well-formed cmpctblock messages will have a (relatively) uniform distribution
-    // of short IDs, any highly-uneven distribution of elements can be safely treated as a
-    // READ_STATUS_FAILED.
-    std::unordered_map<uint64_t, uint16_t> shorttxids(cmpctblock.shorttxids.size());
+    // of short IDs, and the table's hash is salted, an entry that can't be placed close
+    // enough can be safely treated as a READ_STATUS_FAILED.
+    static thread_local ShortIdTable shorttxids;
+    shorttxids.Reset(cmpctblock.shorttxids.size());
     uint16_t index_offset = 0;
     for (size_t i = 0; i < cmpctblock.shorttxids.size(); i++) {
         while (txn_available[i + index_offset])
             index_offset++;
-        shorttxids[cmpctblock.shorttxids[i]] = i + index_offset;
-        // To determine the chance that the number of entries in a bucket exceeds N,
-        // we use the fact that the number of elements in a single bucket is
-        // binomially distributed (with n = the number of shorttxids S, and p =
-        // 1 / the number of buckets), that in the worst case the number of buckets is
-        // equal to S (due to std::unordered_map having a default load factor of 1.0),
-        // and that the chance for any bucket to exceed N elements is at most
-        // buckets * (the chance that any given bucket is above N elements).
-        // Thus: P(max_elements_per_bucket > N) <= S * (1 - cdf(binomial(n=S,p=1/S), N)).
-        // If we assume blocks of up to 16000, allowing 12 elements per bucket should
-        // only fail once per ~1 million block transfers (per peer and connection).
-        if (shorttxids.bucket_size(shorttxids.bucket(cmpctblock.shorttxids[i])) > 12)
-            return READ_STATUS_FAILED;
+        // TODO: in the shortid-collision case, we should instead request both transactions
+        // which collided. Falling back to full-block-request here is overkill.
+        if (!shorttxids.Insert(cmpctblock.shorttxids[i], i + index_offset))
+            return READ_STATUS_FAILED; // Short ID collision, or too uneven a distribution
     }
-    // TODO: in the shortid-collision case, we should instead request both transactions
-    // which collided. Falling back to full-block-request here is overkill.
-    if (shorttxids.size() != cmpctblock.shorttxids.size())
-        return READ_STATUS_FAILED; // Short ID collision
 
     std::vector<bool> have_txn(txn_available.size());
     {
     LOCK(pool->cs);
-    const std::vector<std::pair<uint256, CTxMemPool::txiter> >& vTxHashes = pool->vTxHashes;
-    for (size_t i = 0; i < vTxHashes.size(); i++) {
-        uint64_t shortid = cmpctblock.GetShortID(vTxHashes[i].first);
-        std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
-        if (idit != shorttxids.end()) {
-            if (!have_txn[idit->second]) {
-                txn_available[idit->second] = vTxHashes[i].second->GetSharedTx();
-                have_txn[idit->second]  = true;
-                mempool_count++;
-            } else {
-                // If we find two mempool txn that match the short id, just request it.
-                // This should be rare enough that the extra bandwidth doesn't matter,
-                // but eating a round-trip due to FillBlock failure would be annoying
-                if (txn_available[idit->second]) {
-                    txn_available[idit->second].reset();
-                    mempool_count--;
+    // LitecoinCash: CompactBlocks: Short IDs are computed for a batch of mempool witness hashes at a time,
+    // so the early exit below still saves most of the work
+    uint64_t mempool_shortids[SHORTID_BATCH_SIZE];
+    const std::vector<uint256>& vTxHashes = pool->vTxHashes;
+    for (size_t batch = 0; batch < vTxHashes.size() && mempool_count < shorttxids.size(); batch += SHORTID_BATCH_SIZE) {
+        const size_t batch_count = std::min(SHORTID_BATCH_SIZE, vTxHashes.size() - batch);
+        cmpctblock.GetShortIDs(&vTxHashes[batch], batch_count, mempool_shortids);
+        for (size_t j = 0; j < batch_count; j++) {
+            const uint16_t* idit = shorttxids.Find(mempool_shortids[j]);
+            if (idit) {
+                if (!have_txn[*idit]) {
+                    txn_available[*idit] = pool->vTxHashEntries[batch + j]->GetSharedTx();
+                    have_txn[*idit]  = true;
+                    mempool_count++;
+                } else {
+                    // If we find two mempool txn that match the short id, just request it.
+                    // This should be rare enough that the extra bandwidth doesn't matter,
+                    // but eating a round-trip due to FillBlock failure would be annoying
+                    if (txn_available[*idit]) {
+                        txn_available[*idit].reset();
+                        mempool_count--;
+                    }
                 }
             }
+            // Though ideally we'd continue scanning for the two-txn-match-shortid case,
+            // the performance win of an early exit here is too good to pass up and worth
+            // the extra risk.
+            if (mempool_count == shorttxids.size())
+                break;
         }
-        // Though ideally we'd continue scanning for the two-txn-match-shortid case,
-        // the performance win of an early exit here is too good to pass up and worth
-        // the extra risk.
-        if (mempool_count == shorttxids.size())
-            break;
     }
     }
 
     for (size_t i = 0; i < extra_txn.size(); i++) {
         uint64_t shortid = cmpctblock.GetShortID(extra_txn[i].first);
-        std::unordered_map<uint64_t, uint16_t>::iterator idit = shorttxids.find(shortid);
-        if (idit != shorttxids.end()) {
-            if (!have_txn[idit->second]) {
-                txn_available[idit->second] = extra_txn[i].second;
-                have_txn[idit->second]  = true;
+        const uint16_t* idit = shorttxids.Find(shortid);
+        if (idit) {
+            if (!have_txn[*idit]) {
+                txn_available[*idit] = extra_txn[i].second;
+                have_txn[*idit]  = true;
                 mempool_count++;
                 extra_count++;
             } else {
@@ -147,9 +234,9 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
                 // but eating a round-trip due to FillBlock failure would be annoying
                 // Note that we don't want duplication between extra_txn and mempool to
                 // trigger this case, so we compare witness hashes first
-                if (txn_available[idit->second] &&
-                        txn_available[idit->second]->GetWitnessHash() != extra_txn[i].second->GetWitnessHash()) {
-                    txn_available[idit->second].reset();
+                if (txn_available[*idit] &&
+                        txn_available[*idit]->GetWitnessHash() != extra_txn[i].second->GetWitnessHash()) {
+                    txn_available[*idit].reset();
                     mempool_count--;
                     extra_count--;
                 }
@@ -162,7 +249,20 @@ ReadStatus PartiallyDownloadedBlock::InitData(const CBlockHeaderAndShortTxIDs& c
             break;
     }
 
-    LogPrint(BCLog::CMPCTBLOCK, "Initialized PartiallyDownloadedBlock for block %s using a cmpctblock of size %lu\n", cmpctblock.header.GetHash().ToString(), GetSerializeSize(cmpctblock, SER_NETWORK, PROTOCOL_VERSION));
+    // LitecoinCash: CompactBlocks: Reconstruction stats
+    const int64_t nMicros = GetTimeMicros() - nTimeStart;
+    {
+        LOCK(cs_compact_block_stats);
+        compactBlockStats.nBlocks++;
+        compactBlockStats.nTxPrefilled += prefilled_count;
+        compactBlockStats.nTxMempool += mempool_count - extra_count;
+        compactBlockStats.nTxExtra += extra_count;
+        compactBlockStats.nTxMissing += txn_available.size() - prefilled_count - mempool_count;
+        compactBlockStats.nReconstructMicros += nMicros;
+        compactBlockStats.nMaxReconstructMicros = std::max(compactBlockStats.nMaxReconstructMicros, nMicros);
+    }
+
+    LogPrint(BCLog::CMPCTBLOCK, "Initialized PartiallyDownloadedBlock for block %s using a cmpctblock of size %lu (%.2fms)\n", cmpctblock.header.GetHash().ToString(), GetSerializeSize(cmpctblock, SER_NETWORK, PROTOCOL_VERSION), 0.001 * nMicros);
 
     return READ_STATUS_OK;
 }
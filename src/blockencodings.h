@@ -151,6 +151,8 @@ public:
     CBlockHeaderAndShortTxIDs(const CBlock& block, bool fUseWTXID);
 
     uint64_t GetShortID(const uint256& txhash) const;
+    /** LitecoinCash: CompactBlocks: GetShortID of count hashes at once */
+    void GetShortIDs(const uint256* txhashes, size_t count, uint64_t* out) const;
 
     size_t BlockTxCount() const { return shorttxids.size() + prefilledtxn.size(); }
 
@@ -206,4 +208,16 @@ public:
     ReadStatus FillBlock(CBlock& block, const std::vector<CTransactionRef>& vtx_missing);
 };
 
+/** LitecoinCash: CompactBlocks: Statistics about compact blocks reconstructed since startup */
+struct CompactBlockStats {
+    uint64_t nBlocks = 0;               //!< Compact blocks initialized
+    uint64_t nTxPrefilled = 0;          //!< Transactions sent along with the compact block
+    uint64_t nTxMempool = 0;            //!< Transactions found in the mempool
+    uint64_t nTxExtra = 0;              //!< Transactions found among the extra transactions
+    uint64_t nTxMissing = 0;            //!< Transactions that had to be requested
+    int64_t nReconstructMicros = 0;     //!< Total time spent matching short IDs
+    int64_t nMaxReconstructMicros = 0;  //!< Longest time spent matching the short IDs of one block
+};
+CompactBlockStats GetCompactBlockStats();
+
 #endif
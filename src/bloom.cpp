@@ -4,7 +4,10 @@
 
 #include <bloom.h>
 
+#include <primitives/block.h>
 #include <primitives/transaction.h>
+#include <crypto/common.h>
+#include <crypto/sha256.h>
 #include <hash.h>
 #include <script/script.h>
 #include <script/standard.h>
@@ -125,6 +128,31 @@ void CBloomFilter::reset(const unsigned int nNewTweak)
     nTweak = nNewTweak;
 }
 
+bool CBloomFilter::ContainsPrepared(const uint32_t* pk, uint32_t nLen) const
+{
+    if (isFull)
+        return true;
+    if (isEmpty)
+        return false;
+    // Most elements miss on the first hash function, so that one is checked on its own; a batch of
+    // seeds for the rest costs little more than one
+    uint32_t seeds[8], hashes[8];
+    for (unsigned int i = 0, nCount; i < nHashFuncs; i += nCount)
+    {
+        nCount = i == 0 ? 1 : std::min(nHashFuncs - i, 8u);
+        for (unsigned int j = 0; j < nCount; j++)
+            seeds[j] = (i + j) * 0xFBA4C795 + nTweak;
+        MurmurHash3PreparedBatch(pk, nLen, seeds, nCount, hashes);
+        for (unsigned int j = 0; j < nCount; j++)
+        {
+            unsigned int nIndex = hashes[j] % (vData.size() * 8);
+            if (!(vData[nIndex >> 3] & (1 << (7 & nIndex))))
+                return false;
+        }
+    }
+    return true;
+}
+
 bool CBloomFilter::IsWithinSizeConstraints() const
 {
     return vData.size() <= MAX_BLOOM_FILTER_SIZE && nHashFuncs <= MAX_HASH_FUNCS;
@@ -200,6 +228,146 @@ bool CBloomFilter::IsRelevantAndUpdate(const CTransaction& tx)
     return false;
 }
 
+bool CBloomFilter::IsRelevantAndUpdate(const CBloomBlockElements& elements, size_t nTx)
+{
+    // Keep in step with IsRelevantAndUpdate(const CTransaction&) above
+    bool fFound = false;
+    if (isFull)
+        return true;
+    if (isEmpty)
+        return false;
+    const CBloomBlockElements::Tx& tx = elements.vTx[nTx];
+    if (ContainsPrepared(&elements.vWords[tx.txid.nPos], tx.txid.nLen))
+        fFound = true;
+
+    for (uint32_t i = tx.nOutputsBegin; i < tx.nOutputsEnd; i++)
+    {
+        const CBloomBlockElements::Output& output = elements.vOutputs[i];
+        for (uint32_t j = output.nElementsBegin; j < output.nElementsEnd; j++)
+        {
+            const CBloomBlockElements::Element& element = elements.vElements[j];
+            if (ContainsPrepared(&elements.vWords[element.nPos], element.nLen))
+            {
+                fFound = true;
+                if ((nFlags & BLOOM_UPDATE_MASK) == BLOOM_UPDATE_ALL ||
+                        ((nFlags & BLOOM_UPDATE_MASK) == BLOOM_UPDATE_P2PUBKEY_ONLY && output.fPubKeyOrMultisig))
+                    insert(COutPoint(tx.hash, i - tx.nOutputsBegin));
+                break;
+            }
+        }
+    }
+
+    if (fFound)
+        return true;
+
+    for (uint32_t i = tx.nInputsBegin; i < tx.nInputsEnd; i++)
+    {
+        const CBloomBlockElements::Input& input = elements.vInputs[i];
+        if (ContainsPrepared(&elements.vWords[input.prevout.nPos], input.prevout.nLen))
+            return true;
+        for (uint32_t j = input.nElementsBegin; j < input.nElementsEnd; j++)
+        {
+            const CBloomBlockElements::Element& element = elements.vElements[j];
+            if (ContainsPrepared(&elements.vWords[element.nPos], element.nLen))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+CBloomBlockElements::Element CBloomBlockElements::Add(const unsigned char* data, size_t nLen)
+{
+    Element element;
+    element.nPos = vWords.size();
+    element.nLen = nLen;
+    MurmurHash3Prepare(data, nLen, vWords);
+    return element;
+}
+
+CBloomBlockElements::CBloomBlockElements(const CBlock& block)
+{
+    vTx.reserve(block.vtx.size());
+    std::vector<unsigned char> data;
+    for (const CTransactionRef& ptx : block.vtx)
+    {
+        Tx tx;
+        tx.hash = ptx->GetHash();
+        tx.txid = Add(tx.hash.begin(), tx.hash.size());
+
+        tx.nOutputsBegin = vOutputs.size();
+        for (const CTxOut& txout : ptx->vout)
+        {
+            Output output;
+            output.nElementsBegin = vElements.size();
+            CScript::const_iterator pc = txout.scriptPubKey.begin();
+            while (pc < txout.scriptPubKey.end())
+            {
+                opcodetype opcode;
+                if (!txout.scriptPubKey.GetOp(pc, opcode, data))
+                    break;
+                if (data.size() != 0)
+                    vElements.push_back(Add(data.data(), data.size()));
+            }
+            output.nElementsEnd = vElements.size();
+            txnouttype type;
+            std::vector<std::vector<unsigned char> > vSolutions;
+            output.fPubKeyOrMultisig = output.nElementsEnd != output.nElementsBegin && Solver(txout.scriptPubKey, type, vSolutions) &&
+                (type == TX_PUBKEY || type == TX_MULTISIG);
+            vOutputs.push_back(output);
+        }
+        tx.nOutputsEnd = vOutputs.size();
+
+        tx.nInputsBegin = vInputs.size();
+        for (const CTxIn& txin : ptx->vin)
+        {
+            // The serialized outpoint: hash, then index
+            unsigned char prevout[36];
+            memcpy(prevout, txin.prevout.hash.begin(), 32);
+            WriteLE32(prevout + 32, txin.prevout.n);
+            Input input;
+            input.prevout = Add(prevout, sizeof(prevout));
+            input.nElementsBegin = vElements.size();
+            CScript::const_iterator pc = txin.scriptSig.begin();
+            while (pc < txin.scriptSig.end())
+            {
+                opcodetype opcode;
+                if (!txin.scriptSig.GetOp(pc, opcode, data))
+                    break;
+                if (data.size() != 0)
+                    vElements.push_back(Add(data.data(), data.size()));
+            }
+            input.nElementsEnd = vElements.size();
+            vInputs.push_back(input);
+        }
+        tx.nInputsEnd = vInputs.size();
+        vTx.push_back(tx);
+    }
+
+    // Each level of the merkle tree hashes pairs of nodes of the one below, an odd node out paired with itself
+    vMerkleTree.reserve(vTx.size() * 2);
+    for (const Tx& tx : vTx)
+        vMerkleTree.push_back(tx.hash);
+    std::vector<unsigned char> vPairs;
+    size_t nLevelBegin = 0, nWidth = vTx.size();
+    while (nWidth > 1)
+    {
+        const size_t nNextWidth = (nWidth + 1) / 2;
+        vPairs.resize(nNextWidth * 64);
+        for (size_t i = 0; i < nNextWidth; i++)
+        {
+            const uint256& left = vMerkleTree[nLevelBegin + i * 2];
+            const uint256& right = i * 2 + 1 < nWidth ? vMerkleTree[nLevelBegin + i * 2 + 1] : left;
+            memcpy(&vPairs[i * 64], left.begin(), 32);
+            memcpy(&vPairs[i * 64 + 32], right.begin(), 32);
+        }
+        nLevelBegin = vMerkleTree.size();
+        vMerkleTree.resize(nLevelBegin + nNextWidth);
+        SHA256D64(vMerkleTree[nLevelBegin].begin(), vPairs.data(), nNextWidth);
+        nWidth = nNextWidth;
+    }
+}
+
 void CBloomFilter::UpdateEmptyFull()
 {
     bool full = true;
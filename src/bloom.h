@@ -6,12 +6,14 @@
 #define BITCOIN_BLOOM_H
 
 #include <serialize.h>
+#include <uint256.h>
 
 #include <vector>
 
+class CBlock;
+class CBloomBlockElements;
 class COutPoint;
 class CTransaction;
-class uint256;
 
 //! 20,000 items with fp rate < 0.1% or 10,000 items and <0.0001%
 static const unsigned int MAX_BLOOM_FILTER_SIZE = 36000; // bytes
@@ -52,6 +54,8 @@ private:
     unsigned char nFlags;
 
     unsigned int Hash(unsigned int nHashNum, const std::vector<unsigned char>& vDataToHash) const;
+    // LitecoinCash: BloomBatch: contains() for data prepared by CBloomBlockElements
+    bool ContainsPrepared(const uint32_t* pk, uint32_t nLen) const;
 
     // Private constructor for CRollingBloomFilter, no restrictions on size
     CBloomFilter(const unsigned int nElements, const double nFPRate, const unsigned int nTweak);
@@ -97,11 +101,62 @@ public:
 
     //! Also adds any outputs which match the filter to the filter (to match their spending txes)
     bool IsRelevantAndUpdate(const CTransaction& tx);
+    //! LitecoinCash: BloomBatch: The same, for transaction nTx of a block prepared once for all filters
+    bool IsRelevantAndUpdate(const CBloomBlockElements& elements, size_t nTx);
 
     //! Checks for empty and full filters to avoid wasting cpu
     void UpdateEmptyFull();
 };
 
+/**
+ * LitecoinCash: BloomBatch: The data elements IsRelevantAndUpdate looks at in the transactions of a block, picked
+ * out of the scripts and serialized once, with the seed independent part of their hashing done (see
+ * MurmurHash3Prepare), along with the block's merkle tree. Any number of filters can then be matched against the
+ * block, and partial merkle trees built for them, for a fraction of the cost.
+ */
+class CBloomBlockElements
+{
+private:
+    //! Data of nLen bytes, prepared at vWords[nPos]
+    struct Element {
+        uint32_t nPos;
+        uint32_t nLen;
+    };
+    struct Output {
+        uint32_t nElementsBegin, nElementsEnd;  //!< The data pushes in the scriptPubKey
+        bool fPubKeyOrMultisig;                 //!< Whether BLOOM_UPDATE_P2PUBKEY_ONLY adds it
+    };
+    struct Input {
+        Element prevout;
+        uint32_t nElementsBegin, nElementsEnd;  //!< The data pushes in the scriptSig
+    };
+    struct Tx {
+        uint256 hash;
+        Element txid;
+        uint32_t nOutputsBegin, nOutputsEnd;
+        uint32_t nInputsBegin, nInputsEnd;
+    };
+
+    std::vector<uint32_t> vWords;
+    std::vector<Element> vElements;
+    std::vector<Output> vOutputs;
+    std::vector<Input> vInputs;
+    std::vector<Tx> vTx;
+    std::vector<uint256> vMerkleTree;
+
+    Element Add(const unsigned char* data, size_t nLen);
+
+    friend class CBloomFilter;
+
+public:
+    explicit CBloomBlockElements(const CBlock& block);
+
+    size_t size() const { return vTx.size(); }
+
+    /** The hashes of the block's merkle tree, level by level from the txids up; CMerkleBlock doesn't have to hash for each filter */
+    const std::vector<uint256>& MerkleTree() const { return vMerkleTree; }
+};
+
 /**
  * RollingBloomFilter is a probabilistic "keep track of most recently inserted" set.
  * Construct it with the number of items to keep track of, and a false-positive
@@ -443,6 +443,10 @@ public:
         consensus.totalMoneySupplyHeight = 6215968;         // Height at which TMS is reached, do not issue rewards past this point (Note, not accurate value for testnet)
         consensus.hiveNonceMarker = 192;                    // Nonce marker for hivemined blocks
 
+        // LitecoinCash: MinotaurX+Hive1.2: Pow type limits are indexed for every block type (eg in CheckProofOfWork)
+        consensus.powTypeLimits.emplace_back(uint256S("0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));   // sha256d limit
+        consensus.powTypeLimits.emplace_back(uint256S("0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));   // MinotaurX limit
+
         // The best chain should have at least this much work.
         consensus.nMinimumChainWork = uint256S("0x00");
 
@@ -0,0 +1,188 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainstats.h>
+
+#include <arith_uint256.h>
+#include <chain.h>
+#include <chainparams.h>
+#include <memusage.h>
+#include <util.h>
+#include <utiltime.h>
+#include <validation.h>
+
+#include <algorithm>
+
+CChainTypeStats chainTypeStats;
+
+CChainTypeStats::CChainTypeStats() : pindexTip(nullptr)
+{
+}
+
+// Estimated hashes for a pow block, as GetNumHashes() but without re-checking the block type
+static double GetBlockHashes(const CBlockIndex* pindex)
+{
+    arith_uint256 bnTarget;
+    bool fNegative;
+    bool fOverflow;
+
+    bnTarget.SetCompact(pindex->nBits, &fNegative, &fOverflow);
+    if (fNegative || fOverflow || bnTarget == 0)
+        return 0;
+    return ((~bnTarget / (bnTarget + 1)) + 1).getdouble();
+}
+
+int CChainTypeStats::FindLast(ChainStatsType type, int nHeight) const
+{
+    AssertLockHeld(cs);
+    const std::vector<Entry>& entries = vEntries[type];
+    std::vector<Entry>::const_iterator it = std::upper_bound(entries.begin(), entries.end(), nHeight,
+        [](int h, const Entry& entry) { return h < entry.nHeight; });
+    return (int)(it - entries.begin()) - 1;
+}
+
+void CChainTypeStats::SetTip(const CBlockIndex* pindexNew)
+{
+    AssertLockHeld(cs_main);
+    int64_t nTimeStart = GetTimeMicros();
+    const Consensus::Params& consensusParams = Params().GetConsensus();
+
+    // Find where the new tip forks from what we've indexed
+    const CBlockIndex* pindexFork;
+    {
+        LOCK(cs);
+        pindexFork = (pindexTip && pindexNew) ? LastCommonAncestor(pindexTip, pindexNew) : nullptr;
+    }
+    const int nForkHeight = pindexFork ? pindexFork->nHeight : -1;
+
+    // Gather the newly connected blocks, newest first
+    std::vector<const CBlockIndex*> vNew;
+    if (pindexNew)
+        vNew.reserve(pindexNew->nHeight - nForkHeight);
+    for (const CBlockIndex* pindex = pindexNew; pindex && pindex != pindexFork; pindex = pindex->pprev)
+        vNew.push_back(pindex);
+
+    // MinotaurX activation is permanent, so rather than checking each block (which takes cs_main
+    // and a versionbits lookup every time), binary search for the oldest block it applies to
+    size_t nMinotaurX = 0;  // vNew[0, nMinotaurX) have MinotaurX enabled
+    {
+        size_t nHigh = vNew.size();
+        while (nMinotaurX < nHigh) {
+            size_t nMid = (nMinotaurX + nHigh) / 2;
+            if (IsMinotaurXEnabled(vNew[nMid], consensusParams))
+                nMinotaurX = nMid + 1;
+            else
+                nHigh = nMid;
+        }
+    }
+
+    // Classify the new blocks, matching the block type rules used by GetDifficulty and GetNumHashes
+    struct PendingEntry {
+        ChainStatsType type;
+        int32_t nHeight;
+        uint32_t nTime;
+        double dHashes;
+    };
+    std::vector<PendingEntry> vPending;
+    vPending.reserve(vNew.size());
+    for (size_t i = 0; i < vNew.size(); i++) {
+        const CBlockHeader header = vNew[i]->GetBlockHeader();
+        PendingEntry pending;
+        if (header.IsHiveMined(consensusParams)) {
+            pending.type = CHAINSTATS_HIVE;
+        } else if (i >= nMinotaurX) {
+            pending.type = CHAINSTATS_SHA256;   // Before MinotaurX, all pow blocks count as SHA256d
+        } else {
+            POW_TYPE powType = header.GetPoWType();
+            if (powType >= NUM_BLOCK_TYPES)
+                continue;
+            pending.type = (ChainStatsType)powType;
+        }
+        pending.nHeight = vNew[i]->nHeight;
+        pending.nTime = vNew[i]->nTime;
+        pending.dHashes = pending.type == CHAINSTATS_HIVE ? 0 : GetBlockHashes(vNew[i]);
+        vPending.push_back(pending);
+    }
+
+    LOCK(cs);
+
+    // Drop anything above the fork point
+    for (int i = 0; i < NUM_CHAINSTATS_TYPES; i++)
+        while (!vEntries[i].empty() && vEntries[i].back().nHeight > nForkHeight)
+            vEntries[i].pop_back();
+
+    // Append the new blocks, oldest first
+    for (std::vector<PendingEntry>::const_reverse_iterator it = vPending.rbegin(); it != vPending.rend(); ++it) {
+        std::vector<Entry>& entries = vEntries[it->type];
+        Entry entry;
+        entry.nHeight = it->nHeight;
+        entry.nTimeMax = entries.empty() ? it->nTime : std::max(entries.back().nTimeMax, it->nTime);
+        entry.dCumulativeHashes = (entries.empty() ? 0 : entries.back().dCumulativeHashes) + it->dHashes;
+        entries.push_back(entry);
+    }
+    pindexTip = pindexNew;
+
+    if (vNew.size() > 1)
+        LogPrint(BCLog::BENCH, "%s: Indexed %u blocks from height %d in %.2fms\n", __func__, vNew.size(), nForkHeight + 1, 0.001 * (GetTimeMicros() - nTimeStart));
+}
+
+bool CChainTypeStats::GetLastBlock(const CBlockIndex* pindex, ChainStatsType type, const CBlockIndex*& pindexOut) const
+{
+    LOCK(cs);
+    if (!pindex || !pindexTip || pindex->nHeight > pindexTip->nHeight || pindexTip->GetAncestor(pindex->nHeight) != pindex)
+        return false;
+
+    int i = FindLast(type, pindex->nHeight);
+    pindexOut = i < 0 ? nullptr : pindexTip->GetAncestor(vEntries[type][i].nHeight);
+    return true;
+}
+
+const CBlockIndex* CChainTypeStats::GetLastBlock(int nHeight, ChainStatsType type) const
+{
+    LOCK(cs);
+    if (!pindexTip)
+        return nullptr;
+    if (nHeight < 0 || nHeight > pindexTip->nHeight)
+        nHeight = pindexTip->nHeight;
+
+    int i = FindLast(type, nHeight);
+    return i < 0 ? nullptr : pindexTip->GetAncestor(vEntries[type][i].nHeight);
+}
+
+CChainStatsWindow CChainTypeStats::GetWindow(int nHeight, int nLookup, ChainStatsType type) const
+{
+    CChainStatsWindow window;
+
+    LOCK(cs);
+    if (!pindexTip)
+        return window;
+    if (nHeight < 0 || nHeight > pindexTip->nHeight)
+        nHeight = pindexTip->nHeight;
+
+    const std::vector<Entry>& entries = vEntries[type];
+    int nLast = FindLast(type, nHeight);
+    if (nLast < 0)
+        return window;
+    int nFirst = std::max(0, nLast - std::max(0, nLookup));
+
+    window.nBlocks = nLast - nFirst + 1;
+    window.dHashes = entries[nLast].dCumulativeHashes - (nFirst > 0 ? entries[nFirst - 1].dCumulativeHashes : 0);
+    window.nTimeSpan = (int64_t)entries[nLast].nTimeMax - (int64_t)entries[nFirst].nTimeMax;
+    return window;
+}
+
+const CBlockIndex* CChainTypeStats::Tip() const
+{
+    LOCK(cs);
+    return pindexTip;
+}
+
+size_t CChainTypeStats::DynamicMemoryUsage() const
+{
+    LOCK(cs);
+    size_t nUsage = 0;
+    for (int i = 0; i < NUM_CHAINSTATS_TYPES; i++)
+        nUsage += memusage::DynamicUsage(vEntries[i]);
+    return nUsage;
+}
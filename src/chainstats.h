@@ -0,0 +1,84 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef LITECOINCASH_CHAINSTATS_H
+#define LITECOINCASH_CHAINSTATS_H
+
+#include <primitives/block.h>
+#include <sync.h>
+
+#include <stdint.h>
+#include <vector>
+
+class CBlockIndex;
+
+/*
+LitecoinCash: MinotaurX+Hive1.2: Per block type statistics for the active chain.
+
+Difficulty and network hashrate queries only care about blocks of a single type (SHA256d,
+MinotaurX or Hive), which are interleaved on the chain. Rather than stepping back through
+the chain block by block (checking MinotaurX activation at each step) on every query, this
+index keeps a compact, height-ordered list of the active chain's blocks for each type with
+cumulative estimated hashes and a running maximum timestamp. It is kept in step with
+chainActive on every tip change, and answers lookups without cs_main.
+*/
+
+// Block types tracked by the stats index; pow types share values with POW_TYPE
+enum ChainStatsType {
+    CHAINSTATS_SHA256 = POW_TYPE_SHA256,
+    CHAINSTATS_MINOTAURX = POW_TYPE_MINOTAURX,
+    CHAINSTATS_HIVE = NUM_BLOCK_TYPES,
+    NUM_CHAINSTATS_TYPES
+};
+
+/** Summary of a run of same-type blocks, as returned by CChainTypeStats::GetWindow() */
+struct CChainStatsWindow {
+    int nBlocks;            // Number of same-type blocks in the window
+    double dHashes;         // Estimated hashes performed over the window
+    int64_t nTimeSpan;      // Seconds between the running max timestamps at the first and last blocks
+
+    CChainStatsWindow() : nBlocks(0), dHashes(0), nTimeSpan(0) {}
+};
+
+class CChainTypeStats
+{
+private:
+    struct Entry {
+        int32_t nHeight;
+        uint32_t nTimeMax;          // Max block timestamp among this type's blocks up to and including this one
+        double dCumulativeHashes;   // Sum of GetNumHashes() over this type's blocks up to and including this one
+    };
+
+    mutable CCriticalSection cs;
+    const CBlockIndex* pindexTip;
+    std::vector<Entry> vEntries[NUM_CHAINSTATS_TYPES];
+
+    // Index into vEntries[type] of the last block at or below nHeight, or -1
+    int FindLast(ChainStatsType type, int nHeight) const;
+
+public:
+    CChainTypeStats();
+
+    /** Bring the index in line with a new active chain tip (requires cs_main; nullptr to clear) */
+    void SetTip(const CBlockIndex* pindexNew);
+
+    /** Last block of given type at or below pindex, or nullptr if there is none. Returns false if pindex isn't on the indexed chain */
+    bool GetLastBlock(const CBlockIndex* pindex, ChainStatsType type, const CBlockIndex*& pindexOut) const;
+
+    /** Last block of given type at or below nHeight on the indexed chain (or at the tip, if nHeight < 0) */
+    const CBlockIndex* GetLastBlock(int nHeight, ChainStatsType type) const;
+
+    /** Summarise up to nLookup same-type blocks preceding (and including) the last one at or below nHeight (or at the tip, if nHeight < 0) */
+    CChainStatsWindow GetWindow(int nHeight, int nLookup, ChainStatsType type) const;
+
+    /** Currently indexed tip */
+    const CBlockIndex* Tip() const;
+
+    size_t DynamicMemoryUsage() const;
+};
+
+/** Stats index for chainActive */
+extern CChainTypeStats chainTypeStats;
+
+#endif // LITECOINCASH_CHAINSTATS_H
@@ -8,6 +8,10 @@
 #include <sync.h>
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <boost/thread/condition_variable.hpp>
@@ -25,12 +29,39 @@ class CCheckQueueControl;
   * onto the queue, where they are processed by N-1 worker threads. When
   * the master is done adding work, it temporarily joins the worker pool
   * as an N'th worker, until all jobs are done.
+  *
+  * LitecoinCash: WorkStealing: Every worker has its own queue, and the
+  * master deals the verifications it adds out over them. A worker takes
+  * from the back of its own queue, and when that runs dry it steals half
+  * of somebody else's from the front. Each queue has its own lock, which
+  * is only ever contended by a thief, so no lock is shared by all workers
+  * while there is work to do. The shared mutex is only taken to go to
+  * sleep and to wake sleepers up.
   */
 template <typename T>
 class CCheckQueue
 {
 private:
-    //! Mutex to protect the inner state
+    //! LitecoinCash: WorkStealing: Verifications waiting to be taken by one worker (or stolen by another)
+    struct WorkerQueue {
+        std::mutex mutex;
+        //! Taken from the back by its owner, stolen from the front by others
+        std::deque<T> queue;
+    };
+
+    //! LitecoinCash: WorkStealing: Workers beyond this many share queues
+    static const size_t MAX_WORKER_QUEUES = 64;
+
+    //! Queue 0 belongs to the master, the rest to the workers in the order they started
+    std::vector<std::unique_ptr<WorkerQueue>> vQueues;
+
+    //! The number of worker threads (excluding the master) that have started.
+    std::atomic<unsigned int> nWorkers;
+
+    //! The worker queue to deal the next verifications to
+    unsigned int nNextQueue;
+
+    //! Mutex for sleeping and waking up
     boost::mutex mutex;
 
     //! Worker threads block on this when out of work
@@ -39,87 +70,107 @@ private:
     //! Master thread blocks on this when out of work
     boost::condition_variable condMaster;
 
-    //! The queue of elements to be processed.
-    //! As the order of booleans doesn't matter, it is used as a LIFO (stack)
-    std::vector<T> queue;
-
-    //! The number of workers (including the master) that are idle.
-    int nIdle;
-
-    //! The total number of workers (including the master).
-    int nTotal;
-
     //! The temporary evaluation result.
-    bool fAllOk;
+    std::atomic<bool> fAllOk;
 
     /**
      * Number of verifications that haven't completed yet.
      * This includes elements that are no longer queued, but still in the
      * worker's own batches.
      */
-    unsigned int nTodo;
+    std::atomic<unsigned int> nTodo;
+
+    //! Number of verifications in the worker queues
+    std::atomic<unsigned int> nQueued;
 
     //! The maximum number of elements to be processed in one batch
     unsigned int nBatchSize;
 
+    //! Number of queues work is dealt out over, and stolen from
+    size_t NumQueues() const
+    {
+        const size_t nQueues = nWorkers.load(std::memory_order_acquire) + 1;
+        return nQueues < MAX_WORKER_QUEUES ? nQueues : MAX_WORKER_QUEUES;
+    }
+
+    /** Move up to nMax verifications from one end of q into vChecks. */
+    static void TakeFrom(std::deque<T>& q, size_t nMax, bool fBack, std::vector<T>& vChecks)
+    {
+        const size_t nNow = std::min(nMax, q.size());
+        vChecks.resize(nNow);
+        for (size_t i = 0; i < nNow; i++) {
+            // Swap instead of copy, as verifications may own memory
+            if (fBack) {
+                vChecks[i].swap(q.back());
+                q.pop_back();
+            } else {
+                vChecks[i].swap(q.front());
+                q.pop_front();
+            }
+        }
+    }
+
+    /** Get a batch of verifications to do: from our own queue, or else stolen from another. */
+    bool Take(size_t nSelf, std::vector<T>& vChecks)
+    {
+        {
+            WorkerQueue& own = *vQueues[nSelf];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            // Aim for smaller batches as the queue empties, so that all workers finish at about the same time
+            TakeFrom(own.queue, std::max<size_t>(1, std::min<size_t>(nBatchSize, own.queue.size() / 2)), true, vChecks);
+        }
+        const size_t nQueues = NumQueues();
+        for (size_t i = 1; vChecks.empty() && i < nQueues; i++) {
+            WorkerQueue& victim = *vQueues[(nSelf + i) % nQueues];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            TakeFrom(victim.queue, std::min<size_t>(nBatchSize, (victim.queue.size() + 1) / 2), false, vChecks);
+        }
+        if (vChecks.empty())
+            return false;
+        nQueued.fetch_sub(vChecks.size(), std::memory_order_acq_rel);
+        return true;
+    }
+
     /** Internal function that does bulk of the verification work. */
     bool Loop(bool fMaster = false)
     {
-        boost::condition_variable& cond = fMaster ? condMaster : condWorker;
+        size_t nSelf = 0;
+        if (!fMaster)
+            nSelf = 1 + nWorkers.fetch_add(1, std::memory_order_acq_rel) % (MAX_WORKER_QUEUES - 1);
         std::vector<T> vChecks;
         vChecks.reserve(nBatchSize);
-        unsigned int nNow = 0;
-        bool fOk = true;
         do {
-            {
+            if (!Take(nSelf, vChecks)) {
                 boost::unique_lock<boost::mutex> lock(mutex);
-                // first do the clean-up of the previous loop run (allowing us to do it in the same critsect)
-                if (nNow) {
-                    fAllOk &= fOk;
-                    nTodo -= nNow;
-                    if (nTodo == 0 && !fMaster)
-                        // We processed the last element; inform the master it can exit and return the result
-                        condMaster.notify_one();
-                } else {
-                    // first iteration
-                    nTotal++;
-                }
-                // logically, the do loop starts here
-                while (queue.empty()) {
-                    if (fMaster && nTodo == 0) {
-                        nTotal--;
-                        bool fRet = fAllOk;
-                        // reset the status for new work later
-                        if (fMaster)
-                            fAllOk = true;
-                        // return the current status
-                        return fRet;
+                if (fMaster) {
+                    // Nothing left to take; wait for the batches still being worked on
+                    while (nQueued.load() == 0 && nTodo.load() != 0)
+                        condMaster.wait(lock);
+                    if (nTodo.load() == 0) {
+                        // return the current status, and reset it for new work later
+                        return fAllOk.exchange(true);
                     }
-                    nIdle++;
-                    cond.wait(lock); // wait
-                    nIdle--;
-                }
-                // Decide how many work units to process now.
-                // * Do not try to do everything at once, but aim for increasingly smaller batches so
-                //   all workers finish approximately simultaneously.
-                // * Try to account for idle jobs which will instantly start helping.
-                // * Don't do batches smaller than 1 (duh), or larger than nBatchSize.
-                nNow = std::max(1U, std::min(nBatchSize, (unsigned int)queue.size() / (nTotal + nIdle + 1)));
-                vChecks.resize(nNow);
-                for (unsigned int i = 0; i < nNow; i++) {
-                    // We want the lock on the mutex to be as short as possible, so swap jobs from the global
-                    // queue to the local batch vector instead of copying.
-                    vChecks[i].swap(queue.back());
-                    queue.pop_back();
+                } else {
+                    while (nQueued.load() == 0)
+                        condWorker.wait(lock); // wait
                 }
-                // Check whether we need to do work at all
-                fOk = fAllOk;
+                continue;
+            }
+            // execute work, unless something already failed
+            for (T& check : vChecks) {
+                if (!fAllOk.load(std::memory_order_relaxed))
+                    break;
+                if (!check())
+                    fAllOk.store(false, std::memory_order_relaxed);
             }
-            // execute work
-            for (T& check : vChecks)
-                if (fOk)
-                    fOk = check();
+            const unsigned int nNow = vChecks.size();
             vChecks.clear();
+            // Only count them as done once they're gone
+            if (nTodo.fetch_sub(nNow, std::memory_order_acq_rel) == nNow && !fMaster) {
+                // We processed the last element; inform the master it can exit and return the result
+                boost::unique_lock<boost::mutex> lock(mutex);
+                condMaster.notify_one();
+            }
         } while (true);
     }
 
@@ -128,7 +179,11 @@ public:
     boost::mutex ControlMutex;
 
     //! Create a new check queue
-    explicit CCheckQueue(unsigned int nBatchSizeIn) : nIdle(0), nTotal(0), fAllOk(true), nTodo(0), nBatchSize(nBatchSizeIn) {}
+    explicit CCheckQueue(unsigned int nBatchSizeIn) : nWorkers(0), nNextQueue(0), fAllOk(true), nTodo(0), nQueued(0), nBatchSize(nBatchSizeIn)
+    {
+        for (size_t i = 0; i < MAX_WORKER_QUEUES; i++)
+            vQueues.emplace_back(new WorkerQueue());
+    }
 
     //! Worker thread
     void Thread()
@@ -145,15 +200,29 @@ public:
     //! Add a batch of checks to the queue
     void Add(std::vector<T>& vChecks)
     {
-        boost::unique_lock<boost::mutex> lock(mutex);
-        for (T& check : vChecks) {
-            queue.push_back(T());
-            check.swap(queue.back());
+        if (vChecks.empty())
+            return;
+        nTodo.fetch_add(vChecks.size(), std::memory_order_acq_rel);
+        nQueued.fetch_add(vChecks.size(), std::memory_order_acq_rel);
+
+        // Deal the checks out over the workers' queues in about equal parts. The master's own queue is
+        // only used when there are no workers, as the master doesn't start working until it's done adding.
+        const size_t nQueues = NumQueues();
+        const size_t nTargets = nQueues > 1 ? nQueues - 1 : 1;
+        const size_t nChunk = (vChecks.size() + nTargets - 1) / nTargets;
+        for (size_t nDone = 0; nDone < vChecks.size(); nDone += nChunk) {
+            WorkerQueue& target = *vQueues[nQueues > 1 ? 1 + nNextQueue++ % nTargets : 0];
+            std::lock_guard<std::mutex> lock(target.mutex);
+            for (size_t i = nDone; i < std::min(nDone + nChunk, vChecks.size()); i++) {
+                target.queue.push_back(T());
+                vChecks[i].swap(target.queue.back());
+            }
         }
-        nTodo += vChecks.size();
+
+        boost::unique_lock<boost::mutex> lock(mutex);
         if (vChecks.size() == 1)
             condWorker.notify_one();
-        else if (vChecks.size() > 1)
+        else
             condWorker.notify_all();
     }
 
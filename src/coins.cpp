@@ -31,20 +31,31 @@ size_t CCoinsViewBacked::EstimateSize() const { return base->EstimateSize(); }
 
 SaltedOutpointHasher::SaltedOutpointHasher() : k0(GetRand(std::numeric_limits<uint64_t>::max())), k1(GetRand(std::numeric_limits<uint64_t>::max())) {}
 
-CCoinsViewCache::CCoinsViewCache(CCoinsView *baseIn) : CCoinsViewBacked(baseIn), cachedCoinsUsage(0) {}
+CCoinsViewCache::CCoinsViewCache(CCoinsView *baseIn) : CCoinsViewBacked(baseIn),
+    cacheCoins(0, SaltedOutpointHasher(), CCoinsMap::key_equal(), &cacheCoinsMemoryResource), cachedCoinsUsage(0),
+    cacheEpoch(0), fSyncPending(false), nCacheHits(0), nCacheMisses(0) {}
 
 size_t CCoinsViewCache::DynamicMemoryUsage() const {
     return memusage::DynamicUsage(cacheCoins) + cachedCoinsUsage;
 }
 
+size_t CCoinsViewCache::LiveMemoryUsage() const {
+    return cacheCoinsMemoryResource.BytesInUse() + cachedCoinsUsage;
+}
+
 CCoinsMap::iterator CCoinsViewCache::FetchCoin(const COutPoint &outpoint) const {
     CCoinsMap::iterator it = cacheCoins.find(outpoint);
-    if (it != cacheCoins.end())
+    if (it != cacheCoins.end()) {
+        it->second.epoch = cacheEpoch;
+        nCacheHits++;
         return it;
+    }
+    nCacheMisses++;
     Coin tmp;
     if (!base->GetCoin(outpoint, tmp))
         return cacheCoins.end();
     CCoinsMap::iterator ret = cacheCoins.emplace(std::piecewise_construct, std::forward_as_tuple(outpoint), std::forward_as_tuple(std::move(tmp))).first;
+    ret->second.epoch = cacheEpoch;
     if (ret->second.coin.IsSpent()) {
         // The parent only has an empty entry for this outpoint; we can consider our
         // version as fresh.
@@ -81,6 +92,7 @@ void CCoinsViewCache::AddCoin(const COutPoint &outpoint, Coin&& coin, bool possi
     }
     it->second.coin = std::move(coin);
     it->second.flags |= CCoinsCacheEntry::DIRTY | (fresh ? CCoinsCacheEntry::FRESH : 0);
+    it->second.epoch = cacheEpoch;
     cachedCoinsUsage += it->second.coin.DynamicMemoryUsage();
 }
 
@@ -159,6 +171,7 @@ bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn
                 entry.coin = std::move(it->second.coin);
                 cachedCoinsUsage += entry.coin.DynamicMemoryUsage();
                 entry.flags = CCoinsCacheEntry::DIRTY;
+                entry.epoch = cacheEpoch;
                 // We can mark it FRESH in the parent if it was FRESH in the child
                 // Otherwise it might have just been flushed from the parent's cache
                 // and already exist in the grandparent
@@ -188,6 +201,7 @@ bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn
                 itUs->second.coin = std::move(it->second.coin);
                 cachedCoinsUsage += itUs->second.coin.DynamicMemoryUsage();
                 itUs->second.flags |= CCoinsCacheEntry::DIRTY;
+                itUs->second.epoch = cacheEpoch;
                 // NOTE: It is possible the child has a FRESH flag here in
                 // the event the entry we found in the parent is pruned. But
                 // we must not copy that FRESH flag to the parent as that
@@ -201,14 +215,98 @@ bool CCoinsViewCache::BatchWrite(CCoinsMap &mapCoins, const uint256 &hashBlockIn
 }
 
 bool CCoinsViewCache::Flush() {
+    assert(!fSyncPending);
+    nCacheHits = nCacheMisses = 0;
     bool fOk = base->BatchWrite(cacheCoins, hashBlock);
     cacheCoins.clear();
     cachedCoinsUsage = 0;
+    ReallocateCache();
     return fOk;
 }
 
+void CCoinsViewCache::ReallocateCache()
+{
+    assert(cacheCoins.size() == 0);
+    cacheCoins.~CCoinsMap();
+    cacheCoinsMemoryResource.~CCoinsMapMemoryResource();
+    ::new (&cacheCoinsMemoryResource) CCoinsMapMemoryResource();
+    ::new (&cacheCoins) CCoinsMap(0, SaltedOutpointHasher(), CCoinsMap::key_equal(), &cacheCoinsMemoryResource);
+}
+
+void CCoinsViewCache::TakeDirtyCoins(CCoinsMap& mapDirty) {
+    assert(!fSyncPending);
+    for (auto& entry : cacheCoins) {
+        if (!(entry.second.flags & CCoinsCacheEntry::DIRTY)) {
+            continue;
+        }
+        mapDirty.emplace(entry.first, entry.second);
+        // Once the write lands the base agrees with us, spent or not. Spent entries can't simply be
+        // erased yet, as until then the base would still hand out the old coin.
+        entry.second.flags = 0;
+    }
+    fSyncPending = true;
+    cacheEpoch++;
+    nCacheHits = nCacheMisses = 0;
+}
+
+void CCoinsViewCache::SyncDone() {
+    fSyncPending = false;
+}
+
+bool CCoinsViewCache::Sync() {
+    CCoinsMapMemoryResource resource;
+    CCoinsMap mapDirty(0, SaltedOutpointHasher(), CCoinsMap::key_equal(), &resource);
+    TakeDirtyCoins(mapDirty);
+    bool fOk = base->BatchWrite(mapDirty, hashBlock);
+    SyncDone();
+    return fOk;
+}
+
+size_t CCoinsViewCache::Evict(size_t nTargetUsage) {
+    assert(!fSyncPending);
+    const size_t nUsage = LiveMemoryUsage();
+    if (nUsage <= nTargetUsage) {
+        return 0;
+    }
+
+    // Bytes held by unmodified entries, by the number of syncs since they were last used
+    static const size_t MAX_AGE = 255;
+    const size_t nEntryBytes = cacheCoinsMemoryResource.BytesInUse() / std::max<size_t>(cacheCoins.size(), 1);
+    std::vector<size_t> vAgeUsage(MAX_AGE + 1, 0);
+    for (const auto& entry : cacheCoins) {
+        if (!(entry.second.flags & CCoinsCacheEntry::DIRTY)) {
+            const size_t nAge = std::min<size_t>((uint16_t)(cacheEpoch - entry.second.epoch), MAX_AGE);
+            vAgeUsage[nAge] += nEntryBytes + entry.second.coin.DynamicMemoryUsage();
+        }
+    }
+
+    // Drop whole generations, oldest first, until we get below the target
+    size_t nMinAge = MAX_AGE + 1;
+    size_t nFreed = 0;
+    while (nMinAge > 0 && nUsage - nFreed > nTargetUsage) {
+        nFreed += vAgeUsage[--nMinAge];
+    }
+
+    size_t nEvicted = 0;
+    for (CCoinsMap::iterator it = cacheCoins.begin(); it != cacheCoins.end();) {
+        const size_t nAge = std::min<size_t>((uint16_t)(cacheEpoch - it->second.epoch), MAX_AGE);
+        if (!(it->second.flags & CCoinsCacheEntry::DIRTY) && (nAge >= nMinAge || it->second.coin.IsSpent())) {
+            cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
+            it = cacheCoins.erase(it);
+            nEvicted++;
+        } else {
+            ++it;
+        }
+    }
+    return nEvicted;
+}
+
 void CCoinsViewCache::Uncache(const COutPoint& hash)
 {
+    if (fSyncPending) {
+        // LitecoinCash: CoinsSync: The base may not have caught up with this entry yet
+        return;
+    }
     CCoinsMap::iterator it = cacheCoins.find(hash);
     if (it != cacheCoins.end() && it->second.flags == 0) {
         cachedCoinsUsage -= it->second.coin.DynamicMemoryUsage();
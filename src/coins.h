@@ -12,11 +12,13 @@
 #include <hash.h>
 #include <memusage.h>
 #include <serialize.h>
+#include <support/allocators/pool.h>
 #include <uint256.h>
 
 #include <assert.h>
 #include <stdint.h>
 
+#include <functional>
 #include <unordered_map>
 
 /**
@@ -104,6 +106,7 @@ struct CCoinsCacheEntry
 {
     Coin coin; // The actual cached data.
     unsigned char flags;
+    uint16_t epoch; // LitecoinCash: CoinsSync: The cache's sync epoch when this entry was last used
 
     enum Flags {
         DIRTY = (1 << 0), // This cache entry is potentially different from the version in the parent view.
@@ -115,11 +118,23 @@ struct CCoinsCacheEntry
          */
     };
 
-    CCoinsCacheEntry() : flags(0) {}
-    explicit CCoinsCacheEntry(Coin&& coin_) : coin(std::move(coin_)), flags(0) {}
+    CCoinsCacheEntry() : flags(0), epoch(0) {}
+    explicit CCoinsCacheEntry(Coin&& coin_) : coin(std::move(coin_)), flags(0), epoch(0) {}
 };
 
-typedef std::unordered_map<COutPoint, CCoinsCacheEntry, SaltedOutpointHasher> CCoinsMap;
+/**
+ * LitecoinCash: PoolAllocator: The coins cache takes its nodes from a PoolResource, which saves the malloc
+ * overhead of every entry and lets DynamicMemoryUsage account for the map exactly.
+ *
+ * The exact size of an unordered_map node is implementation defined; on top of the value it holds one or
+ * two pointers and sometimes the cached hash. Four extra pointers is enough for every implementation to
+ * fit its nodes into the pool.
+ */
+typedef std::unordered_map<COutPoint, CCoinsCacheEntry, SaltedOutpointHasher, std::equal_to<COutPoint>,
+                           PoolAllocator<std::pair<const COutPoint, CCoinsCacheEntry>,
+                                         sizeof(std::pair<const COutPoint, CCoinsCacheEntry>) + sizeof(void*) * 4> >
+    CCoinsMap;
+typedef CCoinsMap::allocator_type::ResourceType CCoinsMapMemoryResource;
 
 /** Cursor for iterating over CoinsView state */
 class CCoinsViewCursor
@@ -206,11 +221,18 @@ protected:
      * declared as "const".  
      */
     mutable uint256 hashBlock;
+    mutable CCoinsMapMemoryResource cacheCoinsMemoryResource; // LitecoinCash: PoolAllocator: Must outlive cacheCoins
     mutable CCoinsMap cacheCoins;
 
     /* Cached dynamic memory usage for the inner Coin objects. */
     mutable size_t cachedCoinsUsage;
 
+    // LitecoinCash: CoinsSync: Sync bookkeeping, see TakeDirtyCoins()
+    uint16_t cacheEpoch;
+    bool fSyncPending;
+    mutable uint64_t nCacheHits;
+    mutable uint64_t nCacheMisses;
+
 public:
     CCoinsViewCache(CCoinsView *baseIn);
 
@@ -268,6 +290,31 @@ public:
      */
     bool Flush();
 
+    /**
+     * LitecoinCash: CoinsSync: Move a copy of every modified entry into mapDirty, so that it can be written
+     * to the base view (possibly from another thread) without emptying this cache. The entries stay
+     * resident and become clean; spent ones stay behind as spent placeholders, so the base isn't asked
+     * about them before the write has landed.
+     * Until SyncDone() is called, Uncache() does nothing and Evict() must not be used.
+     */
+    void TakeDirtyCoins(CCoinsMap& mapDirty);
+
+    //! LitecoinCash: CoinsSync: The entries taken by TakeDirtyCoins() have been written to the base view.
+    void SyncDone();
+
+    /**
+     * LitecoinCash: CoinsSync: Push the modifications applied to this cache to its base, like Flush(),
+     * but keep the cache populated.
+     */
+    bool Sync();
+
+    /**
+     * LitecoinCash: CoinsSync: Drop unmodified entries, least recently used first, until
+     * LiveMemoryUsage() is at most nTargetUsage (or nothing unmodified is left). Spent placeholders
+     * always go. Returns the number of entries removed.
+     */
+    size_t Evict(size_t nTargetUsage);
+
     /**
      * Removes the UTXO with the given outpoint from the cache, if it is
      * not modified.
@@ -280,6 +327,13 @@ public:
     //! Calculate the size of the cache (in bytes)
     size_t DynamicMemoryUsage() const;
 
+    //! LitecoinCash: CoinsSync: Like DynamicMemoryUsage(), but not counting pooled memory that is free for reuse
+    size_t LiveMemoryUsage() const;
+
+    //! LitecoinCash: CoinsSync: Number of lookups served from / missed by the cache since the last sync
+    uint64_t GetCacheHits() const { return nCacheHits; }
+    uint64_t GetCacheMisses() const { return nCacheMisses; }
+
     /** 
      * Amount of bitcoins coming in to a transaction
      * Note that lightweight clients may not know anything besides the hash of previous transactions,
@@ -295,6 +349,12 @@ public:
 
 private:
     CCoinsMap::iterator FetchCoin(const COutPoint &outpoint) const;
+
+    /**
+     * LitecoinCash: PoolAllocator: Give the (empty) cache's memory back to the system. Erasing entries
+     * only returns them to the pool.
+     */
+    void ReallocateCache();
 };
 
 //! Utility function to add all of a transaction's outputs to a cache.
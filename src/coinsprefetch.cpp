@@ -0,0 +1,167 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <coinsprefetch.h>
+
+#include <primitives/block.h>
+#include <util.h>
+#include <validation.h> // For BlockHasher
+
+#include <unordered_set>
+
+/** Number of outpoints a worker looks up in one go */
+static const size_t PREFETCH_BATCH_SIZE = 64;
+
+CCoinsViewPrefetch::CCoinsViewPrefetch(CCoinsView* viewIn, int nThreads) : CCoinsViewBacked(viewIn), fStop(false), nQueued(0), nGeneration(0)
+{
+    for (int i = 0; i < nThreads; i++) {
+        vThreads.emplace_back(&CCoinsViewPrefetch::ThreadPrefetch, this);
+    }
+}
+
+CCoinsViewPrefetch::~CCoinsViewPrefetch()
+{
+    {
+        WaitableLock lock(cs);
+        fStop = true;
+    }
+    cond.notify_all();
+    for (std::thread& thread : vThreads) {
+        thread.join();
+    }
+}
+
+void CCoinsViewPrefetch::ThreadPrefetch()
+{
+    RenameThread("litecoincash-prefetch");
+    while (true) {
+        std::vector<COutPoint> vBatch;
+        uint64_t nBatchGeneration;
+        {
+            WaitableLock lock(cs);
+            cond.wait(lock, [this] { return fStop || !queue.empty(); });
+            if (fStop)
+                return;
+            vBatch = std::move(queue.front());
+            queue.pop_front();
+            nQueued -= vBatch.size();
+            nBatchGeneration = nGeneration;
+        }
+
+        std::vector<std::pair<COutPoint, Coin>> vFound;
+        vFound.reserve(vBatch.size());
+        for (const COutPoint& outpoint : vBatch) {
+            Coin coin;
+            try {
+                if (base->GetCoin(outpoint, coin))
+                    vFound.emplace_back(outpoint, std::move(coin));
+            } catch (const std::runtime_error& e) {
+                // Leave it to the validation thread to run into (and handle) the error
+                LogPrint(BCLog::COINDB, "%s: %s\n", __func__, e.what());
+            }
+        }
+
+        WaitableLock lock(cs);
+        if (nGeneration != nBatchGeneration) {
+            // The database was written to meanwhile, so what we read may be out of date already
+            stats.nDiscarded += vFound.size();
+            continue;
+        }
+        stats.nFetched += vFound.size();
+        for (auto& found : vFound) {
+            mapStaged.emplace(found.first, std::move(found.second));
+        }
+    }
+}
+
+void CCoinsViewPrefetch::Discard()
+{
+    WaitableLock lock(cs);
+    nGeneration++;
+    stats.nDiscarded += mapStaged.size();
+    mapStaged.clear();
+}
+
+bool CCoinsViewPrefetch::GetCoin(const COutPoint& outpoint, Coin& coin) const
+{
+    {
+        WaitableLock lock(cs);
+        auto it = mapStaged.find(outpoint);
+        if (it != mapStaged.end()) {
+            coin = std::move(it->second);
+            mapStaged.erase(it);
+            stats.nHits++;
+            return true;
+        }
+        stats.nMisses++;
+    }
+    return base->GetCoin(outpoint, coin);
+}
+
+bool CCoinsViewPrefetch::HaveCoin(const COutPoint& outpoint) const
+{
+    {
+        WaitableLock lock(cs);
+        if (mapStaged.count(outpoint))
+            return true;
+    }
+    return base->HaveCoin(outpoint);
+}
+
+bool CCoinsViewPrefetch::BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock)
+{
+    // Drop staged coins both before and after the write: lookups that overlap with it may see either state
+    Discard();
+    bool fOk = base->BatchWrite(mapCoins, hashBlock);
+    Discard();
+    return fOk;
+}
+
+void CCoinsViewPrefetch::Prefetch(const CBlock& block)
+{
+    if (vThreads.empty())
+        return;
+
+    // Outputs created within the block aren't in the database yet
+    std::unordered_set<uint256, BlockHasher> setTxids;
+    for (const auto& tx : block.vtx) {
+        setTxids.insert(tx->GetHash());
+    }
+
+    std::vector<std::vector<COutPoint>> vBatches(1);
+    size_t nInputs = 0;
+    for (const auto& tx : block.vtx) {
+        if (tx->IsCoinBase())
+            continue;
+        for (const CTxIn& txin : tx->vin) {
+            if (setTxids.count(txin.prevout.hash))
+                continue;
+            if (vBatches.back().size() == PREFETCH_BATCH_SIZE)
+                vBatches.emplace_back();
+            vBatches.back().push_back(txin.prevout);
+            nInputs++;
+        }
+    }
+    if (nInputs == 0)
+        return;
+
+    {
+        WaitableLock lock(cs);
+        if (nQueued + mapStaged.size() + nInputs > MAX_COINS_PREFETCH_PENDING)
+            return;
+        for (auto& vBatch : vBatches) {
+            queue.push_back(std::move(vBatch));
+        }
+        nQueued += nInputs;
+    }
+    cond.notify_all();
+}
+
+CoinsPrefetchStats CCoinsViewPrefetch::GetStats() const
+{
+    WaitableLock lock(cs);
+    CoinsPrefetchStats ret = stats;
+    ret.nStaged = mapStaged.size();
+    return ret;
+}
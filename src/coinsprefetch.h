@@ -0,0 +1,81 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef LITECOINCASH_COINSPREFETCH_H
+#define LITECOINCASH_COINSPREFETCH_H
+
+#include <coins.h>
+#include <sync.h>
+
+#include <deque>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class CBlock;
+
+/** LitecoinCash: CoinsPrefetch: Default for -coinsprefetchthreads (0 disables prefetching) */
+static const int DEFAULT_COINS_PREFETCH_THREADS = 4;
+/** LitecoinCash: CoinsPrefetch: Maximum for -coinsprefetchthreads */
+static const int MAX_COINS_PREFETCH_THREADS = 16;
+/** LitecoinCash: CoinsPrefetch: Don't queue more blocks while this many coins are staged or queued */
+static const size_t MAX_COINS_PREFETCH_PENDING = 200000;
+
+/** LitecoinCash: CoinsPrefetch: Counters since startup */
+struct CoinsPrefetchStats {
+    uint64_t nHits = 0;         //!< Cache misses served from prefetched coins
+    uint64_t nMisses = 0;       //!< Cache misses that still went to the database
+    uint64_t nFetched = 0;      //!< Coins read ahead of time
+    uint64_t nDiscarded = 0;    //!< Prefetched coins dropped unused, because the database was written
+    size_t nStaged = 0;         //!< Prefetched coins waiting to be used
+};
+
+/**
+ * LitecoinCash: CoinsPrefetch: Coins view between the coins database and the coins cache that reads the
+ * inputs of blocks before they are connected.
+ *
+ * Once a block has been downloaded and stored, Prefetch() hands its inputs to a few worker threads, which
+ * look them up in the database in parallel and put them into a staging area. When ConnectBlock later misses
+ * those coins in the coins cache, they come from memory instead of a random database read on the validation
+ * thread. A staged coin is handed out once, and then forgotten.
+ *
+ * Staged coins are only valid for as long as the database doesn't change. Every write through this view
+ * drops them, together with the results of any lookups that were in progress at the time.
+ */
+class CCoinsViewPrefetch : public CCoinsViewBacked
+{
+private:
+    mutable CWaitableCriticalSection cs;
+    CConditionVariable cond;
+    std::vector<std::thread> vThreads;
+    bool fStop;
+
+    //! Outpoints waiting to be looked up, in batches
+    std::deque<std::vector<COutPoint>> queue;
+    size_t nQueued;
+    //! Coins looked up, waiting to be used
+    mutable std::unordered_map<COutPoint, Coin, SaltedOutpointHasher> mapStaged;
+    //! Bumped by every database write, so that lookups that were in progress get dropped
+    uint64_t nGeneration;
+
+    mutable CoinsPrefetchStats stats;
+
+    void ThreadPrefetch();
+    void Discard();
+
+public:
+    CCoinsViewPrefetch(CCoinsView* viewIn, int nThreads);
+    ~CCoinsViewPrefetch();
+
+    bool GetCoin(const COutPoint& outpoint, Coin& coin) const override;
+    bool HaveCoin(const COutPoint& outpoint) const override;
+    bool BatchWrite(CCoinsMap& mapCoins, const uint256& hashBlock) override;
+
+    /** Queue the inputs of block for lookup, unless they are created by the block itself. */
+    void Prefetch(const CBlock& block);
+
+    CoinsPrefetchStats GetStats() const;
+};
+
+#endif // LITECOINCASH_COINSPREFETCH_H
@@ -82,6 +82,11 @@ typedef int32_t ssize_t;
 #endif
 #endif
 
+// LitecoinCash: SocketEvents: Peer sockets can be waited on with epoll, so they needn't fit in an fd_set
+#if defined(HAVE_SYS_EPOLL_H)
+#define USE_EPOLL
+#endif
+
 #if HAVE_DECL_STRNLEN == 0
 size_t strnlen( const char *start, size_t max_len);
 #endif // HAVE_DECL_STRNLEN
@@ -0,0 +1,44 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <stdint.h>
+#include <stddef.h>
+#include <immintrin.h>
+
+namespace murmurhash3_avx2 {
+namespace {
+
+__m256i inline K(uint32_t x) { return _mm256_set1_epi32(x); }
+
+__m256i inline Rotl(__m256i x, int r) { return _mm256_or_si256(_mm256_slli_epi32(x, r), _mm256_srli_epi32(x, 32 - r)); }
+
+}
+
+/** MurmurHash3 of the prepared data under 8 seeds, one per 32-bit lane (see MurmurHash3Prepare) */
+void Prepared_8way(const uint32_t* pk, size_t nLen, const uint32_t* seeds, uint32_t* out)
+{
+    __m256i h = _mm256_loadu_si256((const __m256i*)seeds);
+    const size_t nBlocks = nLen / 4;
+    for (size_t i = 0; i < nBlocks; i++) {
+        h = _mm256_xor_si256(h, K(pk[i]));
+        h = Rotl(h, 13);
+        h = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(h, 2), h), K(0xe6546b64));
+    }
+    if (nLen & 3)
+        h = _mm256_xor_si256(h, K(pk[nBlocks]));
+
+    h = _mm256_xor_si256(h, K(nLen));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    h = _mm256_mullo_epi32(h, K(0x85ebca6b));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+    h = _mm256_mullo_epi32(h, K(0xc2b2ae35));
+    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+    _mm256_storeu_si256((__m256i*)out, h);
+}
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// LitecoinCash: ScryptBatch: 8 independent scrypt(1024,1,1) ROMix cores, one per vector lane.
+// The state is kept transposed: word k of lane l lives at X[k * 8 + l].
+
+#ifdef ENABLE_AVX2
+
+#include <stdint.h>
+#include <immintrin.h>
+
+namespace scrypt_avx2_8way {
+namespace {
+
+#define ROTL(a, b) _mm256_or_si256(_mm256_slli_epi32((a), (b)), _mm256_srli_epi32((a), 32 - (b)))
+#define QR(a, b, c, n) x[a] = _mm256_xor_si256(x[a], ROTL(_mm256_add_epi32(x[b], x[c]), n))
+
+/** Salsa20/8 on 8 lanes at once, B ^= Bx then B += Salsa20/8(B) */
+inline void XorSalsa8(__m256i* B, const __m256i* Bx)
+{
+    __m256i x[16];
+    for (int i = 0; i < 16; ++i) {
+        x[i] = B[i] = _mm256_xor_si256(B[i], Bx[i]);
+    }
+    for (int i = 0; i < 8; i += 2) {
+        /* Operate on columns. */
+        QR(4, 0, 12, 7);
+        QR(9, 5, 1, 7);
+        QR(14, 10, 6, 7);
+        QR(3, 15, 11, 7);
+        QR(8, 4, 0, 9);
+        QR(13, 9, 5, 9);
+        QR(2, 14, 10, 9);
+        QR(7, 3, 15, 9);
+        QR(12, 8, 4, 13);
+        QR(1, 13, 9, 13);
+        QR(6, 2, 14, 13);
+        QR(11, 7, 3, 13);
+        QR(0, 12, 8, 18);
+        QR(5, 1, 13, 18);
+        QR(10, 6, 2, 18);
+        QR(15, 11, 7, 18);
+
+        /* Operate on rows. */
+        QR(1, 0, 3, 7);
+        QR(6, 5, 4, 7);
+        QR(11, 10, 9, 7);
+        QR(12, 15, 14, 7);
+        QR(2, 1, 0, 9);
+        QR(7, 6, 5, 9);
+        QR(8, 11, 10, 9);
+        QR(13, 12, 15, 9);
+        QR(3, 2, 1, 13);
+        QR(4, 7, 6, 13);
+        QR(9, 8, 11, 13);
+        QR(14, 13, 12, 13);
+        QR(0, 3, 2, 18);
+        QR(5, 4, 7, 18);
+        QR(10, 9, 8, 18);
+        QR(15, 14, 13, 18);
+    }
+    for (int i = 0; i < 16; ++i) {
+        B[i] = _mm256_add_epi32(B[i], x[i]);
+    }
+}
+
+#undef QR
+#undef ROTL
+
+} // namespace
+
+/** Run the scrypt(1024,1,1) ROMix loop for 8 lanes.
+ *  X: 32 * 8 transposed words, aligned to 32 bytes, updated in place
+ *  V: 1024 * 32 * 8 words of scratch space, aligned to 32 bytes
+ */
+void Core(uint32_t* X, uint32_t* V)
+{
+    __m256i* x = (__m256i*)X;
+    __m256i* v = (__m256i*)V;
+
+    for (int i = 0; i < 1024; ++i) {
+        for (int k = 0; k < 32; ++k) {
+            _mm256_store_si256(&v[i * 32 + k], x[k]);
+        }
+        XorSalsa8(&x[0], &x[16]);
+        XorSalsa8(&x[16], &x[0]);
+    }
+    for (int i = 0; i < 1024; ++i) {
+        // Every lane reads its own (data dependent) row of the scratchpad
+        __m256i idx = _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(x[16], _mm256_set1_epi32(1023)), 8), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+        for (int k = 0; k < 32; ++k) {
+            x[k] = _mm256_xor_si256(x[k], _mm256_i32gather_epi32((const int*)V, idx, 4));
+            idx = _mm256_add_epi32(idx, _mm256_set1_epi32(8));
+        }
+        XorSalsa8(&x[0], &x[16]);
+        XorSalsa8(&x[16], &x[0]);
+    }
+}
+
+} // namespace scrypt_avx2_8way
+
+#endif
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+// LitecoinCash: ScryptBatch: 4 independent scrypt(1024,1,1) ROMix cores, one per vector lane.
+// The state is kept transposed: word k of lane l lives at X[k * 4 + l].
+
+#if defined(__SSE2__)
+
+#include <stdint.h>
+#include <emmintrin.h>
+
+namespace scrypt_sse2_4way {
+namespace {
+
+#define ROTL(a, b) _mm_or_si128(_mm_slli_epi32((a), (b)), _mm_srli_epi32((a), 32 - (b)))
+#define QR(a, b, c, n) x[a] = _mm_xor_si128(x[a], ROTL(_mm_add_epi32(x[b], x[c]), n))
+
+/** Salsa20/8 on 4 lanes at once, B ^= Bx then B += Salsa20/8(B) */
+inline void XorSalsa8(__m128i* B, const __m128i* Bx)
+{
+    __m128i x[16];
+    for (int i = 0; i < 16; ++i) {
+        x[i] = B[i] = _mm_xor_si128(B[i], Bx[i]);
+    }
+    for (int i = 0; i < 8; i += 2) {
+        /* Operate on columns. */
+        QR(4, 0, 12, 7);
+        QR(9, 5, 1, 7);
+        QR(14, 10, 6, 7);
+        QR(3, 15, 11, 7);
+        QR(8, 4, 0, 9);
+        QR(13, 9, 5, 9);
+        QR(2, 14, 10, 9);
+        QR(7, 3, 15, 9);
+        QR(12, 8, 4, 13);
+        QR(1, 13, 9, 13);
+        QR(6, 2, 14, 13);
+        QR(11, 7, 3, 13);
+        QR(0, 12, 8, 18);
+        QR(5, 1, 13, 18);
+        QR(10, 6, 2, 18);
+        QR(15, 11, 7, 18);
+
+        /* Operate on rows. */
+        QR(1, 0, 3, 7);
+        QR(6, 5, 4, 7);
+        QR(11, 10, 9, 7);
+        QR(12, 15, 14, 7);
+        QR(2, 1, 0, 9);
+        QR(7, 6, 5, 9);
+        QR(8, 11, 10, 9);
+        QR(13, 12, 15, 9);
+        QR(3, 2, 1, 13);
+        QR(4, 7, 6, 13);
+        QR(9, 8, 11, 13);
+        QR(14, 13, 12, 13);
+        QR(0, 3, 2, 18);
+        QR(5, 4, 7, 18);
+        QR(10, 9, 8, 18);
+        QR(15, 14, 13, 18);
+    }
+    for (int i = 0; i < 16; ++i) {
+        B[i] = _mm_add_epi32(B[i], x[i]);
+    }
+}
+
+#undef QR
+#undef ROTL
+
+} // namespace
+
+/** Run the scrypt(1024,1,1) ROMix loop for 4 lanes.
+ *  X: 32 * 4 transposed words, aligned to 16 bytes, updated in place
+ *  V: 1024 * 32 * 4 words of scratch space, aligned to 16 bytes
+ */
+void Core(uint32_t* X, uint32_t* V)
+{
+    __m128i* x = (__m128i*)X;
+    __m128i* v = (__m128i*)V;
+
+    for (int i = 0; i < 1024; ++i) {
+        for (int k = 0; k < 32; ++k) {
+            _mm_store_si128(&v[i * 32 + k], x[k]);
+        }
+        XorSalsa8(&x[0], &x[16]);
+        XorSalsa8(&x[16], &x[0]);
+    }
+    for (int i = 0; i < 1024; ++i) {
+        // Every lane reads its own (data dependent) row of the scratchpad
+        alignas(16) uint32_t j[4];
+        _mm_store_si128((__m128i*)j, _mm_and_si128(x[16], _mm_set1_epi32(1023)));
+        for (int k = 0; k < 32; ++k) {
+            x[k] = _mm_xor_si128(x[k], _mm_set_epi32(V[(j[3] * 32 + k) * 4 + 3], V[(j[2] * 32 + k) * 4 + 2], V[(j[1] * 32 + k) * 4 + 1], V[(j[0] * 32 + k) * 4]));
+        }
+        XorSalsa8(&x[0], &x[16]);
+        XorSalsa8(&x[16], &x[0]);
+    }
+}
+
+} // namespace scrypt_sse2_4way
+
+#endif
@@ -27,11 +27,16 @@
  * online backup system.
  */
 
+#if defined(HAVE_CONFIG_H)
+#include "config/bitcoin-config.h"
+#endif
+
 #include "crypto/scrypt.h"
 //#include "util.h"
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#include <vector>
 #include <openssl/sha.h>
 
 #if defined(USE_SSE2) && !defined(USE_SSE2_ALWAYS)
@@ -43,6 +48,26 @@
 #include <cpuid.h>
 #endif
 #endif
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+#include <cpuid.h>
+#endif
+
+// LitecoinCash: ScryptBatch: Multi-lane ROMix cores, see scrypt-sse2-4way.cpp and scrypt-avx2-8way.cpp
+#if defined(__SSE2__)
+namespace scrypt_sse2_4way
+{
+void Core(uint32_t* X, uint32_t* V);
+}
+#endif
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+namespace scrypt_avx2_8way
+{
+void Core(uint32_t* X, uint32_t* V);
+}
+#endif
+
 #ifndef __FreeBSD__
 static inline uint32_t be32dec(const void *pp)
 {
@@ -330,3 +355,96 @@ void scrypt_1024_1_1_256(const char *input, char *output)
 	char scratchpad[SCRYPT_SCRATCHPAD_SIZE];
     scrypt_1024_1_1_256_sp(input, output, scratchpad);
 }
+
+typedef void (*scrypt_core_t)(uint32_t *X, uint32_t *V);
+
+#if defined(__SSE2__)
+static scrypt_core_t scrypt_core_4way = &scrypt_sse2_4way::Core;
+#else
+static scrypt_core_t scrypt_core_4way = nullptr;
+#endif
+static scrypt_core_t scrypt_core_8way = nullptr;
+
+/* Per-thread scratch space for the batch API, aligned for the vector cores and grown on demand. */
+static char *scrypt_batch_scratchpad(size_t lanes)
+{
+	static thread_local std::vector<char> scratchpad;
+	if (scratchpad.size() < lanes * 131072 + 63)
+		scratchpad.resize(lanes * 131072 + 63);
+	return (char *)(((uintptr_t)scratchpad.data() + 63) & ~(uintptr_t)(63));
+}
+
+template<size_t LANES>
+static void scrypt_1024_1_1_256_multiway(const char *input, char *output, uint32_t *V, scrypt_core_t core)
+{
+	alignas(32) uint32_t X[32 * LANES];
+	uint8_t B[128];
+	size_t l;
+	int k;
+
+	for (l = 0; l < LANES; l++) {
+		PBKDF2_SHA256((const uint8_t *)input + 80 * l, 80, (const uint8_t *)input + 80 * l, 80, 1, B, 128);
+		for (k = 0; k < 32; k++)
+			X[k * LANES + l] = le32dec(&B[4 * k]);
+	}
+
+	core(X, V);
+
+	for (l = 0; l < LANES; l++) {
+		for (k = 0; k < 32; k++)
+			le32enc(&B[4 * k], X[k * LANES + l]);
+		PBKDF2_SHA256((const uint8_t *)input + 80 * l, 80, B, 128, 1, (uint8_t *)output + 32 * l, 32);
+	}
+}
+
+void scrypt_1024_1_1_256_batch(const char *input, char *output, size_t count)
+{
+	if (scrypt_core_8way && count >= 8) {
+		uint32_t *V = (uint32_t *)scrypt_batch_scratchpad(8);
+		for (; count >= 8; count -= 8, input += 8 * 80, output += 8 * 32)
+			scrypt_1024_1_1_256_multiway<8>(input, output, V, scrypt_core_8way);
+	}
+	if (scrypt_core_4way && count >= 4) {
+		uint32_t *V = (uint32_t *)scrypt_batch_scratchpad(4);
+		for (; count >= 4; count -= 4, input += 4 * 80, output += 4 * 32)
+			scrypt_1024_1_1_256_multiway<4>(input, output, V, scrypt_core_4way);
+	}
+	if (count > 0) {
+		char *scratchpad = scrypt_batch_scratchpad(1);
+		for (; count > 0; count--, input += 80, output += 32)
+			scrypt_1024_1_1_256_sp(input, output, scratchpad);
+	}
+}
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+static bool scrypt_have_avx2()
+{
+	uint32_t eax, ebx, ecx, edx, xcr0;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return false;
+	/* OSXSAVE and AVX, with the ymm state enabled by the OS */
+	if (!((ecx >> 27) & 1) || !((ecx >> 28) & 1))
+		return false;
+	__asm__("xgetbv" : "=a"(xcr0), "=d"(edx) : "c"(0));
+	if ((xcr0 & 6) != 6)
+		return false;
+	if (__get_cpuid_max(0, nullptr) < 7)
+		return false;
+	__cpuid_count(7, 0, eax, ebx, ecx, edx);
+	return (ebx >> 5) & 1;
+}
+#endif
+
+std::string scrypt_detect_batch()
+{
+	std::string ret = "scrypt: batch hashing using ";
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+	if (scrypt_have_avx2()) {
+		scrypt_core_8way = &scrypt_avx2_8way::Core;
+		ret += "avx2(8way),";
+	}
+#endif
+	if (scrypt_core_4way)
+		ret += "sse2(4way),";
+	return ret + "scalar(1way)";
+}
@@ -2,14 +2,20 @@
 #define SCRYPT_H
 #include <stdlib.h>
 #include <stdint.h>
+#include <string>
 
 static const int SCRYPT_SCRATCHPAD_SIZE = 131072 + 63;
 
 void scrypt_1024_1_1_256(const char *input, char *output);
 void scrypt_1024_1_1_256_sp_generic(const char *input, char *output, char *scratchpad);
 
+/** LitecoinCash: ScryptBatch: Hash count 80 byte inputs (stored back to back) into count 32 byte outputs,
+ *  running as many of them side by side as the multi-lane cores picked by scrypt_detect_batch() allow.
+ *  Scratch space is kept per thread and reused across calls. */
+void scrypt_1024_1_1_256_batch(const char *input, char *output, size_t count);
+std::string scrypt_detect_batch();
+
 #if defined(USE_SSE2)
-#include <string>
 #if defined(_M_X64) || defined(__x86_64__) || defined(_M_AMD64) || (defined(MAC_OSX) && defined(__i386__))
 #define USE_SSE2_ALWAYS 1
 #define scrypt_1024_1_1_256_sp(input, output, scratchpad) scrypt_1024_1_1_256_sp_sse2((input), (output), (scratchpad))
@@ -0,0 +1,70 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include <crypto/common.h>
+
+namespace siphash_avx2 {
+namespace {
+
+__m256i inline K(uint64_t x) { return _mm256_set1_epi64x(x); }
+
+__m256i inline Rotl(__m256i x, int b) { return _mm256_or_si256(_mm256_slli_epi64(x, b), _mm256_srli_epi64(x, 64 - b)); }
+
+/** Word w of each of the 4 inputs, which are 32 bytes apart */
+__m256i inline Read4(const unsigned char* in, int w)
+{
+    return _mm256_set_epi64x(ReadLE64(in + 96 + 8 * w), ReadLE64(in + 64 + 8 * w), ReadLE64(in + 32 + 8 * w), ReadLE64(in + 8 * w));
+}
+
+void inline SipRound(__m256i& v0, __m256i& v1, __m256i& v2, __m256i& v3)
+{
+    v0 = _mm256_add_epi64(v0, v1); v1 = Rotl(v1, 13); v1 = _mm256_xor_si256(v1, v0);
+    v0 = Rotl(v0, 32);
+    v2 = _mm256_add_epi64(v2, v3); v3 = Rotl(v3, 16); v3 = _mm256_xor_si256(v3, v2);
+    v0 = _mm256_add_epi64(v0, v3); v3 = Rotl(v3, 21); v3 = _mm256_xor_si256(v3, v0);
+    v2 = _mm256_add_epi64(v2, v1); v1 = Rotl(v1, 17); v1 = _mm256_xor_si256(v1, v2);
+    v2 = Rotl(v2, 32);
+}
+
+}
+
+/** SipHashUint256 of 4 consecutive 32 byte values, one per 64-bit lane */
+void Uint256_4way(uint64_t k0, uint64_t k1, const unsigned char* in, uint64_t* out)
+{
+    __m256i d = Read4(in, 0);
+    __m256i v0 = K(0x736f6d6570736575ULL ^ k0);
+    __m256i v1 = K(0x646f72616e646f6dULL ^ k1);
+    __m256i v2 = K(0x6c7967656e657261ULL ^ k0);
+    __m256i v3 = _mm256_xor_si256(K(0x7465646279746573ULL ^ k1), d);
+
+    for (int w = 0; w < 4; w++) {
+        if (w > 0) {
+            d = Read4(in, w);
+            v3 = _mm256_xor_si256(v3, d);
+        }
+        SipRound(v0, v1, v2, v3);
+        SipRound(v0, v1, v2, v3);
+        v0 = _mm256_xor_si256(v0, d);
+    }
+    v3 = _mm256_xor_si256(v3, K(((uint64_t)4) << 59));
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    v0 = _mm256_xor_si256(v0, K(((uint64_t)4) << 59));
+    v2 = _mm256_xor_si256(v2, K(0xFF));
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    SipRound(v0, v1, v2, v3);
+    __m256i r = _mm256_xor_si256(_mm256_xor_si256(v0, v1), _mm256_xor_si256(v2, v3));
+    _mm256_storeu_si256((__m256i*)out, r);
+}
+
+}
+
+#endif
@@ -475,6 +475,17 @@ public:
             }
         return false;
     }
+
+    /** LitecoinCash: PersistSigCache: Call f on every element that hasn't been erased (or allowed to be), so
+     * that the cache can be saved.
+     */
+    template <typename F>
+    void for_each(F f) const
+    {
+        for (uint32_t i = 0; i < size; ++i)
+            if (!collection_flags.bit_is_set(i))
+                f(table[i]);
+    }
 };
 } // namespace CuckooCache
 
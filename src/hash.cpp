@@ -6,18 +6,39 @@
 #include <crypto/common.h>
 #include <crypto/hmac_sha512.h>
 
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+#include <cpuid.h>
+#endif
+
 
 inline uint32_t ROTL32(uint32_t x, int8_t r)
 {
     return (x << r) | (x >> (32 - r));
 }
 
+static inline uint32_t MurmurHash3MixBlock(uint32_t k1)
+{
+    k1 *= 0xcc9e2d51;
+    k1 = ROTL32(k1, 15);
+    k1 *= 0x1b873593;
+    return k1;
+}
+
+static inline uint32_t MurmurHash3Finalize(uint32_t h1, uint32_t nLen)
+{
+    h1 ^= nLen;
+    h1 ^= h1 >> 16;
+    h1 *= 0x85ebca6b;
+    h1 ^= h1 >> 13;
+    h1 *= 0xc2b2ae35;
+    h1 ^= h1 >> 16;
+    return h1;
+}
+
 unsigned int MurmurHash3(unsigned int nHashSeed, const std::vector<unsigned char>& vDataToHash)
 {
     // The following is MurmurHash3 (x86_32), see http://code.google.com/p/smhasher/source/browse/trunk/MurmurHash3.cpp
     uint32_t h1 = nHashSeed;
-    const uint32_t c1 = 0xcc9e2d51;
-    const uint32_t c2 = 0x1b873593;
 
     const int nblocks = vDataToHash.size() / 4;
 
@@ -26,11 +47,7 @@ unsigned int MurmurHash3(unsigned int nHashSeed, const std::vector<unsigned char
     const uint8_t* blocks = vDataToHash.data();
 
     for (int i = 0; i < nblocks; ++i) {
-        uint32_t k1 = ReadLE32(blocks + i*4);
-
-        k1 *= c1;
-        k1 = ROTL32(k1, 15);
-        k1 *= c2;
+        uint32_t k1 = MurmurHash3MixBlock(ReadLE32(blocks + i*4));
 
         h1 ^= k1;
         h1 = ROTL32(h1, 13);
@@ -50,22 +67,12 @@ unsigned int MurmurHash3(unsigned int nHashSeed, const std::vector<unsigned char
             k1 ^= tail[1] << 8;
         case 1:
             k1 ^= tail[0];
-            k1 *= c1;
-            k1 = ROTL32(k1, 15);
-            k1 *= c2;
-            h1 ^= k1;
+            h1 ^= MurmurHash3MixBlock(k1);
     }
 
     //----------
     // finalization
-    h1 ^= vDataToHash.size();
-    h1 ^= h1 >> 16;
-    h1 *= 0x85ebca6b;
-    h1 ^= h1 >> 13;
-    h1 *= 0xc2b2ae35;
-    h1 ^= h1 >> 16;
-
-    return h1;
+    return MurmurHash3Finalize(h1, vDataToHash.size());
 }
 
 void BIP32Hash(const ChainCode &chainCode, unsigned int nChild, unsigned char header, const unsigned char data[32], unsigned char output[64])
@@ -205,6 +212,94 @@ uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val)
     return v0 ^ v1 ^ v2 ^ v3;
 }
 
+// LitecoinCash: CompactBlocks: Multi-way SipHashUint256, see crypto/siphash_avx2.cpp
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+namespace siphash_avx2
+{
+void Uint256_4way(uint64_t k0, uint64_t k1, const unsigned char* in, uint64_t* out);
+}
+
+static bool HaveAVX2()
+{
+    uint32_t eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || !((ecx >> 27) & 1) || !((ecx >> 28) & 1))
+        return false;
+    // The OS has to save the ymm registers (XCR0 bits 1 and 2)
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    if ((a & 6) != 6 || __get_cpuid_max(0, nullptr) < 7)
+        return false;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx >> 5) & 1;
+}
+#endif
+
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, const uint256* vals, size_t count, uint64_t* out)
+{
+    static_assert(sizeof(uint256) == 32, "uint256 values need to be back to back");
+    size_t i = 0;
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+    static const bool fAVX2 = HaveAVX2();
+    if (fAVX2) {
+        for (; i + 4 <= count; i += 4)
+            siphash_avx2::Uint256_4way(k0, k1, vals[i].begin(), out + i);
+    }
+#endif
+    for (; i < count; i++)
+        out[i] = SipHashUint256(k0, k1, vals[i]);
+}
+
+void MurmurHash3Prepare(const unsigned char* data, size_t nLen, std::vector<uint32_t>& out)
+{
+    const size_t nBlocks = nLen / 4;
+    for (size_t i = 0; i < nBlocks; i++)
+        out.push_back(MurmurHash3MixBlock(ReadLE32(data + i * 4)));
+
+    const unsigned char* tail = data + nBlocks * 4;
+    uint32_t k1 = 0;
+    switch (nLen & 3) {
+        case 3:
+            k1 ^= tail[2] << 16;
+        case 2:
+            k1 ^= tail[1] << 8;
+        case 1:
+            k1 ^= tail[0];
+            out.push_back(MurmurHash3MixBlock(k1));
+    }
+}
+
+// LitecoinCash: BloomBatch: Multi-seed MurmurHash3, see crypto/murmurhash3_avx2.cpp
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+namespace murmurhash3_avx2
+{
+void Prepared_8way(const uint32_t* pk, size_t nLen, const uint32_t* seeds, uint32_t* out);
+}
+#endif
+
+void MurmurHash3PreparedBatch(const uint32_t* pk, size_t nLen, const uint32_t* seeds, size_t count, uint32_t* out)
+{
+    size_t i = 0;
+#if defined(ENABLE_AVX2) && !defined(BUILD_BITCOIN_INTERNAL)
+    static const bool fAVX2 = HaveAVX2();
+    if (fAVX2) {
+        for (; i + 8 <= count; i += 8)
+            murmurhash3_avx2::Prepared_8way(pk, nLen, seeds + i, out + i);
+    }
+#endif
+    const size_t nBlocks = nLen / 4;
+    for (; i < count; i++) {
+        uint32_t h1 = seeds[i];
+        for (size_t j = 0; j < nBlocks; j++) {
+            h1 ^= pk[j];
+            h1 = ROTL32(h1, 13);
+            h1 = h1 * 5 + 0xe6546b64;
+        }
+        if (nLen & 3)
+            h1 ^= pk[nBlocks];
+        out[i] = MurmurHash3Finalize(h1, nLen);
+    }
+}
+
 uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint32_t extra)
 {
     /* Specialized implementation for efficiency */
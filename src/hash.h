@@ -229,4 +229,15 @@ public:
 uint64_t SipHashUint256(uint64_t k0, uint64_t k1, const uint256& val);
 uint64_t SipHashUint256Extra(uint64_t k0, uint64_t k1, const uint256& val, uint32_t extra);
 
+/** LitecoinCash: CompactBlocks: SipHashUint256 of count values into out, 4 at a time on CPUs with AVX2 */
+void SipHashUint256Batch(uint64_t k0, uint64_t k1, const uint256* vals, size_t count, uint64_t* out);
+
+/**
+ * LitecoinCash: BloomBatch: The part of MurmurHash3 that doesn't depend on the seed: the mixed 4 byte blocks of
+ * the data, then its mixed tail if it has one, (nLen + 3) / 4 words in all. They are appended to out.
+ */
+void MurmurHash3Prepare(const unsigned char* data, size_t nLen, std::vector<uint32_t>& out);
+/** LitecoinCash: BloomBatch: MurmurHash3 of the nLen bytes prepared at pk under count seeds, 8 at a time on CPUs with AVX2 */
+void MurmurHash3PreparedBatch(const uint32_t* pk, size_t nLen, const uint32_t* seeds, size_t count, uint32_t* out);
+
 #endif // BITCOIN_HASH_H
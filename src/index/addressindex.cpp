@@ -0,0 +1,344 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <map>
+
+#include <chainparams.h>
+#include <crypto/sha256.h>
+#include <index/addressindex.h>
+#include <undo.h>
+#include <util.h>
+#include <validation.h>
+
+/* The index database stores two kinds of entries for each script, both keyed by the SHA256 hash of
+ * the script so that they can be read back with a single range scan:
+ *
+ * - Unspent outputs, with keys [DB_UNSPENT, script hash, outpoint] and their value and height.
+ * - History entries, with keys [DB_HISTORY, script hash, height (BE), position in block (BE)] and
+ *   the txid and block hash along with the amounts the transaction paid to and spent from the
+ *   script. Heights and positions are big-endian so that a scan returns the history in chain order.
+ *
+ * The best block locator is written in the same batch as the entries of each block, and of each
+ * rewind, so after an unclean shutdown it still names the block that the entries on disk are for.
+ * Init undoes the entries of that block and its ancestors back to the active chain if it was
+ * disconnected in the meantime.
+ */
+constexpr char DB_HISTORY = 'h';
+constexpr char DB_UNSPENT = 'u';
+
+std::unique_ptr<AddressIndex> g_addressindex;
+
+namespace {
+
+struct DBHistoryKey {
+    uint256 script_hash;
+    int height;
+    uint32_t tx_pos;
+
+    DBHistoryKey() : height(0), tx_pos(0) {}
+    DBHistoryKey(const uint256& script_hash_in, int height_in, uint32_t tx_pos_in) :
+        script_hash(script_hash_in), height(height_in), tx_pos(tx_pos_in) {}
+
+    template<typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_HISTORY);
+        s << script_hash;
+        ser_writedata32be(s, height);
+        ser_writedata32be(s, tx_pos);
+    }
+
+    template<typename Stream>
+    void Unserialize(Stream& s)
+    {
+        char prefix = ser_readdata8(s);
+        if (prefix != DB_HISTORY) {
+            throw std::ios_base::failure("Invalid format for address index DB history key");
+        }
+        s >> script_hash;
+        height = ser_readdata32be(s);
+        tx_pos = ser_readdata32be(s);
+    }
+};
+
+struct DBHistoryValue {
+    uint256 txid;
+    uint256 block_hash;
+    CAmount received;
+    CAmount sent;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(txid);
+        READWRITE(block_hash);
+        READWRITE(received);
+        READWRITE(sent);
+    }
+};
+
+struct DBUnspentKey {
+    uint256 script_hash;
+    COutPoint outpoint;
+
+    DBUnspentKey() {}
+    DBUnspentKey(const uint256& script_hash_in, const COutPoint& outpoint_in) :
+        script_hash(script_hash_in), outpoint(outpoint_in) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        char prefix = DB_UNSPENT;
+        READWRITE(prefix);
+        if (prefix != DB_UNSPENT) {
+            throw std::ios_base::failure("Invalid format for address index DB unspent key");
+        }
+
+        READWRITE(script_hash);
+        READWRITE(outpoint);
+    }
+};
+
+struct DBUnspentValue {
+    CAmount value;
+    int height;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(value);
+        READWRITE(height);
+    }
+};
+
+}; // namespace
+
+static uint256 ScriptHash(const CScript& script)
+{
+    uint256 hash;
+    CSHA256().Write(script.data(), script.size()).Finalize(hash.begin());
+    return hash;
+}
+
+/** Access to the address index database (indexes/addressindex/) */
+class AddressIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+};
+
+AddressIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(GetDataDir() / "indexes" / "addressindex", n_cache_size, f_memory, f_wipe)
+{}
+
+AddressIndex::AddressIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
+    : m_db(MakeUnique<AddressIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+AddressIndex::~AddressIndex() {}
+
+BaseIndex::DB& AddressIndex::GetDB() const { return *m_db; }
+
+bool AddressIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    // The outputs of the genesis block cannot be spent, so there is nothing to index for it.
+    if (pindex->nHeight == 0) {
+        return true;
+    }
+
+    CBlockUndo block_undo;
+    if (!UndoReadFromDisk(block_undo, pindex)) {
+        return false;
+    }
+    if (block_undo.vtxundo.size() + 1 != block.vtx.size()) {
+        return error("%s: undo data of block %s does not match its transactions",
+                     __func__, pindex->GetBlockHash().ToString());
+    }
+
+    CDBBatch batch(*m_db);
+    for (uint32_t i = 0; i < block.vtx.size(); ++i) {
+        const CTransaction& tx = *block.vtx[i];
+
+        // Amounts received and sent by each script the transaction touches
+        std::map<uint256, std::pair<CAmount, CAmount>> script_amounts;
+
+        if (!tx.IsCoinBase()) {
+            const CTxUndo& tx_undo = block_undo.vtxundo[i - 1];
+            for (size_t j = 0; j < tx.vin.size(); ++j) {
+                const CTxOut& prev_out = tx_undo.vprevout[j].out;
+                const uint256 script_hash = ScriptHash(prev_out.scriptPubKey);
+                script_amounts[script_hash].second += prev_out.nValue;
+                batch.Erase(DBUnspentKey(script_hash, tx.vin[j].prevout));
+            }
+        }
+
+        for (uint32_t n = 0; n < tx.vout.size(); ++n) {
+            const CTxOut& out = tx.vout[n];
+            if (out.scriptPubKey.IsUnspendable()) continue;
+            const uint256 script_hash = ScriptHash(out.scriptPubKey);
+            script_amounts[script_hash].first += out.nValue;
+            batch.Write(DBUnspentKey(script_hash, COutPoint(tx.GetHash(), n)),
+                        DBUnspentValue{out.nValue, pindex->nHeight});
+        }
+
+        for (const auto& entry : script_amounts) {
+            batch.Write(DBHistoryKey(entry.first, pindex->nHeight, i),
+                        DBHistoryValue{tx.GetHash(), pindex->GetBlockHash(), entry.second.first, entry.second.second});
+        }
+    }
+
+    {
+        LOCK(cs_main);
+        GetDB().WriteBestBlock(batch, chainActive.GetLocator(pindex));
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool AddressIndex::Init()
+{
+    // The best block on disk is the one the entries on disk are for. If it was disconnected while the
+    // index was not running, undo its entries back to the fork, which Init then resumes from.
+    LOCK(cs_main);
+    const CBlockIndex* stale_tip = ReadStaleBestBlock();
+    if (stale_tip) {
+        const CBlockIndex* fork = chainActive.FindFork(stale_tip);
+        if (fork && !UndoBlocks(stale_tip, fork)) {
+            return false;
+        }
+    }
+    return BaseIndex::Init();
+}
+
+bool AddressIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
+{
+    return UndoBlocks(current_tip, new_tip) && BaseIndex::Rewind(current_tip, new_tip);
+}
+
+bool AddressIndex::UndoBlocks(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
+{
+    assert(current_tip->GetAncestor(new_tip->nHeight) == new_tip);
+
+    const Consensus::Params& consensus_params = Params().GetConsensus();
+    CDBBatch batch(*m_db);
+    for (const CBlockIndex* pindex = current_tip; pindex != new_tip; pindex = pindex->pprev) {
+        CBlock block;
+        CBlockUndo block_undo;
+        if (!ReadBlockFromDisk(block, pindex, consensus_params) || !UndoReadFromDisk(block_undo, pindex)) {
+            return error("%s: failed to read block %s", __func__, pindex->GetBlockHash().ToString());
+        }
+        if (block_undo.vtxundo.size() + 1 != block.vtx.size()) {
+            return error("%s: undo data of block %s does not match its transactions",
+                         __func__, pindex->GetBlockHash().ToString());
+        }
+
+        // Go through the transactions last to first, so that outputs both created and spent within
+        // the block end up erased.
+        for (uint32_t i = block.vtx.size(); i-- > 0;) {
+            const CTransaction& tx = *block.vtx[i];
+
+            for (uint32_t n = 0; n < tx.vout.size(); ++n) {
+                const CTxOut& out = tx.vout[n];
+                if (out.scriptPubKey.IsUnspendable()) continue;
+                const uint256 script_hash = ScriptHash(out.scriptPubKey);
+                batch.Erase(DBUnspentKey(script_hash, COutPoint(tx.GetHash(), n)));
+                batch.Erase(DBHistoryKey(script_hash, pindex->nHeight, i));
+            }
+
+            if (tx.IsCoinBase()) continue;
+            const CTxUndo& tx_undo = block_undo.vtxundo[i - 1];
+            for (size_t j = 0; j < tx.vin.size(); ++j) {
+                const Coin& coin = tx_undo.vprevout[j];
+                const uint256 script_hash = ScriptHash(coin.out.scriptPubKey);
+                batch.Write(DBUnspentKey(script_hash, tx.vin[j].prevout),
+                            DBUnspentValue{coin.out.nValue, static_cast<int>(coin.nHeight)});
+                batch.Erase(DBHistoryKey(script_hash, pindex->nHeight, i));
+            }
+        }
+    }
+
+    // Move the best block along in the same batch, so that the entries of the disconnected blocks
+    // are never missing from a block the index still claims to hold.
+    {
+        LOCK(cs_main);
+        GetDB().WriteBestBlock(batch, chainActive.GetLocator(new_tip));
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool AddressIndex::LookupBalance(const CScript& script, Balance& balance_out) const
+{
+    const uint256 script_hash = ScriptHash(script);
+    balance_out = Balance();
+
+    std::unique_ptr<CDBIterator> db_it(m_db->NewIterator());
+    DBHistoryKey key;
+    for (db_it->Seek(DBHistoryKey(script_hash, 0, 0)); db_it->Valid(); db_it->Next()) {
+        if (!db_it->GetKey(key) || key.script_hash != script_hash) break;
+
+        DBHistoryValue value;
+        if (!db_it->GetValue(value)) {
+            return error("%s: unable to read value in %s at key (%c, %s)",
+                         __func__, GetName(), DB_HISTORY, script_hash.ToString());
+        }
+        balance_out.balance += value.received - value.sent;
+        balance_out.received += value.received;
+        ++balance_out.tx_count;
+    }
+    return true;
+}
+
+bool AddressIndex::LookupUnspent(const CScript& script, size_t skip, size_t count,
+                                 std::vector<Unspent>& unspent_out) const
+{
+    const uint256 script_hash = ScriptHash(script);
+    unspent_out.clear();
+
+    std::unique_ptr<CDBIterator> db_it(m_db->NewIterator());
+    DBUnspentKey key;
+    for (db_it->Seek(DBUnspentKey(script_hash, COutPoint(uint256(), 0)));
+         db_it->Valid() && unspent_out.size() < count; db_it->Next()) {
+        if (!db_it->GetKey(key) || key.script_hash != script_hash) break;
+        if (skip > 0) {
+            --skip;
+            continue;
+        }
+
+        DBUnspentValue value;
+        if (!db_it->GetValue(value)) {
+            return error("%s: unable to read value in %s at key (%c, %s)",
+                         __func__, GetName(), DB_UNSPENT, script_hash.ToString());
+        }
+        unspent_out.push_back(Unspent{key.outpoint, value.value, value.height});
+    }
+    return true;
+}
+
+bool AddressIndex::LookupHistory(const CScript& script, size_t skip, size_t count,
+                                 std::vector<HistoryEntry>& history_out) const
+{
+    const uint256 script_hash = ScriptHash(script);
+    history_out.clear();
+
+    std::unique_ptr<CDBIterator> db_it(m_db->NewIterator());
+    DBHistoryKey key;
+    for (db_it->Seek(DBHistoryKey(script_hash, 0, 0));
+         db_it->Valid() && history_out.size() < count; db_it->Next()) {
+        if (!db_it->GetKey(key) || key.script_hash != script_hash) break;
+        if (skip > 0) {
+            --skip;
+            continue;
+        }
+
+        DBHistoryValue value;
+        if (!db_it->GetValue(value)) {
+            return error("%s: unable to read value in %s at key (%c, %s)",
+                         __func__, GetName(), DB_HISTORY, script_hash.ToString());
+        }
+        history_out.push_back(HistoryEntry{value.txid, key.height, value.block_hash, value.received, value.sent});
+    }
+    return true;
+}
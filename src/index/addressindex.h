@@ -0,0 +1,96 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef LITECOINCASH_INDEX_ADDRESSINDEX_H
+#define LITECOINCASH_INDEX_ADDRESSINDEX_H
+
+#include <amount.h>
+#include <chain.h>
+#include <index/base.h>
+#include <script/script.h>
+
+#include <memory>
+#include <vector>
+
+static const bool DEFAULT_ADDRESSINDEX = false;
+
+/**
+ * LitecoinCash: AddressIndex: AddressIndex is used to look up the unspent outputs and the transaction
+ * history of an address, or rather of its output script, as of the best block of the index.
+ *
+ * Scripts are keyed by their SHA256 hash. For each script the index keeps its unspent outputs, and
+ * an entry for every transaction paying to or spending from it, ordered by height and position in
+ * the block. Blocks are applied and disconnected with the help of their undo data, which holds the
+ * outputs that they spend.
+ */
+class AddressIndex final : public BaseIndex
+{
+public:
+    /** An output to a script that is unspent as of the best block of the index. */
+    struct Unspent {
+        COutPoint outpoint;
+        CAmount value;
+        int height;
+    };
+
+    /** A transaction paying to or spending from a script. */
+    struct HistoryEntry {
+        uint256 txid;
+        int height;
+        uint256 block_hash;
+        CAmount received;
+        CAmount sent;
+    };
+
+    /** Totals over the whole history of a script. */
+    struct Balance {
+        CAmount balance{0};
+        CAmount received{0};
+        uint64_t tx_count{0};
+    };
+
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+    /// Undo the entries of the blocks from current_tip back to new_tip, and make new_tip the best
+    /// block, in a single batch.
+    bool UndoBlocks(const CBlockIndex* current_tip, const CBlockIndex* new_tip);
+
+protected:
+    bool Init() override;
+
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+    const char* GetName() const override { return "addressindex"; }
+
+public:
+    /** Constructs the index, which becomes available to be queried. */
+    explicit AddressIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~AddressIndex() override;
+
+    /** Sum up the history of a script. */
+    bool LookupBalance(const CScript& script, Balance& balance_out) const;
+
+    /** Get up to count unspent outputs to a script, after skipping the first skip of them. */
+    bool LookupUnspent(const CScript& script, size_t skip, size_t count,
+                       std::vector<Unspent>& unspent_out) const;
+
+    /** Get up to count history entries of a script, oldest first, after skipping the first skip. */
+    bool LookupHistory(const CScript& script, size_t skip, size_t count,
+                       std::vector<HistoryEntry>& history_out) const;
+};
+
+/** The global address index. May be null. */
+extern std::unique_ptr<AddressIndex> g_addressindex;
+
+#endif // LITECOINCASH_INDEX_ADDRESSINDEX_H
@@ -0,0 +1,148 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <index/spentindex.h>
+#include <util.h>
+#include <validation.h>
+
+/* The index database stores, for every spent output, the txid and input index of the transaction
+ * spending it and the height of its block, with keys [DB_SPENT, outpoint]. As in the address index,
+ * the best block locator is written in the same batch as the entries of each block.
+ */
+constexpr char DB_SPENT = 's';
+
+std::unique_ptr<SpentIndex> g_spentindex;
+
+namespace {
+
+struct DBSpentKey {
+    COutPoint outpoint;
+
+    explicit DBSpentKey(const COutPoint& outpoint_in) : outpoint(outpoint_in) {}
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        char prefix = DB_SPENT;
+        READWRITE(prefix);
+        if (prefix != DB_SPENT) {
+            throw std::ios_base::failure("Invalid format for spent index DB key");
+        }
+
+        READWRITE(outpoint);
+    }
+};
+
+struct DBSpentValue {
+    uint256 txid;
+    uint32_t input_index;
+    int height;
+
+    ADD_SERIALIZE_METHODS;
+
+    template <typename Stream, typename Operation>
+    inline void SerializationOp(Stream& s, Operation ser_action) {
+        READWRITE(txid);
+        READWRITE(input_index);
+        READWRITE(height);
+    }
+};
+
+}; // namespace
+
+/** Access to the spent index database (indexes/spentindex/) */
+class SpentIndex::DB : public BaseIndex::DB
+{
+public:
+    explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+};
+
+SpentIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
+    BaseIndex::DB(GetDataDir() / "indexes" / "spentindex", n_cache_size, f_memory, f_wipe)
+{}
+
+SpentIndex::SpentIndex(size_t n_cache_size, bool f_memory, bool f_wipe)
+    : m_db(MakeUnique<SpentIndex::DB>(n_cache_size, f_memory, f_wipe))
+{}
+
+SpentIndex::~SpentIndex() {}
+
+BaseIndex::DB& SpentIndex::GetDB() const { return *m_db; }
+
+bool SpentIndex::WriteBlock(const CBlock& block, const CBlockIndex* pindex)
+{
+    CDBBatch batch(*m_db);
+    for (const auto& tx : block.vtx) {
+        if (tx->IsCoinBase()) continue;
+        for (uint32_t i = 0; i < tx->vin.size(); ++i) {
+            batch.Write(DBSpentKey(tx->vin[i].prevout), DBSpentValue{tx->GetHash(), i, pindex->nHeight});
+        }
+    }
+
+    {
+        LOCK(cs_main);
+        GetDB().WriteBestBlock(batch, chainActive.GetLocator(pindex));
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool SpentIndex::Init()
+{
+    // The best block on disk is the one the entries on disk are for. If it was disconnected while the
+    // index was not running, undo its entries back to the fork, which Init then resumes from.
+    LOCK(cs_main);
+    const CBlockIndex* stale_tip = ReadStaleBestBlock();
+    if (stale_tip) {
+        const CBlockIndex* fork = chainActive.FindFork(stale_tip);
+        if (fork && !UndoBlocks(stale_tip, fork)) {
+            return false;
+        }
+    }
+    return BaseIndex::Init();
+}
+
+bool SpentIndex::Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
+{
+    return UndoBlocks(current_tip, new_tip) && BaseIndex::Rewind(current_tip, new_tip);
+}
+
+bool SpentIndex::UndoBlocks(const CBlockIndex* current_tip, const CBlockIndex* new_tip)
+{
+    assert(current_tip->GetAncestor(new_tip->nHeight) == new_tip);
+
+    const Consensus::Params& consensus_params = Params().GetConsensus();
+    CDBBatch batch(*m_db);
+    for (const CBlockIndex* pindex = current_tip; pindex != new_tip; pindex = pindex->pprev) {
+        CBlock block;
+        if (!ReadBlockFromDisk(block, pindex, consensus_params)) {
+            return error("%s: failed to read block %s", __func__, pindex->GetBlockHash().ToString());
+        }
+        for (const auto& tx : block.vtx) {
+            if (tx->IsCoinBase()) continue;
+            for (const CTxIn& txin : tx->vin) {
+                batch.Erase(DBSpentKey(txin.prevout));
+            }
+        }
+    }
+
+    // Move the best block along in the same batch, so that the index never claims to hold a block
+    // whose entries are gone.
+    {
+        LOCK(cs_main);
+        GetDB().WriteBestBlock(batch, chainActive.GetLocator(new_tip));
+    }
+    return m_db->WriteBatch(batch);
+}
+
+bool SpentIndex::LookupSpent(const COutPoint& outpoint, SpentInfo& info_out) const
+{
+    DBSpentValue value;
+    if (!m_db->Read(DBSpentKey(outpoint), value)) {
+        return false;
+    }
+    info_out = SpentInfo{value.txid, value.input_index, value.height};
+    return true;
+}
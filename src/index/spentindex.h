@@ -0,0 +1,65 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef LITECOINCASH_INDEX_SPENTINDEX_H
+#define LITECOINCASH_INDEX_SPENTINDEX_H
+
+#include <chain.h>
+#include <index/base.h>
+
+#include <memory>
+
+static const bool DEFAULT_SPENTINDEX = false;
+
+/**
+ * LitecoinCash: AddressIndex: SpentIndex is used to look up the transaction that spends an output, as of
+ * the best block of the index. Unlike the UTXO set, which forgets outputs once they are spent, it
+ * keeps an entry for every output spent in the chain, keyed by the outpoint.
+ */
+class SpentIndex final : public BaseIndex
+{
+public:
+    /** The input spending an output. */
+    struct SpentInfo {
+        uint256 txid;
+        uint32_t input_index;
+        int height;
+    };
+
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+    /// Undo the entries of the blocks from current_tip back to new_tip, and make new_tip the best
+    /// block, in a single batch.
+    bool UndoBlocks(const CBlockIndex* current_tip, const CBlockIndex* new_tip);
+
+protected:
+    bool Init() override;
+
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+    const char* GetName() const override { return "spentindex"; }
+
+public:
+    /** Constructs the index, which becomes available to be queried. */
+    explicit SpentIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~SpentIndex() override;
+
+    /** Look up the input spending an output. Returns false if the output is not spent. */
+    bool LookupSpent(const COutPoint& outpoint, SpentInfo& info_out) const;
+};
+
+/** The global spent output index. May be null. */
+extern std::unique_ptr<SpentIndex> g_spentindex;
+
+#endif // LITECOINCASH_INDEX_SPENTINDEX_H
@@ -0,0 +1,63 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef LITECOINCASH_INDEX_TXINDEX_H
+#define LITECOINCASH_INDEX_TXINDEX_H
+
+#include <chain.h>
+#include <index/base.h>
+#include <txdb.h>
+
+/**
+ * LitecoinCash: TxIndex: TxIndex is used to look up transactions included in the blockchain by hash.
+ * The index is written to a LevelDB database and records the filesystem
+ * location of each transaction by transaction hash.
+ *
+ * It used to be written by ConnectBlock itself, into the block tree database, which made every block
+ * connection wait on it and meant the index could only be switched on with a -reindex. Like the other
+ * indexes it now follows the chain from validation notifications and catches up in the background.
+ */
+class TxIndex final : public BaseIndex
+{
+protected:
+    class DB;
+
+private:
+    const std::unique_ptr<DB> m_db;
+
+protected:
+    /// Override base class init to migrate from the block tree database.
+    bool Init() override;
+
+    bool WriteBlock(const CBlock& block, const CBlockIndex* pindex) override;
+
+    BaseIndex::DB& GetDB() const override;
+
+    const char* GetName() const override { return "txindex"; }
+
+public:
+    /// Constructs the index, which becomes available to be queried.
+    explicit TxIndex(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+
+    // Destructor is declared because this class contains a unique_ptr to an incomplete type.
+    virtual ~TxIndex() override;
+
+    /// Look up a transaction by hash.
+    ///
+    /// @param[in]   tx_hash  The hash of the transaction to be returned.
+    /// @param[out]  block_hash  The hash of the block the transaction is found in.
+    /// @param[out]  tx  The transaction itself.
+    /// @return  true if transaction is found, false otherwise
+    bool FindTx(const uint256& tx_hash, uint256& block_hash, CTransactionRef& tx) const;
+};
+
+/// The global transaction index, used in GetTransaction. May be null.
+extern std::unique_ptr<TxIndex> g_txindex;
+
+/// Earlier versions kept the transaction index in the block tree database, flagged "txindex" and
+/// always in sync with the chain tip. Clear the flag and record best_locator as the block those
+/// entries are in sync with, so that a later TxIndex migrates them and catches up from there.
+bool SuspendLegacyTxIndex(CBlockTreeDB& block_tree_db, const CBlockLocator& best_locator);
+
+#endif // LITECOINCASH_INDEX_TXINDEX_H
@@ -0,0 +1,53 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <mappedfile.h>
+
+#include <util.h>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+CMappedFile::CMappedFile() : m_data(nullptr), m_size(0) {}
+
+CMappedFile::~CMappedFile()
+{
+#ifndef WIN32
+    if (m_data)
+        munmap(m_data, m_size);
+#endif
+}
+
+bool CMappedFile::Open(const fs::path& path)
+{
+    assert(!m_data);
+#ifndef WIN32
+    int fd = open(path.string().c_str(), O_RDONLY);
+    if (fd < 0) {
+        LogPrintf("Unable to open file %s\n", path.string());
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (data == MAP_FAILED) {
+        LogPrintf("Unable to map file %s: %s\n", path.string(), strerror(errno));
+        return false;
+    }
+    m_data = data;
+    m_size = st.st_size;
+    return true;
+#else
+    return false;
+#endif
+}
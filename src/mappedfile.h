@@ -0,0 +1,35 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef LITECOINCASH_MAPPEDFILE_H
+#define LITECOINCASH_MAPPEDFILE_H
+
+#include <fs.h>
+
+#include <stddef.h>
+
+/**
+ * LitecoinCash: MappedBlocks: Read-only memory map of a whole file, as it was when it was opened.
+ * Where memory mapping isn't supported, Open() fails and callers read the file instead.
+ */
+class CMappedFile
+{
+private:
+    void* m_data;
+    size_t m_size;
+
+public:
+    CMappedFile();
+    ~CMappedFile();
+
+    CMappedFile(const CMappedFile&) = delete;
+    CMappedFile& operator=(const CMappedFile&) = delete;
+
+    bool Open(const fs::path& path);
+
+    const unsigned char* data() const { return static_cast<const unsigned char*>(m_data); }
+    size_t size() const { return m_size; }
+};
+
+#endif // LITECOINCASH_MAPPEDFILE_H
@@ -10,9 +10,10 @@
 #include <utilstrencodings.h>
 
 
-CMerkleBlock::CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std::set<uint256>* txids)
+CMerkleBlock::CMerkleBlock(const CBlock& block, CBloomFilter* filter, const CBloomBlockElements* elements, const std::set<uint256>* txids)
 {
     header = block.GetBlockHeader();
+    assert(!elements || elements->size() == block.vtx.size());
 
     std::vector<bool> vMatch;
     std::vector<uint256> vHashes;
@@ -25,7 +26,7 @@ CMerkleBlock::CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std:
         const uint256& hash = block.vtx[i]->GetHash();
         if (txids && txids->count(hash)) {
             vMatch.push_back(true);
-        } else if (filter && filter->IsRelevantAndUpdate(*block.vtx[i])) {
+        } else if (filter && (elements ? filter->IsRelevantAndUpdate(*elements, i) : filter->IsRelevantAndUpdate(*block.vtx[i]))) {
             vMatch.push_back(true);
             vMatchedTxn.emplace_back(i, hash);
         } else {
@@ -34,13 +35,20 @@ CMerkleBlock::CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std:
         vHashes.push_back(hash);
     }
 
-    txn = CPartialMerkleTree(vHashes, vMatch);
+    txn = elements ? CPartialMerkleTree(vHashes, vMatch, elements->MerkleTree()) : CPartialMerkleTree(vHashes, vMatch);
 }
 
 uint256 CPartialMerkleTree::CalcHash(int height, unsigned int pos, const std::vector<uint256> &vTxid) {
     //we can never have zero txs in a merkle block, we always need the coinbase tx
     //if we do not have this assert, we can hit a memory access violation when indexing into vTxid
     assert(vTxid.size() != 0);
+    // LitecoinCash: BloomBatch: Look the hash up if all of them were computed beforehand
+    if (pvTreeHashes) {
+        size_t nOffset = 0;
+        for (int h = 0; h < height; h++)
+            nOffset += CalcTreeWidth(h);
+        return (*pvTreeHashes)[nOffset + pos];
+    }
     if (height == 0) {
         // hash at height 0 is the txids themself
         return vTxid[pos];
@@ -127,6 +135,18 @@ CPartialMerkleTree::CPartialMerkleTree(const std::vector<uint256> &vTxid, const
     TraverseAndBuild(nHeight, 0, vTxid, vMatch);
 }
 
+CPartialMerkleTree::CPartialMerkleTree(const std::vector<uint256> &vTxid, const std::vector<bool> &vMatch, const std::vector<uint256> &vTreeHashes) : nTransactions(vTxid.size()), fBad(false) {
+    int nHeight = 0;
+    size_t nNodes = CalcTreeWidth(0);
+    while (CalcTreeWidth(nHeight) > 1)
+        nNodes += CalcTreeWidth(++nHeight);
+    assert(vTreeHashes.size() == nNodes);
+
+    pvTreeHashes = &vTreeHashes;
+    TraverseAndBuild(nHeight, 0, vTxid, vMatch);
+    pvTreeHashes = nullptr;
+}
+
 CPartialMerkleTree::CPartialMerkleTree() : nTransactions(0), fBad(true) {}
 
 uint256 CPartialMerkleTree::ExtractMatches(std::vector<uint256> &vMatch, std::vector<unsigned int> &vnIndex) {
@@ -62,6 +62,9 @@ protected:
     /** flag set when encountering invalid data */
     bool fBad;
 
+    /** LitecoinCash: BloomBatch: while building from them, the hashes of all nodes, level by level from the txids up */
+    const std::vector<uint256>* pvTreeHashes = nullptr;
+
     /** helper function to efficiently calculate the number of nodes at given height in the merkle tree */
     unsigned int CalcTreeWidth(int height) const {
         return (nTransactions+(1 << height)-1) >> height;
@@ -107,6 +110,9 @@ public:
     /** Construct a partial merkle tree from a list of transaction ids, and a mask that selects a subset of them */
     CPartialMerkleTree(const std::vector<uint256> &vTxid, const std::vector<bool> &vMatch);
 
+    /** LitecoinCash: BloomBatch: The same, with the hashes of the whole tree computed beforehand (see CBloomBlockElements::MerkleTree) */
+    CPartialMerkleTree(const std::vector<uint256> &vTxid, const std::vector<bool> &vMatch, const std::vector<uint256> &vTreeHashes);
+
     CPartialMerkleTree();
 
     /**
@@ -144,10 +150,13 @@ public:
      * Note that this will call IsRelevantAndUpdate on the filter for each transaction,
      * thus the filter will likely be modified.
      */
-    CMerkleBlock(const CBlock& block, CBloomFilter& filter) : CMerkleBlock(block, &filter, nullptr) { }
+    CMerkleBlock(const CBlock& block, CBloomFilter& filter) : CMerkleBlock(block, &filter, nullptr, nullptr) { }
+
+    // LitecoinCash: BloomBatch: The same, with the block's data elements already prepared for matching
+    CMerkleBlock(const CBlock& block, CBloomFilter& filter, const CBloomBlockElements& elements) : CMerkleBlock(block, &filter, &elements, nullptr) { }
 
     // Create from a CBlock, matching the txids in the set
-    CMerkleBlock(const CBlock& block, const std::set<uint256>& txids) : CMerkleBlock(block, nullptr, &txids) { }
+    CMerkleBlock(const CBlock& block, const std::set<uint256>& txids) : CMerkleBlock(block, nullptr, nullptr, &txids) { }
 
     CMerkleBlock() {}
 
@@ -161,7 +170,7 @@ public:
 
 private:
     // Combined constructor to consolidate code
-    CMerkleBlock(const CBlock& block, CBloomFilter* filter, const std::set<uint256>* txids);
+    CMerkleBlock(const CBlock& block, CBloomFilter* filter, const CBloomBlockElements* elements, const std::set<uint256>* txids);
 };
 
 #endif // BITCOIN_MERKLEBLOCK_H
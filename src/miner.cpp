@@ -37,6 +37,7 @@
 #include <sync.h>           // LitecoinCash: Hive
 #include <boost/thread.hpp> // LitecoinCash: Hive: Mining optimisations
 #include <crypto/minotaurx/yespower/yespower.h>  // LitecoinCash: MinotaurX+Hive1.2
+#include <boost/bind.hpp>  // LitecoinCash: Block templates
 
 
 static CCriticalSection cs_solution_vars;
@@ -188,13 +189,12 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
     // transaction (which in most cases can be a no-op).
     fIncludeWitness = IsWitnessEnabled(pindexPrev, chainparams.GetConsensus()) && fMineWitnessTx;
 
-    int nPackagesSelected = 0;
-    int nDescendantsUpdated = 0;
+    int nChunksSelected = 0;
     // LitecoinCash: Don't include BCTs in hivemined blocks
     if (hiveProofScript)
         fIncludeBCTs = false;
 
-    addPackageTxs(nPackagesSelected, nDescendantsUpdated);
+    addChunkTxs(nChunksSelected);
 
     int64_t nTime1 = GetTimeMicros();
 
@@ -279,7 +279,7 @@ std::unique_ptr<CBlockTemplate> BlockAssembler::CreateNewBlock(const CScript& sc
 
     int64_t nTime2 = GetTimeMicros();
 
-    LogPrint(BCLog::BENCH, "CreateNewBlock() packages: %.2fms (%d packages, %d updated descendants), validity: %.2fms (total %.2fms)\n", 0.001 * (nTime1 - nTimeStart), nPackagesSelected, nDescendantsUpdated, 0.001 * (nTime2 - nTime1), 0.001 * (nTime2 - nTimeStart));
+    LogPrint(BCLog::BENCH, "CreateNewBlock() chunks: %.2fms (%d chunks), validity: %.2fms (total %.2fms)\n", 0.001 * (nTime1 - nTimeStart), nChunksSelected, 0.001 * (nTime2 - nTime1), 0.001 * (nTime2 - nTimeStart));
 
     return std::move(pblocktemplate);
 }
@@ -346,48 +346,6 @@ void BlockAssembler::AddToBlock(CTxMemPool::txiter iter)
     }
 }
 
-int BlockAssembler::UpdatePackagesForAdded(const CTxMemPool::setEntries& alreadyAdded,
-        indexed_modified_transaction_set &mapModifiedTx)
-{
-    int nDescendantsUpdated = 0;
-    for (const CTxMemPool::txiter it : alreadyAdded) {
-        CTxMemPool::setEntries descendants;
-        mempool.CalculateDescendants(it, descendants);
-        // Insert all descendants (not yet in block) into the modified set
-        for (CTxMemPool::txiter desc : descendants) {
-            if (alreadyAdded.count(desc))
-                continue;
-            ++nDescendantsUpdated;
-            modtxiter mit = mapModifiedTx.find(desc);
-            if (mit == mapModifiedTx.end()) {
-                CTxMemPoolModifiedEntry modEntry(desc);
-                modEntry.nSizeWithAncestors -= it->GetTxSize();
-                modEntry.nModFeesWithAncestors -= it->GetModifiedFee();
-                modEntry.nSigOpCostWithAncestors -= it->GetSigOpCost();
-                mapModifiedTx.insert(modEntry);
-            } else {
-                mapModifiedTx.modify(mit, update_for_parent_inclusion(it));
-            }
-        }
-    }
-    return nDescendantsUpdated;
-}
-
-// Skip entries in mapTx that are already in a block or are present
-// in mapModifiedTx (which implies that the mapTx ancestor state is
-// stale due to ancestor inclusion in the block)
-// Also skip transactions that we've already failed to add. This can happen if
-// we consider a transaction in mapModifiedTx and it fails: we can then
-// potentially consider it again while walking mapTx.  It's currently
-// guaranteed to fail again, but as a belt-and-suspenders check we put it in
-// failedTx and avoid re-evaluation, since the re-evaluation would be using
-// cached size/sigops/fee values that are not actually correct.
-bool BlockAssembler::SkipMapTxEntry(CTxMemPool::txiter it, indexed_modified_transaction_set &mapModifiedTx, CTxMemPool::setEntries &failedTx)
-{
-    assert (it != mempool.mapTx.end());
-    return mapModifiedTx.count(it) || inBlock.count(it) || failedTx.count(it);
-}
-
 void BlockAssembler::SortForBlock(const CTxMemPool::setEntries& package, CTxMemPool::txiter entry, std::vector<CTxMemPool::txiter>& sortedEntries)
 {
     // Sort package by ancestor count
@@ -399,30 +357,27 @@ void BlockAssembler::SortForBlock(const CTxMemPool::setEntries& package, CTxMemP
     std::sort(sortedEntries.begin(), sortedEntries.end(), CompareTxIterByAncestorCount());
 }
 
-// This transaction selection algorithm orders the mempool based
-// on feerate of a transaction including all unconfirmed ancestors.
-// Since we don't remove transactions from the mempool as we select them
-// for block inclusion, we need an alternate method of updating the feerate
-// of a transaction with its not-yet-selected ancestors as we go.
-// This is accomplished by walking the in-mempool descendants of selected
-// transactions and storing a temporary modified state in mapModifiedTxs.
-// Each time through the loop, we compare the best transaction in
-// mapModifiedTxs with the next transaction in the mempool to decide what
-// transaction package to work on next.
-void BlockAssembler::addPackageTxs(int &nPackagesSelected, int &nDescendantsUpdated)
+// LitecoinCash: ClusterMempool: This transaction selection algorithm walks
+// the chunks of every cluster in the mempool. Within a cluster the chunks are
+// already in decreasing fee rate order and valid to appear in that order, so
+// merging the clusters' chunk sequences by fee rate (with a heap holding each
+// cluster's next chunk) gives the best block the linearizations allow, without
+// having to update any ancestor state as transactions are selected.
+void BlockAssembler::addChunkTxs(int &nChunksSelected)
 {
-    // mapModifiedTx will store sorted packages after they are modified
-    // because some of their txs are already in the block
-    indexed_modified_transaction_set mapModifiedTx;
-    // Keep track of entries that failed inclusion, to avoid duplicate work
-    CTxMemPool::setEntries failedTx;
-
-    // Start by adding all descendants of previously added txs to mapModifiedTx
-    // and modifying them for their already included ancestors
-    UpdatePackagesForAdded(inBlock, mapModifiedTx);
-
-    CTxMemPool::indexed_transaction_set::index<ancestor_score>::type::iterator mi = mempool.mapTx.get<ancestor_score>().begin();
-    CTxMemPool::txiter iter;
+    struct ClusterCursor {
+        const CTxMemPoolCluster* cluster;
+        size_t nChunk;
+        size_t nTx;
+    };
+    // Heap with the cursor whose next chunk has the highest fee rate on top
+    auto compareCursors = [](const ClusterCursor& a, const ClusterCursor& b) {
+        return b.cluster->vChunks[b.nChunk].HasHigherFeeRate(a.cluster->vChunks[a.nChunk]);
+    };
+    std::vector<ClusterCursor> vHeap;
+    for (const auto& entry : mempool.GetClusters())
+        vHeap.push_back(ClusterCursor{entry.second.get(), 0, 0});
+    std::make_heap(vHeap.begin(), vHeap.end(), compareCursors);
 
     // Limit the number of attempts to add transactions to the block when it is
     // close to full; this is just a simple heuristic to finish quickly if the
@@ -430,68 +385,35 @@ void BlockAssembler::addPackageTxs(int &nPackagesSelected, int &nDescendantsUpda
     const int64_t MAX_CONSECUTIVE_FAILURES = 1000;
     int64_t nConsecutiveFailed = 0;
 
-    while (mi != mempool.mapTx.get<ancestor_score>().end() || !mapModifiedTx.empty())
+    while (!vHeap.empty())
     {
-        // First try to find a new transaction in mapTx to evaluate.
-        if (mi != mempool.mapTx.get<ancestor_score>().end() &&
-                SkipMapTxEntry(mempool.mapTx.project<0>(mi), mapModifiedTx, failedTx)) {
-            ++mi;
-            continue;
-        }
-
-        // Now that mi is not stale, determine which transaction to evaluate:
-        // the next entry from mapTx, or the best from mapModifiedTx?
-        bool fUsingModified = false;
+        std::pop_heap(vHeap.begin(), vHeap.end(), compareCursors);
+        ClusterCursor cursor = vHeap.back();
+        vHeap.pop_back();
 
-        modtxscoreiter modit = mapModifiedTx.get<ancestor_score>().begin();
-        if (mi == mempool.mapTx.get<ancestor_score>().end()) {
-            // We're out of entries in mapTx; use the entry from mapModifiedTx
-            iter = modit->iter;
-            fUsingModified = true;
-        } else {
-            // Try to compare the mapTx entry to the mapModifiedTx entry
-            iter = mempool.mapTx.project<0>(mi);
-            if (modit != mapModifiedTx.get<ancestor_score>().end() &&
-                    CompareTxMemPoolEntryByAncestorFee()(*modit, CTxMemPoolModifiedEntry(iter))) {
-                // The best entry in mapModifiedTx has higher score
-                // than the one from mapTx.
-                // Switch which transaction (package) to consider
-                iter = modit->iter;
-                fUsingModified = true;
-            } else {
-                // Either no entry in mapModifiedTx, or it's worse than mapTx.
-                // Increment mi for the next loop iteration.
-                ++mi;
-            }
-        }
-
-        // We skip mapTx entries that are inBlock, and mapModifiedTx shouldn't
-        // contain anything that is inBlock.
-        assert(!inBlock.count(iter));
-
-        uint64_t packageSize = iter->GetSizeWithAncestors();
-        CAmount packageFees = iter->GetModFeesWithAncestors();
-        int64_t packageSigOpsCost = iter->GetSigOpCostWithAncestors();
-        if (fUsingModified) {
-            packageSize = modit->nSizeWithAncestors;
-            packageFees = modit->nModFeesWithAncestors;
-            packageSigOpsCost = modit->nSigOpCostWithAncestors;
-        }
-
-        if (packageFees < blockMinFeeRate.GetFee(packageSize)) {
+        const CTxMemPoolCluster::Chunk& chunk = cursor.cluster->vChunks[cursor.nChunk];
+        if (chunk.nModFees < blockMinFeeRate.GetFee(chunk.nSize)) {
             // Everything else we might consider has a lower fee rate
             return;
         }
 
-        if (!TestPackage(packageSize, packageSigOpsCost)) {
-            if (fUsingModified) {
-                // Since we always look at the best entry in mapModifiedTx,
-                // we must erase failed entries so that we can consider the
-                // next best entry on the next loop iteration
-                mapModifiedTx.get<ancestor_score>().erase(modit);
-                failedTx.insert(iter);
-            }
+        const std::vector<CTxMemPool::txiter>::const_iterator chunkBegin = cursor.cluster->vTxs.begin() + cursor.nTx;
+        const std::vector<CTxMemPool::txiter>::const_iterator chunkEnd = chunkBegin + chunk.nTxCount;
+        cursor.nTx += chunk.nTxCount;
+        cursor.nChunk++;
+
+        CTxMemPool::setEntries package(chunkBegin, chunkEnd);
+        onlyUnconfirmed(package);
+        uint64_t packageSize = 0;
+        int64_t packageSigOpsCost = 0;
+        for (const CTxMemPool::txiter it : package) {
+            packageSize += it->GetTxSize();
+            packageSigOpsCost += it->GetSigOpCost();
+        }
 
+        // The rest of a cluster can depend on a chunk that doesn't make it in,
+        // so a failure leaves the cluster out from there on.
+        if (!TestPackage(packageSize, packageSigOpsCost)) {
             ++nConsecutiveFailed;
 
             if (nConsecutiveFailed > MAX_CONSECUTIVE_FAILURES && nBlockWeight >
@@ -502,6 +424,51 @@ void BlockAssembler::addPackageTxs(int &nPackagesSelected, int &nDescendantsUpda
             continue;
         }
 
+        // Test if all tx's are Final
+        if (!TestPackageTransactions(package))
+            continue;
+
+        // This chunk will make it in; reset the failed counter.
+        nConsecutiveFailed = 0;
+
+        // The linearization is already a valid order
+        for (std::vector<CTxMemPool::txiter>::const_iterator it = chunkBegin; it != chunkEnd; ++it) {
+            if (package.count(*it))
+                AddToBlock(*it);
+        }
+
+        ++nChunksSelected;
+
+        if (cursor.nChunk < cursor.cluster->vChunks.size()) {
+            vHeap.push_back(cursor);
+            std::push_heap(vHeap.begin(), vHeap.end(), compareCursors);
+        }
+    }
+}
+
+// LitecoinCash: Block templates: Append new packages to the end of the block, best ancestor feerate first.
+// Parents are either already in the block or part of the package, so the block order stays valid.
+std::unique_ptr<CBlockTemplate> BlockAssembler::UpdateBlock(std::unique_ptr<CBlockTemplate> pblocktemplateIn, CBlockIndex* pindexPrev, std::vector<CTxMemPool::txiter>& vNewEntries, CAmount& nFeesSkipped)
+{
+    int64_t nTimeStart = GetTimeMicros();
+
+    pblocktemplate = std::move(pblocktemplateIn);
+    pblock = &pblocktemplate->block;
+    nFeesSkipped = 0;
+
+    LOCK2(cs_main, mempool.cs);
+    const CAmount nFeesBefore = nFees;
+    int nPackagesSelected = 0;
+
+    std::sort(vNewEntries.begin(), vNewEntries.end(), [](const CTxMemPool::txiter& a, const CTxMemPool::txiter& b) {
+        return CompareTxMemPoolEntryByAncestorFee()(*a, *b);
+    });
+
+    for (const CTxMemPool::txiter iter : vNewEntries) {
+        // May already have been added as an ancestor of a better package
+        if (inBlock.count(iter))
+            continue;
+
         CTxMemPool::setEntries ancestors;
         uint64_t nNoLimit = std::numeric_limits<uint64_t>::max();
         std::string dummy;
@@ -510,33 +477,170 @@ void BlockAssembler::addPackageTxs(int &nPackagesSelected, int &nDescendantsUpda
         onlyUnconfirmed(ancestors);
         ancestors.insert(iter);
 
-        // Test if all tx's are Final
-        if (!TestPackageTransactions(ancestors)) {
-            if (fUsingModified) {
-                mapModifiedTx.get<ancestor_score>().erase(modit);
-                failedTx.insert(iter);
-            }
+        uint64_t packageSize = 0;
+        CAmount packageFees = 0;
+        int64_t packageSigOpsCost = 0;
+        for (const CTxMemPool::txiter it : ancestors) {
+            packageSize += it->GetTxSize();
+            packageFees += it->GetModifiedFee();
+            packageSigOpsCost += it->GetSigOpCost();
+        }
+
+        if (packageFees < blockMinFeeRate.GetFee(packageSize))
+            continue;
+
+        if (!TestPackage(packageSize, packageSigOpsCost)) {
+            nFeesSkipped += packageFees;
             continue;
         }
 
-        // This transaction will make it in; reset the failed counter.
-        nConsecutiveFailed = 0;
+        if (!TestPackageTransactions(ancestors))
+            continue;
 
-        // Package can be added. Sort the entries in a valid order.
         std::vector<CTxMemPool::txiter> sortedEntries;
         SortForBlock(ancestors, iter, sortedEntries);
+        for (const CTxMemPool::txiter it : sortedEntries)
+            AddToBlock(it);
+
+        ++nPackagesSelected;
+    }
+
+    if (nPackagesSelected == 0)
+        return std::move(pblocktemplate);
+
+    nLastBlockTx = nBlockTx;
+    nLastBlockWeight = nBlockWeight;
+
+    // Pay the new fees to the coinbase, and recommit to the new witness merkle root
+    CMutableTransaction coinbaseTx(*pblock->vtx[0]);
+    coinbaseTx.vout.resize(1);
+    coinbaseTx.vin[0].scriptWitness.SetNull();
+    coinbaseTx.vout[0].nValue += nFees - nFeesBefore;
+    pblock->vtx[0] = MakeTransactionRef(std::move(coinbaseTx));
+    pblocktemplate->vchCoinbaseCommitment = GenerateCoinbaseCommitment(*pblock, pindexPrev, chainparams.GetConsensus());
+    pblocktemplate->vTxFees[0] = -nFees;
+    pblocktemplate->vTxSigOpsCost[0] = WITNESS_SCALE_FACTOR * GetLegacySigOpCount(*pblock->vtx[0]);
+
+    // The updated template goes out to miners just like a new one, so it is validated just the same
+    CValidationState state;
+    if (!TestBlockValidity(state, chainparams, *pblock, pindexPrev, false, false))
+        throw std::runtime_error(strprintf("%s: TestBlockValidity failed: %s", __func__, FormatStateMessage(state)));
+
+    LogPrint(BCLog::BENCH, "UpdateBlock(): %d new packages, block weight: %u txs: %u fees: %ld (%.2fms)\n", nPackagesSelected, nBlockWeight, nBlockTx, nFees, 0.001 * (GetTimeMicros() - nTimeStart));
+
+    return std::move(pblocktemplate);
+}
+
+// LitecoinCash: Block templates: Rebuild once new packages that didn't fit are worth more than 1/20th of the template's fees
+static const CAmount TEMPLATE_REBUILD_SKIPPED_FEE_DIVISOR = 20;
+
+std::unique_ptr<CBlockTemplateManager> g_block_templates;
+
+CBlockTemplateManager::CBlockTemplateManager(const CChainParams& params) : chainparams(params)
+{
+    mempool.NotifyEntryAdded.connect(boost::bind(&CBlockTemplateManager::MempoolEntryAdded, this, _1));
+    mempool.NotifyEntryRemoved.connect(boost::bind(&CBlockTemplateManager::MempoolEntryRemoved, this, _1, _2));
+}
+
+CBlockTemplateManager::~CBlockTemplateManager()
+{
+    mempool.NotifyEntryAdded.disconnect(boost::bind(&CBlockTemplateManager::MempoolEntryAdded, this, _1));
+    mempool.NotifyEntryRemoved.disconnect(boost::bind(&CBlockTemplateManager::MempoolEntryRemoved, this, _1, _2));
+}
 
-        for (size_t i=0; i<sortedEntries.size(); ++i) {
-            AddToBlock(sortedEntries[i]);
-            // Erase from the modified set, if present
-            mapModifiedTx.erase(sortedEntries[i]);
+// Both notifications fire just before the mempool bumps its update counter, so a template is
+// still current as long as the counter matches what we've been told about.
+void CBlockTemplateManager::MempoolEntryAdded(CTransactionRef tx)
+{
+    LOCK(mempool.cs);
+    for (CachedTemplate& cached : templates) {
+        if (cached.fStale)
+            continue;
+        if (cached.nTransactionsUpdated != mempool.GetTransactionsUpdated()) {
+            cached.fStale = true;
+            continue;
         }
+        cached.nTransactionsUpdated++;
+        cached.vAdded.push_back(tx->GetHash());
+    }
+}
 
-        ++nPackagesSelected;
+void CBlockTemplateManager::MempoolEntryRemoved(CTransactionRef tx, MemPoolRemovalReason reason)
+{
+    LOCK(mempool.cs);
+    for (CachedTemplate& cached : templates) {
+        if (cached.fStale)
+            continue;
+        // Don't go near the assembler's entries if we might have missed a removal already
+        if (cached.nTransactionsUpdated != mempool.GetTransactionsUpdated()) {
+            cached.fStale = true;
+            continue;
+        }
+        cached.nTransactionsUpdated++;
+        CTxMemPool::txiter it = mempool.mapTx.find(tx->GetHash());
+        if (it != mempool.mapTx.end() && cached.assembler->IsInBlock(it))
+            cached.fStale = true;
+    }
+}
+
+bool CBlockTemplateManager::NeedsRebuild(const CachedTemplate& cached, const CBlockIndex* pindexPrev, bool fMineWitnessTx) const
+{
+    return cached.fStale
+        || cached.pindexPrev != pindexPrev
+        || cached.fMineWitnessTx != fMineWitnessTx
+        || cached.nTransactionsUpdated != mempool.GetTransactionsUpdated()
+        || cached.nFeesSkipped > -cached.pblocktemplate->vTxFees[0] / TEMPLATE_REBUILD_SKIPPED_FEE_DIVISOR;
+}
 
-        // Update transactions that depend on each of these
-        nDescendantsUpdated += UpdatePackagesForAdded(ancestors, mapModifiedTx);
+std::unique_ptr<CBlockTemplate> CBlockTemplateManager::GetBlockTemplate(const CScript& scriptPubKeyIn, bool fMineWitnessTx, const POW_TYPE powType)
+{
+    if (powType >= NUM_BLOCK_TYPES)
+        throw std::runtime_error("Error: Unrecognised pow type requested");
+
+    LOCK2(cs_main, mempool.cs);
+    CBlockIndex* pindexPrev = chainActive.Tip();
+    CachedTemplate& cached = templates[powType];
+
+    if (!NeedsRebuild(cached, pindexPrev, fMineWitnessTx) && !cached.vAdded.empty()) {
+        // Entries which have already left the mempool again don't matter; they weren't in the block
+        std::vector<CTxMemPool::txiter> vNewEntries;
+        for (const uint256& hash : cached.vAdded) {
+            CTxMemPool::txiter it = mempool.mapTx.find(hash);
+            if (it != mempool.mapTx.end())
+                vNewEntries.push_back(it);
+        }
+        cached.vAdded.clear();
+
+        // Mark the template stale first, in case UpdateBlock throws
+        cached.fStale = true;
+        CAmount nFeesSkipped = 0;
+        cached.pblocktemplate = cached.assembler->UpdateBlock(std::move(cached.pblocktemplate), pindexPrev, vNewEntries, nFeesSkipped);
+        cached.nFeesSkipped += nFeesSkipped;
+        cached.fStale = false;
+    }
+
+    if (NeedsRebuild(cached, pindexPrev, fMineWitnessTx)) {
+        cached.fStale = true;
+        cached.pblocktemplate.reset();
+        cached.assembler.reset(new BlockAssembler(chainparams));
+        cached.pblocktemplate = cached.assembler->CreateNewBlock(scriptPubKeyIn, fMineWitnessTx, nullptr, powType);
+        if (!cached.pblocktemplate)
+            return nullptr;
+        cached.pindexPrev = pindexPrev;
+        cached.fMineWitnessTx = fMineWitnessTx;
+        cached.nTransactionsUpdated = mempool.GetTransactionsUpdated();
+        cached.vAdded.clear();
+        cached.nFeesSkipped = 0;
+        cached.fStale = false;
     }
+
+    std::unique_ptr<CBlockTemplate> pblocktemplate(new CBlockTemplate(*cached.pblocktemplate));
+    CMutableTransaction coinbaseTx(*pblocktemplate->block.vtx[0]);
+    coinbaseTx.vout[0].scriptPubKey = scriptPubKeyIn;
+    pblocktemplate->block.vtx[0] = MakeTransactionRef(std::move(coinbaseTx));
+    UpdateTime(&pblocktemplate->block, chainparams.GetConsensus(), pindexPrev);
+
+    return pblocktemplate;
 }
 
 void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce)
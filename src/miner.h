@@ -41,49 +41,6 @@ struct CBlockTemplate
     std::vector<unsigned char> vchCoinbaseCommitment;
 };
 
-// Container for tracking updates to ancestor feerate as we include (parent)
-// transactions in a block
-struct CTxMemPoolModifiedEntry {
-    explicit CTxMemPoolModifiedEntry(CTxMemPool::txiter entry)
-    {
-        iter = entry;
-        nSizeWithAncestors = entry->GetSizeWithAncestors();
-        nModFeesWithAncestors = entry->GetModFeesWithAncestors();
-        nSigOpCostWithAncestors = entry->GetSigOpCostWithAncestors();
-    }
-
-    int64_t GetModifiedFee() const { return iter->GetModifiedFee(); }
-    uint64_t GetSizeWithAncestors() const { return nSizeWithAncestors; }
-    CAmount GetModFeesWithAncestors() const { return nModFeesWithAncestors; }
-    size_t GetTxSize() const { return iter->GetTxSize(); }
-    const CTransaction& GetTx() const { return iter->GetTx(); }
-
-    CTxMemPool::txiter iter;
-    uint64_t nSizeWithAncestors;
-    CAmount nModFeesWithAncestors;
-    int64_t nSigOpCostWithAncestors;
-};
-
-/** Comparator for CTxMemPool::txiter objects.
- *  It simply compares the internal memory address of the CTxMemPoolEntry object
- *  pointed to. This means it has no meaning, and is only useful for using them
- *  as key in other indexes.
- */
-struct CompareCTxMemPoolIter {
-    bool operator()(const CTxMemPool::txiter& a, const CTxMemPool::txiter& b) const
-    {
-        return &(*a) < &(*b);
-    }
-};
-
-struct modifiedentry_iter {
-    typedef CTxMemPool::txiter result_type;
-    result_type operator() (const CTxMemPoolModifiedEntry &entry) const
-    {
-        return entry.iter;
-    }
-};
-
 // A comparator that sorts transactions based on number of ancestors.
 // This is sufficient to sort an ancestor package in an order that is valid
 // to appear in a block.
@@ -96,40 +53,6 @@ struct CompareTxIterByAncestorCount {
     }
 };
 
-typedef boost::multi_index_container<
-    CTxMemPoolModifiedEntry,
-    boost::multi_index::indexed_by<
-        boost::multi_index::ordered_unique<
-            modifiedentry_iter,
-            CompareCTxMemPoolIter
-        >,
-        // sorted by modified ancestor fee rate
-        boost::multi_index::ordered_non_unique<
-            // Reuse same tag from CTxMemPool's similar index
-            boost::multi_index::tag<ancestor_score>,
-            boost::multi_index::identity<CTxMemPoolModifiedEntry>,
-            CompareTxMemPoolEntryByAncestorFee
-        >
-    >
-> indexed_modified_transaction_set;
-
-typedef indexed_modified_transaction_set::nth_index<0>::type::iterator modtxiter;
-typedef indexed_modified_transaction_set::index<ancestor_score>::type::iterator modtxscoreiter;
-
-struct update_for_parent_inclusion
-{
-    explicit update_for_parent_inclusion(CTxMemPool::txiter it) : iter(it) {}
-
-    void operator() (CTxMemPoolModifiedEntry &e)
-    {
-        e.nModFeesWithAncestors -= iter->GetFee();
-        e.nSizeWithAncestors -= iter->GetTxSize();
-        e.nSigOpCostWithAncestors -= iter->GetSigOpCost();
-    }
-
-    CTxMemPool::txiter iter;
-};
-
 /** Generate a new block, without valid proof-of-work */
 class BlockAssembler
 {
@@ -172,6 +95,14 @@ public:
     // LitecoinCash: MinotaurX+Hive1.2: Accept POW_TYPE arg
     std::unique_ptr<CBlockTemplate> CreateNewBlock(const CScript& scriptPubKeyIn, bool fMineWitnessTx=true, const CScript* hiveProofScript=nullptr, const POW_TYPE powType=POW_TYPE_SHA256);
 
+    /** LitecoinCash: Block templates: Extend the PoW template made by this assembler's last
+      * CreateNewBlock call with newly arrived mempool entries (and their unselected ancestors).
+      * nFeesSkipped is set to the fees of new packages which no longer fit in the block. */
+    std::unique_ptr<CBlockTemplate> UpdateBlock(std::unique_ptr<CBlockTemplate> pblocktemplateIn, CBlockIndex* pindexPrev, std::vector<CTxMemPool::txiter>& vNewEntries, CAmount& nFeesSkipped);
+
+    /** LitecoinCash: Block templates: Whether a mempool entry is in the block being assembled */
+    bool IsInBlock(CTxMemPool::txiter it) const { return inBlock.count(it); }
+
 private:
     // utility functions
     /** Clear the block's state and prepare for assembling a new block */
@@ -180,12 +111,11 @@ private:
     void AddToBlock(CTxMemPool::txiter iter);
 
     // Methods for how to add transactions to a block.
-    /** Add transactions based on feerate including unconfirmed ancestors
-      * Increments nPackagesSelected / nDescendantsUpdated with corresponding
-      * statistics from the package selection (for logging statistics). */
-    void addPackageTxs(int &nPackagesSelected, int &nDescendantsUpdated);
+    /** LitecoinCash: ClusterMempool: Add the mempool's cluster chunks, best fee rate first.
+      * Increments nChunksSelected (for logging statistics). */
+    void addChunkTxs(int &nChunksSelected);
 
-    // helper functions for addPackageTxs()
+    // helper functions for addChunkTxs()
     /** Remove confirmed (inBlock) entries from given set */
     void onlyUnconfirmed(CTxMemPool::setEntries& testSet);
     /** Test if a new package would "fit" in the block */
@@ -195,17 +125,50 @@ private:
       * These checks should always succeed, and they're here
       * only as an extra check in case of suboptimal node configuration */
     bool TestPackageTransactions(const CTxMemPool::setEntries& package);
-    /** Return true if given transaction from mapTx has already been evaluated,
-      * or if the transaction's cached data in mapTx is incorrect. */
-    bool SkipMapTxEntry(CTxMemPool::txiter it, indexed_modified_transaction_set &mapModifiedTx, CTxMemPool::setEntries &failedTx);
     /** Sort the package in an order that is valid to appear in a block */
     void SortForBlock(const CTxMemPool::setEntries& package, CTxMemPool::txiter entry, std::vector<CTxMemPool::txiter>& sortedEntries);
-    /** Add descendants of given transactions to mapModifiedTx with ancestor
-      * state updated assuming given transactions are inBlock. Returns number
-      * of updated descendants. */
-    int UpdatePackagesForAdded(const CTxMemPool::setEntries& alreadyAdded, indexed_modified_transaction_set &mapModifiedTx);
 };
 
+/**
+ * LitecoinCash: Block templates: Keeps a PoW block template per pow algorithm, and extends it as
+ * transactions enter the mempool instead of re-running package selection on every request.
+ * A template is only rebuilt from scratch when the tip changes, when a transaction it holds
+ * leaves the mempool, when the mempool changes in a way we aren't notified of (eg
+ * prioritisetransaction), or when new packages that didn't fit add up to a large enough
+ * share of the template's fees.
+ */
+class CBlockTemplateManager
+{
+public:
+    explicit CBlockTemplateManager(const CChainParams& params);
+    ~CBlockTemplateManager();
+
+    /** Return a copy of the current template for powType with its coinbase paying to scriptPubKeyIn */
+    std::unique_ptr<CBlockTemplate> GetBlockTemplate(const CScript& scriptPubKeyIn, bool fMineWitnessTx=true, const POW_TYPE powType=POW_TYPE_SHA256);
+
+private:
+    struct CachedTemplate {
+        std::unique_ptr<BlockAssembler> assembler;
+        std::unique_ptr<CBlockTemplate> pblocktemplate;
+        const CBlockIndex* pindexPrev = nullptr;
+        bool fMineWitnessTx = true;
+        unsigned int nTransactionsUpdated = 0;  // Mempool update counter the template is current with
+        std::vector<uint256> vAdded;            // Txids which entered the mempool since the last update
+        CAmount nFeesSkipped = 0;               // Fees of new packages which didn't fit
+        bool fStale = true;
+    };
+
+    void MempoolEntryAdded(CTransactionRef tx);
+    void MempoolEntryRemoved(CTransactionRef tx, MemPoolRemovalReason reason);
+    bool NeedsRebuild(const CachedTemplate& cached, const CBlockIndex* pindexPrev, bool fMineWitnessTx) const;
+
+    const CChainParams& chainparams;
+    CachedTemplate templates[NUM_BLOCK_TYPES];  // Guarded by mempool.cs
+};
+
+/** LitecoinCash: Block templates: Shared template manager for getblocktemplate, generate and stratum */
+extern std::unique_ptr<CBlockTemplateManager> g_block_templates;
+
 /** Modify the extranonce in a block */
 void IncrementExtraNonce(CBlock* pblock, const CBlockIndex* pindexPrev, unsigned int& nExtraNonce);
 int64_t UpdateTime(CBlockHeader* pblock, const Consensus::Params& consensusParams, const CBlockIndex* pindexPrev);
@@ -24,6 +24,11 @@
 #include <string.h>
 #else
 #include <fcntl.h>
+#include <sys/uio.h>
+#endif
+
+#ifdef USE_EPOLL
+#include <sys/epoll.h>
 #endif
 
 #ifdef USE_UPNP
@@ -42,6 +47,11 @@
 // We add a random period time (0 to 1 seconds) to feeler connections to prevent synchronization.
 #define FEELER_SLEEP_WINDOW 1
 
+/** LitecoinCash: SocketEvents: Longest wait for socket events, which bounds how late inactivity is noticed */
+static const int SOCKET_EVENTS_TIMEOUT_MS = 50;
+/** LitecoinCash: SocketEvents: Events taken from epoll in one go */
+static const int MAX_SOCKET_EVENTS = 256;
+
 #if !defined(HAVE_MSG_NOSIGNAL)
 #define MSG_NOSIGNAL 0
 #endif
@@ -86,6 +96,10 @@ static bool vfLimited[NET_MAX] = {};
 std::string strSubVersion;
 
 limitedmap<uint256, int64_t> mapAlreadyAskedFor(MAX_INV_SZ);
+CNetBufferPool netBufferPool;
+
+/** LitecoinCash: NetBuffers: At most this many buffers are handed to one send call */
+static const size_t MAX_SEND_SEGMENTS = 64;
 
 void CConnman::AddOneShot(const std::string& strDest)
 {
@@ -416,14 +430,14 @@ CNode* CConnman::ConnectNode(CAddress addrConnect, const char *pszDest, bool fCo
         bool proxyConnectionFailed = false;
 
         if (GetProxy(addrConnect.GetNetwork(), proxy)) {
-            hSocket = CreateSocket(proxy.proxy);
+            hSocket = CreateSocket(proxy.proxy, socketEventsMode == SocketEventsMode::Select);
             if (hSocket == INVALID_SOCKET) {
                 return nullptr;
             }
             connected = ConnectThroughProxy(proxy, addrConnect.ToStringIP(), addrConnect.GetPort(), hSocket, nConnectTimeout, &proxyConnectionFailed);
         } else {
             // no proxy needed (none set for target network)
-            hSocket = CreateSocket(addrConnect);
+            hSocket = CreateSocket(addrConnect, socketEventsMode == SocketEventsMode::Select);
             if (hSocket == INVALID_SOCKET) {
                 return nullptr;
             }
@@ -435,7 +449,7 @@ CNode* CConnman::ConnectNode(CAddress addrConnect, const char *pszDest, bool fCo
             addrman.Attempt(addrConnect, fCountFailure);
         }
     } else if (pszDest && GetNameProxy(proxy)) {
-        hSocket = CreateSocket(proxy.proxy);
+        hSocket = CreateSocket(proxy.proxy, socketEventsMode == SocketEventsMode::Select);
         if (hSocket == INVALID_SOCKET) {
             return nullptr;
         }
@@ -746,7 +760,7 @@ bool CNode::ReceiveMsgBytes(const char *pch, unsigned int nBytes, bool& complete
         // get current incomplete message, or create a new one
         if (vRecvMsg.empty() ||
             vRecvMsg.back().complete())
-            vRecvMsg.push_back(CNetMessage(Params().MessageStart(), SER_NETWORK, INIT_PROTO_VERSION));
+            vRecvMsg.emplace_back(Params().MessageStart(), SER_NETWORK, INIT_PROTO_VERSION);
 
         CNetMessage& msg = vRecvMsg.back();
 
@@ -786,6 +800,14 @@ bool CNode::ReceiveMsgBytes(const char *pch, unsigned int nBytes, bool& complete
     return true;
 }
 
+char* CNode::GetRecvBuffer(size_t& nSpace)
+{
+    LOCK(cs_vRecv);
+    if (vRecvMsg.empty())
+        return nullptr;
+    return vRecvMsg.back().GetDataBuffer(nSpace);
+}
+
 void CNode::SetSendVersion(int nVersionIn)
 {
     // Send version may only be changed in the version message, and
@@ -841,6 +863,12 @@ int CNetMessage::readHeader(const char *pch, unsigned int nBytes)
     // switch state to reading message data
     in_data = true;
 
+    // LitecoinCash: NetBuffers: Receive into the buffer of an earlier message, if one is big enough
+    if (hdr.nMessageSize) {
+        CNetSerializeData buffer = netBufferPool.Get(hdr.nMessageSize);
+        vRecv.SwapData(buffer);
+    }
+
     return nCopy;
 }
 
@@ -855,12 +883,99 @@ int CNetMessage::readData(const char *pch, unsigned int nBytes)
     }
 
     hasher.Write((const unsigned char*)pch, nCopy);
-    memcpy(&vRecv[nDataPos], pch, nCopy);
+    // LitecoinCash: NetBuffers: Nothing to copy if the data was received straight into place
+    if (pch != &vRecv[nDataPos])
+        memcpy(&vRecv[nDataPos], pch, nCopy);
     nDataPos += nCopy;
 
     return nCopy;
 }
 
+char* CNetMessage::GetDataBuffer(size_t& nSpace)
+{
+    if (!in_data || complete())
+        return nullptr;
+    if (vRecv.size() == nDataPos) {
+        // Allocate up to 256 KiB ahead, but never more than the total message size.
+        vRecv.resize(std::min(hdr.nMessageSize, nDataPos + 256 * 1024));
+    }
+    nSpace = vRecv.size() - nDataPos;
+    return &vRecv[nDataPos];
+}
+
+CNetMessage::~CNetMessage()
+{
+    CNetSerializeData buffer;
+    vRecv.SwapData(buffer);
+    netBufferPool.Put(std::move(buffer));
+}
+
+CNetSerializeData CNetBufferPool::Get(size_t nSize)
+{
+    CNetSerializeData buffer;
+    LOCK(cs);
+    auto best = vBuffers.end();
+    for (auto it = vBuffers.begin(); it != vBuffers.end(); ++it) {
+        if (it->capacity() >= nSize && (best == vBuffers.end() || it->capacity() < best->capacity()))
+            best = it;
+    }
+    if (best == vBuffers.end()) {
+        nMisses++;
+        return buffer;
+    }
+    nHits++;
+    nBytes -= best->capacity();
+    buffer.swap(*best);
+    *best = std::move(vBuffers.back());
+    vBuffers.pop_back();
+    return buffer;
+}
+
+void CNetBufferPool::Put(CNetSerializeData&& buffer)
+{
+    const size_t nCapacity = buffer.capacity();
+    if (nCapacity == 0 || nCapacity > MAX_PROTOCOL_MESSAGE_LENGTH)
+        return;
+    buffer.clear();
+    LOCK(cs);
+    if (vBuffers.size() >= MAX_NET_BUFFER_POOL_SIZE || nBytes + nCapacity > MAX_NET_BUFFER_POOL_BYTES)
+        return;
+    nBytes += nCapacity;
+    vBuffers.push_back(std::move(buffer));
+}
+
+void CNetBufferPool::GetStats(NetBufferStats& stats) const
+{
+    LOCK(cs);
+    stats.nPoolHits = nHits;
+    stats.nPoolMisses = nMisses;
+    stats.nPoolBuffers = vBuffers.size();
+    stats.nPoolBytes = nBytes;
+}
+
+/** LitecoinCash: NetBuffers: Lay out a message header the way CMessageHeader serializes, without a stream */
+static void WriteMessageHeader(std::array<unsigned char, CMessageHeader::HEADER_SIZE>& header, const std::string& command, const unsigned char* data, size_t nDataSize)
+{
+    CMessageHeader hdr(Params().MessageStart(), command.c_str(), nDataSize);
+    uint256 hash = Hash(data, data + nDataSize);
+    memcpy(header.data(), hdr.pchMessageStart, CMessageHeader::MESSAGE_START_SIZE);
+    memcpy(header.data() + CMessageHeader::MESSAGE_START_SIZE, hdr.pchCommand, CMessageHeader::COMMAND_SIZE);
+    WriteLE32(header.data() + CMessageHeader::MESSAGE_SIZE_OFFSET, hdr.nMessageSize);
+    memcpy(header.data() + CMessageHeader::CHECKSUM_OFFSET, hash.begin(), CMessageHeader::CHECKSUM_SIZE);
+}
+
+CSharedNetMsg::CSharedNetMsg(CSerializedNetMsg&& msg) : command(std::move(msg.command)), nDataSize(msg.data.size())
+{
+    std::shared_ptr<const std::vector<unsigned char>> vData = std::make_shared<const std::vector<unsigned char>>(std::move(msg.data));
+    data = std::shared_ptr<const unsigned char>(vData, vData->data());
+    WriteMessageHeader(header, command, data.get(), nDataSize);
+}
+
+CSharedNetMsg::CSharedNetMsg(const std::string& commandIn, std::shared_ptr<const unsigned char> dataIn, size_t nDataSizeIn) : command(commandIn), data(std::move(dataIn)), nDataSize(nDataSizeIn)
+{
+    WriteMessageHeader(header, command, data.get(), nDataSize);
+}
+
 const uint256& CNetMessage::GetMessageHash() const
 {
     assert(complete());
@@ -878,33 +993,72 @@ const uint256& CNetMessage::GetMessageHash() const
 
 
 // requires LOCK(cs_vSend)
-size_t CConnman::SocketSendData(CNode *pnode) const
+size_t CConnman::SocketSendData(CNode *pnode)
 {
-    auto it = pnode->vSendMsg.begin();
     size_t nSentSize = 0;
 
-    while (it != pnode->vSendMsg.end()) {
-        const auto &data = *it;
-        assert(data.size() > pnode->nSendOffset);
+    while (!pnode->vSendMsg.empty()) {
+        // LitecoinCash: NetBuffers: Hand the headers and payloads of as many queued messages as possible to one call
+        std::pair<const char*, size_t> vSegments[MAX_SEND_SEGMENTS];
+        size_t nSegments = 0;
+        size_t nOffset = pnode->nSendOffset;
+        for (auto it = pnode->vSendMsg.begin(); it != pnode->vSendMsg.end() && nSegments + 2 <= MAX_SEND_SEGMENTS; ++it) {
+            assert(it->size() > nOffset);
+            if (nOffset < it->header.size())
+                vSegments[nSegments++] = std::make_pair(reinterpret_cast<const char*>(it->header.data()) + nOffset, it->header.size() - nOffset);
+            const size_t nDataOffset = nOffset > it->header.size() ? nOffset - it->header.size() : 0;
+            if (nDataOffset < it->nDataSize)
+                vSegments[nSegments++] = std::make_pair(reinterpret_cast<const char*>(it->data.get()) + nDataOffset, it->nDataSize - nDataOffset);
+            nOffset = 0;
+        }
+#ifdef WIN32
+        // No gathering writes here; one buffer per call
+        nSegments = 1;
+#endif
+        size_t nSegmentBytes = 0;
+        for (size_t i = 0; i < nSegments; i++)
+            nSegmentBytes += vSegments[i].second;
+
         int nBytes = 0;
         {
             LOCK(pnode->cs_hSocket);
             if (pnode->hSocket == INVALID_SOCKET)
                 break;
-            nBytes = send(pnode->hSocket, reinterpret_cast<const char*>(data.data()) + pnode->nSendOffset, data.size() - pnode->nSendOffset, MSG_NOSIGNAL | MSG_DONTWAIT);
+#ifdef WIN32
+            nBytes = send(pnode->hSocket, vSegments[0].first, vSegments[0].second, MSG_NOSIGNAL | MSG_DONTWAIT);
+#else
+            struct iovec vIov[MAX_SEND_SEGMENTS];
+            for (size_t i = 0; i < nSegments; i++) {
+                vIov[i].iov_base = const_cast<char*>(vSegments[i].first);
+                vIov[i].iov_len = vSegments[i].second;
+            }
+            struct msghdr msg = {};
+            msg.msg_iov = vIov;
+            msg.msg_iovlen = nSegments;
+            nBytes = sendmsg(pnode->hSocket, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+#endif
         }
+        nSendCalls++;
         if (nBytes > 0) {
             pnode->nLastSend = GetSystemTimeInSeconds();
             pnode->nSendBytes += nBytes;
-            pnode->nSendOffset += nBytes;
             nSentSize += nBytes;
-            if (pnode->nSendOffset == data.size()) {
+            size_t nLeft = nBytes;
+            while (nLeft > 0) {
+                const size_t nRemaining = pnode->vSendMsg.front().size() - pnode->nSendOffset;
+                if (nLeft < nRemaining) {
+                    pnode->nSendOffset += nLeft;
+                    break;
+                }
+                nLeft -= nRemaining;
                 pnode->nSendOffset = 0;
-                pnode->nSendSize -= data.size();
-                pnode->fPauseSend = pnode->nSendSize > nSendBufferMaxSize;
-                it++;
-            } else {
-                // could not send full message; stop sending more
+                pnode->nSendSize -= pnode->vSendMsg.front().size();
+                pnode->vSendMsg.pop_front();
+                nMessagesSent++;
+            }
+            pnode->fPauseSend = pnode->nSendSize > nSendBufferMaxSize;
+            if ((size_t)nBytes < nSegmentBytes) {
+                // could not send everything; stop sending more
                 break;
             }
         } else {
@@ -922,11 +1076,10 @@ size_t CConnman::SocketSendData(CNode *pnode) const
         }
     }
 
-    if (it == pnode->vSendMsg.end()) {
+    if (pnode->vSendMsg.empty()) {
         assert(pnode->nSendOffset == 0);
         assert(pnode->nSendSize == 0);
     }
-    pnode->vSendMsg.erase(pnode->vSendMsg.begin(), it);
     return nSentSize;
 }
 
@@ -1103,7 +1256,7 @@ void CConnman::AcceptConnection(const ListenSocket& hListenSocket) {
         return;
     }
 
-    if (!IsSelectableSocket(hSocket))
+    if (socketEventsMode == SocketEventsMode::Select && !IsSelectableSocket(hSocket))
     {
         LogPrintf("connection from %s dropped: non-selectable socket\n", addr.ToString());
         CloseSocket(hSocket);
@@ -1146,302 +1299,539 @@ void CConnman::AcceptConnection(const ListenSocket& hListenSocket) {
         LOCK(cs_vNodes);
         vNodes.push_back(pnode);
     }
+    RegisterSocketEvents(pnode);
 }
 
-void CConnman::ThreadSocketHandler()
+void CConnman::DisconnectNodes()
 {
-    unsigned int nPrevNodeCount = 0;
-    while (!interruptNet)
     {
-        //
-        // Disconnect nodes
-        //
+        LOCK(cs_vNodes);
+        // Disconnect unused nodes
+        std::vector<CNode*> vNodesCopy = vNodes;
+        for (CNode* pnode : vNodesCopy)
         {
-            LOCK(cs_vNodes);
-            // Disconnect unused nodes
-            std::vector<CNode*> vNodesCopy = vNodes;
-            for (CNode* pnode : vNodesCopy)
+            if (pnode->fDisconnect)
             {
-                if (pnode->fDisconnect)
-                {
-                    // remove from vNodes
-                    vNodes.erase(remove(vNodes.begin(), vNodes.end(), pnode), vNodes.end());
+                // remove from vNodes
+                vNodes.erase(remove(vNodes.begin(), vNodes.end(), pnode), vNodes.end());
 
-                    // release outbound grant (if any)
-                    pnode->grantOutbound.Release();
+                // release outbound grant (if any)
+                pnode->grantOutbound.Release();
 
-                    // close socket and cleanup
-                    pnode->CloseSocketDisconnect();
+                // close socket and cleanup
+                pnode->CloseSocketDisconnect();
 
-                    // hold in disconnected pool until all refs are released
-                    pnode->Release();
-                    vNodesDisconnected.push_back(pnode);
-                }
+                // hold in disconnected pool until all refs are released
+                pnode->Release();
+                vNodesDisconnected.push_back(pnode);
             }
         }
+    }
+    {
+        // Delete disconnected nodes
+        std::list<CNode*> vNodesDisconnectedCopy = vNodesDisconnected;
+        for (CNode* pnode : vNodesDisconnectedCopy)
         {
-            // Delete disconnected nodes
-            std::list<CNode*> vNodesDisconnectedCopy = vNodesDisconnected;
-            for (CNode* pnode : vNodesDisconnectedCopy)
-            {
-                // wait until threads are done using it
-                if (pnode->GetRefCount() <= 0) {
-                    bool fDelete = false;
-                    {
-                        TRY_LOCK(pnode->cs_inventory, lockInv);
-                        if (lockInv) {
-                            TRY_LOCK(pnode->cs_vSend, lockSend);
-                            if (lockSend) {
-                                fDelete = true;
-                            }
+            // wait until threads are done using it
+            if (pnode->GetRefCount() <= 0) {
+                bool fDelete = false;
+                {
+                    TRY_LOCK(pnode->cs_inventory, lockInv);
+                    if (lockInv) {
+                        TRY_LOCK(pnode->cs_vSend, lockSend);
+                        if (lockSend) {
+                            fDelete = true;
                         }
                     }
-                    if (fDelete) {
-                        vNodesDisconnected.remove(pnode);
-                        DeleteNode(pnode);
-                    }
+                }
+                if (fDelete) {
+                    vNodesDisconnected.remove(pnode);
+                    ForgetSocketEvents(pnode);
+                    DeleteNode(pnode);
                 }
             }
         }
-        size_t vNodesSize;
+    }
+}
+
+void CConnman::NotifyNumConnectionsChanged()
+{
+    size_t vNodesSize;
+    {
+        LOCK(cs_vNodes);
+        vNodesSize = vNodes.size();
+    }
+    if(vNodesSize != nPrevNodeCount) {
+        nPrevNodeCount = vNodesSize;
+        if(clientInterface)
+            clientInterface->NotifyNumConnectionsChanged(nPrevNodeCount);
+    }
+}
+
+void CConnman::InactivityCheck(CNode *pnode)
+{
+    int64_t nTime = GetSystemTimeInSeconds();
+    if (nTime - pnode->nTimeConnected > 60)
+    {
+        if (pnode->nLastRecv == 0 || pnode->nLastSend == 0)
         {
-            LOCK(cs_vNodes);
-            vNodesSize = vNodes.size();
+            LogPrint(BCLog::NET, "socket no message in first 60 seconds, %d %d from %d\n", pnode->nLastRecv != 0, pnode->nLastSend != 0, pnode->GetId());
+            pnode->fDisconnect = true;
         }
-        if(vNodesSize != nPrevNodeCount) {
-            nPrevNodeCount = vNodesSize;
-            if(clientInterface)
-                clientInterface->NotifyNumConnectionsChanged(nPrevNodeCount);
+        else if (nTime - pnode->nLastSend > TIMEOUT_INTERVAL)
+        {
+            LogPrintf("socket sending timeout: %is\n", nTime - pnode->nLastSend);
+            pnode->fDisconnect = true;
         }
+        else if (nTime - pnode->nLastRecv > (pnode->nVersion > BIP0031_VERSION ? TIMEOUT_INTERVAL : 90*60))
+        {
+            LogPrintf("socket receive timeout: %is\n", nTime - pnode->nLastRecv);
+            pnode->fDisconnect = true;
+        }
+        else if (pnode->nPingNonceSent && pnode->nPingUsecStart + TIMEOUT_INTERVAL * 1000000 < GetTimeMicros())
+        {
+            LogPrintf("ping timeout: %fs\n", 0.000001 * (GetTimeMicros() - pnode->nPingUsecStart));
+            pnode->fDisconnect = true;
+        }
+        else if (!pnode->fSuccessfullyConnected)
+        {
+            LogPrintf("version handshake timeout from %d\n", pnode->GetId());
+            pnode->fDisconnect = true;
+        }
+    }
+}
 
-        //
-        // Find which sockets have data to receive
-        //
-        struct timeval timeout;
-        timeout.tv_sec  = 0;
-        timeout.tv_usec = 50000; // frequency to poll pnode->vSend
-
-        fd_set fdsetRecv;
-        fd_set fdsetSend;
-        fd_set fdsetError;
-        FD_ZERO(&fdsetRecv);
-        FD_ZERO(&fdsetSend);
-        FD_ZERO(&fdsetError);
-        SOCKET hSocketMax = 0;
-        bool have_fds = false;
-
-        for (const ListenSocket& hListenSocket : vhListenSocket) {
-            FD_SET(hListenSocket.socket, &fdsetRecv);
-            hSocketMax = std::max(hSocketMax, hListenSocket.socket);
-            have_fds = true;
+bool CConnman::SocketRecvData(CNode *pnode)
+{
+    // typical socket buffer is 8K-64K
+    char pchBuf[0x10000];
+    // LitecoinCash: NetBuffers: A large message body goes straight into its buffer, with fewer and bigger reads
+    size_t nSpace = 0;
+    char* pchRecv = pnode->GetRecvBuffer(nSpace);
+    if (!pchRecv || nSpace < sizeof(pchBuf)) {
+        pchRecv = pchBuf;
+        nSpace = sizeof(pchBuf);
+    }
+    int nBytes = 0;
+    {
+        LOCK(pnode->cs_hSocket);
+        if (pnode->hSocket == INVALID_SOCKET)
+            return false;
+        nBytes = recv(pnode->hSocket, pchRecv, nSpace, MSG_DONTWAIT);
+    }
+    nRecvCalls++;
+    if (nBytes > 0)
+    {
+        if (pchRecv != pchBuf)
+            nRecvDirectBytes += nBytes;
+        bool notify = false;
+        if (!pnode->ReceiveMsgBytes(pchRecv, nBytes, notify))
+            pnode->CloseSocketDisconnect();
+        RecordBytesRecv(nBytes);
+        if (notify) {
+            size_t nSizeAdded = 0;
+            auto it(pnode->vRecvMsg.begin());
+            for (; it != pnode->vRecvMsg.end(); ++it) {
+                if (!it->complete())
+                    break;
+                nSizeAdded += it->vRecv.size() + CMessageHeader::HEADER_SIZE;
+            }
+            {
+                LOCK(pnode->cs_vProcessMsg);
+                pnode->vProcessMsg.splice(pnode->vProcessMsg.end(), pnode->vRecvMsg, pnode->vRecvMsg.begin(), it);
+                pnode->nProcessQueueSize += nSizeAdded;
+                pnode->fPauseRecv = pnode->nProcessQueueSize > nReceiveFloodSize;
+            }
+            WakeMessageHandler();
+        }
+        return (size_t)nBytes == nSpace;
+    }
+    else if (nBytes == 0)
+    {
+        // socket closed gracefully
+        if (!pnode->fDisconnect) {
+            LogPrint(BCLog::NET, "socket closed\n");
+        }
+        pnode->CloseSocketDisconnect();
+    }
+    else if (nBytes < 0)
+    {
+        // error
+        int nErr = WSAGetLastError();
+        if (nErr != WSAEWOULDBLOCK && nErr != WSAEMSGSIZE && nErr != WSAEINTR && nErr != WSAEINPROGRESS)
+        {
+            if (!pnode->fDisconnect)
+                LogPrintf("socket recv error %s\n", NetworkErrorString(nErr));
+            pnode->CloseSocketDisconnect();
         }
+    }
+    return false;
+}
+
+void CConnman::SocketHandlerSelect()
+{
+    //
+    // Find which sockets have data to receive
+    //
+    struct timeval timeout;
+    timeout.tv_sec  = 0;
+    timeout.tv_usec = 50000; // frequency to poll pnode->vSend
+
+    fd_set fdsetRecv;
+    fd_set fdsetSend;
+    fd_set fdsetError;
+    FD_ZERO(&fdsetRecv);
+    FD_ZERO(&fdsetSend);
+    FD_ZERO(&fdsetError);
+    SOCKET hSocketMax = 0;
+    bool have_fds = false;
 
+    for (const ListenSocket& hListenSocket : vhListenSocket) {
+        FD_SET(hListenSocket.socket, &fdsetRecv);
+        hSocketMax = std::max(hSocketMax, hListenSocket.socket);
+        have_fds = true;
+    }
+
+    {
+        LOCK(cs_vNodes);
+        for (CNode* pnode : vNodes)
         {
-            LOCK(cs_vNodes);
-            for (CNode* pnode : vNodes)
+            // Implement the following logic:
+            // * If there is data to send, select() for sending data. As this only
+            //   happens when optimistic write failed, we choose to first drain the
+            //   write buffer in this case before receiving more. This avoids
+            //   needlessly queueing received data, if the remote peer is not themselves
+            //   receiving data. This means properly utilizing TCP flow control signalling.
+            // * Otherwise, if there is space left in the receive buffer, select() for
+            //   receiving data.
+            // * Hand off all complete messages to the processor, to be handled without
+            //   blocking here.
+
+            bool select_recv = !pnode->fPauseRecv;
+            bool select_send;
             {
-                // Implement the following logic:
-                // * If there is data to send, select() for sending data. As this only
-                //   happens when optimistic write failed, we choose to first drain the
-                //   write buffer in this case before receiving more. This avoids
-                //   needlessly queueing received data, if the remote peer is not themselves
-                //   receiving data. This means properly utilizing TCP flow control signalling.
-                // * Otherwise, if there is space left in the receive buffer, select() for
-                //   receiving data.
-                // * Hand off all complete messages to the processor, to be handled without
-                //   blocking here.
-
-                bool select_recv = !pnode->fPauseRecv;
-                bool select_send;
-                {
-                    LOCK(pnode->cs_vSend);
-                    select_send = !pnode->vSendMsg.empty();
-                }
+                LOCK(pnode->cs_vSend);
+                select_send = !pnode->vSendMsg.empty();
+            }
 
-                LOCK(pnode->cs_hSocket);
-                if (pnode->hSocket == INVALID_SOCKET)
-                    continue;
+            LOCK(pnode->cs_hSocket);
+            if (pnode->hSocket == INVALID_SOCKET)
+                continue;
 
-                FD_SET(pnode->hSocket, &fdsetError);
-                hSocketMax = std::max(hSocketMax, pnode->hSocket);
-                have_fds = true;
+            FD_SET(pnode->hSocket, &fdsetError);
+            hSocketMax = std::max(hSocketMax, pnode->hSocket);
+            have_fds = true;
 
-                if (select_send) {
-                    FD_SET(pnode->hSocket, &fdsetSend);
-                    continue;
-                }
-                if (select_recv) {
-                    FD_SET(pnode->hSocket, &fdsetRecv);
-                }
+            if (select_send) {
+                FD_SET(pnode->hSocket, &fdsetSend);
+                continue;
+            }
+            if (select_recv) {
+                FD_SET(pnode->hSocket, &fdsetRecv);
             }
         }
+    }
 
-        int nSelect = select(have_fds ? hSocketMax + 1 : 0,
-                             &fdsetRecv, &fdsetSend, &fdsetError, &timeout);
-        if (interruptNet)
+    int nSelect = select(have_fds ? hSocketMax + 1 : 0,
+                         &fdsetRecv, &fdsetSend, &fdsetError, &timeout);
+    if (interruptNet)
+        return;
+
+    if (nSelect == SOCKET_ERROR)
+    {
+        if (have_fds)
+        {
+            int nErr = WSAGetLastError();
+            LogPrintf("socket select error %s\n", NetworkErrorString(nErr));
+            for (unsigned int i = 0; i <= hSocketMax; i++)
+                FD_SET(i, &fdsetRecv);
+        }
+        FD_ZERO(&fdsetSend);
+        FD_ZERO(&fdsetError);
+        if (!interruptNet.sleep_for(std::chrono::milliseconds(timeout.tv_usec/1000)))
             return;
+    }
 
-        if (nSelect == SOCKET_ERROR)
+    //
+    // Accept new connections
+    //
+    for (const ListenSocket& hListenSocket : vhListenSocket)
+    {
+        if (hListenSocket.socket != INVALID_SOCKET && FD_ISSET(hListenSocket.socket, &fdsetRecv))
         {
-            if (have_fds)
-            {
-                int nErr = WSAGetLastError();
-                LogPrintf("socket select error %s\n", NetworkErrorString(nErr));
-                for (unsigned int i = 0; i <= hSocketMax; i++)
-                    FD_SET(i, &fdsetRecv);
-            }
-            FD_ZERO(&fdsetSend);
-            FD_ZERO(&fdsetError);
-            if (!interruptNet.sleep_for(std::chrono::milliseconds(timeout.tv_usec/1000)))
-                return;
+            AcceptConnection(hListenSocket);
         }
+    }
+
+    //
+    // Service each socket
+    //
+    std::vector<CNode*> vNodesCopy;
+    {
+        LOCK(cs_vNodes);
+        vNodesCopy = vNodes;
+        for (CNode* pnode : vNodesCopy)
+            pnode->AddRef();
+    }
+    for (CNode* pnode : vNodesCopy)
+    {
+        if (interruptNet)
+            break;
 
         //
-        // Accept new connections
+        // Receive
         //
-        for (const ListenSocket& hListenSocket : vhListenSocket)
+        bool recvSet = false;
+        bool sendSet = false;
+        bool errorSet = false;
         {
-            if (hListenSocket.socket != INVALID_SOCKET && FD_ISSET(hListenSocket.socket, &fdsetRecv))
-            {
-                AcceptConnection(hListenSocket);
-            }
+            LOCK(pnode->cs_hSocket);
+            if (pnode->hSocket == INVALID_SOCKET)
+                continue;
+            recvSet = FD_ISSET(pnode->hSocket, &fdsetRecv);
+            sendSet = FD_ISSET(pnode->hSocket, &fdsetSend);
+            errorSet = FD_ISSET(pnode->hSocket, &fdsetError);
+        }
+        if (recvSet || errorSet)
+        {
+            SocketRecvData(pnode);
         }
 
         //
-        // Service each socket
+        // Send
         //
-        std::vector<CNode*> vNodesCopy;
+        if (sendSet)
         {
-            LOCK(cs_vNodes);
-            vNodesCopy = vNodes;
-            for (CNode* pnode : vNodesCopy)
-                pnode->AddRef();
+            LOCK(pnode->cs_vSend);
+            size_t nBytes = SocketSendData(pnode);
+            if (nBytes) {
+                RecordBytesSent(nBytes);
+            }
         }
+
+        InactivityCheck(pnode);
+    }
+    {
+        LOCK(cs_vNodes);
         for (CNode* pnode : vNodesCopy)
-        {
-            if (interruptNet)
+            pnode->Release();
+    }
+}
+
+#ifdef USE_EPOLL
+bool CConnman::InitSocketEvents()
+{
+    epollfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollfd == -1) {
+        LogPrintf("epoll_create1 failed: %s\n", NetworkErrorString(errno));
+        return false;
+    }
+    if (pipe2(wakeupPipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+        LogPrintf("pipe2 failed: %s\n", NetworkErrorString(errno));
+        wakeupPipe[0] = wakeupPipe[1] = -1;
+        return false;
+    }
+
+    // The wakeup pipe and the listening sockets are level triggered, so whatever isn't handled in one
+    // round comes up again in the next
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    if (epoll_ctl(epollfd, EPOLL_CTL_ADD, wakeupPipe[0], &event) != 0) {
+        LogPrintf("epoll_ctl failed for the wakeup pipe: %s\n", NetworkErrorString(errno));
+        return false;
+    }
+    for (ListenSocket& hListenSocket : vhListenSocket) {
+        event.events = EPOLLIN;
+        event.data.ptr = &hListenSocket;
+        if (epoll_ctl(epollfd, EPOLL_CTL_ADD, hListenSocket.socket, &event) != 0) {
+            LogPrintf("epoll_ctl failed for a listening socket: %s\n", NetworkErrorString(errno));
+            return false;
+        }
+    }
+    return true;
+}
+
+void CConnman::SocketHandlerEpoll()
+{
+    // Don't wait if a peer is known to have more to read than one recv() took, and it can be read now
+    int nTimeout = SOCKET_EVENTS_TIMEOUT_MS;
+    for (CNode* pnode : setRecvReady) {
+        if (!pnode->fPauseRecv && !setSendBlocked.count(pnode)) {
+            nTimeout = 0;
+            break;
+        }
+    }
+
+    epoll_event events[MAX_SOCKET_EVENTS];
+    int nEvents = epoll_wait(epollfd, events, MAX_SOCKET_EVENTS, nTimeout);
+    if (interruptNet)
+        return;
+    if (nEvents < 0) {
+        if (errno != EINTR) {
+            LogPrintf("socket epoll error %s\n", NetworkErrorString(errno));
+            if (!interruptNet.sleep_for(std::chrono::milliseconds(SOCKET_EVENTS_TIMEOUT_MS)))
                 return;
+        }
+        nEvents = 0;
+    }
 
-            //
-            // Receive
-            //
-            bool recvSet = false;
-            bool sendSet = false;
-            bool errorSet = false;
-            {
-                LOCK(pnode->cs_hSocket);
-                if (pnode->hSocket == INVALID_SOCKET)
-                    continue;
-                recvSet = FD_ISSET(pnode->hSocket, &fdsetRecv);
-                sendSet = FD_ISSET(pnode->hSocket, &fdsetSend);
-                errorSet = FD_ISSET(pnode->hSocket, &fdsetError);
-            }
-            if (recvSet || errorSet)
-            {
-                // typical socket buffer is 8K-64K
-                char pchBuf[0x10000];
-                int nBytes = 0;
-                {
-                    LOCK(pnode->cs_hSocket);
-                    if (pnode->hSocket == INVALID_SOCKET)
-                        continue;
-                    nBytes = recv(pnode->hSocket, pchBuf, sizeof(pchBuf), MSG_DONTWAIT);
-                }
-                if (nBytes > 0)
-                {
-                    bool notify = false;
-                    if (!pnode->ReceiveMsgBytes(pchBuf, nBytes, notify))
-                        pnode->CloseSocketDisconnect();
-                    RecordBytesRecv(nBytes);
-                    if (notify) {
-                        size_t nSizeAdded = 0;
-                        auto it(pnode->vRecvMsg.begin());
-                        for (; it != pnode->vRecvMsg.end(); ++it) {
-                            if (!it->complete())
-                                break;
-                            nSizeAdded += it->vRecv.size() + CMessageHeader::HEADER_SIZE;
-                        }
-                        {
-                            LOCK(pnode->cs_vProcessMsg);
-                            pnode->vProcessMsg.splice(pnode->vProcessMsg.end(), pnode->vRecvMsg, pnode->vRecvMsg.begin(), it);
-                            pnode->nProcessQueueSize += nSizeAdded;
-                            pnode->fPauseRecv = pnode->nProcessQueueSize > nReceiveFloodSize;
-                        }
-                        WakeMessageHandler();
-                    }
-                }
-                else if (nBytes == 0)
-                {
-                    // socket closed gracefully
-                    if (!pnode->fDisconnect) {
-                        LogPrint(BCLog::NET, "socket closed\n");
-                    }
-                    pnode->CloseSocketDisconnect();
-                }
-                else if (nBytes < 0)
-                {
-                    // error
-                    int nErr = WSAGetLastError();
-                    if (nErr != WSAEWOULDBLOCK && nErr != WSAEMSGSIZE && nErr != WSAEINTR && nErr != WSAEINPROGRESS)
-                    {
-                        if (!pnode->fDisconnect)
-                            LogPrintf("socket recv error %s\n", NetworkErrorString(nErr));
-                        pnode->CloseSocketDisconnect();
-                    }
-                }
+    for (int i = 0; i < nEvents; i++) {
+        const epoll_event& event = events[i];
+        if (event.data.ptr == nullptr) {
+            char buf[128];
+            while (read(wakeupPipe[0], buf, sizeof(buf)) > 0) {}
+            continue;
+        }
+        bool fListenSocket = false;
+        for (const ListenSocket& hListenSocket : vhListenSocket) {
+            if (event.data.ptr == &hListenSocket) {
+                AcceptConnection(hListenSocket);
+                fListenSocket = true;
+                break;
             }
+        }
+        if (fListenSocket)
+            continue;
 
-            //
-            // Send
-            //
-            if (sendSet)
-            {
-                LOCK(pnode->cs_vSend);
-                size_t nBytes = SocketSendData(pnode);
-                if (nBytes) {
-                    RecordBytesSent(nBytes);
-                }
-            }
+        // Peer sockets are edge triggered: they stay ready to read until a read comes up short, and to
+        // write until a write does
+        CNode* pnode = static_cast<CNode*>(event.data.ptr);
+        if (event.events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+            setRecvReady.insert(pnode);
+        if (event.events & EPOLLOUT)
+            setSendBlocked.erase(pnode);
+    }
 
-            //
-            // Inactivity checking
-            //
-            int64_t nTime = GetSystemTimeInSeconds();
-            if (nTime - pnode->nTimeConnected > 60)
-            {
-                if (pnode->nLastRecv == 0 || pnode->nLastSend == 0)
-                {
-                    LogPrint(BCLog::NET, "socket no message in first 60 seconds, %d %d from %d\n", pnode->nLastRecv != 0, pnode->nLastSend != 0, pnode->GetId());
-                    pnode->fDisconnect = true;
-                }
-                else if (nTime - pnode->nLastSend > TIMEOUT_INTERVAL)
-                {
-                    LogPrintf("socket sending timeout: %is\n", nTime - pnode->nLastSend);
-                    pnode->fDisconnect = true;
-                }
-                else if (nTime - pnode->nLastRecv > (pnode->nVersion > BIP0031_VERSION ? TIMEOUT_INTERVAL : 90*60))
-                {
-                    LogPrintf("socket receive timeout: %is\n", nTime - pnode->nLastRecv);
-                    pnode->fDisconnect = true;
-                }
-                else if (pnode->nPingNonceSent && pnode->nPingUsecStart + TIMEOUT_INTERVAL * 1000000 < GetTimeMicros())
-                {
-                    LogPrintf("ping timeout: %fs\n", 0.000001 * (GetTimeMicros() - pnode->nPingUsecStart));
-                    pnode->fDisconnect = true;
-                }
-                else if (!pnode->fSuccessfullyConnected)
-                {
-                    LogPrintf("version handshake timeout from %d\n", pnode->GetId());
-                    pnode->fDisconnect = true;
-                }
-            }
+    //
+    // Receive
+    //
+    // As with select(), a peer with sends waiting isn't read from until they're done (see SocketHandlerSelect)
+    std::vector<CNode*> vRecvReady(setRecvReady.begin(), setRecvReady.end());
+    for (CNode* pnode : vRecvReady) {
+        if (interruptNet)
+            return;
+        if (pnode->fPauseRecv || setSendBlocked.count(pnode))
+            continue;
+        if (!SocketRecvData(pnode))
+            setRecvReady.erase(pnode);
+    }
+
+    //
+    // Send what couldn't be sent right away
+    //
+    std::vector<CNode*> vSendPending;
+    {
+        LOCK(cs_setSendPending);
+        for (CNode* pnode : setSendPending) {
+            if (!setSendBlocked.count(pnode))
+                vSendPending.push_back(pnode);
         }
-        {
-            LOCK(cs_vNodes);
-            for (CNode* pnode : vNodesCopy)
-                pnode->Release();
+    }
+    for (CNode* pnode : vSendPending) {
+        LOCK(pnode->cs_vSend);
+        size_t nBytes = SocketSendData(pnode);
+        if (nBytes) {
+            RecordBytesSent(nBytes);
+        }
+        if (pnode->vSendMsg.empty() || pnode->fDisconnect) {
+            LOCK(cs_setSendPending);
+            setSendPending.erase(pnode);
+        } else {
+            setSendBlocked.insert(pnode);
+        }
+    }
+
+    //
+    // Inactivity checking, once a second rather than on every wakeup
+    //
+    int64_t nTime = GetSystemTimeInSeconds();
+    if (nTime != nLastInactivityCheck) {
+        nLastInactivityCheck = nTime;
+        LOCK(cs_vNodes);
+        for (CNode* pnode : vNodes)
+            InactivityCheck(pnode);
+    }
+}
+#endif
+
+void CConnman::RegisterSocketEvents(CNode* pnode)
+{
+#ifdef USE_EPOLL
+    if (socketEventsMode != SocketEventsMode::Epoll)
+        return;
+    LOCK(pnode->cs_hSocket);
+    if (pnode->hSocket == INVALID_SOCKET)
+        return;
+    epoll_event event;
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.ptr = pnode;
+    if (epoll_ctl(epollfd, EPOLL_CTL_ADD, pnode->hSocket, &event) != 0) {
+        LogPrintf("epoll_ctl failed for peer=%d: %s\n", pnode->GetId(), NetworkErrorString(errno));
+        pnode->fDisconnect = true;
+    }
+#endif
+}
+
+void CConnman::ForgetSocketEvents(CNode* pnode)
+{
+    // Closing the socket took it out of the epoll set already
+    setRecvReady.erase(pnode);
+    setSendBlocked.erase(pnode);
+    LOCK(cs_setSendPending);
+    setSendPending.erase(pnode);
+}
+
+void CConnman::ThreadSocketHandler()
+{
+    while (!interruptNet)
+    {
+        DisconnectNodes();
+        NotifyNumConnectionsChanged();
+#ifdef USE_EPOLL
+        if (socketEventsMode == SocketEventsMode::Epoll) {
+            SocketHandlerEpoll();
+            continue;
+        }
+#endif
+        SocketHandlerSelect();
+    }
+}
+
+void CConnman::WakeSocketHandler()
+{
+#ifdef USE_EPOLL
+    if (socketEventsMode == SocketEventsMode::Epoll && wakeupPipe[1] != -1) {
+        char buf = 0;
+        if (write(wakeupPipe[1], &buf, 1) != 1) {
+            // The pipe is full, so the socket handler has a wakeup waiting already
         }
     }
+#endif
+}
+
+bool SocketEventsModeFromString(const std::string& str, SocketEventsMode& mode)
+{
+    if (str == "select") {
+        mode = SocketEventsMode::Select;
+        return true;
+    }
+#ifdef USE_EPOLL
+    if (str == "epoll") {
+        mode = SocketEventsMode::Epoll;
+        return true;
+    }
+#endif
+    return false;
+}
+
+std::string SocketEventsModeToString(SocketEventsMode mode)
+{
+    switch (mode) {
+    case SocketEventsMode::Select: return "select";
+    case SocketEventsMode::Epoll: return "epoll";
+    }
+    assert(false);
 }
 
 void CConnman::WakeMessageHandler()
@@ -1989,9 +2379,10 @@ void CConnman::OpenNetworkConnection(const CAddress& addrConnect, bool fCountFai
         LOCK(cs_vNodes);
         vNodes.push_back(pnode);
     }
+    RegisterSocketEvents(pnode);
 }
 
-void CConnman::ThreadMessageHandler()
+void CConnman::ThreadMessageHandler(int nWorker)
 {
     while (!flagInterruptMsgProc)
     {
@@ -2006,21 +2397,35 @@ void CConnman::ThreadMessageHandler()
 
         bool fMoreWork = false;
 
-        for (CNode* pnode : vNodesCopy)
+        // LitecoinCash: MsgHandler: Each worker starts its pass at a different peer, and skips peers another
+        // worker is on. A peer is only ever handled by one worker at a time, so its messages stay in order.
+        const size_t nNodes = vNodesCopy.size();
+        const size_t nFirst = nNodes ? nWorker * nNodes / nMsgHandlerThreads : 0;
+        for (size_t i = 0; i < nNodes; i++)
         {
+            CNode* pnode = vNodesCopy[(nFirst + i) % nNodes];
             if (pnode->fDisconnect)
                 continue;
+            bool fExpected = false;
+            if (!pnode->fMsgProcClaimed.compare_exchange_strong(fExpected, true))
+                continue;
 
             // Receive messages
             bool fMoreNodeWork = m_msgproc->ProcessMessages(pnode, flagInterruptMsgProc);
             fMoreWork |= (fMoreNodeWork && !pnode->fPauseSend);
-            if (flagInterruptMsgProc)
-                return;
-            // Send messages
-            {
+            if (!flagInterruptMsgProc) {
+                // Send messages
                 LOCK(pnode->cs_sendProcessing);
                 m_msgproc->SendMessages(pnode, flagInterruptMsgProc);
             }
+            pnode->fMsgProcClaimed = false;
+
+            // A message that came in while this worker had the peer may have woken a worker that skipped the
+            // peer, and had the wake-up cleared by it, so look for one before going to sleep
+            if (!fMoreWork && !pnode->fPauseSend) {
+                LOCK(pnode->cs_vProcessMsg);
+                fMoreWork = !pnode->vProcessMsg.empty();
+            }
 
             if (flagInterruptMsgProc)
                 return;
@@ -2060,7 +2465,7 @@ bool CConnman::BindListenPort(const CService &addrBind, std::string& strError, b
         return false;
     }
 
-    SOCKET hListenSocket = CreateSocket(addrBind);
+    SOCKET hListenSocket = CreateSocket(addrBind, socketEventsMode == SocketEventsMode::Select);
     if (hListenSocket == INVALID_SOCKET)
     {
         strError = strprintf("Error: Couldn't open socket for incoming connections (socket returned error %s)", NetworkErrorString(WSAGetLastError()));
@@ -2310,6 +2715,14 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
 
     fAddressesInitialized = true;
 
+#ifdef USE_EPOLL
+    // LitecoinCash: SocketEvents
+    if (socketEventsMode == SocketEventsMode::Epoll && !InitSocketEvents()) {
+        LogPrintf("Falling back to select() for socket events\n");
+        socketEventsMode = SocketEventsMode::Select;
+    }
+#endif
+
     if (semOutbound == nullptr) {
         // initialize semaphore
         semOutbound = MakeUnique<CSemaphore>(std::min((nMaxOutbound + nMaxFeeler), nMaxConnections));
@@ -2355,7 +2768,8 @@ bool CConnman::Start(CScheduler& scheduler, const Options& connOptions)
         threadOpenConnections = std::thread(&TraceThread<std::function<void()> >, "opencon", std::function<void()>(std::bind(&CConnman::ThreadOpenConnections, this, connOptions.m_specified_outgoing)));
 
     // Process messages
-    threadMessageHandler = std::thread(&TraceThread<std::function<void()> >, "msghand", std::function<void()>(std::bind(&CConnman::ThreadMessageHandler, this)));
+    for (int i = 0; i < nMsgHandlerThreads; i++)
+        vThreadMessageHandler.emplace_back(&TraceThread<std::function<void()> >, "msghand", std::function<void()>(std::bind(&CConnman::ThreadMessageHandler, this, i)));
 
     // Dump network addresses
     scheduler.scheduleEvery(std::bind(&CConnman::DumpData, this), DUMP_ADDRESSES_INTERVAL * 1000);
@@ -2387,6 +2801,7 @@ void CConnman::Interrupt()
     condMsgProc.notify_all();
 
     interruptNet();
+    WakeSocketHandler();
     InterruptSocks5(true);
 
     if (semOutbound) {
@@ -2404,8 +2819,11 @@ void CConnman::Interrupt()
 
 void CConnman::Stop()
 {
-    if (threadMessageHandler.joinable())
-        threadMessageHandler.join();
+    for (std::thread& thread : vThreadMessageHandler) {
+        if (thread.joinable())
+            thread.join();
+    }
+    vThreadMessageHandler.clear();
     if (threadOpenConnections.joinable())
         threadOpenConnections.join();
     if (threadOpenAddedConnections.joinable())
@@ -2439,6 +2857,24 @@ void CConnman::Stop()
     vNodes.clear();
     vNodesDisconnected.clear();
     vhListenSocket.clear();
+    setRecvReady.clear();
+    setSendBlocked.clear();
+    {
+        LOCK(cs_setSendPending);
+        setSendPending.clear();
+    }
+#ifdef USE_EPOLL
+    if (epollfd != -1) {
+        close(epollfd);
+        epollfd = -1;
+    }
+    for (int& fd : wakeupPipe) {
+        if (fd != -1) {
+            close(fd);
+            fd = -1;
+        }
+    }
+#endif
     semOutbound.reset();
     semAddnode.reset();
 }
@@ -2664,6 +3100,17 @@ uint64_t CConnman::GetTotalBytesSent()
     return nTotalBytesSent;
 }
 
+NetBufferStats CConnman::GetNetBufferStats() const
+{
+    NetBufferStats stats;
+    stats.nSendCalls = nSendCalls;
+    stats.nMessagesSent = nMessagesSent;
+    stats.nRecvCalls = nRecvCalls;
+    stats.nRecvDirectBytes = nRecvDirectBytes;
+    netBufferPool.GetStats(stats);
+    return stats;
+}
+
 ServiceFlags CConnman::GetLocalServices() const
 {
     return nLocalServices;
@@ -2741,6 +3188,7 @@ CNode::CNode(NodeId idIn, ServiceFlags nLocalServicesIn, int nMyStartingHeightIn
     nextSendTimeFeeFilter = 0;
     fPauseRecv = false;
     fPauseSend = false;
+    fMsgProcClaimed = false;
     nProcessQueueSize = 0;
 
     for (const std::string &msg : getAllNetMessageTypes())
@@ -2800,19 +3248,17 @@ bool CConnman::NodeFullyConnected(const CNode* pnode)
 
 void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
 {
-    size_t nMessageSize = msg.data.size();
-    size_t nTotalSize = nMessageSize + CMessageHeader::HEADER_SIZE;
-    LogPrint(BCLog::NET, "sending %s (%d bytes) peer=%d\n",  SanitizeString(msg.command.c_str()), nMessageSize, pnode->GetId());
-
-    std::vector<unsigned char> serializedHeader;
-    serializedHeader.reserve(CMessageHeader::HEADER_SIZE);
-    uint256 hash = Hash(msg.data.data(), msg.data.data() + nMessageSize);
-    CMessageHeader hdr(Params().MessageStart(), msg.command.c_str(), nMessageSize);
-    memcpy(hdr.pchChecksum, hash.begin(), CMessageHeader::CHECKSUM_SIZE);
+    PushMessage(pnode, CSharedNetMsg(std::move(msg)));
+}
 
-    CVectorWriter{SER_NETWORK, INIT_PROTO_VERSION, serializedHeader, 0, hdr};
+void CConnman::PushMessage(CNode* pnode, CSharedNetMsg msg)
+{
+    size_t nMessageSize = msg.nDataSize;
+    size_t nTotalSize = msg.size();
+    LogPrint(BCLog::NET, "sending %s (%d bytes) peer=%d\n",  SanitizeString(msg.command.c_str()), nMessageSize, pnode->GetId());
 
     size_t nBytesSent = 0;
+    bool fWakeSocketHandler = false;
     {
         LOCK(pnode->cs_vSend);
         bool optimisticSend(pnode->vSendMsg.empty());
@@ -2823,14 +3269,20 @@ void CConnman::PushMessage(CNode* pnode, CSerializedNetMsg&& msg)
 
         if (pnode->nSendSize > nSendBufferMaxSize)
             pnode->fPauseSend = true;
-        pnode->vSendMsg.push_back(std::move(serializedHeader));
-        if (nMessageSize)
-            pnode->vSendMsg.push_back(std::move(msg.data));
+        pnode->vSendMsg.push_back(std::move(msg));
 
         // If write queue empty, attempt "optimistic write"
         if (optimisticSend == true)
             nBytesSent = SocketSendData(pnode);
+
+        // LitecoinCash: SocketEvents: With epoll the socket handler only sends for peers it's told about
+        if (socketEventsMode == SocketEventsMode::Epoll && !pnode->vSendMsg.empty()) {
+            LOCK(cs_setSendPending);
+            fWakeSocketHandler = setSendPending.insert(pnode).second;
+        }
     }
+    if (fWakeSocketHandler)
+        WakeSocketHandler();
     if (nBytesSent)
         RecordBytesSent(nBytesSent);
 }
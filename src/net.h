@@ -22,6 +22,7 @@
 #include <uint256.h>
 #include <threadinterrupt.h>
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <stdint.h>
@@ -83,6 +84,24 @@ static const bool DEFAULT_BLOCKSONLY = false;
 static const bool DEFAULT_FORCEDNSSEED = false;
 static const size_t DEFAULT_MAXRECEIVEBUFFER = 5 * 1000;
 static const size_t DEFAULT_MAXSENDBUFFER    = 1 * 1000;
+/** LitecoinCash: MsgHandler: Default and maximum number of threads handling peer messages */
+static const int DEFAULT_MSGHANDLER_THREADS = 4;
+static const int MAX_MSGHANDLER_THREADS = 16;
+
+/** LitecoinCash: SocketEvents: How the socket handler waits for activity on the sockets */
+enum class SocketEventsMode {
+    Select,
+    Epoll,
+};
+/** -socketevents default */
+#ifdef USE_EPOLL
+static const SocketEventsMode DEFAULT_SOCKETEVENTS = SocketEventsMode::Epoll;
+#else
+static const SocketEventsMode DEFAULT_SOCKETEVENTS = SocketEventsMode::Select;
+#endif
+/** Fails for unknown modes, and for those this platform doesn't have */
+bool SocketEventsModeFromString(const std::string& str, SocketEventsMode& mode);
+std::string SocketEventsModeToString(SocketEventsMode mode);
 
 // NOTE: When adjusting this, update rpcnet:setban's help ("24h")
 static const unsigned int DEFAULT_MISBEHAVING_BANTIME = 60 * 60 * 24;  // Default 24-hour ban
@@ -113,6 +132,36 @@ struct CSerializedNetMsg
     std::string command;
 };
 
+/**
+ * LitecoinCash: NetBuffers: A message as it goes on the wire. The payload is shared rather than owned, so one
+ * message can be queued to many peers, or point into a memory mapped block file, without being copied. The
+ * header, checksum included, is built once.
+ */
+struct CSharedNetMsg
+{
+    explicit CSharedNetMsg(CSerializedNetMsg&& msg);
+    CSharedNetMsg(const std::string& commandIn, std::shared_ptr<const unsigned char> dataIn, size_t nDataSizeIn);
+
+    std::string command;
+    std::array<unsigned char, CMessageHeader::HEADER_SIZE> header;
+    std::shared_ptr<const unsigned char> data;
+    size_t nDataSize;
+
+    size_t size() const { return header.size() + nDataSize; }
+};
+
+/** LitecoinCash: NetBuffers: Counters since startup for how network data moves between sockets and buffers */
+struct NetBufferStats {
+    uint64_t nSendCalls = 0;        //!< Calls that handed data to a socket
+    uint64_t nMessagesSent = 0;     //!< Messages fully handed over
+    uint64_t nRecvCalls = 0;        //!< Calls that read data from a socket
+    uint64_t nRecvDirectBytes = 0;  //!< Bytes read straight into a message's buffer, without a copy
+    uint64_t nPoolHits = 0;         //!< Messages received into a reused buffer
+    uint64_t nPoolMisses = 0;       //!< Messages that needed a buffer of their own
+    size_t nPoolBuffers = 0;        //!< Buffers waiting to be reused
+    size_t nPoolBytes = 0;          //!< Memory held by those buffers
+};
+
 class NetEventsInterface;
 class CConnman
 {
@@ -145,6 +194,8 @@ public:
         bool m_use_addrman_outgoing = true;
         std::vector<std::string> m_specified_outgoing;
         std::vector<std::string> m_added_nodes;
+        SocketEventsMode socketEventsMode = SocketEventsMode::Select;  // LitecoinCash: SocketEvents
+        int nMsgHandlerThreads = 1;     // LitecoinCash: MsgHandler
     };
 
     void Init(const Options& connOptions) {
@@ -158,6 +209,8 @@ public:
         m_msgproc = connOptions.m_msgproc;
         nSendBufferMaxSize = connOptions.nSendBufferMaxSize;
         nReceiveFloodSize = connOptions.nReceiveFloodSize;
+        socketEventsMode = connOptions.socketEventsMode;
+        nMsgHandlerThreads = std::max(1, std::min(connOptions.nMsgHandlerThreads, MAX_MSGHANDLER_THREADS));
         {
             LOCK(cs_totalBytesSent);
             nMaxOutboundTimeframe = connOptions.nMaxOutboundTimeframe;
@@ -183,6 +236,8 @@ public:
     bool ForNode(NodeId id, std::function<bool(CNode* pnode)> func);
 
     void PushMessage(CNode* pnode, CSerializedNetMsg&& msg);
+    /** LitecoinCash: NetBuffers: Queue a message whose payload may also be queued to other peers */
+    void PushMessage(CNode* pnode, CSharedNetMsg msg);
 
     template<typename Callable>
     void ForEachNode(Callable&& func)
@@ -304,6 +359,7 @@ public:
 
     uint64_t GetTotalBytesRecv();
     uint64_t GetTotalBytesSent();
+    NetBufferStats GetNetBufferStats() const;
 
     void SetBestHeight(int height);
     int GetBestHeight() const;
@@ -314,6 +370,11 @@ public:
     unsigned int GetReceiveFloodSize() const;
 
     void WakeMessageHandler();
+
+    /** LitecoinCash: SocketEvents: Have the socket handler look at the sockets again without waiting */
+    void WakeSocketHandler();
+    SocketEventsMode GetSocketEventsMode() const { return socketEventsMode; }
+    int GetMsgHandlerThreads() const { return nMsgHandlerThreads; }
 private:
     struct ListenSocket {
         SOCKET socket;
@@ -329,8 +390,20 @@ private:
     void AddOneShot(const std::string& strDest);
     void ProcessOneShot();
     void ThreadOpenConnections(std::vector<std::string> connect);
-    void ThreadMessageHandler();
+    void ThreadMessageHandler(int nWorker);
     void AcceptConnection(const ListenSocket& hListenSocket);
+    void DisconnectNodes();
+    void NotifyNumConnectionsChanged();
+    void InactivityCheck(CNode *pnode);
+    /** Returns whether the socket may have more to read */
+    bool SocketRecvData(CNode *pnode);
+    void SocketHandlerSelect();
+#ifdef USE_EPOLL
+    bool InitSocketEvents();
+    void SocketHandlerEpoll();
+#endif
+    void RegisterSocketEvents(CNode* pnode);
+    void ForgetSocketEvents(CNode* pnode);
     void ThreadSocketHandler();
     void ThreadDNSAddressSeed();
 
@@ -349,7 +422,7 @@ private:
 
     NodeId GetNewNodeId();
 
-    size_t SocketSendData(CNode *pnode) const;
+    size_t SocketSendData(CNode *pnode);
     //!check is the banlist has unwritten changes
     bool BannedSetIsDirty();
     //!set the "dirty" flag for the banlist
@@ -379,6 +452,12 @@ private:
     uint64_t nMaxOutboundLimit GUARDED_BY(cs_totalBytesSent);
     uint64_t nMaxOutboundTimeframe GUARDED_BY(cs_totalBytesSent);
 
+    // LitecoinCash: NetBuffers: Socket calls, to see how well sends and receives are batched
+    std::atomic<uint64_t> nSendCalls{0};
+    std::atomic<uint64_t> nMessagesSent{0};
+    std::atomic<uint64_t> nRecvCalls{0};
+    std::atomic<uint64_t> nRecvDirectBytes{0};
+
     // Whitelisted ranges. Any node connecting from these is automatically
     // whitelisted (as well as those connecting to whitelisted binds).
     std::vector<CSubNet> vWhitelistedRange;
@@ -401,6 +480,19 @@ private:
     std::list<CNode*> vNodesDisconnected;
     mutable CCriticalSection cs_vNodes;
     std::atomic<NodeId> nLastNodeId;
+    unsigned int nPrevNodeCount = 0;
+
+    // LitecoinCash: SocketEvents: With epoll, only sockets something happened on are looked at
+    SocketEventsMode socketEventsMode;
+#ifdef USE_EPOLL
+    int epollfd = -1;
+    int wakeupPipe[2] = {-1, -1};
+#endif
+    std::set<CNode*> setRecvReady;          //!< Peers that may have more to read (socket handler only)
+    std::set<CNode*> setSendBlocked;        //!< Peers whose sends are waiting for room (socket handler only)
+    CCriticalSection cs_setSendPending;
+    std::set<CNode*> setSendPending GUARDED_BY(cs_setSendPending); //!< Peers with sends queued for the socket handler
+    int64_t nLastInactivityCheck = 0;
 
     /** Services this instance offers */
     ServiceFlags nLocalServices;
@@ -414,6 +506,7 @@ private:
     std::atomic<int> nBestHeight;
     CClientUIInterface* clientInterface;
     NetEventsInterface* m_msgproc;
+    int nMsgHandlerThreads;
 
     /** SipHasher seeds for deterministic randomness */
     const uint64_t nSeed0, nSeed1;
@@ -431,7 +524,7 @@ private:
     std::thread threadSocketHandler;
     std::thread threadOpenAddedConnections;
     std::thread threadOpenConnections;
-    std::thread threadMessageHandler;
+    std::vector<std::thread> vThreadMessageHandler;   // LitecoinCash: MsgHandler
 
     /** flag for deciding to connect to an extra outbound peer,
      *  in excess of nMaxOutbound
@@ -553,6 +646,37 @@ public:
 
 
 
+/** LitecoinCash: NetBuffers: At most this many received message buffers are kept for reuse */
+static const size_t MAX_NET_BUFFER_POOL_SIZE = 64;
+/** LitecoinCash: NetBuffers: Nor do they hold more memory than this between them */
+static const size_t MAX_NET_BUFFER_POOL_BYTES = 16 * 1024 * 1024;
+
+/**
+ * LitecoinCash: NetBuffers: The buffers of received messages, kept once the messages have been processed, so the
+ * next ones can be received into them instead of into fresh allocations.
+ */
+class CNetBufferPool
+{
+private:
+    mutable CCriticalSection cs;
+    std::vector<CNetSerializeData> vBuffers;
+    size_t nBytes;
+    uint64_t nHits;
+    uint64_t nMisses;
+
+public:
+    CNetBufferPool() : nBytes(0), nHits(0), nMisses(0) {}
+
+    /** Take the smallest empty buffer that can hold nSize bytes, or an unallocated one if there is none. */
+    CNetSerializeData Get(size_t nSize);
+    /** Give a buffer back for reuse. It is freed instead if the pool is full. */
+    void Put(CNetSerializeData&& buffer);
+    void GetStats(NetBufferStats& stats) const;
+};
+
+/** LitecoinCash: NetBuffers: Buffers for messages received from any peer */
+extern CNetBufferPool netBufferPool;
+
 class CNetMessage {
 private:
     mutable CHash256 hasher;
@@ -560,11 +684,11 @@ private:
 public:
     bool in_data;                   // parsing header (false) or data (true)
 
-    CDataStream hdrbuf;             // partially received header
+    CNetDataStream hdrbuf;          // partially received header
     CMessageHeader hdr;             // complete header
     unsigned int nHdrPos;
 
-    CDataStream vRecv;              // received message data
+    CNetDataStream vRecv;           // received message data
     unsigned int nDataPos;
 
     int64_t nTime;                  // time (in microseconds) of message receipt.
@@ -577,6 +701,12 @@ public:
         nTime = 0;
     }
 
+    // LitecoinCash: NetBuffers: The data buffer goes back to the pool when done with, so messages move but don't copy
+    CNetMessage(CNetMessage&&) = default;
+    CNetMessage(const CNetMessage&) = delete;
+    CNetMessage& operator=(const CNetMessage&) = delete;
+    ~CNetMessage();
+
     bool complete() const
     {
         if (!in_data)
@@ -594,6 +724,9 @@ public:
 
     int readHeader(const char *pch, unsigned int nBytes);
     int readData(const char *pch, unsigned int nBytes);
+
+    /** LitecoinCash: NetBuffers: Where the next nSpace bytes of data can be received straight into, or nullptr while the header is incomplete */
+    char* GetDataBuffer(size_t& nSpace);
 };
 
 
@@ -608,7 +741,7 @@ public:
     size_t nSendSize; // total size of all vSendMsg entries
     size_t nSendOffset; // offset inside the first vSendMsg already sent
     uint64_t nSendBytes;
-    std::deque<std::vector<unsigned char>> vSendMsg;
+    std::deque<CSharedNetMsg> vSendMsg;
     CCriticalSection cs_vSend;
     CCriticalSection cs_hSocket;
     CCriticalSection cs_vRecv;
@@ -618,6 +751,8 @@ public:
     size_t nProcessQueueSize;
 
     CCriticalSection cs_sendProcessing;
+    // LitecoinCash: MsgHandler: Set while a message handler thread works on this peer, so its messages stay in order
+    std::atomic_bool fMsgProcClaimed;
 
     std::deque<CInv> vRecvGetData;
     uint64_t nRecvBytes;
@@ -670,8 +805,10 @@ public:
     std::atomic<int> nStartingHeight;
 
     // flood relay
-    std::vector<CAddress> vAddrToSend;
-    CRollingBloomFilter addrKnown;
+    // LitecoinCash: MsgHandler: Other peers' message handlers relay addresses to this one
+    CCriticalSection cs_addrSend;
+    std::vector<CAddress> vAddrToSend GUARDED_BY(cs_addrSend);
+    CRollingBloomFilter addrKnown GUARDED_BY(cs_addrSend);
     bool fGetAddr;
     std::set<uint256> setKnown;
     int64_t nNextAddrSend;
@@ -763,6 +900,8 @@ public:
     }
 
     bool ReceiveMsgBytes(const char *pch, unsigned int nBytes, bool& complete);
+    /** LitecoinCash: NetBuffers: Where the message being received can take data straight from the socket, if anywhere */
+    char* GetRecvBuffer(size_t& nSpace);
 
     void SetRecvVersion(int nVersionIn)
     {
@@ -794,6 +933,7 @@ public:
 
     void AddAddressKnown(const CAddress& _addr)
     {
+        LOCK(cs_addrSend);
         addrKnown.insert(_addr.GetKey());
     }
 
@@ -802,6 +942,7 @@ public:
         // Known checking here is only to save space from duplicates.
         // SendMessages will filter it again for knowns that were added
         // after addresses were pushed.
+        LOCK(cs_addrSend);
         if (_addr.IsValid() && !addrKnown.contains(_addr.GetKey())) {
             if (vAddrToSend.size() >= MAX_ADDR_TO_SEND) {
                 vAddrToSend[insecure_rand.randrange(vAddrToSend.size())] = _addr;
@@ -30,6 +30,9 @@
 #include <utilmoneystr.h>
 #include <utilstrencodings.h>
 #include <rialto.h> // LitecoinCash: Rialto
+#include <blockcache.h> // LitecoinCash: BlockCache
+#include <blockfilter.h> // LitecoinCash: BlockFilterIndex
+#include <index/blockfilterindex.h>
 
 #if defined(NDEBUG)
 # error "LitecoinCash cannot be compiled without assertions."
@@ -845,6 +848,40 @@ void PeerLogicValidation::BlockConnected(const std::shared_ptr<const CBlock>& pb
     }
 
     g_last_tip_update = GetTime();
+
+    // LitecoinCash: BlockCache: Peers following the tip are about to ask for this block
+    if (serializedBlockCache.IsEnabled() && !IsInitialBlockDownload())
+        serializedBlockCache.Insert(*pblock, true);
+}
+
+// LitecoinCash: BloomBatch: Light clients following the tip ask for filtered versions of the same few blocks, so their
+// prepared data elements are kept for the most recently asked for ones. Preparing a block costs about as much as
+// matching it directly, so it only pays off from the second request on: a block is prepared when it's asked for again,
+// and only near the tip, so a client rescanning older blocks has each of them matched directly.
+static const size_t MAX_BLOOM_ELEMENTS_CACHE = 8;
+static const int MAX_BLOOM_ELEMENTS_DEPTH = 6;
+/** Null for blocks asked for once, and not prepared yet */
+static std::list<std::pair<uint256, std::shared_ptr<const CBloomBlockElements>>> listBloomElementsCache GUARDED_BY(cs_main);
+
+/** The prepared data elements of a block, or null if it should be matched directly */
+static std::shared_ptr<const CBloomBlockElements> GetBloomBlockElements(const CBlockIndex* pindex, const CBlock& block)
+{
+    AssertLockHeld(cs_main);
+    if (!chainActive.Contains(pindex) || pindex->nHeight < chainActive.Height() - MAX_BLOOM_ELEMENTS_DEPTH)
+        return nullptr;
+    const uint256 hash = pindex->GetBlockHash();
+    for (auto it = listBloomElementsCache.begin(); it != listBloomElementsCache.end(); ++it) {
+        if (it->first == hash) {
+            listBloomElementsCache.splice(listBloomElementsCache.begin(), listBloomElementsCache, it);
+            if (!it->second)
+                it->second = std::make_shared<const CBloomBlockElements>(block);
+            return it->second;
+        }
+    }
+    listBloomElementsCache.emplace_front(hash, nullptr);
+    if (listBloomElementsCache.size() > MAX_BLOOM_ELEMENTS_CACHE)
+        listBloomElementsCache.pop_back();
+    return nullptr;
 }
 
 // All of the following cache a recent block, and are protected by cs_most_recent_block
@@ -876,8 +913,9 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex *pindex, const std:
         fWitnessesPresentInMostRecentCompactBlock = fWitnessEnabled;
     }
 
-    connman->ForEachNode([this, &pcmpctblock, pindex, &msgMaker, fWitnessEnabled, &hashBlock](CNode* pnode) {
-        // TODO: Avoid the repeated-serialization here
+    // LitecoinCash: NetBuffers: Serialized when the first peer needs it, then shared with the others
+    std::unique_ptr<CSharedNetMsg> pmsgCmpctBlock;
+    connman->ForEachNode([this, &pcmpctblock, pindex, &msgMaker, fWitnessEnabled, &hashBlock, &pmsgCmpctBlock](CNode* pnode) {
         if (pnode->nVersion < INVALID_CB_NO_BAN_VERSION || pnode->fDisconnect)
             return;
         ProcessBlockAvailability(pnode->GetId());
@@ -889,7 +927,9 @@ void PeerLogicValidation::NewPoWValidBlock(const CBlockIndex *pindex, const std:
 
             LogPrint(BCLog::NET, "%s sending header-and-ids %s to peer=%d\n", "PeerLogicValidation::NewPoWValidBlock",
                     hashBlock.ToString(), pnode->GetId());
-            connman->PushMessage(pnode, msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock));
+            if (!pmsgCmpctBlock)
+                pmsgCmpctBlock.reset(new CSharedNetMsg(msgMaker.Make(NetMsgType::CMPCTBLOCK, *pcmpctblock)));
+            connman->PushMessage(pnode, *pmsgCmpctBlock);
             state.pindexBestHeaderSent = pindex;
         }
     });
@@ -1147,8 +1187,18 @@ void static ProcessGetBlockData(CNode* pfrom, const Consensus::Params& consensus
     if (send && (mi->second->nStatus & BLOCK_HAVE_DATA))
     {
         std::shared_ptr<const CBlock> pblock;
-        if (a_recent_block && a_recent_block->GetHash() == (*mi).second->GetBlockHash()) {
+        CRawBlock rawBlock;
+        // LitecoinCash: BlockCache: Full blocks are sent as serialized bytes, from the cache if they're there
+        const bool fFullBlock = inv.type == MSG_BLOCK || inv.type == MSG_WITNESS_BLOCK;
+        const bool fWitness = inv.type == MSG_WITNESS_BLOCK;
+        if (fFullBlock && serializedBlockCache.Get(inv.hash, fWitness, rawBlock)) {
+            // Nothing to read
+        } else if (a_recent_block && a_recent_block->GetHash() == (*mi).second->GetBlockHash()) {
             pblock = a_recent_block;
+        } else if (fWitness && ReadRawBlockFromDisk(rawBlock, (*mi).second, Params().MessageStart())) {
+            // LitecoinCash: MappedBlocks: A witness block goes over the wire the way it's stored, so send the stored bytes
+            // The cache keeps the stored bytes (and with them the mapping) rather than a copy
+            serializedBlockCache.Insert(inv.hash, true, rawBlock);
         } else {
             // Send block from disk
             std::shared_ptr<CBlock> pblockRead = std::make_shared<CBlock>();
@@ -1156,10 +1206,11 @@ void static ProcessGetBlockData(CNode* pfrom, const Consensus::Params& consensus
                 assert(!"cannot load block from disk");
             pblock = pblockRead;
         }
-        if (inv.type == MSG_BLOCK)
-            connman->PushMessage(pfrom, msgMaker.Make(SERIALIZE_TRANSACTION_NO_WITNESS, NetMsgType::BLOCK, *pblock));
-        else if (inv.type == MSG_WITNESS_BLOCK)
-            connman->PushMessage(pfrom, msgMaker.Make(NetMsgType::BLOCK, *pblock));
+        if (fFullBlock && pblock)
+            rawBlock = serializedBlockCache.Insert(*pblock, fWitness);
+        // LitecoinCash: NetBuffers: The serialized block goes out as it is, without a copy into the message
+        if (fFullBlock)
+            connman->PushMessage(pfrom, CSharedNetMsg(NetMsgType::BLOCK, rawBlock.shared_data(), rawBlock.size()));
         else if (inv.type == MSG_FILTERED_BLOCK)
         {
             bool sendMerkleBlock = false;
@@ -1168,7 +1219,11 @@ void static ProcessGetBlockData(CNode* pfrom, const Consensus::Params& consensus
                 LOCK(pfrom->cs_filter);
                 if (pfrom->pfilter) {
                     sendMerkleBlock = true;
-                    merkleBlock = CMerkleBlock(*pblock, *pfrom->pfilter);
+                    std::shared_ptr<const CBloomBlockElements> elements = GetBloomBlockElements(mi->second, *pblock);
+                    if (elements)
+                        merkleBlock = CMerkleBlock(*pblock, *pfrom->pfilter, *elements);
+                    else
+                        merkleBlock = CMerkleBlock(*pblock, *pfrom->pfilter);
                 }
             }
             if (sendMerkleBlock) {
@@ -1543,7 +1598,229 @@ bool static ProcessHeadersMessage(CNode *pfrom, CConnman *connman, const std::ve
     return true;
 }
 
-bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStream& vRecv, int64_t nTimeReceived, const CChainParams& chainparams, CConnman* connman, const std::atomic<bool>& interruptMsgProc)
+/** LitecoinCash: BlockFilterIndex: Maximum number of compact filters that may be requested with one getcfilters. See BIP 157. */
+static constexpr uint32_t MAX_GETCFILTERS_SIZE = 1000;
+/** LitecoinCash: BlockFilterIndex: Maximum number of cf hashes that may be requested with one getcfheaders. See BIP 157. */
+static constexpr uint32_t MAX_GETCFHEADERS_SIZE = 2000;
+
+/**
+ * LitecoinCash: BlockFilterIndex: Validation logic for compact filters request handling.
+ *
+ * May disconnect from the peer in the case of a bad request.
+ *
+ * @param[in]   pfrom           The peer that we received the request from
+ * @param[in]   chain_params    Chain parameters
+ * @param[in]   filter_type     The filter type the request is for. Must be basic filters.
+ * @param[in]   start_height    The start height for the request
+ * @param[in]   stop_hash       The stop_hash for the request
+ * @param[in]   max_height_diff The maximum number of items permitted to request, as specified in BIP 157
+ * @param[out]  stop_index      The CBlockIndex for the stop_hash block, if the request can be serviced.
+ * @param[out]  filter_index    The filter index, if the request can be serviced.
+ * @return                      True if the request can be serviced.
+ */
+static bool PrepareBlockFilterRequest(CNode* pfrom, const CChainParams& chain_params,
+                                      BlockFilterType filter_type, uint32_t start_height,
+                                      const uint256& stop_hash, uint32_t max_height_diff,
+                                      const CBlockIndex*& stop_index,
+                                      BlockFilterIndex*& filter_index)
+{
+    const bool supported_filter_type =
+        (filter_type == BlockFilterType::BASIC &&
+         (pfrom->GetLocalServices() & NODE_COMPACT_FILTERS));
+    if (!supported_filter_type) {
+        LogPrint(BCLog::NET, "peer %d requested unsupported block filter type: %d\n",
+                 pfrom->GetId(), static_cast<uint8_t>(filter_type));
+        pfrom->fDisconnect = true;
+        return false;
+    }
+
+    {
+        LOCK(cs_main);
+        BlockMap::const_iterator it = mapBlockIndex.find(stop_hash);
+        stop_index = it == mapBlockIndex.end() ? nullptr : it->second;
+
+        // Check that the stop block exists and the peer would be allowed to fetch it.
+        if (!stop_index || !BlockRequestAllowed(stop_index, chain_params.GetConsensus())) {
+            LogPrint(BCLog::NET, "peer %d requested invalid block hash: %s\n",
+                     pfrom->GetId(), stop_hash.ToString());
+            pfrom->fDisconnect = true;
+            return false;
+        }
+    }
+
+    uint32_t stop_height = stop_index->nHeight;
+    if (start_height > stop_height) {
+        LogPrint(BCLog::NET, "peer %d sent invalid getcfilters/getcfheaders with " /* Continued */
+                 "start height %d and stop height %d\n",
+                 pfrom->GetId(), start_height, stop_height);
+        pfrom->fDisconnect = true;
+        return false;
+    }
+    if (stop_height - start_height >= max_height_diff) {
+        LogPrint(BCLog::NET, "peer %d requested too many cfilters/cfheaders: %d / %d\n",
+                 pfrom->GetId(), stop_height - start_height + 1, max_height_diff);
+        pfrom->fDisconnect = true;
+        return false;
+    }
+
+    filter_index = GetBlockFilterIndex(filter_type);
+    if (!filter_index) {
+        LogPrint(BCLog::NET, "Filter index for supported type %s not found\n", BlockFilterTypeName(filter_type));
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * LitecoinCash: BlockFilterIndex: Handle a cfilters request.
+ *
+ * May disconnect from the peer in the case of a bad request.
+ *
+ * @param[in]   pfrom           The peer that we received the request from
+ * @param[in]   vRecv           The raw message received
+ * @param[in]   chain_params    Chain parameters
+ * @param[in]   connman         Pointer to the connection manager
+ */
+static void ProcessGetCFilters(CNode* pfrom, CNetDataStream& vRecv, const CChainParams& chain_params,
+                               CConnman* connman)
+{
+    uint8_t filter_type_ser;
+    uint32_t start_height;
+    uint256 stop_hash;
+
+    vRecv >> filter_type_ser >> start_height >> stop_hash;
+
+    const BlockFilterType filter_type = static_cast<BlockFilterType>(filter_type_ser);
+
+    const CBlockIndex* stop_index;
+    BlockFilterIndex* filter_index;
+    if (!PrepareBlockFilterRequest(pfrom, chain_params, filter_type, start_height, stop_hash,
+                                   MAX_GETCFILTERS_SIZE, stop_index, filter_index)) {
+        return;
+    }
+
+    std::vector<BlockFilter> filters;
+    if (!filter_index->LookupFilterRange(start_height, stop_index, filters)) {
+        LogPrint(BCLog::NET, "Failed to find block filter in index: filter_type=%s, start_height=%d, stop_hash=%s\n",
+                     BlockFilterTypeName(filter_type), start_height, stop_hash.ToString());
+        return;
+    }
+
+    for (const auto& filter : filters) {
+        CSerializedNetMsg msg = CNetMsgMaker(pfrom->GetSendVersion())
+            .Make(NetMsgType::CFILTER, filter);
+        connman->PushMessage(pfrom, std::move(msg));
+    }
+}
+
+/**
+ * LitecoinCash: BlockFilterIndex: Handle a cfheaders request.
+ *
+ * May disconnect from the peer in the case of a bad request.
+ *
+ * @param[in]   pfrom           The peer that we received the request from
+ * @param[in]   vRecv           The raw message received
+ * @param[in]   chain_params    Chain parameters
+ * @param[in]   connman         Pointer to the connection manager
+ */
+static void ProcessGetCFHeaders(CNode* pfrom, CNetDataStream& vRecv, const CChainParams& chain_params,
+                                CConnman* connman)
+{
+    uint8_t filter_type_ser;
+    uint32_t start_height;
+    uint256 stop_hash;
+
+    vRecv >> filter_type_ser >> start_height >> stop_hash;
+
+    const BlockFilterType filter_type = static_cast<BlockFilterType>(filter_type_ser);
+
+    const CBlockIndex* stop_index;
+    BlockFilterIndex* filter_index;
+    if (!PrepareBlockFilterRequest(pfrom, chain_params, filter_type, start_height, stop_hash,
+                                   MAX_GETCFHEADERS_SIZE, stop_index, filter_index)) {
+        return;
+    }
+
+    uint256 prev_header;
+    if (start_height > 0) {
+        const CBlockIndex* const prev_block =
+            stop_index->GetAncestor(static_cast<int>(start_height - 1));
+        if (!filter_index->LookupFilterHeader(prev_block, prev_header)) {
+            LogPrint(BCLog::NET, "Failed to find block filter header in index: filter_type=%s, block_hash=%s\n",
+                         BlockFilterTypeName(filter_type), prev_block->GetBlockHash().ToString());
+            return;
+        }
+    }
+
+    std::vector<uint256> filter_hashes;
+    if (!filter_index->LookupFilterHashRange(start_height, stop_index, filter_hashes)) {
+        LogPrint(BCLog::NET, "Failed to find block filter hashes in index: filter_type=%s, start_height=%d, stop_hash=%s\n",
+                     BlockFilterTypeName(filter_type), start_height, stop_hash.ToString());
+        return;
+    }
+
+    CSerializedNetMsg msg = CNetMsgMaker(pfrom->GetSendVersion())
+        .Make(NetMsgType::CFHEADERS,
+              filter_type_ser,
+              stop_index->GetBlockHash(),
+              prev_header,
+              filter_hashes);
+    connman->PushMessage(pfrom, std::move(msg));
+}
+
+/**
+ * LitecoinCash: BlockFilterIndex: Handle a getcfcheckpt request.
+ *
+ * May disconnect from the peer in the case of a bad request.
+ *
+ * @param[in]   pfrom           The peer that we received the request from
+ * @param[in]   vRecv           The raw message received
+ * @param[in]   chain_params    Chain parameters
+ * @param[in]   connman         Pointer to the connection manager
+ */
+static void ProcessGetCFCheckPt(CNode* pfrom, CNetDataStream& vRecv, const CChainParams& chain_params,
+                                CConnman* connman)
+{
+    uint8_t filter_type_ser;
+    uint256 stop_hash;
+
+    vRecv >> filter_type_ser >> stop_hash;
+
+    const BlockFilterType filter_type = static_cast<BlockFilterType>(filter_type_ser);
+
+    const CBlockIndex* stop_index;
+    BlockFilterIndex* filter_index;
+    if (!PrepareBlockFilterRequest(pfrom, chain_params, filter_type, /*start_height=*/0, stop_hash,
+                                   /*max_height_diff=*/std::numeric_limits<uint32_t>::max(),
+                                   stop_index, filter_index)) {
+        return;
+    }
+
+    std::vector<uint256> headers(stop_index->nHeight / CFCHECKPT_INTERVAL);
+
+    // Populate headers.
+    const CBlockIndex* block_index = stop_index;
+    for (int i = headers.size() - 1; i >= 0; i--) {
+        int height = (i + 1) * CFCHECKPT_INTERVAL;
+        block_index = block_index->GetAncestor(height);
+
+        if (!filter_index->LookupFilterHeader(block_index, headers[i])) {
+            LogPrint(BCLog::NET, "Failed to find block filter header in index: filter_type=%s, block_hash=%s\n",
+                         BlockFilterTypeName(filter_type), block_index->GetBlockHash().ToString());
+            return;
+        }
+    }
+
+    CSerializedNetMsg msg = CNetMsgMaker(pfrom->GetSendVersion())
+        .Make(NetMsgType::CFCHECKPT,
+              filter_type_ser,
+              stop_index->GetBlockHash(),
+              headers);
+    connman->PushMessage(pfrom, std::move(msg));
+}
+
+bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CNetDataStream& vRecv, int64_t nTimeReceived, const CChainParams& chainparams, CConnman* connman, const std::atomic<bool>& interruptMsgProc)
 {
     LogPrint(BCLog::NET, "received: %s (%u bytes) peer=%d\n", SanitizeString(strCommand), vRecv.size(), pfrom->GetId());
     if (gArgs.IsArgSet("-dropmessagestest") && GetRand(gArgs.GetArg("-dropmessagestest", 0)) == 0)
@@ -2397,7 +2674,7 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         // dummy (empty) BLOCKTXN message, to re-use the logic there in
         // completing processing of the putative block (without cs_main).
         bool fProcessBLOCKTXN = false;
-        CDataStream blockTxnMsg(SER_NETWORK, PROTOCOL_VERSION);
+        CNetDataStream blockTxnMsg(SER_NETWORK, PROTOCOL_VERSION);
 
         // If we end up treating this as a plain headers message, call that as well
         // without cs_main.
@@ -2727,7 +3004,10 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         }
         pfrom->fSentAddr = true;
 
-        pfrom->vAddrToSend.clear();
+        {
+            LOCK(pfrom->cs_addrSend);
+            pfrom->vAddrToSend.clear();
+        }
         std::vector<CAddress> vAddr = connman->GetAddresses();
         FastRandomContext insecure_rand;
         for (const CAddress &addr : vAddr)
@@ -2912,6 +3192,7 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         // Check if Rialto enabled on this node
         if ((g_connman->GetLocalServices() & NODE_RIALTO) != NODE_RIALTO) {
             LogPrintf("Rialto: Message received from peer=%d, but Rialto is not enabled on this node. Punishing peer.\n", pfrom->GetId());
+            LOCK(cs_main);
             Misbehaving(pfrom->GetId(), 20);
             return true;
         }
@@ -2923,6 +3204,7 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         std::string err;
         if (!RialtoParseLayer3Envelope(strMsg, err)) {
             LogPrintf("Rialto: Invalid message received from peer=%d; punishing. Error: %s\n", pfrom->GetId(), err);
+            LOCK(cs_main);
             Misbehaving(pfrom->GetId(), 20);
             return true;
         }
@@ -2938,6 +3220,19 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
         RelayRialtoMessage(message, connman, pfrom);
     }
 
+    // LitecoinCash: BlockFilterIndex
+    else if (strCommand == NetMsgType::GETCFILTERS) {
+        ProcessGetCFilters(pfrom, vRecv, chainparams, connman);
+    }
+
+    else if (strCommand == NetMsgType::GETCFHEADERS) {
+        ProcessGetCFHeaders(pfrom, vRecv, chainparams, connman);
+    }
+
+    else if (strCommand == NetMsgType::GETCFCHECKPT) {
+        ProcessGetCFCheckPt(pfrom, vRecv, chainparams, connman);
+    }
+
     else {
         // Ignore unknown commands for extensibility
         LogPrint(BCLog::NET, "Unknown command \"%s\" from peer=%d\n", SanitizeString(strCommand), pfrom->GetId());
@@ -2948,6 +3243,56 @@ bool static ProcessMessage(CNode* pfrom, const std::string& strCommand, CDataStr
     return true;
 }
 
+bool MessageNeedsChainstate(const std::string& strCommand)
+{
+    // LitecoinCash: MsgHandler: These only touch the peer and network state, or lock cs_main briefly themselves
+    static const std::set<std::string> setNoChainstate = {
+        NetMsgType::REJECT, NetMsgType::ADDR, NetMsgType::GETADDR, NetMsgType::MEMPOOL, NetMsgType::PING,
+        NetMsgType::PONG, NetMsgType::FILTERLOAD, NetMsgType::FILTERADD, NetMsgType::FILTERCLEAR,
+        NetMsgType::FEEFILTER, NetMsgType::NOTFOUND, NetMsgType::RIALTO,
+        NetMsgType::GETCFILTERS, NetMsgType::GETCFHEADERS, NetMsgType::GETCFCHECKPT,
+    };
+    return !setNoChainstate.count(strCommand);
+}
+
+namespace {
+
+// LitecoinCash: MsgHandler: Keyed by the known message types, so junk commands can't grow the map
+const std::string MSG_PROCESSING_COMMAND_OTHER = "*other*";
+CCriticalSection cs_msg_processing_stats;
+std::map<std::string, MessageProcessingStats> mapMsgProcessingStats GUARDED_BY(cs_msg_processing_stats);
+
+void RecordMessageProcessing(const std::string& strCommand, int64_t nWaitMicros, int64_t nProcessMicros)
+{
+    LOCK(cs_msg_processing_stats);
+    if (mapMsgProcessingStats.empty()) {
+        for (const std::string& msg : getAllNetMessageTypes())
+            mapMsgProcessingStats[msg];
+        mapMsgProcessingStats[MSG_PROCESSING_COMMAND_OTHER];
+    }
+    auto it = mapMsgProcessingStats.find(strCommand);
+    if (it == mapMsgProcessingStats.end())
+        it = mapMsgProcessingStats.find(MSG_PROCESSING_COMMAND_OTHER);
+    MessageProcessingStats& stats = it->second;
+    stats.nCount++;
+    stats.nWaitMicros += std::max<int64_t>(0, nWaitMicros);
+    stats.nProcessMicros += nProcessMicros;
+    stats.nMaxProcessMicros = std::max(stats.nMaxProcessMicros, nProcessMicros);
+}
+
+} // namespace
+
+std::map<std::string, MessageProcessingStats> GetMessageProcessingStats()
+{
+    LOCK(cs_msg_processing_stats);
+    std::map<std::string, MessageProcessingStats> mapStats;
+    for (const auto& entry : mapMsgProcessingStats) {
+        if (entry.second.nCount)
+            mapStats.insert(entry);
+    }
+    return mapStats;
+}
+
 static bool SendRejectsAndCheckIfBanned(CNode* pnode, CConnman* connman)
 {
     AssertLockHeld(cs_main);
@@ -3012,7 +3357,11 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
         // Just take one message
         msgs.splice(msgs.begin(), pfrom->vProcessMsg, pfrom->vProcessMsg.begin());
         pfrom->nProcessQueueSize -= msgs.front().vRecv.size() + CMessageHeader::HEADER_SIZE;
+        bool fWasPaused = pfrom->fPauseRecv;
         pfrom->fPauseRecv = pfrom->nProcessQueueSize > connman->GetReceiveFloodSize();
+        // LitecoinCash: SocketEvents: Reading from the peer can go on straight away
+        if (fWasPaused && !pfrom->fPauseRecv)
+            connman->WakeSocketHandler();
         fMoreWork = !pfrom->vProcessMsg.empty();
     }
     CNetMessage& msg(msgs.front());
@@ -3038,7 +3387,7 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
     unsigned int nMessageSize = hdr.nMessageSize;
 
     // Checksum
-    CDataStream& vRecv = msg.vRecv;
+    CNetDataStream& vRecv = msg.vRecv;
     const uint256& hash = msg.GetMessageHash();
     if (memcmp(hash.begin(), hdr.pchChecksum, CMessageHeader::CHECKSUM_SIZE) != 0)
     {
@@ -3051,6 +3400,7 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
 
     // Process message
     bool fRet = false;
+    const int64_t nProcessStart = GetTimeMicros();
     try
     {
         fRet = ProcessMessage(pfrom, strCommand, vRecv, msg.nTime, chainparams, connman, interruptMsgProc);
@@ -3091,9 +3441,14 @@ bool PeerLogicValidation::ProcessMessages(CNode* pfrom, std::atomic<bool>& inter
     if (!fRet) {
         LogPrint(BCLog::NET, "%s(%s, %u bytes) FAILED peer=%d\n", __func__, SanitizeString(strCommand), nMessageSize, pfrom->GetId());
     }
+    RecordMessageProcessing(strCommand, nProcessStart - msg.nTime, GetTimeMicros() - nProcessStart);
 
-    LOCK(cs_main);
-    SendRejectsAndCheckIfBanned(pfrom, connman);
+    // LitecoinCash: MsgHandler: Other handler threads can get on with the chainstate meanwhile. Once connected,
+    // SendMessages runs right after this, and sends the rejects and bans for these instead.
+    if (MessageNeedsChainstate(strCommand) || !pfrom->fSuccessfullyConnected) {
+        LOCK(cs_main);
+        SendRejectsAndCheckIfBanned(pfrom, connman);
+    }
 
     return fMoreWork;
 }
@@ -3304,6 +3659,7 @@ bool PeerLogicValidation::SendMessages(CNode* pto, std::atomic<bool>& interruptM
         // Message: addr
         //
         if (pto->nNextAddrSend < nNow) {
+            LOCK(pto->cs_addrSend);
             pto->nNextAddrSend = PoissonNextSend(nNow, AVG_ADDRESS_BROADCAST_INTERVAL);
             std::vector<CAddress> vAddr;
             vAddr.reserve(pto->vAddrToSend.size());
@@ -79,6 +79,19 @@ struct CNodeStateStats {
 
 /** Get statistics from node state */
 bool GetNodeStateStats(NodeId nodeid, CNodeStateStats &stats);
+
+/** LitecoinCash: MsgHandler: Whether handling this message type needs cs_main, rather than only network state */
+bool MessageNeedsChainstate(const std::string& strCommand);
+
+/** LitecoinCash: MsgHandler: Timings of the messages of one type handled since startup */
+struct MessageProcessingStats {
+    uint64_t nCount = 0;                //!< Messages handled
+    int64_t nWaitMicros = 0;            //!< Total time between receiving and handling them
+    int64_t nProcessMicros = 0;         //!< Total time spent handling them
+    int64_t nMaxProcessMicros = 0;      //!< Longest time spent handling one
+};
+/** Message types that were handled at least once; unknown ones are counted as "*other*" */
+std::map<std::string, MessageProcessingStats> GetMessageProcessingStats();
 /** Increase a node's misbehavior score. */
 void Misbehaving(NodeId nodeid, int howmuch);
 
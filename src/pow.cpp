@@ -554,10 +554,16 @@ bool CheckHiveProof(const CBlock* pblock, const Consensus::Params& consensusPara
     // Get height (a CBlockIndex isn't always available when this func is called, eg in reads from disk)
     int blockHeight;
     CBlockIndex* pindexPrev;
+    bool fAssumeValid = false;
     {
         LOCK(cs_main);
         pindexPrev = mapBlockIndex[pblock->hashPrevBlock];
         blockHeight = pindexPrev->nHeight + 1;
+
+        // LitecoinCash: Hive: Blocks buried under -assumevalid skip the bee hash and signature checks (but not the structural checks)
+        BlockMap::const_iterator it = mapBlockIndex.find(pblock->GetHash());
+        if (it != mapBlockIndex.end())
+            fAssumeValid = IsBlockAssumedValid(it->second, consensusParams);
     }
     if (!pindexPrev) {
         LogPrintf("CheckHiveProof: Couldn't get previous block's CBlockIndex!\n");
@@ -649,34 +655,37 @@ bool CheckHiveProof(const CBlock* pblock, const Consensus::Params& consensusPara
         LogPrintf("CheckHiveProof: bctTxId             = %s\n", txidStr);
 
     // Check bee hash against target
-    std::string deterministicRandString = GetDeterministicRandString(pindexPrev);
-    if (verbose)
-        LogPrintf("CheckHiveProof: detRandString       = %s\n", deterministicRandString);
-    arith_uint256 beeHashTarget;
-    beeHashTarget.SetCompact(GetNextHiveWorkRequired(pindexPrev, consensusParams));
-    if (verbose)
-        LogPrintf("CheckHiveProof: beeHashTarget       = %s\n", beeHashTarget.ToString());
-    
-    // LitecoinCash: MinotaurX+Hive1.2: Use the correct inner Hive hash
-    if (!IsMinotaurXEnabled(pindexPrev, consensusParams)) {
-        std::string hashHex = (CHashWriter(SER_GETHASH, 0) << deterministicRandString << txidStr << beeNonce).GetHash().GetHex();
-        arith_uint256 beeHash = arith_uint256(hashHex);
+    std::string deterministicRandString;
+    if (!fAssumeValid) {
+        deterministicRandString = GetDeterministicRandString(pindexPrev);
         if (verbose)
-            LogPrintf("CheckHiveProof: beeHash             = %s\n", beeHash.GetHex());
-        if (beeHash >= beeHashTarget) {
-            LogPrintf("CheckHiveProof: Bee does not meet hash target!\n");
-            return false;
-        }
-    } else {
-        arith_uint256 beeHash(CBlockHeader::MinotaurHashArbitrary(std::string(deterministicRandString + txidStr + std::to_string(beeNonce)).c_str()).ToString());
+            LogPrintf("CheckHiveProof: detRandString       = %s\n", deterministicRandString);
+        arith_uint256 beeHashTarget;
+        beeHashTarget.SetCompact(GetNextHiveWorkRequired(pindexPrev, consensusParams));
         if (verbose)
-            LogPrintf("CheckHive12Proof: beeHash           = %s\n", beeHash.GetHex());
-        if (beeHash >= beeHashTarget) {
-            LogPrintf("CheckHive12Proof: Bee does not meet hash target!\n");
-            return false;
+            LogPrintf("CheckHiveProof: beeHashTarget       = %s\n", beeHashTarget.ToString());
+    
+        // LitecoinCash: MinotaurX+Hive1.2: Use the correct inner Hive hash
+        if (!IsMinotaurXEnabled(pindexPrev, consensusParams)) {
+            std::string hashHex = (CHashWriter(SER_GETHASH, 0) << deterministicRandString << txidStr << beeNonce).GetHash().GetHex();
+            arith_uint256 beeHash = arith_uint256(hashHex);
+            if (verbose)
+                LogPrintf("CheckHiveProof: beeHash             = %s\n", beeHash.GetHex());
+            if (beeHash >= beeHashTarget) {
+                LogPrintf("CheckHiveProof: Bee does not meet hash target!\n");
+                return false;
+            }
+        } else {
+            arith_uint256 beeHash(CBlockHeader::MinotaurHashArbitrary(std::string(deterministicRandString + txidStr + std::to_string(beeNonce)).c_str()).ToString());
+            if (verbose)
+                LogPrintf("CheckHive12Proof: beeHash           = %s\n", beeHash.GetHex());
+            if (beeHash >= beeHashTarget) {
+                LogPrintf("CheckHive12Proof: Bee does not meet hash target!\n");
+                return false;
+            }
         }
     }
-    
+
     // Grab the message sig (bytes 79-end; byte 78 is size)
     std::vector<unsigned char> messageSig(&txCoinbase->vout[0].scriptPubKey[79], &txCoinbase->vout[0].scriptPubKey[79 + 65]);
     if (verbose)
@@ -701,17 +710,19 @@ bool CheckHiveProof(const CBlock* pblock, const Consensus::Params& consensusPara
         LogPrintf("CheckHiveProof: Can't get pubkey for honey address\n");
         return false;
     }
-    CHashWriter ss(SER_GETHASH, 0);
-    ss << deterministicRandString;
-    uint256 mhash = ss.GetHash();
-    CPubKey pubkey;
-    if (!pubkey.RecoverCompact(mhash, messageSig)) {
-        LogPrintf("CheckHiveProof: Couldn't recover pubkey from hash\n");
-        return false;
-    }
-    if (pubkey.GetID() != *keyID) {
-        LogPrintf("CheckHiveProof: Signature mismatch! GetID() = %s, *keyID = %s\n", pubkey.GetID().ToString(), (*keyID).ToString());
-        return false;
+    if (!fAssumeValid) {
+        CHashWriter ss(SER_GETHASH, 0);
+        ss << deterministicRandString;
+        uint256 mhash = ss.GetHash();
+        CPubKey pubkey;
+        if (!pubkey.RecoverCompact(mhash, messageSig)) {
+            LogPrintf("CheckHiveProof: Couldn't recover pubkey from hash\n");
+            return false;
+        }
+        if (pubkey.GetID() != *keyID) {
+            LogPrintf("CheckHiveProof: Signature mismatch! GetID() = %s, *keyID = %s\n", pubkey.GetID().ToString(), (*keyID).ToString());
+            return false;
+        }
     }
 
     // Grab the BCT utxo
@@ -857,7 +868,7 @@ bool CheckHiveProof(const CBlock* pblock, const Consensus::Params& consensusPara
     }
 
     if (verbose)
-        LogPrintf("CheckHiveProof: Pass at %i%s\n", blockHeight, deepDrill ? " (used deepdrill)" : "");
+        LogPrintf("CheckHiveProof: Pass at %i%s%s\n", blockHeight, deepDrill ? " (used deepdrill)" : "", fAssumeValid ? " (assumed valid)" : "");
 
     return true;
 }
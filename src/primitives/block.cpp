@@ -16,6 +16,8 @@
 #include <validation.h>                 // LitecoinCash: MinotaurX+Hive1.2
 #include <util.h>                       // LitecoinCash: MinotaurX+Hive1.2
 
+#include <deque>
+
 uint256 CBlockHeader::GetHash() const
 {
     return SerializeHash(*this);
@@ -42,6 +44,70 @@ uint256 CBlockHeader::MinotaurHashString(std::string data) {
     return Minotaur(data.begin(), data.end(), false);
 }
 
+// LitecoinCash: ScryptBatch: Scrypt pow hashes filled in by PrecomputePoWHashes, keyed by block hash.
+// The oldest entries are dropped when full; they are only ever a shortcut.
+static const size_t POW_HASH_CACHE_SIZE = 8192;
+static CCriticalSection cs_powHashCache;
+static std::unordered_map<uint256, uint256, BlockHasher> mapPoWHashCache;
+static std::deque<uint256> dequePoWHashCacheOrder;    // LitecoinCash: ReindexPipeline: Insertion order, for eviction
+
+static void CachePoWHash(const uint256& hash, const uint256& powHash)
+{
+    AssertLockHeld(cs_powHashCache);
+    if (!mapPoWHashCache.emplace(hash, powHash).second)
+        return;
+    dequePoWHashCacheOrder.push_back(hash);
+    if (dequePoWHashCacheOrder.size() > POW_HASH_CACHE_SIZE) {
+        mapPoWHashCache.erase(dequePoWHashCacheOrder.front());
+        dequePoWHashCacheOrder.pop_front();
+    }
+}
+
+static bool LookupPoWHash(const CBlockHeader& header, uint256& powHash)
+{
+    LOCK(cs_powHashCache);
+    if (mapPoWHashCache.empty())
+        return false;
+    auto it = mapPoWHashCache.find(header.GetHash());
+    if (it == mapPoWHashCache.end())
+        return false;
+    powHash = it->second;
+    return true;
+}
+
+void PrecomputePoWHashes(const std::vector<const CBlockHeader*>& headers, bool fAllTypes)
+{
+    const uint32_t powForkTime = Params().GetConsensus().powForkTime;
+    std::vector<char> input;
+    std::vector<uint256> hashes;
+    for (const CBlockHeader* header : headers) {
+        if (header->nTime > powForkTime) {
+            // LitecoinCash: ReindexPipeline: MinotaurX can't be batched, but can be done ahead on another thread
+            if (fAllTypes && header->nVersion < 0x20000000 && header->GetPoWType() == POW_TYPE_MINOTAURX) {
+                const uint256 powHash = header->GetPoWHash();
+                LOCK(cs_powHashCache);
+                CachePoWHash(header->GetHash(), powHash);
+            }
+            continue;
+        }
+        const char* begin = BEGIN(header->nVersion);
+        input.insert(input.end(), begin, begin + 80);
+        hashes.push_back(header->GetHash());
+    }
+    if (hashes.empty())
+        return;
+
+    std::vector<char> output(hashes.size() * 32);
+    scrypt_1024_1_1_256_batch(input.data(), output.data(), hashes.size());
+
+    LOCK(cs_powHashCache);
+    for (size_t i = 0; i < hashes.size(); i++) {
+        uint256 powHash;
+        memcpy(powHash.begin(), &output[i * 32], 32);
+        CachePoWHash(hashes[i], powHash);
+    }
+}
+
 // LitecoinCash: MinotaurX+Hive1.2: Get pow hash based on block type and UASF activation
 uint256 CBlockHeader::GetPoWHash() const
 {
@@ -55,8 +121,13 @@ uint256 CBlockHeader::GetPoWHash() const
                 return GetHash();
                 break;
             case POW_TYPE_MINOTAURX:
+            {
+                uint256 thash;
+                if (LookupPoWHash(*this, thash))    // LitecoinCash: ReindexPipeline
+                    return thash;
                 return Minotaur(BEGIN(nVersion), END(nNonce), true);
                 break;
+            }
             default:                                                // Don't crash the client on invalid blockType, just return a bad hash
                 return HIGH_HASH;
         }
@@ -64,6 +135,8 @@ uint256 CBlockHeader::GetPoWHash() const
     
     // LCC not forked yet; still on Litecoin chain - definitely scrypt
     uint256 thash;
+    if (LookupPoWHash(*this, thash))    // LitecoinCash: ScryptBatch
+        return thash;
     scrypt_1024_1_1_256(BEGIN(nVersion), BEGIN(thash));
     return thash;
 }
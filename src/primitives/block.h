@@ -202,4 +202,10 @@ struct CBlockLocator
     }
 };
 
+/**
+ * LitecoinCash: ScryptBatch: Compute the scrypt pow hashes of pre-fork headers a batch at a time,
+ * and remember them for the GetPoWHash calls that validate those headers next.
+ */
+void PrecomputePoWHashes(const std::vector<const CBlockHeader*>& headers, bool fAllTypes = false);
+
 #endif // BITCOIN_PRIMITIVES_BLOCK_H
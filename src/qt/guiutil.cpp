@@ -924,6 +924,9 @@ QString formatServicesStr(quint64 mask)
             case NODE_RIALTO:       // LitecoinCash: Rialto service bit
                 strList.append("RIALTO");
                 break;
+            case NODE_COMPACT_FILTERS:  // LitecoinCash: BlockFilterIndex service bit
+                strList.append("COMPACT_FILTERS");
+                break;
             case NODE_XTHIN:
                 strList.append("XTHIN");
                 break;
@@ -10,6 +10,7 @@
 #include <primitives/transaction.h>
 #include <validation.h>
 #include <httpserver.h>
+#include <index/txindex.h>  // LitecoinCash: TxIndex
 #include <rpc/blockchain.h>
 #include <rpc/server.h>
 #include <streams.h>
@@ -208,7 +209,6 @@ static bool rest_block(HTTPRequest* req,
     if (!ParseHashStr(hashStr, hash))
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
 
-    CBlock block;
     CBlockIndex* pblockindex = nullptr;
     {
         LOCK(cs_main);
@@ -218,11 +218,27 @@ static bool rest_block(HTTPRequest* req,
         pblockindex = mapBlockIndex[hash];
         if (fHavePruned && !(pblockindex->nStatus & BLOCK_HAVE_DATA) && pblockindex->nTx > 0)
             return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not available (pruned data)");
+    }
 
-        if (!ReadBlockFromDisk(block, pblockindex, Params().GetConsensus()))
+    // LitecoinCash: MappedBlocks: Serve the stored bytes as they are, unless the witness data has to be stripped
+    if ((rf == RF_BINARY || rf == RF_HEX) && !(RPCSerializationFlags() & SERIALIZE_TRANSACTION_NO_WITNESS)) {
+        CRawBlock rawBlock;
+        if (!ReadRawBlockFromDisk(rawBlock, pblockindex, Params().MessageStart()))
             return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+        if (rf == RF_BINARY) {
+            req->WriteHeader("Content-Type", "application/octet-stream");
+            req->WriteReply(HTTP_OK, std::string(reinterpret_cast<const char*>(rawBlock.data()), rawBlock.size()));
+        } else {
+            req->WriteHeader("Content-Type", "text/plain");
+            req->WriteReply(HTTP_OK, HexStr(rawBlock.data(), rawBlock.data() + rawBlock.size()) + "\n");
+        }
+        return true;
     }
 
+    CBlock block;
+    if (!ReadBlockFromDisk(block, pblockindex, Params().GetConsensus()))
+        return RESTERR(req, HTTP_NOT_FOUND, hashStr + " not found");
+
     CDataStream ssBlock(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
     ssBlock << block;
 
@@ -350,6 +366,11 @@ static bool rest_tx(HTTPRequest* req, const std::string& strURIPart)
     if (!ParseHashStr(hashStr, hash))
         return RESTERR(req, HTTP_BAD_REQUEST, "Invalid hash: " + hashStr);
 
+    // LitecoinCash: TxIndex: Let the index catch up with the chain before looking the transaction up in it
+    if (g_txindex) {
+        g_txindex->BlockUntilSyncedToCurrentChain();
+    }
+
     CTransactionRef tx;
     uint256 hashBlock = uint256();
     if (!GetTransaction(hash, tx, Params().GetConsensus(), hashBlock, true))
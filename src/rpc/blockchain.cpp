@@ -7,10 +7,13 @@
 #include <rpc/blockchain.h>
 
 #include <amount.h>
+#include <base58.h>
 #include <chain.h>
+#include <chainstats.h>         // LitecoinCash: MinotaurX+Hive1.2
 #include <chainparams.h>
 #include <checkpoints.h>
 #include <coins.h>
+#include <coinsprefetch.h>  // LitecoinCash: CoinsPrefetch
 #include <consensus/validation.h>
 #include <validation.h>
 #include <core_io.h>
@@ -18,6 +21,8 @@
 #include <policy/policy.h>
 #include <primitives/transaction.h>
 #include <rpc/server.h>
+#include <script/sigcache.h>    // LitecoinCash: PersistSigCache
+#include <script/standard.h>
 #include <streams.h>
 #include <sync.h>
 #include <txdb.h>
@@ -25,6 +30,9 @@
 #include <util.h>
 #include <utilstrencodings.h>
 #include <hash.h>
+#include <index/addressindex.h>      // LitecoinCash: AddressIndex
+#include <index/blockfilterindex.h>   // LitecoinCash: BlockFilterIndex
+#include <index/spentindex.h>        // LitecoinCash: AddressIndex
 #include <validationinterface.h>
 #include <warnings.h>
 
@@ -66,35 +74,48 @@ double GetDifficulty(const CChain& chain, const CBlockIndex* blockindex, bool ge
 
     const Consensus::Params& consensusParams = Params().GetConsensus();
 
-    // LitecoinCash: Hive: If tip is PoW and we want hivemined, step back until we find a Hive block
-    // LitecoinCash: Hive 1.1: Allow there to be multiple hive blocks in the way
-    if (getHiveDifficulty) {
-        while (!blockindex->GetBlockHeader().IsHiveMined(consensusParams)) {
-            if (!blockindex->pprev || blockindex->nHeight < consensusParams.minHiveCheckBlock) {   // Ran out of blocks without finding a Hive block? Return min target
+    // LitecoinCash: MinotaurX+Hive1.2: Find the last block of the requested type from the chain type stats where
+    // possible, rather than stepping back through the chain
+    const CBlockIndex* pindexLast;
+    if (&chain == &chainActive && chainTypeStats.GetLastBlock(blockindex, getHiveDifficulty ? CHAINSTATS_HIVE : (ChainStatsType)powType, pindexLast)) {
+        if (!pindexLast) {
+            if (getHiveDifficulty) {
                 LogPrint(BCLog::HIVE, "GetDifficulty: No hivemined blocks found in history\n");
                 return 1.0;
             }
-
-            blockindex = blockindex->pprev;
+            return 0;
         }
+        blockindex = pindexLast;
     } else {
-        // LitecoinCash: MinotaurX+Hive1.2: Skip over incorrect powTypes
-        if (IsMinotaurXEnabled(blockindex, consensusParams)) {
-            while (blockindex->GetBlockHeader().IsHiveMined(consensusParams) || blockindex->GetBlockHeader().GetPoWType() != powType) {
-                assert (blockindex->pprev);
-                blockindex = blockindex->pprev;
-                if (!IsMinotaurXEnabled(blockindex, consensusParams)) {
-                    return 0;
+        // LitecoinCash: Hive: If tip is PoW and we want hivemined, step back until we find a Hive block
+        // LitecoinCash: Hive 1.1: Allow there to be multiple hive blocks in the way
+        if (getHiveDifficulty) {
+            while (!blockindex->GetBlockHeader().IsHiveMined(consensusParams)) {
+                if (!blockindex->pprev || blockindex->nHeight < consensusParams.minHiveCheckBlock) {   // Ran out of blocks without finding a Hive block? Return min target
+                    LogPrint(BCLog::HIVE, "GetDifficulty: No hivemined blocks found in history\n");
+                    return 1.0;
                 }
+
+                blockindex = blockindex->pprev;
             }
         } else {
-            while (blockindex->GetBlockHeader().IsHiveMined(consensusParams)) {
-                assert (blockindex->pprev);
-                blockindex = blockindex->pprev;
+            // LitecoinCash: MinotaurX+Hive1.2: Skip over incorrect powTypes
+            if (IsMinotaurXEnabled(blockindex, consensusParams)) {
+                while (blockindex->GetBlockHeader().IsHiveMined(consensusParams) || blockindex->GetBlockHeader().GetPoWType() != powType) {
+                    assert (blockindex->pprev);
+                    blockindex = blockindex->pprev;
+                    if (!IsMinotaurXEnabled(blockindex, consensusParams)) {
+                        return 0;
+                    }
+                }
+            } else {
+                while (blockindex->GetBlockHeader().IsHiveMined(consensusParams)) {
+                    assert (blockindex->pprev);
+                    blockindex = blockindex->pprev;
+                }
             }
         }
     }
-    
 
     int nShift = (blockindex->nBits >> 24) & 0xff;
     double dDiff =
@@ -496,7 +517,7 @@ void entryToJSON(UniValue &info, const CTxMemPoolEntry &e)
     info.push_back(Pair("ancestorcount", e.GetCountWithAncestors()));
     info.push_back(Pair("ancestorsize", e.GetSizeWithAncestors()));
     info.push_back(Pair("ancestorfees", e.GetModFeesWithAncestors()));
-    info.push_back(Pair("wtxid", mempool.vTxHashes[e.vTxHashesIdx].first.ToString()));
+    info.push_back(Pair("wtxid", mempool.vTxHashes[e.vTxHashesIdx].ToString()));
     const CTransaction& tx = e.GetTx();
     std::set<std::string> setDepends;
     for (const CTxIn& txin : tx.vin)
@@ -1080,6 +1101,125 @@ UniValue gettxoutsetinfo(const JSONRPCRequest& request)
     return ret;
 }
 
+// LitecoinCash: CoinsSync: Report on the coins cache and its writes to the coins database
+UniValue getcoinscacheinfo(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 0)
+        throw std::runtime_error(
+            "getcoinscacheinfo\n"
+            "\nReturns details about the in-memory UTXO cache and how it is written to disk.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"backgroundflush\": true|false, (boolean) Whether dirty coins are written without emptying the cache\n"
+            "  \"entries\": n,             (numeric) Number of entries in the cache\n"
+            "  \"usage\": n,               (numeric) Memory in use by the cache, in bytes\n"
+            "  \"allocated\": n,           (numeric) Memory held by the cache, including memory free for reuse, in bytes\n"
+            "  \"inflight\": n,            (numeric) Memory held by the copy of the coins being written in the background, in bytes\n"
+            "  \"limit\": n,               (numeric) Memory budget of the cache (-dbcache), in bytes\n"
+            "  \"hits\": n,                (numeric) Lookups served from the cache since the last write\n"
+            "  \"misses\": n,              (numeric) Lookups that went to disk since the last write\n"
+            "  \"flushes\": n,             (numeric) Number of writes since startup\n"
+            "  \"lastflush\": {            (json object) The last write, if any\n"
+            "     \"time\": xxx,           (numeric) Start time in seconds since epoch (Jan 1 1970 GMT)\n"
+            "     \"duration_ms\": x.xxx,  (numeric) Time taken, in milliseconds\n"
+            "     \"coins\": n,            (numeric) Number of coins written\n"
+            "     \"background\": true|false, (boolean) Whether the write happened in the background\n"
+            "     \"hits\": n,             (numeric) Cache hits in the interval before the write\n"
+            "     \"misses\": n,           (numeric) Cache misses in the interval before the write\n"
+            "     \"evicted\": n           (numeric) Entries dropped by the last eviction\n"
+            "  },\n"
+            "  \"prefetch\": {             (json object) Reading the inputs of downloaded blocks ahead of validation\n"
+            "     \"hits\": n,             (numeric) Cache misses served from prefetched coins\n"
+            "     \"misses\": n,           (numeric) Cache misses that went to disk\n"
+            "     \"fetched\": n,          (numeric) Coins read ahead of time\n"
+            "     \"discarded\": n,        (numeric) Prefetched coins dropped unused because the database was written\n"
+            "     \"staged\": n            (numeric) Prefetched coins waiting to be used\n"
+            "  }\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getcoinscacheinfo", "")
+            + HelpExampleRpc("getcoinscacheinfo", "")
+        );
+
+    LOCK(cs_main);
+    const CoinsFlushStats stats = GetCoinsFlushStats();
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("backgroundflush", fCoinsBackgroundFlush));
+    ret.push_back(Pair("entries", (uint64_t)pcoinsTip->GetCacheSize()));
+    ret.push_back(Pair("usage", (uint64_t)pcoinsTip->LiveMemoryUsage()));
+    ret.push_back(Pair("allocated", (uint64_t)pcoinsTip->DynamicMemoryUsage()));
+    ret.push_back(Pair("inflight", (uint64_t)stats.nInFlightUsage));
+    ret.push_back(Pair("limit", (uint64_t)nCoinCacheUsage));
+    ret.push_back(Pair("hits", pcoinsTip->GetCacheHits()));
+    ret.push_back(Pair("misses", pcoinsTip->GetCacheMisses()));
+    ret.push_back(Pair("flushes", stats.nFlushes));
+    if (stats.nFlushes > 0) {
+        UniValue last(UniValue::VOBJ);
+        last.push_back(Pair("time", stats.nLastTime));
+        last.push_back(Pair("duration_ms", stats.nLastDuration * 0.001));
+        last.push_back(Pair("coins", (uint64_t)stats.nLastCoins));
+        last.push_back(Pair("background", stats.fLastBackground));
+        last.push_back(Pair("hits", stats.nLastHits));
+        last.push_back(Pair("misses", stats.nLastMisses));
+        last.push_back(Pair("evicted", (uint64_t)stats.nLastEvicted));
+        ret.push_back(Pair("lastflush", last));
+    }
+    // LitecoinCash: CoinsPrefetch
+    if (pcoinsprefetch) {
+        const CoinsPrefetchStats prefetch_stats = pcoinsprefetch->GetStats();
+        UniValue prefetch(UniValue::VOBJ);
+        prefetch.push_back(Pair("hits", prefetch_stats.nHits));
+        prefetch.push_back(Pair("misses", prefetch_stats.nMisses));
+        prefetch.push_back(Pair("fetched", prefetch_stats.nFetched));
+        prefetch.push_back(Pair("discarded", prefetch_stats.nDiscarded));
+        prefetch.push_back(Pair("staged", (uint64_t)prefetch_stats.nStaged));
+        ret.push_back(Pair("prefetch", prefetch));
+    }
+    return ret;
+}
+
+// LitecoinCash: PersistSigCache
+static UniValue SignatureCacheStatsToJSON(const SignatureCacheStats& stats)
+{
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("loaded", stats.nLoaded));
+    ret.push_back(Pair("hits", stats.nHits));
+    ret.push_back(Pair("misses", stats.nMisses));
+    return ret;
+}
+
+UniValue getsigcacheinfo(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 0)
+        throw std::runtime_error(
+            "getsigcacheinfo\n"
+            "\nReturns how the signature and script execution caches have done since startup, including the\n"
+            "entries loaded from disk (see -persistsigcache).\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"signatures\": {           (json object) The signature cache\n"
+            "     \"loaded\": n,           (numeric) Entries loaded from disk at startup\n"
+            "     \"hits\": n,             (numeric) Signature checks skipped because they were cached\n"
+            "     \"misses\": n            (numeric) Signature checks that had to be done\n"
+            "  },\n"
+            "  \"scripts\": {              (json object) The script execution cache\n"
+            "     \"loaded\": n,           (numeric) Entries loaded from disk at startup\n"
+            "     \"hits\": n,             (numeric) Transactions whose scripts didn't have to be run again\n"
+            "     \"misses\": n            (numeric) Transactions whose scripts had to be run\n"
+            "  }\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getsigcacheinfo", "")
+            + HelpExampleRpc("getsigcacheinfo", "")
+        );
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("signatures", SignatureCacheStatsToJSON(GetSignatureCacheStats())));
+    ret.push_back(Pair("scripts", SignatureCacheStatsToJSON(GetScriptExecutionCacheStats())));
+    return ret;
+}
+
 UniValue gettxout(const JSONRPCRequest& request)
 {
     if (request.fHelp || request.params.size() < 2 || request.params.size() > 3)
@@ -1485,6 +1625,7 @@ UniValue getchaintips(const JSONRPCRequest& request)
 UniValue mempoolInfoToJSON()
 {
     UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("loaded", g_is_mempool_loaded.load()));
     ret.push_back(Pair("size", (int64_t) mempool.size()));
     ret.push_back(Pair("bytes", (int64_t) mempool.GetTotalTxSize()));
     ret.push_back(Pair("usage", (int64_t) mempool.DynamicMemoryUsage()));
@@ -1504,6 +1645,7 @@ UniValue getmempoolinfo(const JSONRPCRequest& request)
             "\nReturns details on the active state of the TX memory pool.\n"
             "\nResult:\n"
             "{\n"
+            "  \"loaded\": true|false         (boolean) True if the mempool is fully loaded\n"
             "  \"size\": xxxxx,               (numeric) Current tx count\n"
             "  \"bytes\": xxxxx,              (numeric) Sum of all virtual transaction sizes as defined in BIP 141. Differs from actual serialized size because witness data is discounted\n"
             "  \"usage\": xxxxx,              (numeric) Total memory usage for the mempool\n"
@@ -1723,6 +1865,11 @@ UniValue savemempool(const JSONRPCRequest& request)
         );
     }
 
+    // LitecoinCash: MempoolLoad: Don't overwrite mempool.dat with the part loaded so far
+    if (!g_is_mempool_loaded) {
+        throw JSONRPCError(RPC_MISC_ERROR, "The mempool was not loaded yet");
+    }
+
     if (!DumpMempool()) {
         throw JSONRPCError(RPC_MISC_ERROR, "Unable to dump mempool to disk");
     }
@@ -1730,16 +1877,325 @@ UniValue savemempool(const JSONRPCRequest& request)
     return NullUniValue;
 }
 
+// LitecoinCash: BlockFilterIndex
+UniValue getblockfilter(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() < 1 || request.params.size() > 2) {
+        throw std::runtime_error(
+            "getblockfilter \"blockhash\" ( \"filtertype\" )\n"
+            "\nRetrieve a BIP 157 content filter for a particular block.\n"
+            "\nArguments:\n"
+            "1. \"blockhash\"   (string, required) The hash of the block\n"
+            "2. \"filtertype\"  (string, optional, default=basic) The type name of the filter\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"filter\" : \"xxxx\",   (string) the hex-encoded filter data\n"
+            "  \"header\" : \"xxxx\",   (string) the hex-encoded filter header\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getblockfilter", "\"00000000c937983704a73af28acdec37b049d214adbda81d7e2a3dd146f6ed09\" \"basic\"")
+            + HelpExampleRpc("getblockfilter", "\"00000000c937983704a73af28acdec37b049d214adbda81d7e2a3dd146f6ed09\", \"basic\"")
+        );
+    }
+
+    uint256 block_hash = uint256S(request.params[0].get_str());
+    std::string filtertype_name = "basic";
+    if (!request.params[1].isNull()) {
+        filtertype_name = request.params[1].get_str();
+    }
+
+    BlockFilterType filtertype;
+    if (!BlockFilterTypeByName(filtertype_name, filtertype)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Unknown filtertype");
+    }
+
+    BlockFilterIndex* index = GetBlockFilterIndex(filtertype);
+    if (!index) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Index is not enabled for filtertype " + filtertype_name);
+    }
+
+    const CBlockIndex* block_index;
+    bool block_was_connected;
+    {
+        LOCK(cs_main);
+        BlockMap::const_iterator it = mapBlockIndex.find(block_hash);
+        if (it == mapBlockIndex.end()) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Block not found");
+        }
+        block_index = it->second;
+        block_was_connected = block_index->IsValid(BLOCK_VALID_SCRIPTS);
+    }
+
+    bool index_ready = index->BlockUntilSyncedToCurrentChain();
+
+    BlockFilter filter;
+    uint256 filter_header;
+    if (!index->LookupFilter(block_index, filter) ||
+        !index->LookupFilterHeader(block_index, filter_header)) {
+        int err_code;
+        std::string errmsg = "Filter not found.";
+
+        if (!block_was_connected) {
+            err_code = RPC_INVALID_ADDRESS_OR_KEY;
+            errmsg += " Block was not connected to active chain.";
+        } else if (!index_ready) {
+            err_code = RPC_MISC_ERROR;
+            errmsg += " Block filters are still in the process of being indexed.";
+        } else {
+            err_code = RPC_INTERNAL_ERROR;
+            errmsg += " This error is unexpected and indicates index corruption.";
+        }
+
+        throw JSONRPCError(err_code, errmsg);
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("filter", HexStr(filter.GetEncodedFilter())));
+    ret.push_back(Pair("header", filter_header.GetHex()));
+    return ret;
+}
+
+// LitecoinCash: AddressIndex: Most entries returned by one call of the paginated address index RPCs
+static const int MAX_ADDRESS_INDEX_PAGE_SIZE = 1000;
+
+// LitecoinCash: AddressIndex: Resolve an address argument to the script it stands for
+static CScript AddressIndexScript(const UniValue& param)
+{
+    CTxDestination dest = DecodeDestination(param.get_str());
+    if (!IsValidDestination(dest)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Invalid address");
+    }
+    return GetScriptForDestination(dest);
+}
+
+// LitecoinCash: AddressIndex: Results are only complete once the index has caught up with the chain
+static const AddressIndex& GetSyncedAddressIndex()
+{
+    if (!g_addressindex) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Address index is not enabled. Use -addressindex");
+    }
+    if (!g_addressindex->BlockUntilSyncedToCurrentChain()) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Addresses are still in the process of being indexed");
+    }
+    return *g_addressindex;
+}
+
+// LitecoinCash: AddressIndex: Read the count and skip arguments of a paginated RPC
+static void ParseAddressIndexPage(const JSONRPCRequest& request, size_t& count, size_t& skip)
+{
+    int n_count = 100;
+    if (!request.params[1].isNull()) {
+        n_count = request.params[1].get_int();
+    }
+    int n_skip = 0;
+    if (!request.params[2].isNull()) {
+        n_skip = request.params[2].get_int();
+    }
+    if (n_count < 1 || n_count > MAX_ADDRESS_INDEX_PAGE_SIZE) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, strprintf("Count must be between 1 and %d", MAX_ADDRESS_INDEX_PAGE_SIZE));
+    }
+    if (n_skip < 0) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Negative skip");
+    }
+    count = n_count;
+    skip = n_skip;
+}
+
+UniValue getaddressbalance(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 1) {
+        throw std::runtime_error(
+            "getaddressbalance \"address\"\n"
+            "\nReturns the balance of an address, as of the chain tip. Requires -addressindex.\n"
+            "\nArguments:\n"
+            "1. \"address\"     (string, required) The address\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"balance\" : x.xxx,     (numeric) The amount held in unspent outputs to the address\n"
+            "  \"received\" : x.xxx,    (numeric) The total amount ever paid to the address\n"
+            "  \"txcount\" : n          (numeric) The number of transactions paying to or spending from the address\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getaddressbalance", "\"LER4HnAEFwYHbmGxCfP2po1nPrUeiK8KM2\"")
+            + HelpExampleRpc("getaddressbalance", "\"LER4HnAEFwYHbmGxCfP2po1nPrUeiK8KM2\"")
+        );
+    }
+
+    const CScript script = AddressIndexScript(request.params[0]);
+    const AddressIndex& index = GetSyncedAddressIndex();
+
+    AddressIndex::Balance balance;
+    if (!index.LookupBalance(script, balance)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read the address index");
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("balance", ValueFromAmount(balance.balance)));
+    ret.push_back(Pair("received", ValueFromAmount(balance.received)));
+    ret.push_back(Pair("txcount", balance.tx_count));
+    return ret;
+}
+
+UniValue getaddressutxos(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() < 1 || request.params.size() > 3) {
+        throw std::runtime_error(
+            "getaddressutxos \"address\" ( count skip )\n"
+            "\nReturns the unspent outputs to an address, as of the chain tip. Requires -addressindex.\n"
+            "Outputs come in a fixed order, so that consecutive calls can page through them.\n"
+            "\nArguments:\n"
+            "1. \"address\"     (string, required) The address\n"
+            "2. count         (numeric, optional, default=100) The number of outputs to return, at most " + std::to_string(MAX_ADDRESS_INDEX_PAGE_SIZE) + "\n"
+            "3. skip          (numeric, optional, default=0) The number of outputs to skip\n"
+            "\nResult:\n"
+            "[\n"
+            "  {\n"
+            "    \"txid\" : \"hash\",     (string) The transaction id\n"
+            "    \"vout\" : n,          (numeric) The output number\n"
+            "    \"amount\" : x.xxx,    (numeric) The output value in " + CURRENCY_UNIT + "\n"
+            "    \"height\" : n         (numeric) The height of the block including the transaction\n"
+            "  }\n"
+            "  ,...\n"
+            "]\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getaddressutxos", "\"LER4HnAEFwYHbmGxCfP2po1nPrUeiK8KM2\" 100 200")
+            + HelpExampleRpc("getaddressutxos", "\"LER4HnAEFwYHbmGxCfP2po1nPrUeiK8KM2\", 100, 200")
+        );
+    }
+
+    const CScript script = AddressIndexScript(request.params[0]);
+    size_t count, skip;
+    ParseAddressIndexPage(request, count, skip);
+    const AddressIndex& index = GetSyncedAddressIndex();
+
+    std::vector<AddressIndex::Unspent> unspent;
+    if (!index.LookupUnspent(script, skip, count, unspent)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read the address index");
+    }
+
+    UniValue ret(UniValue::VARR);
+    for (const auto& output : unspent) {
+        UniValue entry(UniValue::VOBJ);
+        entry.push_back(Pair("txid", output.outpoint.hash.GetHex()));
+        entry.push_back(Pair("vout", (int)output.outpoint.n));
+        entry.push_back(Pair("amount", ValueFromAmount(output.value)));
+        entry.push_back(Pair("height", output.height));
+        ret.push_back(entry);
+    }
+    return ret;
+}
+
+UniValue getaddresshistory(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() < 1 || request.params.size() > 3) {
+        throw std::runtime_error(
+            "getaddresshistory \"address\" ( count skip )\n"
+            "\nReturns the transactions paying to or spending from an address, oldest first, as of the chain tip.\n"
+            "Requires -addressindex.\n"
+            "\nArguments:\n"
+            "1. \"address\"     (string, required) The address\n"
+            "2. count         (numeric, optional, default=100) The number of transactions to return, at most " + std::to_string(MAX_ADDRESS_INDEX_PAGE_SIZE) + "\n"
+            "3. skip          (numeric, optional, default=0) The number of transactions to skip\n"
+            "\nResult:\n"
+            "[\n"
+            "  {\n"
+            "    \"txid\" : \"hash\",       (string) The transaction id\n"
+            "    \"height\" : n,          (numeric) The height of the block including the transaction\n"
+            "    \"blockhash\" : \"hash\",  (string) The hash of the block including the transaction\n"
+            "    \"received\" : x.xxx,    (numeric) The amount the transaction pays to the address\n"
+            "    \"sent\" : x.xxx         (numeric) The amount the transaction spends from the address\n"
+            "  }\n"
+            "  ,...\n"
+            "]\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getaddresshistory", "\"LER4HnAEFwYHbmGxCfP2po1nPrUeiK8KM2\" 100 200")
+            + HelpExampleRpc("getaddresshistory", "\"LER4HnAEFwYHbmGxCfP2po1nPrUeiK8KM2\", 100, 200")
+        );
+    }
+
+    const CScript script = AddressIndexScript(request.params[0]);
+    size_t count, skip;
+    ParseAddressIndexPage(request, count, skip);
+    const AddressIndex& index = GetSyncedAddressIndex();
+
+    std::vector<AddressIndex::HistoryEntry> history;
+    if (!index.LookupHistory(script, skip, count, history)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read the address index");
+    }
+
+    UniValue ret(UniValue::VARR);
+    for (const auto& tx : history) {
+        UniValue entry(UniValue::VOBJ);
+        entry.push_back(Pair("txid", tx.txid.GetHex()));
+        entry.push_back(Pair("height", tx.height));
+        entry.push_back(Pair("blockhash", tx.block_hash.GetHex()));
+        entry.push_back(Pair("received", ValueFromAmount(tx.received)));
+        entry.push_back(Pair("sent", ValueFromAmount(tx.sent)));
+        ret.push_back(entry);
+    }
+    return ret;
+}
+
+UniValue getspentinfo(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 2) {
+        throw std::runtime_error(
+            "getspentinfo \"txid\" n\n"
+            "\nReturns the input spending a transaction output, as of the chain tip. Requires -spentindex.\n"
+            "\nArguments:\n"
+            "1. \"txid\"       (string, required) The transaction id\n"
+            "2. n            (numeric, required) The output number\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"txid\" : \"hash\",    (string) The id of the spending transaction\n"
+            "  \"index\" : n,        (numeric) The number of the spending input\n"
+            "  \"height\" : n        (numeric) The height of the block including the spending transaction\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getspentinfo", "\"mytxid\" 1")
+            + HelpExampleRpc("getspentinfo", "\"mytxid\", 1")
+        );
+    }
+
+    const uint256 hash = ParseHashV(request.params[0], "txid");
+    const int n = request.params[1].get_int();
+    if (n < 0) {
+        throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid output number");
+    }
+
+    if (!g_spentindex) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Spent index is not enabled. Use -spentindex");
+    }
+    if (!g_spentindex->BlockUntilSyncedToCurrentChain()) {
+        throw JSONRPCError(RPC_MISC_ERROR, "Spent outputs are still in the process of being indexed");
+    }
+
+    SpentIndex::SpentInfo info;
+    if (!g_spentindex->LookupSpent(COutPoint(hash, n), info)) {
+        throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, "Output not found or not spent");
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("txid", info.txid.GetHex()));
+    ret.push_back(Pair("index", (int)info.input_index));
+    ret.push_back(Pair("height", info.height));
+    return ret;
+}
+
 static const CRPCCommand commands[] =
 { //  category              name                      actor (function)         argNames
   //  --------------------- ------------------------  -----------------------  ----------
     { "blockchain",         "getblockchaininfo",      &getblockchaininfo,      {} },
     { "blockchain",         "getchaintxstats",        &getchaintxstats,        {"nblocks", "blockhash"} },
     { "blockchain",         "getbestblockhash",       &getbestblockhash,       {} },
+    { "blockchain",         "getaddressbalance",      &getaddressbalance,      {"address"} },                       // LitecoinCash: AddressIndex
+    { "blockchain",         "getaddresshistory",      &getaddresshistory,      {"address","count","skip"} },        // LitecoinCash: AddressIndex
+    { "blockchain",         "getaddressutxos",        &getaddressutxos,        {"address","count","skip"} },        // LitecoinCash: AddressIndex
     { "blockchain",         "getblockcount",          &getblockcount,          {} },
     { "blockchain",         "getblock",               &getblock,               {"blockhash","verbosity|verbose"} },
     { "blockchain",         "getblockhash",           &getblockhash,           {"height"} },
     { "blockchain",         "getblockheader",         &getblockheader,         {"blockhash","verbose"} },
+    { "blockchain",         "getblockfilter",         &getblockfilter,         {"blockhash","filtertype"} },   // LitecoinCash: BlockFilterIndex
     { "blockchain",         "getchaintips",           &getchaintips,           {} },
     { "blockchain",         "getdifficulty",          &getdifficulty,          {} },
     { "blockchain",         "gethivedifficulty",      &gethivedifficulty,      {} },        // LitecoinCash: Get Hive difficulty
@@ -1748,8 +2204,11 @@ static const CRPCCommand commands[] =
     { "blockchain",         "getmempoolentry",        &getmempoolentry,        {"txid"} },
     { "blockchain",         "getmempoolinfo",         &getmempoolinfo,         {} },
     { "blockchain",         "getrawmempool",          &getrawmempool,          {"verbose"} },
+    { "blockchain",         "getspentinfo",           &getspentinfo,           {"txid","n"} },                      // LitecoinCash: AddressIndex
     { "blockchain",         "gettxout",               &gettxout,               {"txid","n","include_mempool"} },
     { "blockchain",         "gettxoutsetinfo",        &gettxoutsetinfo,        {} },
+    { "blockchain",         "getcoinscacheinfo",      &getcoinscacheinfo,      {} },        // LitecoinCash: CoinsSync
+    { "blockchain",         "getsigcacheinfo",        &getsigcacheinfo,        {} },        // LitecoinCash: PersistSigCache
     { "blockchain",         "pruneblockchain",        &pruneblockchain,        {"height"} },
     { "blockchain",         "savemempool",            &savemempool,            {} },
     { "blockchain",         "verifychain",            &verifychain,            {"checklevel","nblocks"} },
@@ -115,6 +115,11 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "gettxout", 1, "n" },
     { "gettxout", 2, "include_mempool" },
     { "gettxoutproof", 0, "txids" },
+    { "getaddressutxos", 1, "count" },
+    { "getaddressutxos", 2, "skip" },
+    { "getaddresshistory", 1, "count" },
+    { "getaddresshistory", 2, "skip" },
+    { "getspentinfo", 1, "n" },
     { "lockunspent", 0, "unlock" },
     { "lockunspent", 1, "transactions" },
     { "importprivkey", 2, "rescan" },
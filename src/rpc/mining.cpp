@@ -6,6 +6,7 @@
 #include <base58.h>
 #include <amount.h>
 #include <chain.h>
+#include <chainstats.h>     // LitecoinCash: MinotaurX+Hive1.2
 #include <chainparams.h>
 #include <consensus/consensus.h>
 #include <consensus/params.h>
@@ -46,11 +47,12 @@ unsigned int ParseConfirmTarget(const UniValue& value)
  */
 // LitecoinCash: Hive: count hashes with dedicated function, dont use chainwork. GetNumHashes is Hive Aware.
 // LitecoinCash: MinotaurX+Hive1.2: Only consider the correct powType when counting hashes
+// LitecoinCash: MinotaurX+Hive1.2: Answer from the chain type stats index rather than walking the chain. Doesn't need cs_main.
 UniValue GetNetworkHashPS(int lookup, int height, POW_TYPE powType) {
-    CBlockIndex *pb = chainActive.Tip();
+    const CBlockIndex *pb = chainTypeStats.Tip();
 
-    if (height >= 0 && height < chainActive.Height())
-        pb = chainActive[height];
+    if (pb != nullptr && height >= 0 && height < pb->nHeight)
+        pb = pb->GetAncestor(height);
 
     if (pb == nullptr || !pb->nHeight)
         return 0;
@@ -63,54 +65,15 @@ UniValue GetNetworkHashPS(int lookup, int height, POW_TYPE powType) {
     if (lookup > pb->nHeight)
         lookup = pb->nHeight;
 
-    // LitecoinCash: MinotaurX+Hive1.2: Skip incorrect powType
-    while(IsMinotaurXEnabled(pb, Params().GetConsensus()) && pb->GetBlockHeader().GetPoWType() != powType) {
-        assert (pb->pprev);
-        pb = pb->pprev;
-    }
-    // We have either stepped back to before minotaurx fork, or the requested powType block
-    // If we have stepped back to (or started looking up from) pre minotaur, but requested minotaurx pow type, then there are no hashes
-    if (!IsMinotaurXEnabled(pb, Params().GetConsensus()) && powType == POW_TYPE_MINOTAURX) {
-        return 0;
-    }
-    // We are either post-fork and with correct powType, or pre-fork and with correct powType!
-
-    int64_t minTime = pb->GetBlockTime();
-    int64_t maxTime = minTime;
-	
-	arith_uint256 workDiff = GetNumHashes(*pb, powType);    // LitecoinCash: MinotaurX+Hive1.2: add powType param
-	
-    for (int i = 0; i < lookup; i++) {
-        pb = pb->pprev;
-
-        // LitecoinCash: MinotaurX+Hive1.2: Skip incorrect powType
-
-        // TODO: Strictly speaking we may also went to step over hive blocks in here!
-        // However, it is not a major problem as GetNumHashes is Hive aware, and since
-        // hive blocks almost immediately follow pow blocks, the contribution to timing
-        // inaccuracies are most likely fairly insignificant.
-
-        while(IsMinotaurXEnabled(pb, Params().GetConsensus()) && pb->GetBlockHeader().GetPoWType() != powType) {
-            assert (pb->pprev);
-            pb = pb->pprev;
-        }
-        if(!IsMinotaurXEnabled(pb, Params().GetConsensus()) && powType == POW_TYPE_MINOTAURX) {
-            break;
-        }
+    // Sum the hashes over the last lookup + 1 blocks of the requested powType at or below pb. If there are none
+    // (eg MinotaurX requested before it was enabled), then there are no hashes.
+    CChainStatsWindow window = chainTypeStats.GetWindow(pb->nHeight, lookup, (ChainStatsType)powType);
 
-        int64_t time = pb->GetBlockTime();
-        minTime = std::min(time, minTime);
-        maxTime = std::max(time, maxTime);
-        workDiff += GetNumHashes(*pb, powType);              // LitecoinCash: MinotaurX+Hive1.2: add powType param
-    }
-
-    // In case there's a situation where minTime == maxTime, we don't want a divide by zero exception.
-    if (minTime == maxTime)
+    // In case there's a situation where the time span is zero, we don't want a divide by zero exception.
+    if (window.nTimeSpan <= 0)
         return 0;
 
-    int64_t timeDiff = maxTime - minTime;
-
-	return workDiff.getdouble() / timeDiff;
+    return window.dHashes / window.nTimeSpan;
 }
 
 // LitecoinCash: Hive: Mining optimisations: Set hive mining params
@@ -199,7 +162,6 @@ UniValue getnetworkhashps(const JSONRPCRequest& request)
     if (!algoFound)
         throw JSONRPCError(RPC_INVALID_PARAMETER, "Invalid pow algorithm requested");
 
-    LOCK(cs_main);
     return GetNetworkHashPS(!request.params[0].isNull() ? request.params[0].get_int() : 120, !request.params[1].isNull() ? request.params[1].get_int() : -1, powType);
 }
 
@@ -218,7 +180,10 @@ UniValue generateBlocks(std::shared_ptr<CReserveScript> coinbaseScript, int nGen
     UniValue blockHashes(UniValue::VARR);
     while (nHeight < nHeightEnd)
     {
-        std::unique_ptr<CBlockTemplate> pblocktemplate(BlockAssembler(Params()).CreateNewBlock(coinbaseScript->reserveScript));
+        // LitecoinCash: Block templates: Use the shared template manager
+        if (!g_block_templates)
+            throw JSONRPCError(RPC_INTERNAL_ERROR, "Block template manager not running");
+        std::unique_ptr<CBlockTemplate> pblocktemplate(g_block_templates->GetBlockTemplate(coinbaseScript->reserveScript));
         if (!pblocktemplate.get())
             throw JSONRPCError(RPC_INTERNAL_ERROR, "Couldn't create new block");
         CBlock *pblock = &pblocktemplate->block;
@@ -626,37 +591,16 @@ UniValue getblocktemplate(const JSONRPCRequest& request)
     bool fSupportsSegwit = setClientRules.find(segwit_info.name) != setClientRules.end();
 
     // Update block
-    static CBlockIndex* pindexPrev;
-    static int64_t nStart;
-    static std::unique_ptr<CBlockTemplate> pblocktemplate;
-    // Cache whether the last invocation was with segwit support, to avoid returning
-    // a segwit-block to a non-segwit caller.
-    static bool fLastTemplateSupportsSegwit = true;
-    static POW_TYPE lastPowType = NUM_BLOCK_TYPES;  // LitecoinCash: MinotaurX+Hive1.2
-    if (pindexPrev != chainActive.Tip() ||
-        (mempool.GetTransactionsUpdated() != nTransactionsUpdatedLast && GetTime() - nStart > 5) ||
-        fLastTemplateSupportsSegwit != fSupportsSegwit ||
-        lastPowType != powType) // LitecoinCash: MinotaurX+Hive1.2: Include powType check in cache refresh condition
-    {
-        // Clear pindexPrev so future calls make a new block, despite any failures from here on
-        pindexPrev = nullptr;
-
-        // Store the pindexBest used before CreateNewBlock, to avoid races
-        nTransactionsUpdatedLast = mempool.GetTransactionsUpdated();
-        CBlockIndex* pindexPrevNew = chainActive.Tip();
-        nStart = GetTime();
-        fLastTemplateSupportsSegwit = fSupportsSegwit;
-
-        // Create new block
-        CScript scriptDummy = CScript() << OP_TRUE;
-        pblocktemplate = BlockAssembler(Params()).CreateNewBlock(scriptDummy, fSupportsSegwit, nullptr, powType);   // LitecoinCash: MinotaurX+Hive1.2: Include powType
-        lastPowType = powType;   // LitecoinCash: MinotaurX+Hive1.2: Cache pow type just requested
-        if (!pblocktemplate)
-            throw JSONRPCError(RPC_OUT_OF_MEMORY, "Out of memory");
-
-        // Need to update only after we know CreateNewBlock succeeded
-        pindexPrev = pindexPrevNew;
-    }
+    // LitecoinCash: Block templates: The template manager keeps a template per pow type (and segwit
+    // support) current with the mempool, so there's no need to throttle refreshes here
+    if (!g_block_templates)
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Block template manager not running");
+    CBlockIndex* pindexPrev = chainActive.Tip();
+    nTransactionsUpdatedLast = mempool.GetTransactionsUpdated();
+    CScript scriptDummy = CScript() << OP_TRUE;
+    std::unique_ptr<CBlockTemplate> pblocktemplate = g_block_templates->GetBlockTemplate(scriptDummy, fSupportsSegwit, powType);
+    if (!pblocktemplate)
+        throw JSONRPCError(RPC_OUT_OF_MEMORY, "Out of memory");
     CBlock* pblock = &pblocktemplate->block; // pointer for convenience
     const Consensus::Params& consensusParams = Params().GetConsensus();
 
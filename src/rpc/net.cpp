@@ -20,6 +20,8 @@
 #include <utilstrencodings.h>
 #include <version.h>
 #include <warnings.h>
+#include <blockcache.h> // LitecoinCash: BlockCache
+#include <blockencodings.h> // LitecoinCash: CompactBlocks
 
 #include <univalue.h>
 
@@ -367,6 +369,17 @@ UniValue getnettotals(const JSONRPCRequest& request)
             "    \"serve_historical_blocks\": true|false,  (boolean) True if serving historical blocks\n"
             "    \"bytes_left_in_cycle\": t,               (numeric) Bytes left in current time cycle\n"
             "    \"time_left_in_cycle\": t                 (numeric) Seconds left in current time cycle\n"
+            "  },\n"
+            "  \"buffers\":\n"
+            "  {\n"
+            "    \"send_calls\": n,          (numeric) Calls that handed data to a socket\n"
+            "    \"messages_sent\": n,       (numeric) Messages fully handed over\n"
+            "    \"recv_calls\": n,          (numeric) Calls that read data from a socket\n"
+            "    \"recv_direct_bytes\": n,   (numeric) Bytes read straight into a message's buffer, without a copy\n"
+            "    \"pool_hits\": n,           (numeric) Messages received into a reused buffer\n"
+            "    \"pool_misses\": n,         (numeric) Messages that needed a buffer of their own\n"
+            "    \"pool_buffers\": n,        (numeric) Buffers waiting to be reused\n"
+            "    \"pool_bytes\": n           (numeric) Memory held by those buffers\n"
             "  }\n"
             "}\n"
             "\nExamples:\n"
@@ -389,9 +402,100 @@ UniValue getnettotals(const JSONRPCRequest& request)
     outboundLimit.push_back(Pair("bytes_left_in_cycle", g_connman->GetOutboundTargetBytesLeft()));
     outboundLimit.push_back(Pair("time_left_in_cycle", g_connman->GetMaxOutboundTimeLeftInCycle()));
     obj.push_back(Pair("uploadtarget", outboundLimit));
+
+    // LitecoinCash: NetBuffers
+    const NetBufferStats bufferStats = g_connman->GetNetBufferStats();
+    UniValue buffers(UniValue::VOBJ);
+    buffers.push_back(Pair("send_calls", bufferStats.nSendCalls));
+    buffers.push_back(Pair("messages_sent", bufferStats.nMessagesSent));
+    buffers.push_back(Pair("recv_calls", bufferStats.nRecvCalls));
+    buffers.push_back(Pair("recv_direct_bytes", bufferStats.nRecvDirectBytes));
+    buffers.push_back(Pair("pool_hits", bufferStats.nPoolHits));
+    buffers.push_back(Pair("pool_misses", bufferStats.nPoolMisses));
+    buffers.push_back(Pair("pool_buffers", (uint64_t)bufferStats.nPoolBuffers));
+    buffers.push_back(Pair("pool_bytes", (uint64_t)bufferStats.nPoolBytes));
+    obj.push_back(Pair("buffers", buffers));
     return obj;
 }
 
+UniValue getcompactblockinfo(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 0)
+        throw std::runtime_error(
+            "getcompactblockinfo\n"
+            "\nReturns how compact blocks (BIP 152) received since startup were reconstructed.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"blocks\": n,                 (numeric) Compact blocks received\n"
+            "  \"prefilled\": n,              (numeric) Transactions sent along with them\n"
+            "  \"mempool\": n,                (numeric) Transactions found in the mempool\n"
+            "  \"extra\": n,                  (numeric) Transactions found among recently seen transactions outside the mempool\n"
+            "  \"missing\": n,                (numeric) Transactions that had to be requested\n"
+            "  \"avg_reconstruct_ms\": x.xxx, (numeric) Average time spent matching short IDs, in milliseconds\n"
+            "  \"max_reconstruct_ms\": x.xxx  (numeric) Longest time spent matching short IDs, in milliseconds\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getcompactblockinfo", "")
+            + HelpExampleRpc("getcompactblockinfo", "")
+        );
+
+    const CompactBlockStats stats = GetCompactBlockStats();
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("blocks", stats.nBlocks));
+    ret.push_back(Pair("prefilled", stats.nTxPrefilled));
+    ret.push_back(Pair("mempool", stats.nTxMempool));
+    ret.push_back(Pair("extra", stats.nTxExtra));
+    ret.push_back(Pair("missing", stats.nTxMissing));
+    ret.push_back(Pair("avg_reconstruct_ms", stats.nBlocks ? 0.001 * stats.nReconstructMicros / stats.nBlocks : 0.0));
+    ret.push_back(Pair("max_reconstruct_ms", 0.001 * stats.nMaxReconstructMicros));
+    return ret;
+}
+
+UniValue getmessagestats(const JSONRPCRequest& request)
+{
+    if (request.fHelp || request.params.size() != 0)
+        throw std::runtime_error(
+            "getmessagestats\n"
+            "\nReturns how long peer messages handled since startup took, by message type.\n"
+            "\nResult:\n"
+            "{\n"
+            "  \"threads\": n,                    (numeric) Threads handling peer messages\n"
+            "  \"messages\": {\n"
+            "    \"type\": {                      (json object) A message type that was handled at least once\n"
+            "      \"count\": n,                  (numeric) Messages handled\n"
+            "      \"chainstate\": true|false,    (boolean) Whether handling it takes cs_main\n"
+            "      \"avg_wait_ms\": x.xxx,        (numeric) Average time from receiving to handling, in milliseconds\n"
+            "      \"avg_process_ms\": x.xxx,     (numeric) Average time spent handling, in milliseconds\n"
+            "      \"max_process_ms\": x.xxx      (numeric) Longest time spent handling one, in milliseconds\n"
+            "    }, ...\n"
+            "  }\n"
+            "}\n"
+            "\nExamples:\n"
+            + HelpExampleCli("getmessagestats", "")
+            + HelpExampleRpc("getmessagestats", "")
+        );
+    if(!g_connman)
+        throw JSONRPCError(RPC_CLIENT_P2P_DISABLED, "Error: Peer-to-peer functionality missing or disabled");
+
+    UniValue messages(UniValue::VOBJ);
+    for (const auto& entry : GetMessageProcessingStats()) {
+        const MessageProcessingStats& stats = entry.second;
+        UniValue obj(UniValue::VOBJ);
+        obj.push_back(Pair("count", stats.nCount));
+        obj.push_back(Pair("chainstate", MessageNeedsChainstate(entry.first)));
+        obj.push_back(Pair("avg_wait_ms", 0.001 * stats.nWaitMicros / stats.nCount));
+        obj.push_back(Pair("avg_process_ms", 0.001 * stats.nProcessMicros / stats.nCount));
+        obj.push_back(Pair("max_process_ms", 0.001 * stats.nMaxProcessMicros));
+        messages.push_back(Pair(entry.first, obj));
+    }
+
+    UniValue ret(UniValue::VOBJ);
+    ret.push_back(Pair("threads", g_connman->GetMsgHandlerThreads()));
+    ret.push_back(Pair("messages", messages));
+    return ret;
+}
+
 static UniValue GetNetworksInfo()
 {
     UniValue networks(UniValue::VARR);
@@ -429,6 +533,7 @@ UniValue getnetworkinfo(const JSONRPCRequest& request)
             "  \"timeoffset\": xxxxx,                   (numeric) the time offset\n"
             "  \"connections\": xxxxx,                  (numeric) the number of connections\n"
             "  \"networkactive\": true|false,           (bool) whether p2p networking is enabled\n"
+            "  \"socketevents\": \"xxx\",                 (string) how the sockets are waited on, select or epoll\n"
             "  \"networks\": [                          (array) information per network\n"
             "  {\n"
             "    \"name\": \"xxx\",                     (string) network (ipv4, ipv6 or onion)\n"
@@ -449,6 +554,13 @@ UniValue getnetworkinfo(const JSONRPCRequest& request)
             "  }\n"
             "  ,...\n"
             "  ]\n"
+            "  \"blockcache\": {                        (json object) the cache of serialized blocks served to peers\n"
+            "    \"entries\": xxx,                      (numeric) number of serialized blocks held\n"
+            "    \"usage\": xxx,                        (numeric) memory used in bytes\n"
+            "    \"limit\": xxx,                        (numeric) memory limit in bytes, 0 if disabled\n"
+            "    \"hits\": xxx,                         (numeric) block requests served from the cache\n"
+            "    \"misses\": xxx                        (numeric) block requests that had to read the block\n"
+            "  }\n"
             "  \"warnings\": \"...\"                    (string) any network and blockchain warnings\n"
             "}\n"
             "\nExamples:\n"
@@ -467,6 +579,7 @@ UniValue getnetworkinfo(const JSONRPCRequest& request)
     obj.push_back(Pair("timeoffset",    GetTimeOffset()));
     if (g_connman) {
         obj.push_back(Pair("networkactive", g_connman->GetNetworkActive()));
+        obj.push_back(Pair("socketevents",  SocketEventsModeToString(g_connman->GetSocketEventsMode())));    // LitecoinCash: SocketEvents
         obj.push_back(Pair("connections",   (int)g_connman->GetNodeCount(CConnman::CONNECTIONS_ALL)));
     }
     obj.push_back(Pair("networks",      GetNetworksInfo()));
@@ -485,6 +598,15 @@ UniValue getnetworkinfo(const JSONRPCRequest& request)
         }
     }
     obj.push_back(Pair("localaddresses", localAddresses));
+    // LitecoinCash: BlockCache
+    SerializedBlockCacheStats blockCacheStats = serializedBlockCache.GetStats();
+    UniValue blockCache(UniValue::VOBJ);
+    blockCache.push_back(Pair("entries", (uint64_t)blockCacheStats.nEntries));
+    blockCache.push_back(Pair("usage", (uint64_t)blockCacheStats.nBytes));
+    blockCache.push_back(Pair("limit", (uint64_t)blockCacheStats.nMaxBytes));
+    blockCache.push_back(Pair("hits", blockCacheStats.nHits));
+    blockCache.push_back(Pair("misses", blockCacheStats.nMisses));
+    obj.push_back(Pair("blockcache", blockCache));
     obj.push_back(Pair("warnings",       GetWarnings("statusbar")));
     return obj;
 }
@@ -639,6 +761,8 @@ static const CRPCCommand commands[] =
     { "network",            "listbanned",             &listbanned,             {} },
     { "network",            "clearbanned",            &clearbanned,            {} },
     { "network",            "setnetworkactive",       &setnetworkactive,       {"state"} },
+    { "network",            "getcompactblockinfo",    &getcompactblockinfo,    {} },        // LitecoinCash: CompactBlocks
+    { "network",            "getmessagestats",        &getmessagestats,        {} },        // LitecoinCash: MsgHandler
 };
 
 void RegisterNetRPCCommands(CRPCTable &t)
@@ -5,11 +5,17 @@
 
 #include <script/sigcache.h>
 
+#include <clientversion.h>
+#include <hash.h>
 #include <memusage.h>
 #include <pubkey.h>
 #include <random.h>
+#include <streams.h>
 #include <uint256.h>
 #include <util.h>
+#include <utiltime.h>
+
+#include <atomic>
 
 #include <cuckoocache.h>
 #include <boost/thread.hpp>
@@ -28,9 +34,14 @@ private:
     typedef CuckooCache::cache<uint256, SignatureCacheHasher> map_type;
     map_type setValid;
     boost::shared_mutex cs_sigcache;
+    uint32_t nElems;
+    // LitecoinCash: PersistSigCache
+    uint64_t nLoaded;
+    std::atomic<uint64_t> nHits;
+    std::atomic<uint64_t> nMisses;
 
 public:
-    CSignatureCache()
+    CSignatureCache() : nElems(0), nLoaded(0), nHits(0), nMisses(0)
     {
         GetRandBytes(nonce.begin(), 32);
     }
@@ -45,7 +56,12 @@ public:
     Get(const uint256& entry, const bool erase)
     {
         boost::shared_lock<boost::shared_mutex> lock(cs_sigcache);
-        return setValid.contains(entry, erase);
+        if (setValid.contains(entry, erase)) {
+            nHits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        nMisses.fetch_add(1, std::memory_order_relaxed);
+        return false;
     }
 
     void Set(uint256& entry)
@@ -55,7 +71,37 @@ public:
     }
     uint32_t setup_bytes(size_t n)
     {
-        return setValid.setup_bytes(n);
+        nElems = setValid.setup_bytes(n);
+        return nElems;
+    }
+
+    //! LitecoinCash: PersistSigCache: Copy out the nonce and the entries still in use
+    void Dump(uint256& nonceOut, std::vector<uint256>& entries)
+    {
+        boost::shared_lock<boost::shared_mutex> lock(cs_sigcache);
+        nonceOut = nonce;
+        setValid.for_each([&entries](const uint256& entry) { entries.push_back(entry); });
+    }
+
+    //! LitecoinCash: PersistSigCache: Switch to a saved nonce and add the entries computed with it, as far as they fit
+    size_t Load(const uint256& nonceIn, const std::vector<uint256>& entries)
+    {
+        boost::unique_lock<boost::shared_mutex> lock(cs_sigcache);
+        nonce = nonceIn;
+        nLoaded = std::min<size_t>(entries.size(), nElems);
+        for (size_t i = 0; i < nLoaded; i++)
+            setValid.insert(entries[i]);
+        return nLoaded;
+    }
+
+    SignatureCacheStats GetStats()
+    {
+        boost::shared_lock<boost::shared_mutex> lock(cs_sigcache);
+        SignatureCacheStats stats;
+        stats.nLoaded = nLoaded;
+        stats.nHits = nHits.load(std::memory_order_relaxed);
+        stats.nMisses = nMisses.load(std::memory_order_relaxed);
+        return stats;
     }
 };
 
@@ -92,3 +138,115 @@ bool CachingTransactionSignatureChecker::VerifySignature(const std::vector<unsig
         signatureCache.Set(entry);
     return true;
 }
+
+// LitecoinCash: PersistSigCache: Version of the files written by WriteSignatureCacheFile
+static const uint64_t SIGCACHE_DUMP_VERSION = 2;
+
+bool WriteSignatureCacheFile(const fs::path& path, const uint256& nonce, const std::vector<uint256>& entries, int nClientVersion)
+{
+    const fs::path pathTmp = path.string() + ".new";
+    try {
+        FILE* filestr = fsbridge::fopen(pathTmp, "wb");
+        if (!filestr) {
+            return false;
+        }
+
+        CAutoFile file(filestr, SER_DISK, CLIENT_VERSION);
+
+        const uint64_t version = SIGCACHE_DUMP_VERSION;
+        const int64_t nTime = GetTime();
+        CHashWriter hasher(SER_DISK, CLIENT_VERSION);
+        hasher << version << nClientVersion << nTime << nonce << entries;
+        file << version << nClientVersion << nTime << nonce << entries << hasher.GetHash();
+
+        FileCommit(file.Get());
+        file.fclose();
+        RenameOver(pathTmp, path);
+    } catch (const std::exception& e) {
+        LogPrintf("Failed to write %s: %s. Continuing anyway.\n", path.string(), e.what());
+        return false;
+    }
+    return true;
+}
+
+bool ReadSignatureCacheFile(const fs::path& path, uint256& nonce, std::vector<uint256>& entries, int64_t nMaxAge)
+{
+    FILE* filestr = fsbridge::fopen(path, "rb");
+    CAutoFile file(filestr, SER_DISK, CLIENT_VERSION);
+    if (file.IsNull()) {
+        return false;
+    }
+
+    try {
+        uint64_t version;
+        file >> version;
+        if (version != SIGCACHE_DUMP_VERSION) {
+            LogPrintf("Ignoring %s: unknown version %u\n", path.string(), version);
+            return false;
+        }
+        // A newer client may have fixed a bug that the saved results relied on, or an older one may lack a rule
+        int nClientVersion;
+        file >> nClientVersion;
+        if (nClientVersion != CLIENT_VERSION) {
+            LogPrintf("Ignoring %s: written by client version %d\n", path.string(), nClientVersion);
+            return false;
+        }
+
+        int64_t nTime;
+        uint256 nonceRead;
+        std::vector<uint256> entriesRead;
+        uint256 checksum;
+        file >> nTime >> nonceRead >> entriesRead >> checksum;
+
+        CHashWriter hasher(SER_DISK, CLIENT_VERSION);
+        hasher << version << nClientVersion << nTime << nonceRead << entriesRead;
+        if (hasher.GetHash() != checksum) {
+            LogPrintf("Ignoring %s: checksum mismatch\n", path.string());
+            return false;
+        }
+        const int64_t nNow = GetTime();
+        if (nTime > nNow || nNow - nTime > nMaxAge) {
+            LogPrintf("Ignoring %s: written %d seconds ago\n", path.string(), nNow - nTime);
+            return false;
+        }
+
+        nonce = nonceRead;
+        entries.swap(entriesRead);
+    } catch (const std::exception& e) {
+        LogPrintf("Ignoring %s: %s\n", path.string(), e.what());
+        return false;
+    }
+    return true;
+}
+
+bool DumpSignatureCache()
+{
+    const SignatureCacheStats stats = signatureCache.GetStats();
+    LogPrintf("Signature cache: %u entries loaded at startup, %u hits and %u misses since\n", stats.nLoaded, stats.nHits, stats.nMisses);
+
+    int64_t nStart = GetTimeMicros();
+    uint256 nonce;
+    std::vector<uint256> entries;
+    signatureCache.Dump(nonce, entries);
+    if (!WriteSignatureCacheFile(GetDataDir() / "sigcache.dat", nonce, entries))
+        return false;
+    LogPrintf("Dumped %u signature cache entries: %.2fms\n", entries.size(), (GetTimeMicros() - nStart) * 0.001);
+    return true;
+}
+
+bool LoadSignatureCache()
+{
+    int64_t nStart = GetTimeMicros();
+    uint256 nonce;
+    std::vector<uint256> entries;
+    if (!ReadSignatureCacheFile(GetDataDir() / "sigcache.dat", nonce, entries, MAX_SIGCACHE_FILE_AGE))
+        return false;
+    const size_t nLoaded = signatureCache.Load(nonce, entries);
+    LogPrintf("Loaded %u of %u saved signature cache entries: %.2fms\n", nLoaded, entries.size(), (GetTimeMicros() - nStart) * 0.001);
+    return true;
+}
+
+SignatureCacheStats GetSignatureCacheStats()
+{
+    return signatureCache.GetStats();
+}
@@ -6,7 +6,10 @@
 #ifndef BITCOIN_SCRIPT_SIGCACHE_H
 #define BITCOIN_SCRIPT_SIGCACHE_H
 
+#include <clientversion.h>
+#include <fs.h>
 #include <script/interpreter.h>
+#include <uint256.h>
 
 #include <vector>
 
@@ -16,6 +19,17 @@
 static const unsigned int DEFAULT_MAX_SIG_CACHE_SIZE = 32;
 // Maximum sig cache size allowed
 static const int64_t MAX_MAX_SIG_CACHE_SIZE = 16384;
+/** LitecoinCash: PersistSigCache: Default for -persistsigcache */
+static const bool DEFAULT_PERSIST_SIGCACHE = true;
+/** LitecoinCash: PersistSigCache: Saved caches older than this (in seconds) aren't loaded */
+static const int64_t MAX_SIGCACHE_FILE_AGE = 3 * 24 * 60 * 60;
+
+/** LitecoinCash: PersistSigCache: Counters since startup */
+struct SignatureCacheStats {
+    uint64_t nLoaded = 0;       //!< Entries loaded from disk at startup
+    uint64_t nHits = 0;         //!< Lookups found in the cache
+    uint64_t nMisses = 0;       //!< Lookups that had to do the verification
+};
 
 class CPubKey;
 
@@ -53,4 +67,21 @@ public:
 
 void InitSignatureCache();
 
+/**
+ * LitecoinCash: PersistSigCache: Save a cache's nonce and entries, along with the time, the version of the client
+ * that verified them and a checksum. The entries are only meaningful together with the nonce they were computed with.
+ */
+bool WriteSignatureCacheFile(const fs::path& path, const uint256& nonce, const std::vector<uint256>& entries, int nClientVersion = CLIENT_VERSION);
+/**
+ * LitecoinCash: PersistSigCache: Read back a saved cache, if it is intact, no older than nMaxAge seconds and written by
+ * this very version. Entries vouch for verification results, which a different version may not agree with.
+ */
+bool ReadSignatureCacheFile(const fs::path& path, uint256& nonce, std::vector<uint256>& entries, int64_t nMaxAge);
+
+/** LitecoinCash: PersistSigCache: Save the signature cache to disk. */
+bool DumpSignatureCache();
+/** LitecoinCash: PersistSigCache: Load the signature cache from disk, replacing its nonce. Call before any lookups. */
+bool LoadSignatureCache();
+SignatureCacheStats GetSignatureCacheStats();
+
 #endif // BITCOIN_SCRIPT_SIGCACHE_H
@@ -0,0 +1,752 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <stratum.h>
+
+#include <arith_uint256.h>
+#include <base58.h>
+#include <chain.h>
+#include <chainparams.h>
+#include <consensus/merkle.h>
+#include <miner.h>
+#include <netbase.h>
+#include <pow.h>
+#include <random.h>
+#include <script/standard.h>
+#include <streams.h>
+#include <timedata.h>
+#include <txmempool.h>
+#include <util.h>
+#include <utilstrencodings.h>
+#include <utiltime.h>
+#include <validation.h>
+#include <validationinterface.h>
+#include <version.h>
+
+#include <univalue.h>
+
+#include <deque>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include <event2/buffer.h>
+#include <event2/bufferevent.h>
+#include <event2/event.h>
+#include <event2/listener.h>
+#include <event2/thread.h>
+#include <event2/util.h>
+
+const std::string DEFAULT_STRATUM_BIND = "127.0.0.1";
+
+/** Seconds between checks for mempool changes worth a new job */
+static const int STRATUM_JOB_REFRESH_INTERVAL = 5;
+/** Disconnect clients that stay silent for this many seconds */
+static const int STRATUM_CLIENT_TIMEOUT = 600;
+/** Maximum length of a single request line */
+static const size_t MAX_STRATUM_LINE_LENGTH = 16 * 1024;
+/** Extranonce sizes; extranonce1 is assigned per connection, extranonce2 is rolled by the miner */
+static const int STRATUM_EXTRANONCE1_SIZE = 4;
+static const int STRATUM_EXTRANONCE2_SIZE = 4;
+/** Jobs kept per pow type for late shares; older ones are forgotten even while the tip stays put */
+static const size_t MAX_STRATUM_JOBS_PER_TYPE = 8;
+/** Distinct shares remembered per job; once reached, miners are moved onto a fresh job */
+static const size_t MAX_STRATUM_SHARES_PER_JOB = 50000;
+
+/** Stratum error codes */
+enum StratumError {
+    STRATUM_ERR_OTHER = 20,
+    STRATUM_ERR_JOB_NOT_FOUND = 21,
+    STRATUM_ERR_DUPLICATE_SHARE = 22,
+    STRATUM_ERR_LOW_DIFFICULTY = 23,
+    STRATUM_ERR_UNAUTHORIZED = 24,
+    STRATUM_ERR_NOT_SUBSCRIBED = 25,
+};
+
+/** A unit of work for one pow type, shared by all clients on that algorithm's port */
+struct StratumJob {
+    std::string strId;
+    POW_TYPE powType;
+    CBlock block;                           // Template block; the coinbase is rebuilt per client
+    std::vector<uint256> vMerkleBranch;     // Branch from the coinbase to the merkle root
+    int nHeight;
+    int64_t nTimeMin;                       // Earliest acceptable ntime
+    int64_t nMaxFutureBlockTime;
+    unsigned int nTransactionsUpdated;      // mempool.GetTransactionsUpdated() when this job was built
+    int64_t nTimeCreated;
+    std::set<uint256> setShares;            // Header hashes of the shares accepted on this job
+    std::map<CScript, std::pair<std::string, std::string> > mapCoinbaseParts;   // coinb1/coinb2 by payout script
+};
+
+struct StratumClient {
+    POW_TYPE powType;
+    std::string strPeer;
+    std::vector<unsigned char> vchExtraNonce1;
+    bool fSubscribed;
+    bool fAuthorized;
+    std::string strWorker;
+    CScript scriptPayout;
+};
+
+// All of the following are only touched from the stratum thread, except where noted
+static struct event_base* stratumBase = nullptr;
+static boost::thread stratumThread;
+static std::vector<struct evconnlistener*> vStratumListeners;
+static struct event* evStratumTip = nullptr;        // Activated from the validation interface queue on tip changes
+static struct event* evStratumTimer = nullptr;
+static std::map<struct bufferevent*, StratumClient> mapStratumClients;
+static std::map<std::string, std::shared_ptr<StratumJob> > mapStratumJobs;
+static std::deque<std::string> dequeStratumJobIds[NUM_BLOCK_TYPES];   // Ids in mapStratumJobs by pow type, oldest first
+static std::shared_ptr<StratumJob> currentStratumJob[NUM_BLOCK_TYPES];
+static arith_uint256 stratumShareTarget[NUM_BLOCK_TYPES];
+static double dStratumDifficulty = DEFAULT_STRATUM_DIFFICULTY;
+static CScript scriptStratumPayout;                 // From -stratumaddress; if empty, clients are paid to their username
+static uint32_t nStratumExtraNonce1 = 0;
+static uint64_t nStratumJobId = 0;
+
+/** Wakes the stratum thread when the active chain tip moves */
+class StratumNotifier : public CValidationInterface
+{
+protected:
+    void UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlockIndex *pindexFork, bool fInitialDownload) override {
+        if (!fInitialDownload && evStratumTip)
+            event_active(evStratumTip, EV_TIMEOUT, 0);
+    }
+};
+static std::unique_ptr<StratumNotifier> stratumNotifier;
+
+// Share target for the given pow type at the given stratum difficulty, with difficulty 1 being the algorithm's pow limit
+static arith_uint256 GetStratumShareTarget(POW_TYPE powType, double dDifficulty)
+{
+    const Consensus::Params& consensusParams = Params().GetConsensus();
+    const arith_uint256 bnLimit = UintToArith256((size_t)powType < consensusParams.powTypeLimits.size() ? consensusParams.powTypeLimits[powType] : consensusParams.powLimit);
+    const arith_uint256 bnTarget = bnLimit / std::max((uint64_t)1, (uint64_t)(dDifficulty * 65536));
+    if (bnTarget > (~arith_uint256() >> 16))
+        return ~arith_uint256();
+    return bnTarget << 16;
+}
+
+// Stratum sends the previous block hash in internal byte order, with each 32-bit word byte-swapped
+static std::string StratumPrevHashHex(const uint256& hash)
+{
+    std::vector<unsigned char> vch(hash.begin(), hash.end());
+    for (size_t i = 0; i < vch.size(); i += 4) {
+        std::swap(vch[i], vch[i + 3]);
+        std::swap(vch[i + 1], vch[i + 2]);
+    }
+    return HexStr(vch);
+}
+
+// Parse a big-endian 32-bit hex field (ntime, nonce)
+static bool ParseStratumUInt32(const UniValue& value, uint32_t& n)
+{
+    if (!value.isStr() || value.get_str().size() != 8 || !IsHex(value.get_str()))
+        return false;
+    const std::vector<unsigned char> vch = ParseHex(value.get_str());
+    n = ((uint32_t)vch[0] << 24) | ((uint32_t)vch[1] << 16) | ((uint32_t)vch[2] << 8) | (uint32_t)vch[3];
+    return true;
+}
+
+// Coinbase for the given job paying to scriptPayout, with vchExtraNonce (extranonce1 + extranonce2) pushed after the height
+static CMutableTransaction MakeStratumCoinbase(const StratumJob& job, const CScript& scriptPayout, const std::vector<unsigned char>& vchExtraNonce)
+{
+    CMutableTransaction tx(*job.block.vtx[0]);
+    tx.vout[0].scriptPubKey = scriptPayout;
+    tx.vin[0].scriptSig = (CScript() << job.nHeight << vchExtraNonce) + COINBASE_FLAGS;
+    return tx;
+}
+
+// Split the serialized (non-witness) coinbase around the extranonce for mining.notify
+static const std::pair<std::string, std::string>& GetStratumCoinbaseParts(StratumJob& job, const CScript& scriptPayout)
+{
+    std::map<CScript, std::pair<std::string, std::string> >::const_iterator it = job.mapCoinbaseParts.find(scriptPayout);
+    if (it != job.mapCoinbaseParts.end())
+        return it->second;
+
+    const int nExtraNonceSize = STRATUM_EXTRANONCE1_SIZE + STRATUM_EXTRANONCE2_SIZE;
+    const CMutableTransaction tx = MakeStratumCoinbase(job, scriptPayout, std::vector<unsigned char>(nExtraNonceSize, 0));
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION | SERIALIZE_TRANSACTION_NO_WITNESS);
+    ss << tx;
+
+    // nVersion, vin count, prevout, scriptSig length, then the height push and the extranonce push opcode
+    const size_t nOffset = 4 + 1 + 36 + GetSizeOfCompactSize(tx.vin[0].scriptSig.size()) + (CScript() << job.nHeight).size() + 1;
+    assert(nOffset + nExtraNonceSize <= ss.size());
+    std::pair<std::string, std::string> parts(HexStr(ss.begin(), ss.begin() + nOffset), HexStr(ss.begin() + nOffset + nExtraNonceSize, ss.end()));
+    return job.mapCoinbaseParts.emplace(scriptPayout, parts).first->second;
+}
+
+// Build a new job for the given pow type on the current tip
+static std::shared_ptr<StratumJob> BuildStratumJob(POW_TYPE powType)
+{
+    if (IsInitialBlockDownload())
+        return nullptr;
+
+    int64_t nTimeStart = GetTimeMicros();
+    const unsigned int nTransactionsUpdated = mempool.GetTransactionsUpdated();
+    std::unique_ptr<CBlockTemplate> pblocktemplate;
+    try {
+        pblocktemplate = g_block_templates->GetBlockTemplate(CScript() << OP_TRUE, true, powType);   // LitecoinCash: Block templates
+    } catch (const std::exception& e) {
+        LogPrint(BCLog::STRATUM, "stratum: Can't create %s job: %s\n", POW_TYPE_NAMES[powType], e.what());
+        return nullptr;
+    }
+    if (!pblocktemplate)
+        return nullptr;
+
+    std::shared_ptr<StratumJob> job = std::make_shared<StratumJob>();
+    job->strId = strprintf("%x", ++nStratumJobId);
+    job->powType = powType;
+    job->block = pblocktemplate->block;
+    job->nTransactionsUpdated = nTransactionsUpdated;
+    job->nTimeCreated = GetTime();
+    {
+        LOCK(cs_main);
+        BlockMap::const_iterator mi = mapBlockIndex.find(job->block.hashPrevBlock);
+        if (mi == mapBlockIndex.end())
+            return nullptr;
+        const CBlockIndex* pindexPrev = mi->second;
+        job->nHeight = pindexPrev->nHeight + 1;
+        job->nTimeMin = pindexPrev->GetMedianTimePast() + 1;
+        job->nMaxFutureBlockTime = IsMinotaurXEnabled(pindexPrev, Params().GetConsensus()) ? MAX_FUTURE_BLOCK_TIME_MINOTAURX : MAX_FUTURE_BLOCK_TIME;
+    }
+
+    // The branch for the coinbase doesn't depend on the coinbase itself, so it's shared by every client
+    std::vector<uint256> vLeaves;
+    vLeaves.reserve(job->block.vtx.size());
+    for (const CTransactionRef& tx : job->block.vtx)
+        vLeaves.push_back(tx->GetHash());
+    job->vMerkleBranch = ComputeMerkleBranch(vLeaves, 0);
+
+    LogPrint(BCLog::STRATUM, "stratum: New %s job %s at height %d with %u txs in %.2fms\n", POW_TYPE_NAMES[powType], job->strId, job->nHeight, job->block.vtx.size(), 0.001 * (GetTimeMicros() - nTimeStart));
+    return job;
+}
+
+static void StratumSend(struct bufferevent* bev, const UniValue& message)
+{
+    const std::string str = message.write() + "\n";
+    bufferevent_write(bev, str.data(), str.size());
+}
+
+static void StratumReply(struct bufferevent* bev, const UniValue& id, const UniValue& result)
+{
+    UniValue reply(UniValue::VOBJ);
+    reply.push_back(Pair("id", id));
+    reply.push_back(Pair("result", result));
+    reply.push_back(Pair("error", NullUniValue));
+    StratumSend(bev, reply);
+}
+
+static void StratumReplyError(struct bufferevent* bev, const UniValue& id, StratumError code, const std::string& strMessage)
+{
+    UniValue error(UniValue::VARR);
+    error.push_back((int)code);
+    error.push_back(strMessage);
+    error.push_back(NullUniValue);
+
+    UniValue reply(UniValue::VOBJ);
+    reply.push_back(Pair("id", id));
+    reply.push_back(Pair("result", NullUniValue));
+    reply.push_back(Pair("error", error));
+    StratumSend(bev, reply);
+}
+
+static void StratumNotify(struct bufferevent* bev, const std::string& strMethod, const UniValue& params)
+{
+    UniValue notification(UniValue::VOBJ);
+    notification.push_back(Pair("id", NullUniValue));
+    notification.push_back(Pair("method", strMethod));
+    notification.push_back(Pair("params", params));
+    StratumSend(bev, notification);
+}
+
+static void StratumSendJob(struct bufferevent* bev, const StratumClient& client, StratumJob& job, bool fClean)
+{
+    const std::pair<std::string, std::string>& coinbase = GetStratumCoinbaseParts(job, client.scriptPayout);
+
+    UniValue branch(UniValue::VARR);
+    for (const uint256& hash : job.vMerkleBranch)
+        branch.push_back(HexStr(hash.begin(), hash.end()));
+
+    UniValue params(UniValue::VARR);
+    params.push_back(job.strId);
+    params.push_back(StratumPrevHashHex(job.block.hashPrevBlock));
+    params.push_back(coinbase.first);
+    params.push_back(coinbase.second);
+    params.push_back(branch);
+    params.push_back(strprintf("%08x", (uint32_t)job.block.nVersion));
+    params.push_back(strprintf("%08x", job.block.nBits));
+    params.push_back(strprintf("%08x", job.block.nTime));
+    params.push_back(fClean);
+    StratumNotify(bev, "mining.notify", params);
+}
+
+// Make a job available for shares, forgetting the oldest of its pow type beyond MAX_STRATUM_JOBS_PER_TYPE
+static void AddStratumJob(const std::shared_ptr<StratumJob>& job)
+{
+    mapStratumJobs[job->strId] = job;
+    std::deque<std::string>& dequeIds = dequeStratumJobIds[job->powType];
+    dequeIds.push_back(job->strId);
+    while (dequeIds.size() > MAX_STRATUM_JOBS_PER_TYPE) {
+        mapStratumJobs.erase(dequeIds.front());
+        dequeIds.pop_front();
+    }
+}
+
+static void StratumBroadcastJob(StratumJob& job, bool fClean)
+{
+    for (std::pair<struct bufferevent* const, StratumClient>& item : mapStratumClients)
+        if (item.second.powType == job.powType && item.second.fAuthorized)
+            StratumSendJob(item.first, item.second, job, fClean);
+}
+
+// Rebuild jobs for any pow type with miners attached, if the tip has moved or the mempool has changed enough
+static void UpdateStratumJobs(bool fForce)
+{
+    uint256 hashTip;
+    {
+        LOCK(cs_main);
+        if (!chainActive.Tip())
+            return;
+        hashTip = chainActive.Tip()->GetBlockHash();
+    }
+
+    // Work on an old tip is useless; drop it so stale shares are reported as such
+    bool fNewTip = false;
+    for (std::map<std::string, std::shared_ptr<StratumJob> >::iterator it = mapStratumJobs.begin(); it != mapStratumJobs.end(); ) {
+        if (it->second->block.hashPrevBlock != hashTip) {
+            fNewTip = true;
+            it = mapStratumJobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (int i = 0; i < NUM_BLOCK_TYPES; i++) {
+        const POW_TYPE powType = (POW_TYPE)i;
+        std::shared_ptr<StratumJob>& current = currentStratumJob[i];
+        bool fClean = !current || current->block.hashPrevBlock != hashTip;
+
+        bool fMiners = false;
+        for (const std::pair<struct bufferevent* const, StratumClient>& item : mapStratumClients)
+            fMiners |= item.second.powType == powType && item.second.fAuthorized;
+        if (!fMiners) {
+            current.reset();
+            continue;
+        }
+
+        if (!fClean && !fForce && (current->nTransactionsUpdated == mempool.GetTransactionsUpdated() || GetTime() - current->nTimeCreated < STRATUM_JOB_REFRESH_INTERVAL))
+            continue;
+
+        std::shared_ptr<StratumJob> job = BuildStratumJob(powType);
+        if (!job) {
+            if (fClean)
+                current.reset();
+            continue;
+        }
+        current = job;
+        AddStratumJob(job);
+        StratumBroadcastJob(*job, fClean);
+    }
+
+    if (fNewTip)
+        LogPrint(BCLog::STRATUM, "stratum: New tip %s, %u miners notified\n", hashTip.ToString(), mapStratumClients.size());
+}
+
+// Fired on tip changes and every STRATUM_JOB_REFRESH_INTERVAL seconds
+static void StratumUpdateCallback(evutil_socket_t fd, short what, void* arg)
+{
+    UpdateStratumJobs(false);
+}
+
+static void SubmitStratumBlock(const StratumClient& client, const CBlock& block)
+{
+    std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>(block);
+    {
+        LOCK(cs_main);
+        BlockMap::const_iterator mi = mapBlockIndex.find(pblock->hashPrevBlock);
+        if (mi != mapBlockIndex.end())
+            UpdateUncommittedBlockStructures(*pblock, mi->second, Params().GetConsensus());
+    }
+
+    bool fNewBlock = false;
+    if (ProcessNewBlock(Params(), pblock, true, &fNewBlock))
+        LogPrintf("stratum: %s block %s found by %s (%s)\n", POW_TYPE_NAMES[pblock->GetPoWType() < NUM_BLOCK_TYPES ? pblock->GetPoWType() : 0], pblock->GetHash().ToString(), client.strWorker, client.strPeer);
+    else
+        LogPrintf("stratum: Block %s from %s (%s) was not accepted\n", pblock->GetHash().ToString(), client.strWorker, client.strPeer);
+}
+
+// mining.submit: [worker, job_id, extranonce2, ntime, nonce]
+static void StratumSubmit(struct bufferevent* bev, StratumClient& client, const UniValue& id, const UniValue& params)
+{
+    if (!client.fSubscribed)
+        return StratumReplyError(bev, id, STRATUM_ERR_NOT_SUBSCRIBED, "Not subscribed");
+    if (!client.fAuthorized)
+        return StratumReplyError(bev, id, STRATUM_ERR_UNAUTHORIZED, "Unauthorized worker");
+    if (params.size() < 5 || !params[1].isStr() || !params[2].isStr())
+        return StratumReplyError(bev, id, STRATUM_ERR_OTHER, "Invalid parameters");
+
+    std::map<std::string, std::shared_ptr<StratumJob> >::iterator it = mapStratumJobs.find(params[1].get_str());
+    if (it == mapStratumJobs.end() || it->second->powType != client.powType)
+        return StratumReplyError(bev, id, STRATUM_ERR_JOB_NOT_FOUND, "Job not found");
+    const std::shared_ptr<StratumJob> pjob = it->second;
+    StratumJob& job = *pjob;
+
+    // Don't let the duplicate check grow without bound while the tip stays put; roll the miners on instead
+    if (job.setShares.size() >= MAX_STRATUM_SHARES_PER_JOB) {
+        std::shared_ptr<StratumJob>& current = currentStratumJob[client.powType];
+        if (current == pjob) {
+            std::shared_ptr<StratumJob> fresh = BuildStratumJob(client.powType);
+            if (fresh) {
+                current = fresh;
+                AddStratumJob(fresh);
+                StratumBroadcastJob(*fresh, false);
+            }
+        }
+        return StratumReplyError(bev, id, STRATUM_ERR_JOB_NOT_FOUND, "Job has expired");
+    }
+
+    const std::string& strExtraNonce2 = params[2].get_str();
+    uint32_t nTime, nNonce;
+    if (strExtraNonce2.size() != STRATUM_EXTRANONCE2_SIZE * 2 || !IsHex(strExtraNonce2) || !ParseStratumUInt32(params[3], nTime) || !ParseStratumUInt32(params[4], nNonce))
+        return StratumReplyError(bev, id, STRATUM_ERR_OTHER, "Invalid parameters");
+    if (nTime < job.nTimeMin || nTime > GetAdjustedTime() + job.nMaxFutureBlockTime)
+        return StratumReplyError(bev, id, STRATUM_ERR_OTHER, "ntime out of range");
+
+    std::vector<unsigned char> vchExtraNonce(client.vchExtraNonce1);
+    const std::vector<unsigned char> vchExtraNonce2 = ParseHex(strExtraNonce2);
+    vchExtraNonce.insert(vchExtraNonce.end(), vchExtraNonce2.begin(), vchExtraNonce2.end());
+
+    CBlock block(job.block);
+    block.vtx[0] = MakeTransactionRef(MakeStratumCoinbase(job, client.scriptPayout, vchExtraNonce));
+    block.hashMerkleRoot = ComputeMerkleRootFromBranch(block.vtx[0]->GetHash(), job.vMerkleBranch, 0);
+    block.nTime = nTime;
+    block.nNonce = nNonce;
+
+    // Only accepted shares are remembered, so that junk can't fill the job up and expire it for everyone else
+    const uint256 hashBlock = block.GetHash();
+    if (job.setShares.count(hashBlock))
+        return StratumReplyError(bev, id, STRATUM_ERR_DUPLICATE_SHARE, "Duplicate share");
+
+    const arith_uint256 bnHash = UintToArith256(block.GetPoWHash());
+    bool fNegative, fOverflow;
+    arith_uint256 bnTarget;
+    bnTarget.SetCompact(block.nBits, &fNegative, &fOverflow);
+    if (!fNegative && !fOverflow && bnTarget != 0 && bnHash <= bnTarget) {
+        SubmitStratumBlock(client, block);
+    } else if (bnHash > stratumShareTarget[client.powType]) {
+        LogPrint(BCLog::STRATUM, "stratum: Low difficulty share from %s (%s) on job %s\n", client.strWorker, client.strPeer, job.strId);
+        return StratumReplyError(bev, id, STRATUM_ERR_LOW_DIFFICULTY, "Low difficulty share");
+    }
+    job.setShares.insert(hashBlock);
+
+    LogPrint(BCLog::STRATUM, "stratum: Accepted share from %s (%s) on job %s\n", client.strWorker, client.strPeer, job.strId);
+    StratumReply(bev, id, true);
+}
+
+// mining.authorize: [username, password]. The username is "<address>[.<worker>]" unless -stratumaddress is set.
+static void StratumAuthorize(struct bufferevent* bev, StratumClient& client, const UniValue& id, const UniValue& params)
+{
+    if (params.size() < 1 || !params[0].isStr())
+        return StratumReplyError(bev, id, STRATUM_ERR_OTHER, "Invalid parameters");
+
+    const std::string& strUser = params[0].get_str();
+    CScript scriptPayout = scriptStratumPayout;
+    if (scriptPayout.empty()) {
+        CTxDestination dest = DecodeDestination(strUser.substr(0, strUser.find('.')));
+        if (!IsValidDestination(dest)) {
+            LogPrint(BCLog::STRATUM, "stratum: Refused worker %s (%s): not a valid payout address\n", SanitizeString(strUser), client.strPeer);
+            return StratumReplyError(bev, id, STRATUM_ERR_UNAUTHORIZED, "Username must be a valid payout address");
+        }
+        scriptPayout = GetScriptForDestination(dest);
+    }
+
+    client.fAuthorized = true;
+    client.strWorker = SanitizeString(strUser);
+    client.scriptPayout = scriptPayout;
+    StratumReply(bev, id, true);
+    LogPrint(BCLog::STRATUM, "stratum: Authorized %s worker %s (%s)\n", POW_TYPE_NAMES[client.powType], client.strWorker, client.strPeer);
+
+    if (!client.fSubscribed)
+        return;
+
+    // Get the new miner working straight away
+    std::shared_ptr<StratumJob>& current = currentStratumJob[client.powType];
+    if (!current) {
+        current = BuildStratumJob(client.powType);
+        if (!current)
+            return;
+        AddStratumJob(current);
+    }
+    StratumSendJob(bev, client, *current, true);
+}
+
+// mining.subscribe: [user agent, session id]
+static void StratumSubscribe(struct bufferevent* bev, StratumClient& client, const UniValue& id, const UniValue& params)
+{
+    const std::string strSubscription = HexStr(client.vchExtraNonce1);
+
+    UniValue difficulty(UniValue::VARR);
+    difficulty.push_back("mining.set_difficulty");
+    difficulty.push_back(strSubscription);
+    UniValue notify(UniValue::VARR);
+    notify.push_back("mining.notify");
+    notify.push_back(strSubscription);
+    UniValue subscriptions(UniValue::VARR);
+    subscriptions.push_back(difficulty);
+    subscriptions.push_back(notify);
+
+    UniValue result(UniValue::VARR);
+    result.push_back(subscriptions);
+    result.push_back(HexStr(client.vchExtraNonce1));
+    result.push_back(STRATUM_EXTRANONCE2_SIZE);
+    StratumReply(bev, id, result);
+    client.fSubscribed = true;
+
+    UniValue diffParams(UniValue::VARR);
+    diffParams.push_back(dStratumDifficulty);
+    StratumNotify(bev, "mining.set_difficulty", diffParams);
+}
+
+// Handle one request line. Returns false if the client should be dropped.
+static bool StratumProcessLine(struct bufferevent* bev, StratumClient& client, const std::string& strLine)
+{
+    if (strLine.find_first_not_of(" \t\r") == std::string::npos)
+        return true;
+
+    UniValue request;
+    if (!request.read(strLine) || !request.isObject()) {
+        LogPrint(BCLog::STRATUM, "stratum: Malformed request from %s\n", client.strPeer);
+        return false;
+    }
+    const UniValue& id = find_value(request, "id");
+    const UniValue& method = find_value(request, "method");
+    const UniValue& params = find_value(request, "params");
+    if (!method.isStr())
+        return false;
+    const UniValue emptyParams(UniValue::VARR);
+    const UniValue& paramsArray = params.isArray() ? params : emptyParams;
+
+    const std::string& strMethod = method.get_str();
+    if (strMethod == "mining.subscribe") {
+        StratumSubscribe(bev, client, id, paramsArray);
+    } else if (strMethod == "mining.authorize") {
+        StratumAuthorize(bev, client, id, paramsArray);
+    } else if (strMethod == "mining.submit") {
+        StratumSubmit(bev, client, id, paramsArray);
+    } else if (strMethod == "mining.extranonce.subscribe") {
+        StratumReply(bev, id, true);    // Extranonce1 never changes during a session
+    } else if (strMethod == "mining.configure") {
+        UniValue result(UniValue::VOBJ);
+        result.push_back(Pair("version-rolling", false));
+        StratumReply(bev, id, result);
+    } else {
+        StratumReplyError(bev, id, STRATUM_ERR_OTHER, "Method not found");
+    }
+    return true;
+}
+
+static void StratumDisconnect(struct bufferevent* bev)
+{
+    std::map<struct bufferevent*, StratumClient>::iterator it = mapStratumClients.find(bev);
+    if (it != mapStratumClients.end()) {
+        LogPrint(BCLog::STRATUM, "stratum: Disconnected %s\n", it->second.strPeer);
+        mapStratumClients.erase(it);
+    }
+    bufferevent_free(bev);
+}
+
+static void StratumReadCallback(struct bufferevent* bev, void* ctx)
+{
+    std::map<struct bufferevent*, StratumClient>::iterator it = mapStratumClients.find(bev);
+    if (it == mapStratumClients.end())
+        return;
+
+    struct evbuffer* input = bufferevent_get_input(bev);
+    size_t n_read_out = 0;
+    char* line;
+    while ((line = evbuffer_readln(input, &n_read_out, EVBUFFER_EOL_CRLF)) != nullptr) {
+        std::string strLine(line, n_read_out);
+        free(line);
+        if (n_read_out > MAX_STRATUM_LINE_LENGTH || !StratumProcessLine(bev, it->second, strLine)) {
+            StratumDisconnect(bev);
+            return;
+        }
+    }
+    if (evbuffer_get_length(input) > MAX_STRATUM_LINE_LENGTH) {
+        LogPrint(BCLog::STRATUM, "stratum: Request too long from %s\n", it->second.strPeer);
+        StratumDisconnect(bev);
+    }
+}
+
+static void StratumEventCallback(struct bufferevent* bev, short what, void* ctx)
+{
+    if (what & (BEV_EVENT_EOF | BEV_EVENT_ERROR | BEV_EVENT_TIMEOUT))
+        StratumDisconnect(bev);
+}
+
+static void StratumAcceptCallback(struct evconnlistener* listener, evutil_socket_t fd, struct sockaddr* addr, int socklen, void* ctx)
+{
+    struct bufferevent* bev = bufferevent_socket_new(stratumBase, fd, BEV_OPT_CLOSE_ON_FREE);
+    if (!bev) {
+        evutil_closesocket(fd);
+        return;
+    }
+
+    CService peer;
+    peer.SetSockAddr(addr);
+
+    StratumClient& client = mapStratumClients[bev];
+    client.powType = (POW_TYPE)(intptr_t)ctx;
+    client.strPeer = peer.ToString();
+    client.fSubscribed = false;
+    client.fAuthorized = false;
+    const uint32_t nExtraNonce1 = nStratumExtraNonce1++;
+    client.vchExtraNonce1.resize(STRATUM_EXTRANONCE1_SIZE);
+    for (int i = 0; i < STRATUM_EXTRANONCE1_SIZE; i++)
+        client.vchExtraNonce1[i] = (nExtraNonce1 >> (8 * (STRATUM_EXTRANONCE1_SIZE - 1 - i))) & 0xff;
+
+    struct timeval tv = {STRATUM_CLIENT_TIMEOUT, 0};
+    bufferevent_set_timeouts(bev, &tv, nullptr);
+    bufferevent_setcb(bev, StratumReadCallback, nullptr, StratumEventCallback, nullptr);
+    bufferevent_enable(bev, EV_READ | EV_WRITE);
+    LogPrint(BCLog::STRATUM, "stratum: New %s connection from %s\n", POW_TYPE_NAMES[client.powType], client.strPeer);
+}
+
+static bool StratumBind(const std::string& strBind, uint16_t nPort, POW_TYPE powType)
+{
+    CService addrBind;
+    if (!Lookup(strBind.c_str(), addrBind, nPort, false)) {
+        LogPrintf("stratum: Invalid bind address %s\n", strBind);
+        return false;
+    }
+    struct sockaddr_storage sockaddr;
+    socklen_t len = sizeof(sockaddr);
+    if (!addrBind.GetSockAddr((struct sockaddr*)&sockaddr, &len)) {
+        LogPrintf("stratum: Invalid bind address %s\n", addrBind.ToString());
+        return false;
+    }
+
+    struct evconnlistener* listener = evconnlistener_new_bind(stratumBase, StratumAcceptCallback, (void*)(intptr_t)powType,
+        LEV_OPT_CLOSE_ON_FREE | LEV_OPT_REUSEABLE, -1, (struct sockaddr*)&sockaddr, len);
+    if (!listener) {
+        LogPrintf("stratum: Binding %s stratum on %s failed\n", POW_TYPE_NAMES[powType], addrBind.ToString());
+        return false;
+    }
+    vStratumListeners.push_back(listener);
+    LogPrintf("stratum: Serving %s stratum on %s\n", POW_TYPE_NAMES[powType], addrBind.ToString());
+    return true;
+}
+
+static void StratumThread()
+{
+    RenameThread("litecoincash-stratum");
+    event_base_dispatch(stratumBase);
+}
+
+bool StartStratumServer()
+{
+    assert(!stratumBase);
+
+    dStratumDifficulty = DEFAULT_STRATUM_DIFFICULTY;
+    if (gArgs.IsArgSet("-stratumdifficulty")) {
+        const std::string strDifficulty = gArgs.GetArg("-stratumdifficulty", "");
+        if (!ParseDouble(strDifficulty, &dStratumDifficulty) || dStratumDifficulty <= 0 || dStratumDifficulty > 1e12) {
+            LogPrintf("stratum: Invalid -stratumdifficulty '%s'\n", strDifficulty);
+            return false;
+        }
+    }
+    for (int i = 0; i < NUM_BLOCK_TYPES; i++)
+        stratumShareTarget[i] = GetStratumShareTarget((POW_TYPE)i, dStratumDifficulty);
+
+    scriptStratumPayout.clear();
+    if (gArgs.IsArgSet("-stratumaddress")) {
+        CTxDestination dest = DecodeDestination(gArgs.GetArg("-stratumaddress", ""));
+        if (!IsValidDestination(dest)) {
+            LogPrintf("stratum: Invalid -stratumaddress '%s'\n", gArgs.GetArg("-stratumaddress", ""));
+            return false;
+        }
+        scriptStratumPayout = GetScriptForDestination(dest);
+    }
+
+#ifdef WIN32
+    evthread_use_windows_threads();
+#else
+    evthread_use_pthreads();
+#endif
+    stratumBase = event_base_new();
+    if (!stratumBase) {
+        LogPrintf("stratum: Unable to create event_base\n");
+        return false;
+    }
+
+    // Randomise extranonce1 so restarts don't hand out the same work
+    nStratumExtraNonce1 = (uint32_t)GetRand(std::numeric_limits<uint32_t>::max());
+
+    std::vector<std::string> vBind = gArgs.GetArgs("-stratumbind");
+    if (vBind.empty())
+        vBind.push_back(DEFAULT_STRATUM_BIND);
+    const uint16_t nPorts[NUM_BLOCK_TYPES] = {
+        (uint16_t)gArgs.GetArg("-stratumport", DEFAULT_STRATUM_PORT),
+        (uint16_t)gArgs.GetArg("-stratumminotaurxport", DEFAULT_STRATUM_MINOTAURX_PORT)
+    };
+    for (const std::string& strBind : vBind)
+        for (int i = 0; i < NUM_BLOCK_TYPES; i++)
+            StratumBind(strBind, nPorts[i], (POW_TYPE)i);
+    if (vStratumListeners.empty()) {
+        event_base_free(stratumBase);
+        stratumBase = nullptr;
+        return false;
+    }
+
+    evStratumTip = event_new(stratumBase, -1, 0, StratumUpdateCallback, nullptr);
+    evStratumTimer = event_new(stratumBase, -1, EV_PERSIST, StratumUpdateCallback, nullptr);
+    struct timeval tv = {STRATUM_JOB_REFRESH_INTERVAL, 0};
+    event_add(evStratumTimer, &tv);
+
+    stratumNotifier.reset(new StratumNotifier());
+    RegisterValidationInterface(stratumNotifier.get());
+
+    stratumThread = boost::thread(boost::bind(&TraceThread<void (*)()>, "stratum", &StratumThread));
+    return true;
+}
+
+void InterruptStratumServer()
+{
+    if (stratumBase) {
+        LogPrint(BCLog::STRATUM, "stratum: Thread interrupt\n");
+        event_base_loopbreak(stratumBase);
+    }
+}
+
+void StopStratumServer()
+{
+    if (stratumNotifier) {
+        UnregisterValidationInterface(stratumNotifier.get());
+        stratumNotifier.reset();
+    }
+    if (stratumBase) {
+        stratumThread.join();
+        for (std::pair<struct bufferevent* const, StratumClient>& item : mapStratumClients)
+            bufferevent_free(item.first);
+        mapStratumClients.clear();
+        mapStratumJobs.clear();
+        for (int i = 0; i < NUM_BLOCK_TYPES; i++) {
+            dequeStratumJobIds[i].clear();
+            currentStratumJob[i].reset();
+        }
+        for (struct evconnlistener* listener : vStratumListeners)
+            evconnlistener_free(listener);
+        vStratumListeners.clear();
+        event_free(evStratumTip);
+        evStratumTip = nullptr;
+        event_free(evStratumTimer);
+        evStratumTimer = nullptr;
+        event_base_free(stratumBase);
+        stratumBase = nullptr;
+    }
+}
@@ -0,0 +1,31 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+/**
+ * LitecoinCash: Stratum: Embedded Stratum (v1) server for pool mining.
+ *
+ * Serves one port per pow algorithm. Jobs are built straight from BlockAssembler and pushed
+ * with mining.notify whenever the tip or the mempool changes; shares are checked against the
+ * algorithm's native pow hash and solved blocks are handed to ProcessNewBlock.
+ */
+#ifndef LITECOINCASH_STRATUM_H
+#define LITECOINCASH_STRATUM_H
+
+#include <stdint.h>
+#include <string>
+
+static const bool DEFAULT_STRATUM_ENABLE = false;
+static const uint16_t DEFAULT_STRATUM_PORT = 3333;              // SHA256d
+static const uint16_t DEFAULT_STRATUM_MINOTAURX_PORT = 3334;    // MinotaurX
+static const double DEFAULT_STRATUM_DIFFICULTY = 1.0;
+extern const std::string DEFAULT_STRATUM_BIND;
+
+/** Bind the stratum ports and start the server thread */
+bool StartStratumServer();
+/** Break out of the server's event loop */
+void InterruptStratumServer();
+/** Stop the server thread and disconnect all clients */
+void StopStratumServer();
+
+#endif // LITECOINCASH_STRATUM_H
@@ -8,6 +8,7 @@
 #include <keystore.h>
 #include <net.h>
 #include <net_processing.h>
+#include <netmessagemaker.h>
 #include <pow.h>
 #include <script/sign.h>
 #include <serialize.h>
@@ -42,6 +43,24 @@ static NodeId id = 0;
 
 void UpdateLastBlockAnnounceTime(NodeId node, int64_t time_in_seconds);
 
+static void QueueMessage(CNode& node, CSerializedNetMsg&& msg)
+{
+    const CSharedNetMsg shared(std::move(msg));
+    CNetMessage recv(Params().MessageStart(), SER_NETWORK, INIT_PROTO_VERSION);
+    recv.readHeader((const char*)shared.header.data(), shared.header.size());
+    recv.readData((const char*)shared.data.get(), shared.nDataSize);
+    recv.nTime = GetTimeMicros();
+    LOCK(node.cs_vProcessMsg);
+    node.nProcessQueueSize += recv.vRecv.size() + CMessageHeader::HEADER_SIZE;
+    node.vProcessMsg.push_back(std::move(recv));
+}
+
+static uint64_t MessageCount(const std::map<std::string, MessageProcessingStats>& mapStats, const std::string& strCommand)
+{
+    const auto it = mapStats.find(strCommand);
+    return it == mapStats.end() ? 0 : it->second.nCount;
+}
+
 BOOST_FIXTURE_TEST_SUITE(DoS_tests, TestingSetup)
 
 // Test eviction of an outbound peer whose chain never advances
@@ -258,6 +277,47 @@ BOOST_AUTO_TEST_CASE(DoS_banscore)
     peerLogic->FinalizeNode(dummyNode1.GetId(), dummy);
 }
 
+BOOST_AUTO_TEST_CASE(DoS_no_chainstate_messages)
+{
+    std::atomic<bool> interruptDummy(false);
+
+    BOOST_CHECK(!MessageNeedsChainstate(NetMsgType::PONG));
+    BOOST_CHECK(!MessageNeedsChainstate(NetMsgType::FILTERADD));
+    BOOST_CHECK(MessageNeedsChainstate(NetMsgType::TX));
+    BOOST_CHECK(MessageNeedsChainstate("junk"));
+
+    connman->ClearBanned();
+    CAddress addr1(ip(0xa0b0c001), NODE_NONE);
+    CNode dummyNode1(id++, NODE_NETWORK, 0, INVALID_SOCKET, addr1, 4, 4, CAddress(), "", true);
+    dummyNode1.SetSendVersion(PROTOCOL_VERSION);
+    peerLogic->InitializeNode(&dummyNode1);
+    dummyNode1.nVersion = PROTOCOL_VERSION;
+    dummyNode1.fSuccessfullyConnected = true;
+
+    const std::map<std::string, MessageProcessingStats> mapBefore = GetMessageProcessingStats();
+    const CNetMsgMaker msgMaker(INIT_PROTO_VERSION);
+    QueueMessage(dummyNode1, msgMaker.Make(NetMsgType::PONG, (uint64_t)1));
+    QueueMessage(dummyNode1, msgMaker.Make("junk", (uint64_t)1));
+    QueueMessage(dummyNode1, msgMaker.Make(NetMsgType::FILTERADD, std::vector<unsigned char>(1))); // Bloom filters aren't offered
+    for (int i = 0; i < 3; i++)
+        peerLogic->ProcessMessages(&dummyNode1, interruptDummy);
+
+    // The filteradd made the peer misbehave, but it is left to SendMessages to ban it
+    BOOST_CHECK(!connman->IsBanned(addr1));
+    LOCK(dummyNode1.cs_sendProcessing);
+    peerLogic->SendMessages(&dummyNode1, interruptDummy);
+    BOOST_CHECK(connman->IsBanned(addr1));
+
+    const std::map<std::string, MessageProcessingStats> mapAfter = GetMessageProcessingStats();
+    BOOST_CHECK_EQUAL(MessageCount(mapAfter, NetMsgType::PONG), MessageCount(mapBefore, NetMsgType::PONG) + 1);
+    BOOST_CHECK_EQUAL(MessageCount(mapAfter, NetMsgType::FILTERADD), MessageCount(mapBefore, NetMsgType::FILTERADD) + 1);
+    BOOST_CHECK_EQUAL(MessageCount(mapAfter, "*other*"), MessageCount(mapBefore, "*other*") + 1);
+    BOOST_CHECK(!mapAfter.count("junk"));
+
+    bool dummy;
+    peerLogic->FinalizeNode(dummyNode1.GetId(), dummy);
+}
+
 BOOST_AUTO_TEST_CASE(DoS_bantime)
 {
     std::atomic<bool> interruptDummy(false);
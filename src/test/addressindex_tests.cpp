@@ -0,0 +1,265 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <consensus/validation.h>
+#include <index/addressindex.h>
+#include <index/spentindex.h>
+#include <script/standard.h>
+#include <test/test_bitcoin.h>
+#include <util.h>
+#include <validation.h>
+
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(addressindex_tests, TestChain100Setup)
+
+static bool HasUnspent(const AddressIndex& address_index, const CScript& script, const COutPoint& outpoint)
+{
+    std::vector<AddressIndex::Unspent> unspent;
+    BOOST_CHECK(address_index.LookupUnspent(script, 0, std::numeric_limits<size_t>::max(), unspent));
+    for (const AddressIndex::Unspent& entry : unspent) {
+        if (entry.outpoint == outpoint) return true;
+    }
+    return false;
+}
+
+/** Spend the first output of a coinbase paying to script into two outputs of value each to dest_script. */
+static CMutableTransaction CreateSpend(const CKey& key, const CScript& script, const CTransaction& coinbase,
+                                       const CScript& dest_script, CAmount value)
+{
+    CMutableTransaction spend;
+    spend.nVersion = 1;
+    spend.vin.resize(1);
+    spend.vin[0].prevout = COutPoint(coinbase.GetHash(), 0);
+    spend.vout.resize(2);
+    spend.vout[0].nValue = value;
+    spend.vout[0].scriptPubKey = dest_script;
+    spend.vout[1].nValue = value;
+    spend.vout[1].scriptPubKey = dest_script;
+
+    std::vector<unsigned char> vchSig;
+    uint256 hash = SignatureHash(script, spend, 0, SIGHASH_ALL | SIGHASH_FORKID, 0, SIGVERSION_BASE);
+    BOOST_CHECK(key.Sign(hash, vchSig));
+    vchSig.push_back((unsigned char)SIGHASH_ALL | SIGHASH_FORKID);
+    spend.vin[0].scriptSig << vchSig;
+    return spend;
+}
+
+BOOST_AUTO_TEST_CASE(addressindex_spend_and_reorg)
+{
+    AddressIndex address_index(1 << 20, true);
+    SpentIndex spent_index(1 << 20, true);
+
+    // The indexes catch up with the existing chain in the background.
+    address_index.Start();
+    spent_index.Start();
+    WaitForSync(address_index);
+    WaitForSync(spent_index);
+
+    // Every block so far paid its coinbase to the same script.
+    CScript coinbase_script = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    CAmount coinbase_total = 0;
+    for (const CTransaction& txn : coinbaseTxns) {
+        coinbase_total += txn.vout[0].nValue;
+    }
+    AddressIndex::Balance balance;
+    BOOST_CHECK(address_index.LookupBalance(coinbase_script, balance));
+    BOOST_CHECK_EQUAL(balance.balance, coinbase_total);
+    BOOST_CHECK_EQUAL(balance.received, coinbase_total);
+    BOOST_CHECK_EQUAL(balance.tx_count, coinbaseTxns.size());
+
+    // Spend the first coinbase to two outputs to a new script.
+    CKey key;
+    key.MakeNewKey(true);
+    CScript dest_script = GetScriptForDestination(key.GetPubKey().GetID());
+    const COutPoint spent_outpoint(coinbaseTxns[0].GetHash(), 0);
+    const CAmount coinbase_value = coinbaseTxns[0].vout[0].nValue;
+    const CAmount output_value = coinbase_value / 4;
+
+    const CMutableTransaction spend = CreateSpend(coinbaseKey, coinbase_script, coinbaseTxns[0], dest_script, output_value);
+    const CBlock block = CreateAndProcessBlock({spend}, coinbase_script);
+    const uint256 spend_txid = spend.GetHash();
+    BOOST_CHECK(block.vtx.size() == 2 && block.vtx[1]->GetHash() == spend_txid);
+    BOOST_CHECK(address_index.BlockUntilSyncedToCurrentChain());
+    BOOST_CHECK(spent_index.BlockUntilSyncedToCurrentChain());
+
+    CBlockIndex* tip;
+    {
+        LOCK(cs_main);
+        tip = chainActive.Tip();
+    }
+    BOOST_CHECK(tip->GetBlockHash() == block.GetHash());
+
+    // The new script received both outputs in a single transaction.
+    BOOST_CHECK(address_index.LookupBalance(dest_script, balance));
+    BOOST_CHECK_EQUAL(balance.balance, 2 * output_value);
+    BOOST_CHECK_EQUAL(balance.received, 2 * output_value);
+    BOOST_CHECK_EQUAL(balance.tx_count, 1);
+
+    std::vector<AddressIndex::HistoryEntry> history;
+    BOOST_CHECK(address_index.LookupHistory(dest_script, 0, 10, history));
+    BOOST_REQUIRE_EQUAL(history.size(), 1);
+    BOOST_CHECK(history[0].txid == spend_txid);
+    BOOST_CHECK_EQUAL(history[0].height, tip->nHeight);
+    BOOST_CHECK(history[0].block_hash == block.GetHash());
+    BOOST_CHECK_EQUAL(history[0].received, 2 * output_value);
+    BOOST_CHECK_EQUAL(history[0].sent, 0);
+
+    // Unspent outputs are paged through with skip and count.
+    std::vector<AddressIndex::Unspent> unspent, page;
+    BOOST_CHECK(address_index.LookupUnspent(dest_script, 0, 10, unspent));
+    BOOST_REQUIRE_EQUAL(unspent.size(), 2);
+    for (const AddressIndex::Unspent& entry : unspent) {
+        BOOST_CHECK(entry.outpoint.hash == spend_txid);
+        BOOST_CHECK_EQUAL(entry.value, output_value);
+        BOOST_CHECK_EQUAL(entry.height, tip->nHeight);
+    }
+    BOOST_CHECK(address_index.LookupUnspent(dest_script, 0, 1, page));
+    BOOST_REQUIRE_EQUAL(page.size(), 1);
+    BOOST_CHECK(page[0].outpoint == unspent[0].outpoint);
+    BOOST_CHECK(address_index.LookupUnspent(dest_script, 1, 10, page));
+    BOOST_REQUIRE_EQUAL(page.size(), 1);
+    BOOST_CHECK(page[0].outpoint == unspent[1].outpoint);
+    BOOST_CHECK(address_index.LookupUnspent(dest_script, 2, 10, page));
+    BOOST_CHECK(page.empty());
+
+    // The coinbase script gained a coinbase and lost the spent one.
+    const CAmount new_coinbase_total = coinbase_total + block.vtx[0]->vout[0].nValue - coinbase_value;
+    BOOST_CHECK(address_index.LookupBalance(coinbase_script, balance));
+    BOOST_CHECK_EQUAL(balance.balance, new_coinbase_total);
+    BOOST_CHECK_EQUAL(balance.tx_count, coinbaseTxns.size() + 2);
+    BOOST_CHECK(!HasUnspent(address_index, coinbase_script, spent_outpoint));
+
+    BOOST_CHECK(address_index.LookupHistory(coinbase_script, coinbaseTxns.size() + 1, 10, history));
+    BOOST_REQUIRE_EQUAL(history.size(), 1);
+    BOOST_CHECK(history[0].txid == spend_txid);
+    BOOST_CHECK_EQUAL(history[0].received, 0);
+    BOOST_CHECK_EQUAL(history[0].sent, coinbase_value);
+
+    // The spent index points from the coinbase output to its spending input.
+    SpentIndex::SpentInfo info;
+    BOOST_CHECK(spent_index.LookupSpent(spent_outpoint, info));
+    BOOST_CHECK(info.txid == spend_txid);
+    BOOST_CHECK_EQUAL(info.input_index, 0);
+    BOOST_CHECK_EQUAL(info.height, tip->nHeight);
+    BOOST_CHECK(!spent_index.LookupSpent(COutPoint(spend_txid, 0), info));
+
+    // Invalidating the block disconnects it, and both indexes undo its entries.
+    {
+        CValidationState state;
+        {
+            LOCK(cs_main);
+            BOOST_CHECK(InvalidateBlock(state, Params(), tip));
+        }
+        BOOST_CHECK(ActivateBestChain(state, Params()));
+    }
+    SyncWithValidationInterfaceQueue();
+    BOOST_CHECK_EQUAL(address_index.BestBlockIndex(), tip->pprev);
+    BOOST_CHECK_EQUAL(spent_index.BestBlockIndex(), tip->pprev);
+
+    BOOST_CHECK(address_index.LookupBalance(dest_script, balance));
+    BOOST_CHECK_EQUAL(balance.balance, 0);
+    BOOST_CHECK_EQUAL(balance.tx_count, 0);
+    BOOST_CHECK(address_index.LookupUnspent(dest_script, 0, 10, unspent));
+    BOOST_CHECK(unspent.empty());
+
+    BOOST_CHECK(address_index.LookupBalance(coinbase_script, balance));
+    BOOST_CHECK_EQUAL(balance.balance, coinbase_total);
+    BOOST_CHECK_EQUAL(balance.tx_count, coinbaseTxns.size());
+    BOOST_CHECK(HasUnspent(address_index, coinbase_script, spent_outpoint));
+
+    BOOST_CHECK(!spent_index.LookupSpent(spent_outpoint, info));
+
+    address_index.Interrupt();
+    address_index.Stop();
+    spent_index.Interrupt();
+    spent_index.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(addressindex_restart_on_stale_branch)
+{
+    CScript coinbase_script = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    CKey key;
+    key.MakeNewKey(true);
+    CScript dest_script = GetScriptForDestination(key.GetPubKey().GetID());
+    const COutPoint spent_outpoint(coinbaseTxns[0].GetHash(), 0);
+    const CAmount output_value = coinbaseTxns[0].vout[0].nValue / 4;
+
+    // Index a block spending a coinbase, on disk so that the entries outlive the index.
+    const CBlockIndex* stale_tip;
+    {
+        AddressIndex address_index(1 << 20);
+        SpentIndex spent_index(1 << 20);
+        address_index.Start();
+        spent_index.Start();
+        WaitForSync(address_index);
+        WaitForSync(spent_index);
+
+        CreateAndProcessBlock({CreateSpend(coinbaseKey, coinbase_script, coinbaseTxns[0], dest_script, output_value)},
+                              coinbase_script);
+        BOOST_CHECK(address_index.BlockUntilSyncedToCurrentChain());
+        BOOST_CHECK(spent_index.BlockUntilSyncedToCurrentChain());
+        {
+            LOCK(cs_main);
+            stale_tip = chainActive.Tip();
+        }
+        BOOST_CHECK_EQUAL(address_index.BestBlockIndex(), stale_tip);
+        BOOST_CHECK_EQUAL(spent_index.BestBlockIndex(), stale_tip);
+
+        address_index.Interrupt();
+        address_index.Stop();
+        spent_index.Interrupt();
+        spent_index.Stop();
+    }
+
+    // While the indexes are not running, the block is replaced by one without the spend.
+    {
+        CValidationState state;
+        {
+            LOCK(cs_main);
+            BOOST_CHECK(InvalidateBlock(state, Params(), const_cast<CBlockIndex*>(stale_tip)));
+        }
+        BOOST_CHECK(ActivateBestChain(state, Params()));
+    }
+    mempool.clear();
+    const CBlock block = CreateAndProcessBlock({}, coinbase_script);
+    {
+        LOCK(cs_main);
+        BOOST_CHECK(chainActive.Tip()->GetBlockHash() == block.GetHash());
+        BOOST_CHECK(!chainActive.Contains(stale_tip));
+    }
+
+    // Restarted from a best block on the stale branch, the indexes undo its entries before syncing.
+    AddressIndex address_index(1 << 20);
+    SpentIndex spent_index(1 << 20);
+    address_index.Start();
+    spent_index.Start();
+    WaitForSync(address_index);
+    WaitForSync(spent_index);
+
+    AddressIndex::Balance balance;
+    BOOST_CHECK(address_index.LookupBalance(dest_script, balance));
+    BOOST_CHECK_EQUAL(balance.balance, 0);
+    BOOST_CHECK_EQUAL(balance.tx_count, 0);
+    BOOST_CHECK(HasUnspent(address_index, coinbase_script, spent_outpoint));
+
+    std::vector<AddressIndex::HistoryEntry> history;
+    BOOST_CHECK(address_index.LookupHistory(coinbase_script, coinbaseTxns.size(), 10, history));
+    BOOST_REQUIRE_EQUAL(history.size(), 1);
+    BOOST_CHECK(history[0].block_hash == block.GetHash());
+    BOOST_CHECK_EQUAL(history[0].sent, 0);
+
+    SpentIndex::SpentInfo info;
+    BOOST_CHECK(!spent_index.LookupSpent(spent_outpoint, info));
+
+    address_index.Interrupt();
+    address_index.Stop();
+    spent_index.Interrupt();
+    spent_index.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
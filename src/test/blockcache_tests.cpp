@@ -0,0 +1,122 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <blockcache.h>
+#include <consensus/merkle.h>
+#include <primitives/block.h>
+#include <streams.h>
+#include <version.h>
+
+#include <test/test_bitcoin.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(blockcache_tests, BasicTestingSetup)
+
+static uint256 HashOf(int n)
+{
+    return ArithToUint256(arith_uint256(n + 1));
+}
+
+BOOST_AUTO_TEST_CASE(blockcache_lru)
+{
+    // Room for three 10000 byte entries, with some slack for the bookkeeping
+    CSerializedBlockCache cache(35000);
+    CRawBlock block;
+
+    for (int i = 0; i < 4; i++) {
+        CRawBlock inserted = cache.Insert(HashOf(i), true, std::vector<unsigned char>(10000, i));
+        BOOST_CHECK_EQUAL(inserted.size(), 10000U);
+        BOOST_CHECK_EQUAL(inserted.data()[0], i);
+        if (i == 2) {
+            // Touch the first one, so the second one is the oldest when the fourth comes in
+            BOOST_CHECK(cache.Get(HashOf(0), true, block));
+        }
+    }
+
+    BOOST_CHECK(cache.Get(HashOf(0), true, block));
+    BOOST_CHECK_EQUAL(block.data()[0], 0);
+    BOOST_CHECK(!cache.Get(HashOf(1), true, block));
+    BOOST_CHECK(cache.Get(HashOf(2), true, block));
+    BOOST_CHECK(cache.Get(HashOf(3), true, block));
+    BOOST_CHECK_EQUAL(block.data()[9999], 3);
+
+    // With and without witness are separate entries
+    BOOST_CHECK(!cache.Get(HashOf(3), false, block));
+
+    SerializedBlockCacheStats stats = cache.GetStats();
+    BOOST_CHECK_EQUAL(stats.nHits, 4U);
+    BOOST_CHECK_EQUAL(stats.nMisses, 2U);
+    BOOST_CHECK_EQUAL(stats.nEntries, 3U);
+    BOOST_CHECK(stats.nBytes > 30000 && stats.nBytes <= 35000);
+
+    // An entry bigger than the whole budget is handed back, but not kept
+    CRawBlock big = cache.Insert(HashOf(4), true, std::vector<unsigned char>(40000, 4));
+    BOOST_CHECK_EQUAL(big.size(), 40000U);
+    BOOST_CHECK(!cache.Get(HashOf(4), true, block));
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 3U);
+
+    // Entries handed out stay valid after they've been pushed out
+    cache.SetMaxBytes(15000);
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 1U);
+    BOOST_CHECK_EQUAL(block.data()[0], 3);
+
+    cache.SetMaxBytes(0);
+    BOOST_CHECK(!cache.IsEnabled());
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 0U);
+    cache.Insert(HashOf(5), true, std::vector<unsigned char>(10, 5));
+    BOOST_CHECK(!cache.Get(HashOf(5), true, block));
+}
+
+BOOST_AUTO_TEST_CASE(blockcache_raw)
+{
+    CSerializedBlockCache cache(1 << 20);
+
+    // A block read as raw bytes is kept as it is, not copied
+    std::shared_ptr<const std::vector<unsigned char>> data = std::make_shared<const std::vector<unsigned char>>(1000, 7);
+    CRawBlock raw(std::shared_ptr<const unsigned char>(data, data->data()), data->size());
+    CRawBlock inserted = cache.Insert(HashOf(0), true, raw);
+    BOOST_CHECK(inserted.data() == data->data());
+
+    // The cache holds on to the bytes after everyone else has let go
+    const unsigned char* ptr = data->data();
+    data.reset();
+    raw = CRawBlock();
+    inserted = CRawBlock();
+    CRawBlock block;
+    BOOST_CHECK(cache.Get(HashOf(0), true, block));
+    BOOST_CHECK(block.data() == ptr);
+    BOOST_CHECK_EQUAL(block.size(), 1000U);
+    BOOST_CHECK_EQUAL(block.data()[999], 7);
+}
+
+BOOST_AUTO_TEST_CASE(blockcache_serialize)
+{
+    CSerializedBlockCache cache(1 << 20);
+
+    CMutableTransaction coinbase;
+    coinbase.vin.resize(1);
+    coinbase.vin[0].scriptSig = CScript() << 1 << OP_0;
+    coinbase.vin[0].scriptWitness.stack.push_back(std::vector<unsigned char>(32, 0));
+    coinbase.vout.resize(1);
+    coinbase.vout[0].nValue = 1;
+    CBlock block;
+    block.vtx.push_back(MakeTransactionRef(std::move(coinbase)));
+    block.hashMerkleRoot = BlockMerkleRoot(block);
+
+    for (bool fWitness : {true, false}) {
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION | (fWitness ? 0 : SERIALIZE_TRANSACTION_NO_WITNESS));
+        ss << block;
+
+        CRawBlock inserted = cache.Insert(block, fWitness);
+        CRawBlock found;
+        BOOST_CHECK(cache.Get(block.GetHash(), fWitness, found));
+        BOOST_CHECK(std::vector<unsigned char>(found.data(), found.data() + found.size()) == std::vector<unsigned char>(ss.begin(), ss.end()));
+        BOOST_CHECK(found.data() == inserted.data());
+    }
+    BOOST_CHECK_EQUAL(cache.GetStats().nEntries, 2U);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,209 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <blockfilter.h>
+#include <chainparams.h>
+#include <consensus/validation.h>
+#include <index/blockfilterindex.h>
+#include <test/test_bitcoin.h>
+#include <undo.h>
+#include <util.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(blockfilter_index_tests, TestChain100Setup)
+
+static bool CheckFilterLookups(BlockFilterIndex& filter_index, const CBlockIndex* block_index,
+                               uint256& last_header)
+{
+    BlockFilter expected_filter;
+    {
+        CBlock block;
+        CBlockUndo block_undo;
+        if (!ReadBlockFromDisk(block, block_index, Params().GetConsensus())) return false;
+        if (block_index->nHeight > 0 && !UndoReadFromDisk(block_undo, block_index)) return false;
+        expected_filter = BlockFilter(filter_index.GetFilterType(), block, block_undo);
+    }
+
+    BlockFilter tmp_filter;
+    uint256 tmp_header;
+    std::vector<BlockFilter> filters;
+    std::vector<uint256> filter_hashes;
+
+    BOOST_CHECK(filter_index.LookupFilter(block_index, tmp_filter));
+    BOOST_CHECK(filter_index.LookupFilterHeader(block_index, tmp_header));
+    BOOST_CHECK(filter_index.LookupFilterRange(block_index->nHeight, block_index, filters));
+    BOOST_CHECK(filter_index.LookupFilterHashRange(block_index->nHeight, block_index, filter_hashes));
+
+    BOOST_CHECK_EQUAL(filters.size(), 1);
+    BOOST_CHECK_EQUAL(filter_hashes.size(), 1);
+
+    BOOST_CHECK(tmp_filter.GetHash() == expected_filter.GetHash());
+    BOOST_CHECK(tmp_header == expected_filter.ComputeHeader(last_header));
+    BOOST_CHECK(filters[0].GetHash() == expected_filter.GetHash());
+    BOOST_CHECK(filter_hashes[0] == expected_filter.GetHash());
+
+    last_header = tmp_header;
+    return true;
+}
+
+BOOST_AUTO_TEST_CASE(blockfilter_index_initial_sync)
+{
+    BlockFilterIndex filter_index(BlockFilterType::BASIC, 1 << 20, true);
+
+    // Nothing is indexed before the index is started.
+    const CBlockIndex* genesis = chainActive.Genesis();
+    BlockFilter filter;
+    uint256 filter_header;
+    BOOST_CHECK(!filter_index.LookupFilter(genesis, filter));
+    BOOST_CHECK(!filter_index.LookupFilterHeader(genesis, filter_header));
+
+    // The index catches up with the existing chain in the background.
+    filter_index.Start();
+    WaitForSync(filter_index);
+
+    // All filters and headers match those built from the blocks themselves.
+    uint256 last_header;
+    {
+        LOCK(cs_main);
+        for (const CBlockIndex* block_index = genesis; block_index; block_index = chainActive.Next(block_index)) {
+            BOOST_CHECK(CheckFilterLookups(filter_index, block_index, last_header));
+        }
+    }
+
+    // Ranges come back in height order.
+    const CBlockIndex* tip;
+    {
+        LOCK(cs_main);
+        tip = chainActive.Tip();
+    }
+    std::vector<BlockFilter> filters;
+    BOOST_CHECK(filter_index.LookupFilterRange(0, tip, filters));
+    BOOST_CHECK_EQUAL(filters.size(), tip->nHeight + 1);
+    for (const BlockFilter& range_filter : filters) {
+        BOOST_CHECK(range_filter.GetFilterType() == BlockFilterType::BASIC);
+    }
+    BOOST_CHECK(filters.back().GetBlockHash() == tip->GetBlockHash());
+    BOOST_CHECK(!filter_index.LookupFilterRange(tip->nHeight + 1, tip, filters));
+
+    // Blocks connected after the initial sync are indexed from validation notifications.
+    CScript coinbase_script = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    for (int i = 0; i < 10; i++) {
+        CreateAndProcessBlock({}, coinbase_script);
+    }
+    SyncWithValidationInterfaceQueue();
+    {
+        LOCK(cs_main);
+        tip = chainActive.Tip();
+        for (const CBlockIndex* block_index = tip->GetAncestor(tip->nHeight - 9); block_index; block_index = chainActive.Next(block_index)) {
+            BOOST_CHECK(CheckFilterLookups(filter_index, block_index, last_header));
+        }
+    }
+    BOOST_CHECK_EQUAL(filter_index.BestBlockIndex(), tip);
+
+    filter_index.Interrupt();
+    filter_index.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(blockfilter_index_reorg)
+{
+    BlockFilterIndex filter_index(BlockFilterType::BASIC, 1 << 20, true);
+    filter_index.Start();
+    WaitForSync(filter_index);
+
+    CScript coinbase_script = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    for (int i = 0; i < 2; i++) {
+        CreateAndProcessBlock({}, coinbase_script);
+    }
+    SyncWithValidationInterfaceQueue();
+
+    // Invalidating the tip disconnects it, and the index follows the chain back.
+    CBlockIndex* stale_tip;
+    {
+        LOCK(cs_main);
+        stale_tip = chainActive.Tip();
+    }
+    uint256 stale_header;
+    BOOST_CHECK(filter_index.LookupFilterHeader(stale_tip, stale_header));
+    {
+        CValidationState state;
+        {
+            LOCK(cs_main);
+            BOOST_CHECK(InvalidateBlock(state, Params(), stale_tip));
+        }
+        BOOST_CHECK(ActivateBestChain(state, Params()));
+    }
+    SyncWithValidationInterfaceQueue();
+    BOOST_CHECK_EQUAL(filter_index.BestBlockIndex(), stale_tip->pprev);
+
+    // A replacement block takes the stale block's height, while the stale block's filter can still
+    // be looked up by its hash.
+    CScript other_script = CScript() << OP_TRUE;
+    CreateAndProcessBlock({}, other_script);
+    SyncWithValidationInterfaceQueue();
+
+    const CBlockIndex* new_tip;
+    {
+        LOCK(cs_main);
+        new_tip = chainActive.Tip();
+    }
+    BOOST_CHECK_EQUAL(new_tip->nHeight, stale_tip->nHeight);
+    BOOST_CHECK(new_tip != stale_tip);
+    BOOST_CHECK_EQUAL(filter_index.BestBlockIndex(), new_tip);
+
+    uint256 prev_header, new_header, header;
+    BOOST_CHECK(filter_index.LookupFilterHeader(new_tip->pprev, prev_header));
+    BOOST_CHECK(filter_index.LookupFilterHeader(new_tip, new_header));
+    BOOST_CHECK(new_header != stale_header);
+    BOOST_CHECK(filter_index.LookupFilterHeader(stale_tip, header));
+    BOOST_CHECK(header == stale_header);
+
+    BlockFilter filter;
+    BOOST_CHECK(filter_index.LookupFilter(new_tip, filter));
+    BOOST_CHECK(new_header == filter.ComputeHeader(prev_header));
+    BOOST_CHECK(filter.GetFilter().Match(GCSFilter::Element(other_script.begin(), other_script.end())));
+
+    filter_index.Interrupt();
+    filter_index.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(blockfilter_index_init_destroy)
+{
+    BlockFilterIndex* filter_index;
+
+    filter_index = GetBlockFilterIndex(BlockFilterType::BASIC);
+    BOOST_CHECK(filter_index == nullptr);
+
+    BOOST_CHECK(InitBlockFilterIndex(BlockFilterType::BASIC, 1 << 20, true, false));
+
+    filter_index = GetBlockFilterIndex(BlockFilterType::BASIC);
+    BOOST_CHECK(filter_index != nullptr);
+    BOOST_CHECK(filter_index->GetFilterType() == BlockFilterType::BASIC);
+
+    // Initialize returns false if index already exists.
+    BOOST_CHECK(!InitBlockFilterIndex(BlockFilterType::BASIC, 1 << 20, true, false));
+
+    int iter_count = 0;
+    ForEachBlockFilterIndex([&iter_count](BlockFilterIndex& _index) { iter_count++; });
+    BOOST_CHECK_EQUAL(iter_count, 1);
+
+    BOOST_CHECK(DestroyBlockFilterIndex(BlockFilterType::BASIC));
+
+    // Destroy returns false because index was already destroyed.
+    BOOST_CHECK(!DestroyBlockFilterIndex(BlockFilterType::BASIC));
+
+    filter_index = GetBlockFilterIndex(BlockFilterType::BASIC);
+    BOOST_CHECK(filter_index == nullptr);
+
+    // Reinitialize index.
+    BOOST_CHECK(InitBlockFilterIndex(BlockFilterType::BASIC, 1 << 20, true, false));
+
+    DestroyAllBlockFilterIndexes();
+
+    filter_index = GetBlockFilterIndex(BlockFilterType::BASIC);
+    BOOST_CHECK(filter_index == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@
 
 #include <base58.h>
 #include <clientversion.h>
+#include <consensus/merkle.h>
 #include <key.h>
 #include <merkleblock.h>
 #include <primitives/block.h>
@@ -462,6 +463,78 @@ static std::vector<unsigned char> RandomData()
     return std::vector<unsigned char>(r.begin(), r.end());
 }
 
+static std::vector<unsigned char> RandomPubKeyData()
+{
+    std::vector<unsigned char> data = RandomData();
+    data.insert(data.begin(), 2 + InsecureRandBits(1));
+    return data;
+}
+
+static std::vector<unsigned char> FirstPush(const CScript& script)
+{
+    CScript::const_iterator pc = script.begin();
+    opcodetype opcode;
+    std::vector<unsigned char> data;
+    while (script.GetOp(pc, opcode, data) && data.empty()) {}
+    return data;
+}
+
+BOOST_AUTO_TEST_CASE(merkle_block_prepared)
+{
+    // LitecoinCash: BloomBatch: Matching against a prepared block finds, and adds to the filter, exactly
+    // what matching transaction by transaction does
+    CBlock block;
+    for (int i = 0; i < 40; i++) {
+        CMutableTransaction mtx;
+        for (int j = InsecureRandRange(3); j >= 0; j--) {
+            // Spend outputs from earlier in the block now and then
+            const COutPoint prevout = i > 0 && InsecureRandBool() ? COutPoint(block.vtx[InsecureRandRange(i)]->GetHash(), InsecureRandRange(3)) : COutPoint(InsecureRand256(), InsecureRandRange(3));
+            mtx.vin.emplace_back(prevout, CScript() << RandomData() << RandomPubKeyData());
+        }
+        for (int j = 0; j < 3; j++) {
+            CScript script;
+            switch (InsecureRandRange(4)) {
+            case 0: script << RandomPubKeyData() << OP_CHECKSIG; break;
+            case 1: script << OP_DUP << OP_HASH160 << std::vector<unsigned char>(20, i) << OP_EQUALVERIFY << OP_CHECKSIG; break;
+            case 2: script << OP_1 << RandomPubKeyData() << RandomPubKeyData() << OP_2 << OP_CHECKMULTISIG; break;
+            case 3: script << OP_TRUE; break;
+            }
+            mtx.vout.emplace_back(1, script);
+        }
+        block.vtx.push_back(MakeTransactionRef(std::move(mtx)));
+    }
+    const CBloomBlockElements elements(block);
+    BOOST_CHECK_EQUAL(elements.size(), block.vtx.size());
+    BOOST_CHECK(elements.MerkleTree().back() == BlockMerkleRoot(block));
+
+    size_t nMatched = 0;
+    for (int i = 0; i < 60; i++) {
+        CBloomFilter filter(20, 0.01, InsecureRand32(), i % 3);
+        // A few of the block's data elements, from wherever IsRelevantAndUpdate looks for them
+        for (int j = 0; j < 2; j++) {
+            const CTransaction& tx = *block.vtx[InsecureRandRange(block.vtx.size())];
+            switch (InsecureRandRange(4)) {
+            case 0: filter.insert(tx.GetHash()); break;
+            case 1: filter.insert(tx.vin[0].prevout); break;
+            case 2: filter.insert(FirstPush(tx.vin[0].scriptSig)); break;
+            case 3: filter.insert(FirstPush(tx.vout[InsecureRandRange(3)].scriptPubKey)); break;
+            }
+        }
+        CBloomFilter filterPrepared(filter);
+
+        CMerkleBlock merkleBlock(block, filter);
+        CMerkleBlock merkleBlockPrepared(block, filterPrepared, elements);
+        BOOST_CHECK(merkleBlock.vMatchedTxn == merkleBlockPrepared.vMatchedTxn);
+        nMatched += merkleBlock.vMatchedTxn.size();
+
+        CDataStream stream(SER_NETWORK, PROTOCOL_VERSION), streamPrepared(SER_NETWORK, PROTOCOL_VERSION);
+        stream << filter << merkleBlock;
+        streamPrepared << filterPrepared << merkleBlockPrepared;
+        BOOST_CHECK(stream.str() == streamPrepared.str());
+    }
+    BOOST_CHECK(nMatched > 0);
+}
+
 BOOST_AUTO_TEST_CASE(rolling_bloom)
 {
     // last-100-entry, 1% false positive:
@@ -0,0 +1,114 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <arith_uint256.h>
+#include <chain.h>
+#include <chainparams.h>
+#include <chainstats.h>
+#include <validation.h>
+#include <test/test_bitcoin.h>
+
+#include <cmath>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(chainstats_tests, BasicTestingSetup)
+
+// Build a chain of vIndex.size() blocks on top of pindexFork, where every nHivePeriod'th block is hivemined
+static void BuildChain(std::vector<CBlockIndex>& vIndex, std::vector<uint256>& vHashes, CBlockIndex* pindexFork, int nHivePeriod, uint32_t nTimeStart)
+{
+    const Consensus::Params& consensusParams = Params().GetConsensus();
+    for (size_t i = 0; i < vIndex.size(); i++) {
+        vHashes[i] = ArithToUint256(arith_uint256(nTimeStart + i));
+        vIndex[i].phashBlock = &vHashes[i];
+        vIndex[i].pprev = (i == 0) ? pindexFork : &vIndex[i - 1];
+        vIndex[i].nHeight = vIndex[i].pprev ? vIndex[i].pprev->nHeight + 1 : 0;
+        vIndex[i].nTime = nTimeStart + i * 150;
+        vIndex[i].nBits = 0x1e0ffff0 - (i % 7) * 0x100;
+        vIndex[i].nNonce = (i > 0 && i % nHivePeriod == 0) ? consensusParams.hiveNonceMarker : 0;
+        vIndex[i].BuildSkip();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(chainstats_window_and_reorg)
+{
+    std::vector<CBlockIndex> vMain(200);
+    std::vector<uint256> vMainHashes(vMain.size());
+    BuildChain(vMain, vMainHashes, nullptr, 3, 1500000000);
+
+    CChainTypeStats stats;
+    {
+        LOCK(cs_main);
+        stats.SetTip(&vMain.back());
+    }
+    BOOST_CHECK(stats.Tip() == &vMain.back());
+
+    // Last blocks of each type
+    const CBlockIndex* pindexLast = nullptr;
+    BOOST_CHECK(stats.GetLastBlock(&vMain[199], CHAINSTATS_HIVE, pindexLast));
+    BOOST_CHECK(pindexLast == &vMain[198]);
+    BOOST_CHECK(stats.GetLastBlock(&vMain[198], CHAINSTATS_SHA256, pindexLast));
+    BOOST_CHECK(pindexLast == &vMain[197]);
+    BOOST_CHECK(stats.GetLastBlock(&vMain[2], CHAINSTATS_HIVE, pindexLast));
+    BOOST_CHECK(pindexLast == nullptr);
+    BOOST_CHECK(stats.GetLastBlock(&vMain[199], CHAINSTATS_MINOTAURX, pindexLast));
+    BOOST_CHECK(pindexLast == nullptr);
+    BOOST_CHECK(stats.GetLastBlock(100, CHAINSTATS_SHA256) == &vMain[100]);
+    BOOST_CHECK(stats.GetLastBlock(-1, CHAINSTATS_HIVE) == &vMain[198]);
+
+    // A window of 10 pow blocks ending at the tip matches a walk back through the chain
+    CChainStatsWindow window = stats.GetWindow(-1, 10, CHAINSTATS_SHA256);
+    double dHashes = 0;
+    int nBlocks = 0;
+    const CBlockIndex* pindex = &vMain.back();
+    const CBlockIndex* pindexFirst = nullptr;
+    while (nBlocks < 11) {
+        if (pindex->nNonce == 0) {
+            dHashes += GetNumHashes(*pindex, POW_TYPE_SHA256).getdouble();
+            pindexFirst = pindex;
+            nBlocks++;
+        }
+        pindex = pindex->pprev;
+    }
+    BOOST_CHECK_EQUAL(window.nBlocks, 11);
+    BOOST_CHECK(std::abs(window.dHashes - dHashes) < dHashes * 1e-12);
+    BOOST_CHECK_EQUAL(window.nTimeSpan, (int64_t)vMain.back().nTime - (int64_t)pindexFirst->nTime);
+
+    // Windows are clamped at the start of the chain
+    window = stats.GetWindow(5, 1000, CHAINSTATS_SHA256);
+    BOOST_CHECK_EQUAL(window.nBlocks, 5);   // Heights 0, 1, 2, 4, 5
+    BOOST_CHECK(stats.GetWindow(-1, 10, CHAINSTATS_MINOTAURX).nBlocks == 0);
+
+    // Reorg onto a branch forking at height 100
+    std::vector<CBlockIndex> vBranch(150);
+    std::vector<uint256> vBranchHashes(vBranch.size());
+    BuildChain(vBranch, vBranchHashes, &vMain[100], 4, 1600000000);
+    {
+        LOCK(cs_main);
+        stats.SetTip(&vBranch.back());
+    }
+    BOOST_CHECK(stats.Tip() == &vBranch.back());
+    BOOST_CHECK(!stats.GetLastBlock(&vMain[150], CHAINSTATS_SHA256, pindexLast));
+    BOOST_CHECK(stats.GetLastBlock(&vMain[100], CHAINSTATS_SHA256, pindexLast));
+    BOOST_CHECK(pindexLast == &vMain[100]);
+    BOOST_CHECK(stats.GetLastBlock(-1, CHAINSTATS_HIVE) == &vBranch[148]);
+    BOOST_CHECK(stats.GetLastBlock(103, CHAINSTATS_HIVE) == &vMain[99]);
+    BOOST_CHECK(stats.GetLastBlock(105, CHAINSTATS_HIVE) == &vBranch[4]);
+
+    // Reorg back, then clear
+    {
+        LOCK(cs_main);
+        stats.SetTip(&vMain[120]);
+        BOOST_CHECK(stats.GetLastBlock(-1, CHAINSTATS_HIVE) == &vMain[120]);
+        stats.SetTip(nullptr);
+    }
+    BOOST_CHECK(stats.Tip() == nullptr);
+    BOOST_CHECK(stats.GetLastBlock(-1, CHAINSTATS_SHA256) == nullptr);
+
+    // Don't leave dangling pointers to our block indexes in the versionbits cache
+    versionbitscache.Clear();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -209,6 +209,21 @@ BOOST_AUTO_TEST_CASE(test_CheckQueue_Correct_Random)
     Correct_Queue_range(range);
 }
 
+/** LitecoinCash: WorkStealing: Test that the master gets everything done by itself when there are no workers
+ */
+BOOST_AUTO_TEST_CASE(test_CheckQueue_No_Workers)
+{
+    auto queue = std::unique_ptr<Correct_Queue>(new Correct_Queue {QUEUE_BATCH_SIZE});
+    for (size_t i : std::vector<size_t>{0, 1, 1000}) {
+        FakeCheckCheckCompletion::n_calls = 0;
+        CCheckQueueControl<FakeCheckCheckCompletion> control(queue.get());
+        std::vector<FakeCheckCheckCompletion> vChecks(i);
+        control.Add(vChecks);
+        BOOST_REQUIRE(control.Wait());
+        BOOST_REQUIRE_EQUAL(FakeCheckCheckCompletion::n_calls, i);
+    }
+}
+
 
 /** Test that failing checks are caught */
 BOOST_AUTO_TEST_CASE(test_CheckQueue_Catches_Failure)
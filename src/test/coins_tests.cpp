@@ -3,6 +3,7 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <coins.h>
+#include <coinsprefetch.h>
 #include <script/standard.h>
 #include <uint256.h>
 #include <undo.h>
@@ -120,6 +121,8 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
     bool found_an_entry = false;
     bool missed_an_entry = false;
     bool uncached_an_entry = false;
+    bool synced_a_cache = false;
+    bool evicted_an_entry = false;
 
     // A simple map to track what we expect the cache stack to represent.
     std::map<COutPoint, Coin> result;
@@ -187,6 +190,12 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
             uncached_an_entry |= !stack[cacheid]->HaveCoinInCache(out);
         }
 
+        // Once every 200 iterations, evict part of a random cache
+        if (InsecureRandRange(200) == 0) {
+            int cacheid = InsecureRand32() % stack.size();
+            evicted_an_entry |= stack[cacheid]->Evict(stack[cacheid]->LiveMemoryUsage() / 2) > 0;
+        }
+
         // Once every 1000 iterations and at the end, verify the full cache.
         if (InsecureRandRange(1000) == 1 || i == NUM_SIMULATION_ITERATIONS - 1) {
             for (const auto& entry : result) {
@@ -210,7 +219,12 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
             // Every 100 iterations, flush an intermediate cache
             if (stack.size() > 1 && InsecureRandBool() == 0) {
                 unsigned int flushIndex = InsecureRandRange(stack.size() - 1);
-                stack[flushIndex]->Flush();
+                if (InsecureRandBool()) {
+                    stack[flushIndex]->Flush();
+                } else {
+                    stack[flushIndex]->Sync();
+                    synced_a_cache = true;
+                }
             }
         }
         if (InsecureRandRange(100) == 0) {
@@ -253,6 +267,137 @@ BOOST_AUTO_TEST_CASE(coins_cache_simulation_test)
     BOOST_CHECK(found_an_entry);
     BOOST_CHECK(missed_an_entry);
     BOOST_CHECK(uncached_an_entry);
+    BOOST_CHECK(synced_a_cache);
+    BOOST_CHECK(evicted_an_entry);
+}
+
+BOOST_AUTO_TEST_CASE(ccoins_sync_evict)
+{
+    CCoinsViewTest base;
+    CCoinsViewCacheTest cache(&base);
+
+    auto add = [&cache](std::vector<COutPoint>& outs) {
+        for (int i = 0; i < 100; i++) {
+            Coin coin;
+            coin.out.nValue = InsecureRand32();
+            coin.out.scriptPubKey.assign(InsecureRandBits(6), 0);
+            coin.nHeight = 1;
+            outs.emplace_back(InsecureRand256(), 0);
+            cache.AddCoin(outs.back(), std::move(coin), false);
+        }
+    };
+
+    // Syncing writes the coins to the base, and keeps them in the cache
+    std::vector<COutPoint> old_outs, new_outs;
+    add(old_outs);
+    BOOST_CHECK(cache.Sync());
+    for (const COutPoint& out : old_outs) {
+        Coin coin;
+        BOOST_CHECK(base.GetCoin(out, coin));
+        BOOST_CHECK(cache.HaveCoinInCache(out));
+        BOOST_CHECK_EQUAL(cache.map().at(out).flags, 0);
+    }
+
+    // While a write is pending, nothing leaves the cache, and spent coins stay behind as placeholders
+    add(new_outs);
+    BOOST_CHECK(cache.SpendCoin(old_outs[0]));
+    CCoinsMapMemoryResource resource;
+    CCoinsMap dirty(0, SaltedOutpointHasher(), CCoinsMap::key_equal(), &resource);
+    cache.TakeDirtyCoins(dirty);
+    BOOST_CHECK_EQUAL(dirty.size(), new_outs.size() + 1);
+    cache.Uncache(new_outs[0]);
+    BOOST_CHECK(cache.HaveCoinInCache(new_outs[0]));
+    BOOST_CHECK_EQUAL(cache.map().count(old_outs[0]), 1U);
+    BOOST_CHECK(base.BatchWrite(dirty, uint256()));
+    cache.SyncDone();
+    cache.SelfTest();
+
+    // Eviction drops the least recently used coins, and the placeholder
+    const size_t usage = cache.LiveMemoryUsage();
+    BOOST_CHECK(cache.Evict(usage - 1) >= old_outs.size());
+    BOOST_CHECK(cache.LiveMemoryUsage() < usage);
+    for (const COutPoint& out : old_outs) {
+        BOOST_CHECK(!cache.HaveCoinInCache(out));
+    }
+    for (const COutPoint& out : new_outs) {
+        BOOST_CHECK(cache.HaveCoinInCache(out));
+    }
+    BOOST_CHECK(!cache.HaveCoin(old_outs[0]));
+    BOOST_CHECK(cache.HaveCoin(old_outs[1]));
+    cache.SelfTest();
+
+    // Until there's nothing left to evict
+    cache.Evict(0);
+    BOOST_CHECK_EQUAL(cache.GetCacheSize(), 0U);
+    for (const COutPoint& out : new_outs) {
+        BOOST_CHECK(cache.HaveCoin(out));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ccoins_prefetch)
+{
+    CCoinsViewTest base;
+    std::vector<COutPoint> outs;
+    {
+        CCoinsViewCacheTest cache(&base);
+        for (int i = 0; i < 200; i++) {
+            Coin coin;
+            coin.out.nValue = InsecureRand32();
+            coin.nHeight = 1;
+            outs.emplace_back(InsecureRand256(), 0);
+            cache.AddCoin(outs.back(), std::move(coin), false);
+        }
+        cache.SetBestBlock(InsecureRand256());
+        BOOST_CHECK(cache.Flush());
+    }
+
+    // A block spending the first 100 coins, and an output it creates itself
+    CBlock block;
+    CMutableTransaction coinbase;
+    coinbase.vin.resize(1);
+    coinbase.vout.resize(1);
+    block.vtx.push_back(MakeTransactionRef(coinbase));
+    CMutableTransaction spend;
+    for (int i = 0; i < 100; i++) {
+        spend.vin.emplace_back(outs[i]);
+    }
+    spend.vout.resize(1);
+    block.vtx.push_back(MakeTransactionRef(spend));
+    CMutableTransaction child;
+    child.vin.emplace_back(block.vtx[1]->GetHash(), 0);
+    child.vout.resize(1);
+    block.vtx.push_back(MakeTransactionRef(child));
+
+    CCoinsViewPrefetch prefetch(&base, 4);
+    prefetch.Prefetch(block);
+    for (int i = 0; i < 1000 && prefetch.GetStats().nFetched < 100; i++) {
+        MilliSleep(10);
+    }
+    BOOST_CHECK_EQUAL(prefetch.GetStats().nFetched, 100U);
+    BOOST_CHECK_EQUAL(prefetch.GetStats().nStaged, 100U);
+
+    // The block's inputs come from the staging area, anything else from the base
+    CCoinsViewCacheTest cache(&prefetch);
+    for (const COutPoint& out : outs) {
+        BOOST_CHECK(cache.HaveCoin(out));
+    }
+    CoinsPrefetchStats stats = prefetch.GetStats();
+    BOOST_CHECK_EQUAL(stats.nHits, 100U);
+    BOOST_CHECK_EQUAL(stats.nMisses, 100U);
+    BOOST_CHECK_EQUAL(stats.nStaged, 0U);
+
+    // Writing to the base drops whatever is staged
+    prefetch.Prefetch(block);
+    for (int i = 0; i < 1000 && prefetch.GetStats().nFetched < 200; i++) {
+        MilliSleep(10);
+    }
+    BOOST_CHECK(cache.SpendCoin(outs[0]));
+    BOOST_CHECK(cache.Flush());
+    stats = prefetch.GetStats();
+    BOOST_CHECK_EQUAL(stats.nStaged, 0U);
+    BOOST_CHECK_EQUAL(stats.nDiscarded, 100U);
+    BOOST_CHECK(!cache.HaveCoin(outs[0]));
+    BOOST_CHECK(cache.HaveCoin(outs[1]));
 }
 
 // Store of all necessary tx and undo data for next test
@@ -586,7 +731,8 @@ void GetCoinsMapEntry(const CCoinsMap& map, CAmount& value, char& flags)
 
 void WriteCoinsViewEntry(CCoinsView& view, CAmount value, char flags)
 {
-    CCoinsMap map;
+    CCoinsMapMemoryResource resource;
+    CCoinsMap map(0, CCoinsMap::hasher(), CCoinsMap::key_equal(), &resource);
     InsertCoinsMapEntry(map, value, flags);
     view.BatchWrite(map, {});
 }
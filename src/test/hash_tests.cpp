@@ -45,6 +45,27 @@ BOOST_AUTO_TEST_CASE(murmurhash3)
 #undef T
 }
 
+BOOST_AUTO_TEST_CASE(murmurhash3_prepared)
+{
+    // LitecoinCash: BloomBatch: Any number of seeds at once, with the same results as MurmurHash3()
+    for (size_t nLen = 0; nLen < 40; nLen++) {
+        std::vector<unsigned char> data(nLen);
+        for (unsigned char& c : data)
+            c = InsecureRandBits(8);
+        std::vector<uint32_t> vWords;
+        MurmurHash3Prepare(data.data(), nLen, vWords);
+        BOOST_CHECK_EQUAL(vWords.size(), (nLen + 3) / 4);
+
+        const size_t nSeeds = 1 + InsecureRandRange(20);
+        std::vector<uint32_t> seeds(nSeeds), hashes(nSeeds);
+        for (uint32_t& seed : seeds)
+            seed = InsecureRand32();
+        MurmurHash3PreparedBatch(vWords.data(), nLen, seeds.data(), nSeeds, hashes.data());
+        for (size_t i = 0; i < nSeeds; i++)
+            BOOST_CHECK_EQUAL(hashes[i], MurmurHash3(seeds[i], data));
+    }
+}
+
 /*
    SipHash-2-4 output with
    k = 00 01 02 ...
@@ -147,4 +168,22 @@ BOOST_AUTO_TEST_CASE(siphash)
     }
 }
 
+BOOST_AUTO_TEST_CASE(siphash_batch)
+{
+    // The batch has to match one by one hashing, for any count and whether or not the 4-way code path is taken
+    FastRandomContext ctx;
+    for (size_t count = 0; count < 14; count++) {
+        uint64_t k0 = ctx.rand64();
+        uint64_t k1 = ctx.rand64();
+        std::vector<uint256> vals(count);
+        for (uint256& val : vals)
+            val = InsecureRand256();
+        std::vector<uint64_t> out(count + 1, 0);
+        SipHashUint256Batch(k0, k1, vals.data(), count, out.data());
+        for (size_t i = 0; i < count; i++)
+            BOOST_CHECK_EQUAL(out[i], SipHashUint256(k0, k1, vals[i]));
+        BOOST_CHECK_EQUAL(out[count], 0U);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
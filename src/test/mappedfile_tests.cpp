@@ -0,0 +1,70 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <mappedfile.h>
+#include <streams.h>
+#include <test/test_bitcoin.h>
+#include <validation.h>
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(mappedfile_tests, TestChain100Setup)
+
+#ifndef WIN32
+BOOST_AUTO_TEST_CASE(mapped_file)
+{
+    std::vector<unsigned char> contents(10000);
+    for (size_t i = 0; i < contents.size(); i++) {
+        contents[i] = InsecureRandBits(8);
+    }
+    const fs::path path = pathTemp / "mapped";
+    FILE* file = fsbridge::fopen(path, "wb");
+    BOOST_REQUIRE(file);
+    BOOST_CHECK_EQUAL(fwrite(contents.data(), 1, contents.size(), file), contents.size());
+    fclose(file);
+
+    CMappedFile mapped;
+    BOOST_REQUIRE(mapped.Open(path));
+    BOOST_CHECK_EQUAL(mapped.size(), contents.size());
+    BOOST_CHECK(std::equal(contents.begin(), contents.end(), mapped.data()));
+
+    CMappedFile missing;
+    BOOST_CHECK(!missing.Open(pathTemp / "missing"));
+}
+#endif
+
+BOOST_AUTO_TEST_CASE(read_raw_block)
+{
+    LOCK(cs_main);
+    for (CBlockIndex* pindex = chainActive.Tip(); pindex; pindex = pindex->pprev) {
+        CBlock block;
+        BOOST_REQUIRE(ReadBlockFromDisk(block, pindex, Params().GetConsensus()));
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        ss << block;
+
+        // The stored bytes are the block as sent with witness data
+        CRawBlock rawBlock;
+        BOOST_REQUIRE(ReadRawBlockFromDisk(rawBlock, pindex, Params().MessageStart()));
+        BOOST_CHECK_EQUAL(rawBlock.size(), ss.size());
+        BOOST_CHECK(std::equal(ss.begin(), ss.end(), reinterpret_cast<const char*>(rawBlock.data())));
+
+        CDataStream ssRaw(SER_NETWORK, PROTOCOL_VERSION);
+        ssRaw << rawBlock;
+        BOOST_CHECK(ssRaw.str() == ss.str());
+    }
+
+    // A position that isn't a block, or a block we didn't ask for, is refused
+    CRawBlock rawBlock;
+    CDiskBlockPos pos = chainActive.Tip()->GetBlockPos();
+    pos.nPos += 1;
+    BOOST_CHECK(!ReadRawBlockFromDisk(rawBlock, pos, Params().MessageStart()));
+    CBlockIndex index(*chainActive.Tip());
+    index.phashBlock = chainActive.Tip()->pprev->phashBlock;
+    BOOST_CHECK(!ReadRawBlockFromDisk(rawBlock, &index, Params().MessageStart()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
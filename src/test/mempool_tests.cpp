@@ -523,23 +523,26 @@ BOOST_AUTO_TEST_CASE(MempoolSizeLimitTest)
     pool.addUnchecked(tx6.GetHash(), entry.Fee(1100LL).FromTx(tx6));
     pool.addUnchecked(tx7.GetHash(), entry.Fee(9000LL).FromTx(tx7));
 
-    // we only require this remove, at max, 2 txn, because its not clear what we're really optimizing for aside from that
+    // LitecoinCash: ClusterMempool: tx5, tx6 and tx7 only pay for themselves together, so they are the last chunk
+    // and are evicted as one, however little has to go
     pool.TrimToSize(pool.DynamicMemoryUsage() - 1);
     BOOST_CHECK(pool.exists(tx4.GetHash()));
-    BOOST_CHECK(pool.exists(tx6.GetHash()));
+    BOOST_CHECK(!pool.exists(tx5.GetHash()));
+    BOOST_CHECK(!pool.exists(tx6.GetHash()));
     BOOST_CHECK(!pool.exists(tx7.GetHash()));
 
-    if (!pool.exists(tx5.GetHash()))
-        pool.addUnchecked(tx5.GetHash(), entry.Fee(1000LL).FromTx(tx5));
+    pool.addUnchecked(tx5.GetHash(), entry.Fee(1000LL).FromTx(tx5));
+    pool.addUnchecked(tx6.GetHash(), entry.Fee(1100LL).FromTx(tx6));
     pool.addUnchecked(tx7.GetHash(), entry.Fee(9000LL).FromTx(tx7));
 
-    pool.TrimToSize(pool.DynamicMemoryUsage() / 2); // should maximize mempool size by only removing 5/7
+    pool.TrimToSize(pool.DynamicMemoryUsage() / 2);
     BOOST_CHECK(pool.exists(tx4.GetHash()));
     BOOST_CHECK(!pool.exists(tx5.GetHash()));
-    BOOST_CHECK(pool.exists(tx6.GetHash()));
+    BOOST_CHECK(!pool.exists(tx6.GetHash()));
     BOOST_CHECK(!pool.exists(tx7.GetHash()));
 
     pool.addUnchecked(tx5.GetHash(), entry.Fee(1000LL).FromTx(tx5));
+    pool.addUnchecked(tx6.GetHash(), entry.Fee(1100LL).FromTx(tx6));
     pool.addUnchecked(tx7.GetHash(), entry.Fee(9000LL).FromTx(tx7));
 
     std::vector<CTransactionRef> vtx;
@@ -571,4 +574,214 @@ BOOST_AUTO_TEST_CASE(MempoolSizeLimitTest)
     SetMockTime(0);
 }
 
+static const CTxMemPoolCluster& GetCluster(CTxMemPool& pool, const CTransaction& tx)
+{
+    const CTxMemPoolCluster* cluster = pool.mapTx.find(tx.GetHash())->pcluster;
+    BOOST_REQUIRE(cluster);
+    return *cluster;
+}
+
+// Every transaction comes after its parents, and chunk fee rates are decreasing
+static void CheckClusters(CTxMemPool& pool)
+{
+    size_t nTx = 0;
+    for (const auto& entry : pool.GetClusters()) {
+        const CTxMemPoolCluster& cluster = *entry.second;
+        CTxMemPool::setEntries setEarlier;
+        for (const CTxMemPool::txiter it : cluster.vTxs) {
+            BOOST_CHECK(it->pcluster == &cluster);
+            for (const CTxMemPool::txiter parent : pool.GetMemPoolParents(it))
+                BOOST_CHECK(setEarlier.count(parent));
+            setEarlier.insert(it);
+        }
+        size_t nChunkTx = 0;
+        for (size_t i = 0; i < cluster.vChunks.size(); i++) {
+            BOOST_CHECK(i == 0 || cluster.vChunks[i - 1].HasHigherFeeRate(cluster.vChunks[i]));
+            nChunkTx += cluster.vChunks[i].nTxCount;
+        }
+        BOOST_CHECK_EQUAL(nChunkTx, cluster.vTxs.size());
+        nTx += cluster.vTxs.size();
+    }
+    BOOST_CHECK_EQUAL(nTx, pool.size());
+}
+
+BOOST_AUTO_TEST_CASE(MempoolClusterTest)
+{
+    CTxMemPool pool;
+    TestMemPoolEntryHelper entry;
+    LOCK(pool.cs);
+
+    CMutableTransaction txA = CMutableTransaction();
+    txA.vin.resize(1);
+    txA.vin[0].scriptSig = CScript() << OP_1;
+    txA.vout.resize(1);
+    txA.vout[0].scriptPubKey = CScript() << OP_1 << OP_EQUAL;
+    txA.vout[0].nValue = 10 * COIN;
+
+    // tx4 is spent by tx5 and tx6, which are both spent by tx7
+    CMutableTransaction tx4 = CMutableTransaction();
+    tx4.vin.resize(1);
+    tx4.vin[0].scriptSig = CScript() << OP_4;
+    tx4.vout.resize(2);
+    tx4.vout[0].scriptPubKey = CScript() << OP_4 << OP_EQUAL;
+    tx4.vout[0].nValue = 10 * COIN;
+    tx4.vout[1].scriptPubKey = CScript() << OP_4 << OP_EQUAL;
+    tx4.vout[1].nValue = 10 * COIN;
+
+    CMutableTransaction tx5 = CMutableTransaction();
+    tx5.vin.resize(1);
+    tx5.vin[0].prevout = COutPoint(tx4.GetHash(), 0);
+    tx5.vin[0].scriptSig = CScript() << OP_5;
+    tx5.vout.resize(1);
+    tx5.vout[0].scriptPubKey = CScript() << OP_5 << OP_EQUAL;
+    tx5.vout[0].nValue = 10 * COIN;
+
+    CMutableTransaction tx6 = CMutableTransaction();
+    tx6.vin.resize(1);
+    tx6.vin[0].prevout = COutPoint(tx4.GetHash(), 1);
+    tx6.vin[0].scriptSig = CScript() << OP_6;
+    tx6.vout.resize(1);
+    tx6.vout[0].scriptPubKey = CScript() << OP_6 << OP_EQUAL;
+    tx6.vout[0].nValue = 10 * COIN;
+
+    CMutableTransaction tx7 = CMutableTransaction();
+    tx7.vin.resize(2);
+    tx7.vin[0].prevout = COutPoint(tx5.GetHash(), 0);
+    tx7.vin[0].scriptSig = CScript() << OP_7;
+    tx7.vin[1].prevout = COutPoint(tx6.GetHash(), 0);
+    tx7.vin[1].scriptSig = CScript() << OP_7;
+    tx7.vout.resize(1);
+    tx7.vout[0].scriptPubKey = CScript() << OP_7 << OP_EQUAL;
+    tx7.vout[0].nValue = 10 * COIN;
+
+    pool.addUnchecked(txA.GetHash(), entry.Fee(1000LL).FromTx(txA));
+    pool.addUnchecked(tx4.GetHash(), entry.Fee(7000LL).FromTx(tx4));
+    pool.addUnchecked(tx5.GetHash(), entry.Fee(1000LL).FromTx(tx5));
+    pool.addUnchecked(tx6.GetHash(), entry.Fee(1100LL).FromTx(tx6));
+    pool.addUnchecked(tx7.GetHash(), entry.Fee(9000LL).FromTx(tx7));
+    CheckClusters(pool);
+    BOOST_CHECK_EQUAL(pool.GetClusters().size(), 2U);
+
+    // tx4 pays for itself; tx5 and tx6 only get in with tx7 paying for them
+    {
+        const CTxMemPoolCluster& cluster = GetCluster(pool, tx4);
+        BOOST_CHECK_EQUAL(cluster.vTxs.size(), 4U);
+        BOOST_CHECK(cluster.vTxs.front()->GetTx().GetHash() == tx4.GetHash());
+        BOOST_CHECK(cluster.vTxs.back()->GetTx().GetHash() == tx7.GetHash());
+        BOOST_REQUIRE_EQUAL(cluster.vChunks.size(), 2U);
+        BOOST_CHECK_EQUAL(cluster.vChunks[0].nTxCount, 1U);
+        BOOST_CHECK_EQUAL(cluster.vChunks[0].nModFees, 7000);
+        BOOST_CHECK_EQUAL(cluster.vChunks[1].nTxCount, 3U);
+        BOOST_CHECK_EQUAL(cluster.vChunks[1].nModFees, 11100);
+    }
+
+    // Removing tx5 (and so tx7) leaves tx6 to be chunked on its own
+    pool.removeRecursive(tx5);
+    CheckClusters(pool);
+    BOOST_CHECK_EQUAL(pool.GetClusters().size(), 2U);
+    {
+        const CTxMemPoolCluster& cluster = GetCluster(pool, tx6);
+        BOOST_CHECK_EQUAL(cluster.vTxs.size(), 2U);
+        BOOST_CHECK_EQUAL(cluster.vChunks.size(), 2U);
+    }
+
+    // Prioritising tx6 above tx4 merges them into one chunk
+    pool.PrioritiseTransaction(tx6.GetHash(), 20000LL);
+    CheckClusters(pool);
+    {
+        const CTxMemPoolCluster& cluster = GetCluster(pool, tx6);
+        BOOST_REQUIRE_EQUAL(cluster.vChunks.size(), 1U);
+        BOOST_CHECK_EQUAL(cluster.vChunks[0].nModFees, 28100);
+    }
+
+    // Confirming tx4 splits the cluster
+    std::vector<CTransactionRef> vtx;
+    vtx.push_back(MakeTransactionRef(tx4));
+    pool.removeForBlock(vtx, 1);
+    CheckClusters(pool);
+    BOOST_CHECK_EQUAL(pool.GetClusters().size(), 2U);
+    BOOST_CHECK_EQUAL(GetCluster(pool, tx6).vTxs.size(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(MempoolClusterSizeTest)
+{
+    CTxMemPool pool;
+    TestMemPoolEntryHelper entry;
+    LOCK(pool.cs);
+
+    // A chain of two, and a transaction of its own
+    CMutableTransaction tx1 = CMutableTransaction();
+    tx1.vin.resize(1);
+    tx1.vin[0].scriptSig = CScript() << OP_1;
+    tx1.vout.resize(1);
+    tx1.vout[0].scriptPubKey = CScript() << OP_1 << OP_EQUAL;
+    tx1.vout[0].nValue = 10 * COIN;
+    pool.addUnchecked(tx1.GetHash(), entry.Fee(1000LL).FromTx(tx1));
+
+    CMutableTransaction tx2 = tx1;
+    tx2.vin[0].prevout = COutPoint(tx1.GetHash(), 0);
+    pool.addUnchecked(tx2.GetHash(), entry.Fee(1000LL).FromTx(tx2));
+
+    CMutableTransaction tx3 = tx1;
+    tx3.vin[0].scriptSig = CScript() << OP_3;
+    pool.addUnchecked(tx3.GetHash(), entry.Fee(1000LL).FromTx(tx3));
+
+    // A transaction spending both joins them
+    CMutableTransaction tx4 = tx1;
+    tx4.vin.resize(2);
+    tx4.vin[0].prevout = COutPoint(tx2.GetHash(), 0);
+    tx4.vin[1].prevout = COutPoint(tx3.GetHash(), 0);
+    CTxMemPool::setEntries setAncestors;
+    std::string dummy;
+    BOOST_CHECK(pool.CalculateMemPoolAncestors(entry.FromTx(tx4), setAncestors, 100, 1000000, 100, 1000000, dummy));
+    BOOST_CHECK_EQUAL(setAncestors.size(), 3U);
+    BOOST_CHECK_EQUAL(pool.CalculateClusterSize(setAncestors), 4U);
+
+    // Without in-mempool ancestors, a transaction is a cluster of its own
+    BOOST_CHECK_EQUAL(pool.CalculateClusterSize(CTxMemPool::setEntries()), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(MempoolClusterLargeTest)
+{
+    CTxMemPool pool;
+    TestMemPoolEntryHelper entry;
+    LOCK(pool.cs);
+
+    // A chain too long for the full search, ending in a high fee transaction
+    const size_t nChain = 100;
+    std::vector<CTransaction> vChain;
+    CMutableTransaction tx = CMutableTransaction();
+    tx.vin.resize(1);
+    tx.vin[0].scriptSig = CScript() << OP_1;
+    tx.vout.resize(1);
+    tx.vout[0].scriptPubKey = CScript() << OP_1 << OP_EQUAL;
+    tx.vout[0].nValue = 10 * COIN;
+    for (size_t i = 0; i < nChain; i++) {
+        vChain.emplace_back(tx);
+        pool.addUnchecked(tx.GetHash(), entry.Fee(i + 1 == nChain ? 1000000LL : 1000LL).FromTx(tx));
+        tx.vin[0].prevout = COutPoint(tx.GetHash(), 0);
+    }
+    CheckClusters(pool);
+    BOOST_CHECK_EQUAL(pool.GetClusters().size(), 1U);
+    {
+        const CTxMemPoolCluster& cluster = GetCluster(pool, vChain.front());
+        BOOST_CHECK_EQUAL(cluster.vTxs.size(), nChain);
+        BOOST_CHECK_EQUAL(cluster.vChunks.size(), 1U);
+    }
+
+    // A low fee child is a chunk of its own, and the only one evicted
+    pool.addUnchecked(tx.GetHash(), entry.Fee(1000LL).FromTx(tx));
+    pool.TrimToSize(pool.DynamicMemoryUsage() - 1);
+    CheckClusters(pool);
+    BOOST_CHECK_EQUAL(pool.size(), nChain);
+    BOOST_CHECK(!pool.exists(tx.GetHash()));
+    BOOST_CHECK_EQUAL(GetCluster(pool, vChain.front()).vTxs.size(), nChain);
+
+    // The rest of the chain is one chunk, and goes as one
+    pool.TrimToSize(pool.DynamicMemoryUsage() - 1);
+    CheckClusters(pool);
+    BOOST_CHECK_EQUAL(pool.size(), 0U);
+    BOOST_CHECK(pool.GetClusters().empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -201,6 +201,87 @@ void TestPackageSelection(const CChainParams& chainparams, CScript scriptPubKey,
     BOOST_CHECK(pblocktemplate->block.vtx[8]->GetHash() == hashLowFeeTx2);
 }
 
+// LitecoinCash: Block templates: Test that the template manager extends its template as transactions
+// enter the mempool, and rebuilds it when the mempool changes underneath it.
+void TestBlockTemplateManager(const CChainParams& chainparams, CScript scriptPubKey, std::vector<CTransactionRef>& txFirst)
+{
+    TestMemPoolEntryHelper entry;
+    CBlockTemplateManager manager(chainparams);
+
+    std::unique_ptr<CBlockTemplate> pblocktemplate = manager.GetBlockTemplate(scriptPubKey);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 1);
+    const CAmount nCoinbaseValue = pblocktemplate->block.vtx[0]->vout[0].nValue;
+
+    // A new transaction is appended, and its fee paid to the coinbase
+    CMutableTransaction tx;
+    tx.vin.resize(1);
+    tx.vin[0].scriptSig = CScript() << OP_1;
+    tx.vin[0].prevout.hash = txFirst[0]->GetHash();
+    tx.vin[0].prevout.n = 0;
+    tx.vout.resize(1);
+    tx.vout[0].nValue = 5000000000LL - 10000;
+    uint256 hashParentTx = tx.GetHash();
+    mempool.addUnchecked(hashParentTx, entry.Fee(10000).Time(GetTime()).SpendsCoinbase(true).FromTx(tx));
+    pblocktemplate = manager.GetBlockTemplate(scriptPubKey);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 2);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == hashParentTx);
+    BOOST_CHECK_EQUAL(pblocktemplate->vTxFees[0], -10000);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx[0]->vout[0].nValue, nCoinbaseValue + 10000);
+
+    // A child of an included transaction is appended after it; a free transaction isn't
+    tx.vin[0].prevout.hash = hashParentTx;
+    tx.vout[0].nValue = 5000000000LL - 10000 - 20000;
+    uint256 hashChildTx = tx.GetHash();
+    mempool.addUnchecked(hashChildTx, entry.Fee(20000).Time(GetTime()).SpendsCoinbase(false).FromTx(tx));
+    tx.vin[0].prevout.hash = txFirst[1]->GetHash();
+    tx.vout[0].nValue = 5000000000LL - 1000;
+    uint256 hashFreeTx = tx.GetHash();
+    mempool.addUnchecked(hashFreeTx, entry.Fee(0).SpendsCoinbase(true).FromTx(tx));
+    pblocktemplate = manager.GetBlockTemplate(scriptPubKey);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 3);
+    BOOST_CHECK(pblocktemplate->block.vtx[2]->GetHash() == hashChildTx);
+
+    // ...until a child pays for it
+    tx.vin[0].prevout.hash = hashFreeTx;
+    tx.vout[0].nValue = 5000000000LL - 1000 - 50000;
+    uint256 hashCPFPTx = tx.GetHash();
+    mempool.addUnchecked(hashCPFPTx, entry.Fee(50000).SpendsCoinbase(false).FromTx(tx));
+    pblocktemplate = manager.GetBlockTemplate(scriptPubKey);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 5);
+    BOOST_CHECK(pblocktemplate->block.vtx[3]->GetHash() == hashFreeTx);
+    BOOST_CHECK(pblocktemplate->block.vtx[4]->GetHash() == hashCPFPTx);
+    BOOST_CHECK_EQUAL(pblocktemplate->vTxFees[0], -80000);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx[0]->vout[0].nValue, nCoinbaseValue + 80000);
+
+    // Removing an included transaction rebuilds the template without it and its descendants
+    mempool.removeRecursive(*mempool.get(hashParentTx));
+    pblocktemplate = manager.GetBlockTemplate(scriptPubKey);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 3);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == hashFreeTx);
+    BOOST_CHECK(pblocktemplate->block.vtx[2]->GetHash() == hashCPFPTx);
+    BOOST_CHECK_EQUAL(pblocktemplate->vTxFees[0], -50000);
+
+    // Prioritisation isn't notified, but still rebuilds the template
+    tx.vin[0].prevout.hash = txFirst[2]->GetHash();
+    tx.vout[0].nValue = 5000000000LL - 1000;
+    uint256 hashFreeTx2 = tx.GetHash();
+    mempool.addUnchecked(hashFreeTx2, entry.Fee(0).SpendsCoinbase(true).FromTx(tx));
+    pblocktemplate = manager.GetBlockTemplate(scriptPubKey);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 3);
+    mempool.PrioritiseTransaction(hashFreeTx2, 100000);
+    pblocktemplate = manager.GetBlockTemplate(scriptPubKey);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 4);
+    BOOST_CHECK(pblocktemplate->block.vtx[1]->GetHash() == hashFreeTx2);
+    mempool.PrioritiseTransaction(hashFreeTx2, -100000);
+
+    // Every caller gets its own coinbase
+    pblocktemplate = manager.GetBlockTemplate(CScript() << OP_TRUE);
+    BOOST_CHECK(pblocktemplate->block.vtx[0]->vout[0].scriptPubKey == CScript() << OP_TRUE);
+    BOOST_CHECK_EQUAL(pblocktemplate->block.vtx.size(), 3);
+
+    mempool.clear();
+}
+
 // NOTE: These tests rely on CreateNewBlock doing its own self-validation!
 BOOST_AUTO_TEST_CASE(CreateNewBlock_validity)
 {
@@ -517,6 +598,9 @@ BOOST_AUTO_TEST_CASE(CreateNewBlock_validity)
 
     TestPackageSelection(chainparams, scriptPubKey, txFirst);
 
+    mempool.clear();
+    TestBlockTemplateManager(chainparams, scriptPubKey, txFirst);
+
     fCheckpointsEnabled = true;
 }
 
@@ -185,4 +185,120 @@ BOOST_AUTO_TEST_CASE(cnode_simple_test)
     BOOST_CHECK(pnode2->fFeeler == false);
 }
 
+BOOST_AUTO_TEST_CASE(socket_events_mode)
+{
+    SocketEventsMode mode = SocketEventsMode::Epoll;
+    BOOST_CHECK(SocketEventsModeFromString("select", mode));
+    BOOST_CHECK(mode == SocketEventsMode::Select);
+    BOOST_CHECK(!SocketEventsModeFromString("kqueue", mode));
+    BOOST_CHECK(!SocketEventsModeFromString("", mode));
+    BOOST_CHECK(mode == SocketEventsMode::Select);
+#ifdef USE_EPOLL
+    BOOST_CHECK(SocketEventsModeFromString("epoll", mode));
+    BOOST_CHECK(mode == SocketEventsMode::Epoll);
+#else
+    BOOST_CHECK(!SocketEventsModeFromString("epoll", mode));
+#endif
+    BOOST_CHECK(SocketEventsModeFromString(SocketEventsModeToString(DEFAULT_SOCKETEVENTS), mode));
+    BOOST_CHECK(mode == DEFAULT_SOCKETEVENTS);
+}
+
+BOOST_AUTO_TEST_CASE(net_buffer_pool)
+{
+    CNetBufferPool pool;
+    NetBufferStats stats;
+
+    // Nothing to reuse yet
+    BOOST_CHECK_EQUAL(pool.Get(100).capacity(), 0U);
+
+    CNetSerializeData small;
+    small.resize(1000);
+    CNetSerializeData large;
+    large.reserve(100000);
+    pool.Put(std::move(small));
+    pool.Put(std::move(large));
+    pool.Put(CNetSerializeData());
+    pool.GetStats(stats);
+    BOOST_CHECK_EQUAL(stats.nPoolBuffers, 2U);
+    BOOST_CHECK(stats.nPoolBytes >= 101000U);
+
+    // The smallest buffer that fits, handed out empty
+    CNetSerializeData buffer = pool.Get(500);
+    BOOST_CHECK(buffer.capacity() >= 1000U && buffer.capacity() < 100000U);
+    BOOST_CHECK(buffer.empty());
+    BOOST_CHECK_EQUAL(pool.Get(200000).capacity(), 0U);
+    BOOST_CHECK(pool.Get(2000).capacity() >= 100000U);
+    pool.GetStats(stats);
+    BOOST_CHECK_EQUAL(stats.nPoolHits, 2U);
+    BOOST_CHECK_EQUAL(stats.nPoolMisses, 2U);
+    BOOST_CHECK_EQUAL(stats.nPoolBuffers, 0U);
+    BOOST_CHECK_EQUAL(stats.nPoolBytes, 0U);
+
+    // Bounded in count
+    for (size_t i = 0; i < MAX_NET_BUFFER_POOL_SIZE + 10; i++) {
+        CNetSerializeData b;
+        b.reserve(10);
+        pool.Put(std::move(b));
+    }
+    pool.GetStats(stats);
+    BOOST_CHECK_EQUAL(stats.nPoolBuffers, MAX_NET_BUFFER_POOL_SIZE);
+}
+
+BOOST_AUTO_TEST_CASE(shared_net_msg)
+{
+    CSerializedNetMsg msg;
+    msg.command = NetMsgType::PING;
+    msg.data = {1, 2, 3, 4, 5, 6, 7, 8};
+    const std::vector<unsigned char> data = msg.data;
+
+    // The header is what CMessageHeader serializes to
+    CMessageHeader hdr(Params().MessageStart(), NetMsgType::PING, data.size());
+    uint256 hash = Hash(data.begin(), data.end());
+    memcpy(hdr.pchChecksum, hash.begin(), CMessageHeader::CHECKSUM_SIZE);
+    std::vector<unsigned char> serializedHeader;
+    CVectorWriter{SER_NETWORK, INIT_PROTO_VERSION, serializedHeader, 0, hdr};
+
+    CSharedNetMsg shared(std::move(msg));
+    BOOST_CHECK(std::equal(shared.header.begin(), shared.header.end(), serializedHeader.begin()));
+    BOOST_CHECK_EQUAL(shared.size(), CMessageHeader::HEADER_SIZE + data.size());
+    BOOST_CHECK(std::equal(data.begin(), data.end(), shared.data.get()));
+
+    // Same again for a payload that is borrowed, not moved in
+    CSharedNetMsg borrowed(NetMsgType::PING, shared.data, shared.nDataSize);
+    BOOST_CHECK(borrowed.header == shared.header);
+    BOOST_CHECK(borrowed.data == shared.data);
+}
+
+BOOST_AUTO_TEST_CASE(cnetmessage_direct_receive)
+{
+    std::vector<unsigned char> data(300000);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = InsecureRandBits(8);
+    CSerializedNetMsg msg;
+    msg.command = NetMsgType::BLOCK;
+    msg.data = data;
+    const CSharedNetMsg shared(std::move(msg));
+
+    CNetMessage recv(Params().MessageStart(), SER_NETWORK, INIT_PROTO_VERSION);
+    size_t nSpace = 0;
+    BOOST_CHECK(recv.GetDataBuffer(nSpace) == nullptr);
+    BOOST_CHECK_EQUAL(recv.readHeader((const char*)shared.header.data(), shared.header.size()), (int)shared.header.size());
+
+    // Some data copied in, the rest received straight into place
+    BOOST_CHECK_EQUAL(recv.readData((const char*)data.data(), 1000), 1000);
+    size_t nPos = 1000;
+    while (!recv.complete()) {
+        char* pch = recv.GetDataBuffer(nSpace);
+        BOOST_REQUIRE(pch != nullptr);
+        BOOST_CHECK(nSpace > 0 && nSpace <= data.size() - nPos);
+        memcpy(pch, data.data() + nPos, nSpace);
+        BOOST_CHECK_EQUAL(recv.readData(pch, nSpace), (int)nSpace);
+        nPos += nSpace;
+    }
+    BOOST_CHECK_EQUAL(nPos, data.size());
+    BOOST_CHECK(recv.GetDataBuffer(nSpace) == nullptr);
+    BOOST_CHECK(std::equal(data.begin(), data.end(), (const unsigned char*)recv.vRecv.data()));
+    BOOST_CHECK(recv.GetMessageHash() == Hash(data.begin(), data.end()));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
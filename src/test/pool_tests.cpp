@@ -0,0 +1,103 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <memusage.h>
+#include <support/allocators/pool.h>
+#include <test/test_bitcoin.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(pool_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(basic_allocate_deallocate)
+{
+    PoolResource<64, 8> resource(1024);
+    BOOST_CHECK_EQUAL(resource.NumAllocatedChunks(), 1U);
+    BOOST_CHECK_EQUAL(resource.ChunkSizeBytes(), 1024U);
+
+    // Blocks of the same size are handed out back to back from the chunk
+    void* a = resource.Allocate(8, 8);
+    void* b = resource.Allocate(8, 8);
+    BOOST_CHECK_EQUAL(static_cast<char*>(b) - static_cast<char*>(a), 8);
+
+    // A freed block is reused for the next allocation of that size, but not for other sizes
+    resource.Deallocate(a, 8, 8);
+    void* c = resource.Allocate(16, 8);
+    BOOST_CHECK(c != a);
+    void* d = resource.Allocate(8, 8);
+    BOOST_CHECK(d == a);
+
+    // Sizes are rounded up to the alignment
+    resource.Deallocate(d, 8, 8);
+    void* e = resource.Allocate(5, 8);
+    BOOST_CHECK(e == a);
+
+    // Too large or too strictly aligned allocations don't come from the pool
+    void* big = resource.Allocate(128, 8);
+    void* aligned = resource.Allocate(8, 64);
+    resource.Deallocate(big, 128, 8);
+    resource.Deallocate(aligned, 8, 64);
+    BOOST_CHECK_EQUAL(resource.NumAllocatedChunks(), 1U);
+
+    resource.Deallocate(b, 8, 8);
+    resource.Deallocate(c, 16, 8);
+    resource.Deallocate(e, 5, 8);
+}
+
+BOOST_AUTO_TEST_CASE(chunks_are_reused)
+{
+    PoolResource<64, 8> resource(1024);
+    std::vector<void*> blocks;
+    for (int i = 0; i < 1024 / 32 * 3; ++i) {
+        blocks.push_back(resource.Allocate(32, 8));
+    }
+    BOOST_CHECK_EQUAL(resource.NumAllocatedChunks(), 3U);
+    BOOST_CHECK_EQUAL(resource.BytesInUse(), blocks.size() * 32);
+
+    for (void* p : blocks) {
+        resource.Deallocate(p, 32, 8);
+    }
+    BOOST_CHECK_EQUAL(resource.BytesInUse(), 0U);
+    for (void*& p : blocks) {
+        p = resource.Allocate(32, 8);
+    }
+    BOOST_CHECK_EQUAL(resource.NumAllocatedChunks(), 3U);
+    for (void* p : blocks) {
+        resource.Deallocate(p, 32, 8);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(unordered_map_memusage)
+{
+    typedef std::unordered_map<uint64_t, uint64_t, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                               PoolAllocator<std::pair<const uint64_t, uint64_t>, sizeof(std::pair<const uint64_t, uint64_t>) + sizeof(void*) * 4> >
+        Map;
+    Map::allocator_type::ResourceType resource;
+    Map map(0, Map::hasher(), Map::key_equal(), &resource);
+
+    for (uint64_t i = 0; i < 100000; ++i) {
+        map[i] = i;
+    }
+    for (uint64_t i = 0; i < 100000; ++i) {
+        BOOST_CHECK_EQUAL(map[i], i);
+    }
+    // All nodes came from the pool, so the map's usage is its chunks plus the bucket array
+    size_t chunks = resource.NumAllocatedChunks();
+    BOOST_CHECK(chunks > 1);
+    BOOST_CHECK(memusage::DynamicUsage(map) >= chunks * resource.ChunkSizeBytes());
+
+    // Erasing and reinserting the same number of entries doesn't grow the pool
+    for (uint64_t i = 0; i < 100000; ++i) {
+        map.erase(i);
+    }
+    for (uint64_t i = 0; i < 100000; ++i) {
+        map[i + 100000] = i;
+    }
+    BOOST_CHECK_EQUAL(resource.NumAllocatedChunks(), chunks);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
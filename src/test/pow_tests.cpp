@@ -83,4 +83,33 @@ BOOST_AUTO_TEST_CASE(GetBlockProofEquivalentTime_test)
     }
 }
 
+/* LitecoinCash: ReindexPipeline: Test that precomputed pow hashes are the ones GetPoWHash would compute */
+BOOST_AUTO_TEST_CASE(precomputed_pow_hashes)
+{
+    const uint32_t powForkTime = Params().GetConsensus().powForkTime;
+    std::vector<CBlockHeader> headers(24);
+    for (size_t i = 0; i < headers.size(); i++) {
+        CBlockHeader& header = headers[i];
+        header.hashPrevBlock = InsecureRand256();
+        header.nNonce = InsecureRand32();
+        if (i < 16) {
+            header.nTime = powForkTime - i;         // scrypt
+            header.nVersion = 4;
+        } else {
+            header.nTime = powForkTime + i;
+            header.nVersion = (i % 2 ? POW_TYPE_MINOTAURX : POW_TYPE_SHA256) << 16;
+        }
+    }
+
+    std::vector<uint256> expected;
+    std::vector<const CBlockHeader*> pheaders;
+    for (const CBlockHeader& header : headers) {
+        expected.push_back(header.GetPoWHash());
+        pheaders.push_back(&header);
+    }
+    PrecomputePoWHashes(pheaders, true);
+    for (size_t i = 0; i < headers.size(); i++)
+        BOOST_CHECK(headers[i].GetPoWHash() == expected[i]);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
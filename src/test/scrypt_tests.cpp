@@ -30,6 +30,20 @@ BOOST_AUTO_TEST_CASE(scrypt_hashtest)
         scrypt_1024_1_1_256_sp_generic((const char*)&inputbytes[0], BEGIN(scrypthash), scratchpad);
         BOOST_CHECK_EQUAL(scrypthash.ToString().c_str(), expected[i]);
     }
+
+    // LitecoinCash: ScryptBatch: 13 hashes go through the 8-way, 4-way and single lane paths
+    (void) scrypt_detect_batch();
+    const int BATCHCOUNT = 13;
+    std::vector<unsigned char> batchinput;
+    for (int i = 0; i < BATCHCOUNT; i++) {
+        inputbytes = ParseHex(inputhex[i % HASHCOUNT]);
+        batchinput.insert(batchinput.end(), inputbytes.begin(), inputbytes.end());
+    }
+    std::vector<uint256> batchoutput(BATCHCOUNT);
+    scrypt_1024_1_1_256_batch((const char*)batchinput.data(), BEGIN(batchoutput[0]), BATCHCOUNT);
+    for (int i = 0; i < BATCHCOUNT; i++) {
+        BOOST_CHECK_EQUAL(batchoutput[i].ToString().c_str(), expected[i % HASHCOUNT]);
+    }
 }
 
 BOOST_AUTO_TEST_SUITE_END()
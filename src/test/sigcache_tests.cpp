@@ -0,0 +1,106 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cuckoocache.h>
+#include <fs.h>
+#include <script/sigcache.h>
+#include <uint256.h>
+#include <util.h>
+#include <utiltime.h>
+
+#include <test/test_bitcoin.h>
+
+#include <set>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(sigcache_tests, TestingSetup)
+
+static std::vector<uint256> RandomEntries(size_t n)
+{
+    std::vector<uint256> entries;
+    for (size_t i = 0; i < n; i++)
+        entries.push_back(InsecureRand256());
+    return entries;
+}
+
+BOOST_AUTO_TEST_CASE(cuckoocache_for_each)
+{
+    CuckooCache::cache<uint256, SignatureCacheHasher> cache;
+    cache.setup_bytes(1 << 16);
+    const std::vector<uint256> entries = RandomEntries(100);
+    for (const uint256& entry : entries)
+        cache.insert(entry);
+    // Entries allowed to be erased are no longer reported
+    for (size_t i = 0; i < 10; i++)
+        BOOST_CHECK(cache.contains(entries[i], true));
+
+    std::set<uint256> seen;
+    cache.for_each([&seen](const uint256& entry) { seen.insert(entry); });
+    BOOST_CHECK_EQUAL(seen.size(), 90U);
+    for (size_t i = 0; i < entries.size(); i++)
+        BOOST_CHECK_EQUAL(seen.count(entries[i]), i < 10 ? 0U : 1U);
+}
+
+BOOST_AUTO_TEST_CASE(sigcache_file_roundtrip)
+{
+    const fs::path path = GetDataDir() / "sigcache_test.dat";
+    const uint256 nonce = InsecureRand256();
+    const std::vector<uint256> entries = RandomEntries(1000);
+    BOOST_CHECK(WriteSignatureCacheFile(path, nonce, entries));
+    BOOST_CHECK(!fs::exists(path.string() + ".new"));
+
+    uint256 nonceRead;
+    std::vector<uint256> entriesRead;
+    BOOST_CHECK(ReadSignatureCacheFile(path, nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+    BOOST_CHECK(nonceRead == nonce);
+    BOOST_CHECK(entriesRead == entries);
+
+    // A missing file is not an error worth more than a false
+    BOOST_CHECK(!ReadSignatureCacheFile(GetDataDir() / "nonexistent.dat", nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+}
+
+BOOST_AUTO_TEST_CASE(sigcache_file_rejected)
+{
+    const fs::path path = GetDataDir() / "sigcache_test.dat";
+    const uint256 nonce = InsecureRand256();
+    const std::vector<uint256> entries = RandomEntries(100);
+    uint256 nonceRead;
+    std::vector<uint256> entriesRead;
+
+    // Too old
+    const int64_t nNow = GetTime();
+    SetMockTime(nNow);
+    BOOST_CHECK(WriteSignatureCacheFile(path, nonce, entries));
+    SetMockTime(nNow + MAX_SIGCACHE_FILE_AGE + 1);
+    BOOST_CHECK(!ReadSignatureCacheFile(path, nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+    // Written in the future
+    SetMockTime(nNow - 60);
+    BOOST_CHECK(!ReadSignatureCacheFile(path, nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+    SetMockTime(nNow);
+    BOOST_CHECK(ReadSignatureCacheFile(path, nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+    SetMockTime(0);
+
+    // Corrupted: flip a bit in the middle of the entries
+    FILE* file = fsbridge::fopen(path, "rb+");
+    BOOST_REQUIRE(file);
+    BOOST_REQUIRE_EQUAL(fseek(file, 1000, SEEK_SET), 0);
+    int c = fgetc(file);
+    BOOST_REQUIRE_EQUAL(fseek(file, 1000, SEEK_SET), 0);
+    fputc(c ^ 1, file);
+    fclose(file);
+    BOOST_CHECK(!ReadSignatureCacheFile(path, nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+
+    // Truncated
+    fs::resize_file(path, 500);
+    BOOST_CHECK(!ReadSignatureCacheFile(path, nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+
+    // Written by another version of the client
+    BOOST_CHECK(WriteSignatureCacheFile(path, nonce, entries, CLIENT_VERSION - 1));
+    BOOST_CHECK(!ReadSignatureCacheFile(path, nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+    BOOST_CHECK(WriteSignatureCacheFile(path, nonce, entries, CLIENT_VERSION + 1));
+    BOOST_CHECK(!ReadSignatureCacheFile(path, nonceRead, entriesRead, MAX_SIGCACHE_FILE_AGE));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
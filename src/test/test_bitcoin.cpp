@@ -8,6 +8,7 @@
 #include <consensus/consensus.h>
 #include <consensus/validation.h>
 #include <crypto/sha256.h>
+#include <index/base.h>
 #include <validation.h>
 #include <miner.h>
 #include <net_processing.h>
@@ -16,6 +17,7 @@
 #include <rpc/server.h>
 #include <rpc/register.h>
 #include <script/sigcache.h>
+#include <utiltime.h>
 
 #include <memory>
 
@@ -183,3 +185,14 @@ CBlock getBlock13b8a()
     stream >> block;
     return block;
 }
+
+void WaitForSync(BaseIndex& index)
+{
+    int64_t time_start = GetTimeMillis();
+    while (!index.BlockUntilSyncedToCurrentChain()) {
+        if (GetTimeMillis() >= time_start + 10000) {
+            throw std::runtime_error("Timed out waiting for index to sync.");
+        }
+        MilliSleep(100);
+    }
+}
@@ -118,4 +118,9 @@ struct TestMemPoolEntryHelper
 
 CBlock getBlock13b8a();
 
+class BaseIndex;
+
+/** Block until the index has caught up with the active chain; throws if that takes over 10 seconds. */
+void WaitForSync(BaseIndex& index);
+
 #endif
@@ -0,0 +1,73 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chain.h>
+#include <chainparams.h>
+#include <random.h>
+#include <txdb.h>
+#include <uint256.h>
+
+#include <test/test_bitcoin.h>
+
+#include <map>
+#include <memory>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(txdb_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(load_block_index_guts)
+{
+    // A chain with a few side branches, spread over the whole key space
+    const int nBlocks = 5000;
+    std::vector<uint256> vHashes(nBlocks);
+    std::vector<std::unique_ptr<CBlockIndex>> vIndex;
+    for (int i = 0; i < nBlocks; i++) {
+        vIndex.emplace_back(new CBlockIndex());
+        CBlockIndex* pindex = vIndex.back().get();
+        pindex->pprev = i == 0 ? nullptr : vIndex[i % 10 == 0 ? i / 2 : i - 1].get();
+        pindex->nHeight = pindex->pprev ? pindex->pprev->nHeight + 1 : 0;
+        pindex->nTime = i;
+        pindex->nBits = 0x207fffff;
+        pindex->nNonce = InsecureRand32();
+        pindex->nStatus = BLOCK_VALID_TREE;
+        pindex->nTx = i % 7;
+        // Entries are stored under their header hash
+        vHashes[i] = pindex->GetBlockHeader().GetHash();
+        pindex->phashBlock = &vHashes[i];
+    }
+    std::vector<const CBlockIndex*> vWrite;
+    for (const auto& pindex : vIndex)
+        vWrite.push_back(pindex.get());
+
+    CBlockTreeDB db(1 << 20, true);
+    BOOST_CHECK(db.WriteBatchSync({}, 0, vWrite));
+
+    std::map<uint256, std::unique_ptr<CBlockIndex>> mapLoaded;
+    auto insertBlockIndex = [&mapLoaded](const uint256& hash) -> CBlockIndex* {
+        if (hash.IsNull())
+            return nullptr;
+        auto it = mapLoaded.find(hash);
+        if (it == mapLoaded.end()) {
+            it = mapLoaded.emplace(hash, std::unique_ptr<CBlockIndex>(new CBlockIndex())).first;
+            it->second->phashBlock = &it->first;
+        }
+        return it->second.get();
+    };
+    BOOST_CHECK(db.LoadBlockIndexGuts(Params().GetConsensus(), insertBlockIndex));
+
+    BOOST_CHECK_EQUAL(mapLoaded.size(), (size_t)nBlocks);
+    for (const auto& pindex : vIndex) {
+        auto it = mapLoaded.find(pindex->GetBlockHash());
+        BOOST_REQUIRE(it != mapLoaded.end());
+        const CBlockIndex* pindexLoaded = it->second.get();
+        BOOST_CHECK(pindexLoaded->pprev == (pindex->pprev ? mapLoaded[pindex->pprev->GetBlockHash()].get() : nullptr));
+        BOOST_CHECK_EQUAL(pindexLoaded->nHeight, pindex->nHeight);
+        BOOST_CHECK_EQUAL(pindexLoaded->nTime, pindex->nTime);
+        BOOST_CHECK_EQUAL(pindexLoaded->nNonce, pindex->nNonce);
+        BOOST_CHECK_EQUAL(pindexLoaded->nTx, pindex->nTx);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+// Copyright (c) 2026 The Litecoin Cash Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <chainparams.h>
+#include <index/txindex.h>
+#include <script/standard.h>
+#include <test/test_bitcoin.h>
+#include <txdb.h>
+#include <util.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(txindex_tests, TestChain100Setup)
+
+static void CheckFindTx(const TxIndex& txindex, const CTransaction& tx)
+{
+    CTransactionRef tx_disk;
+    uint256 block_hash;
+    if (!txindex.FindTx(tx.GetHash(), block_hash, tx_disk)) {
+        BOOST_ERROR("FindTx failed");
+    } else if (tx_disk->GetHash() != tx.GetHash()) {
+        BOOST_ERROR("Read incorrect tx");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(txindex_initial_sync)
+{
+    TxIndex txindex(1 << 20, true);
+
+    CTransactionRef tx_disk;
+    uint256 block_hash;
+
+    // Transaction should not be found in the index before it is started.
+    for (const auto& txn : coinbaseTxns) {
+        BOOST_CHECK(!txindex.FindTx(txn.GetHash(), block_hash, tx_disk));
+    }
+
+    // BlockUntilSyncedToCurrentChain should return false before txindex is started.
+    BOOST_CHECK(!txindex.BlockUntilSyncedToCurrentChain());
+
+    // The index catches up with the existing chain in the background.
+    txindex.Start();
+    WaitForSync(txindex);
+
+    // Check that txindex has all txs that were in the chain before it started.
+    for (const auto& txn : coinbaseTxns) {
+        CheckFindTx(txindex, txn);
+    }
+
+    // Check that new transactions in new blocks make it into the index.
+    CScript coinbase_script = GetScriptForDestination(coinbaseKey.GetPubKey().GetID());
+    for (int i = 0; i < 10; i++) {
+        const CBlock block = CreateAndProcessBlock({}, coinbase_script);
+        BOOST_CHECK(txindex.BlockUntilSyncedToCurrentChain());
+        CheckFindTx(txindex, *block.vtx[0]);
+    }
+
+    txindex.Interrupt();
+    txindex.Stop();
+}
+
+BOOST_AUTO_TEST_CASE(txindex_migration)
+{
+    // Lay out an index the way earlier versions kept it, in the block tree database and flagged as
+    // in sync with the chain tip.
+    const std::vector<CTransaction> legacy_txns = coinbaseTxns;
+    {
+        LOCK(cs_main);
+        for (const CBlockIndex* pindex = chainActive[1]; pindex; pindex = chainActive.Next(pindex)) {
+            CBlock block;
+            BOOST_REQUIRE(ReadBlockFromDisk(block, pindex, Params().GetConsensus()));
+            CDiskTxPos pos(pindex->GetBlockPos(), GetSizeOfCompactSize(block.vtx.size()));
+            BOOST_REQUIRE(pblocktree->Write(std::make_pair('t', block.vtx[0]->GetHash()), pos));
+        }
+        BOOST_REQUIRE(pblocktree->WriteFlag("txindex", true));
+    }
+
+    // Blocks connected while the index is switched off are left to the new index to catch up on.
+    {
+        LOCK(cs_main);
+        BOOST_CHECK(SuspendLegacyTxIndex(*pblocktree, chainActive.GetLocator()));
+    }
+    bool f_legacy_flag = true;
+    BOOST_CHECK(pblocktree->ReadFlag("txindex", f_legacy_flag));
+    BOOST_CHECK(!f_legacy_flag);
+
+    CScript coinbase_script = GetScriptForDestination(coinbaseKey.GetPubKey().GetID());
+    const CBlock block = CreateAndProcessBlock({}, coinbase_script);
+
+    TxIndex txindex(1 << 20, true);
+    txindex.Start();
+    WaitForSync(txindex);
+
+    // Every entry is moved out of the block tree database.
+    for (const auto& txn : legacy_txns) {
+        CheckFindTx(txindex, txn);
+        BOOST_CHECK(!pblocktree->Exists(std::make_pair('t', txn.GetHash())));
+    }
+    CheckFindTx(txindex, *block.vtx[0]);
+
+    txindex.Interrupt();
+    txindex.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -16,12 +16,16 @@
 
 #include <stdint.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include <boost/thread.hpp>
 
 static const char DB_COIN = 'C';
 static const char DB_COINS = 'c';
 static const char DB_BLOCK_FILES = 'f';
-static const char DB_TXINDEX = 't';
 static const char DB_BLOCK_INDEX = 'b';
 
 static const char DB_BEST_BLOCK = 'B';
@@ -236,17 +240,6 @@ bool CBlockTreeDB::WriteBatchSync(const std::vector<std::pair<int, const CBlockF
     return WriteBatch(batch, true);
 }
 
-bool CBlockTreeDB::ReadTxIndex(const uint256 &txid, CDiskTxPos &pos) {
-    return Read(std::make_pair(DB_TXINDEX, txid), pos);
-}
-
-bool CBlockTreeDB::WriteTxIndex(const std::vector<std::pair<uint256, CDiskTxPos> >&vect) {
-    CDBBatch batch(*this);
-    for (std::vector<std::pair<uint256,CDiskTxPos> >::const_iterator it=vect.begin(); it!=vect.end(); it++)
-        batch.Write(std::make_pair(DB_TXINDEX, it->first), it->second);
-    return WriteBatch(batch);
-}
-
 bool CBlockTreeDB::WriteFlag(const std::string &name, bool fValue) {
     return Write(std::make_pair(DB_FLAG, name), fValue ? '1' : '0');
 }
@@ -259,52 +252,176 @@ bool CBlockTreeDB::ReadFlag(const std::string &name, bool &fValue) {
     return true;
 }
 
-bool CBlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex)
+namespace {
+
+/**
+ * LitecoinCash: FastIndexLoad: Hands batches of block index entries from the threads that read them to the
+ * thread that links them up. Readers wait while too many batches are queued, so memory stays bounded.
+ */
+class BlockIndexLoadQueue
 {
-    std::unique_ptr<CDBIterator> pcursor(NewIterator());
+private:
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<std::vector<CDiskBlockIndex>> batches;
+    size_t nMaxBatches;
+    int nReaders;
+    bool fFailed;
+    bool fStop;
+
+public:
+    BlockIndexLoadQueue(int nReadersIn, size_t nMaxBatchesIn) : nMaxBatches(nMaxBatchesIn), nReaders(nReadersIn), fFailed(false), fStop(false) {}
+
+    //! Returns false if the reader should give up
+    bool Push(std::vector<CDiskBlockIndex>&& batch)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]{ return fStop || batches.size() < nMaxBatches; });
+        if (fStop)
+            return false;
+        batches.push_back(std::move(batch));
+        cond.notify_all();
+        return true;
+    }
 
-    pcursor->Seek(std::make_pair(DB_BLOCK_INDEX, uint256()));
+    //! Returns false once all readers are done and everything has been taken
+    bool Pop(std::vector<CDiskBlockIndex>& batch)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]{ return fStop || !batches.empty() || nReaders == 0; });
+        if (fStop || batches.empty())
+            return false;
+        batch = std::move(batches.front());
+        batches.pop_front();
+        cond.notify_all();
+        return true;
+    }
+
+    void ReaderDone(bool fOk)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        nReaders--;
+        if (!fOk) {
+            fFailed = true;
+            fStop = true;
+        }
+        cond.notify_all();
+    }
+
+    void Stop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        fStop = true;
+        cond.notify_all();
+    }
+
+    bool Failed()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return fFailed;
+    }
+};
+
+//! LitecoinCash: FastIndexLoad: Read the block index entries whose hash starts with a byte in [nBegin, nEnd)
+void ReadBlockIndexSlice(CDBWrapper& db, int nBegin, int nEnd, BlockIndexLoadQueue& queue)
+{
+    RenameThread("litecoincash-loadblkidx");
+    bool fOk = true;
+    try {
+        std::unique_ptr<CDBIterator> pcursor(db.NewIterator());
+        uint256 start;
+        *start.begin() = nBegin;
+        pcursor->Seek(std::make_pair(DB_BLOCK_INDEX, start));
+
+        std::vector<CDiskBlockIndex> batch;
+        batch.reserve(BLOCK_INDEX_LOAD_BATCH_SIZE);
+        while (pcursor->Valid()) {
+            std::pair<char, uint256> key;
+            if (!pcursor->GetKey(key) || key.first != DB_BLOCK_INDEX || *key.second.begin() >= nEnd)
+                break;
+            batch.emplace_back();
+            if (!pcursor->GetValue(batch.back())) {
+                fOk = error("%s: failed to read value", __func__);
+                break;
+            }
+            if (batch.size() == BLOCK_INDEX_LOAD_BATCH_SIZE) {
+                if (!queue.Push(std::move(batch)))
+                    break;
+                batch.clear();
+                batch.reserve(BLOCK_INDEX_LOAD_BATCH_SIZE);
+            }
+            pcursor->Next();
+        }
+        if (fOk && !batch.empty())
+            queue.Push(std::move(batch));
+    } catch (const std::exception& e) {
+        fOk = error("%s: %s", __func__, e.what());
+    }
+    queue.ReaderDone(fOk);
+}
+
+} // namespace
+
+bool CBlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex)
+{
+    // LitecoinCash: FastIndexLoad: Reading and deserializing the entries is split over a few threads, each
+    // scanning its own slice of the key space. Linking them up stays on this thread, as entries come in.
+    const int64_t nStart = GetTimeMicros();
+    const int nThreads = std::max(1, std::min(GetNumCores(), MAX_BLOCK_INDEX_LOAD_THREADS));
+    BlockIndexLoadQueue queue(nThreads, 4 * nThreads);
+    std::vector<std::thread> vThreads;
+    for (int i = 0; i < nThreads; i++)
+        vThreads.emplace_back(ReadBlockIndexSlice, std::ref(*this), 256 * i / nThreads, 256 * (i + 1) / nThreads, std::ref(queue));
+
+    // Make sure the readers are gone before the queue is, however this returns
+    struct ReaderJoiner {
+        BlockIndexLoadQueue& queue;
+        std::vector<std::thread>& vThreads;
+        ~ReaderJoiner()
+        {
+            queue.Stop();
+            for (std::thread& thread : vThreads)
+                thread.join();
+        }
+    } joiner{queue, vThreads};
 
     // Load mapBlockIndex
-    while (pcursor->Valid()) {
+    size_t nEntries = 0;
+    std::vector<CDiskBlockIndex> batch;
+    while (queue.Pop(batch)) {
         boost::this_thread::interruption_point();
-        std::pair<char, uint256> key;
-        if (pcursor->GetKey(key) && key.first == DB_BLOCK_INDEX) {
-            CDiskBlockIndex diskindex;
-            if (pcursor->GetValue(diskindex)) {
-                // Construct block index object
-                CBlockIndex* pindexNew = insertBlockIndex(diskindex.GetBlockHash());
-                pindexNew->pprev          = insertBlockIndex(diskindex.hashPrev);
-                pindexNew->nHeight        = diskindex.nHeight;
-                pindexNew->nFile          = diskindex.nFile;
-                pindexNew->nDataPos       = diskindex.nDataPos;
-                pindexNew->nUndoPos       = diskindex.nUndoPos;
-                pindexNew->nVersion       = diskindex.nVersion;
-                pindexNew->hashMerkleRoot = diskindex.hashMerkleRoot;
-                pindexNew->nTime          = diskindex.nTime;
-                pindexNew->nBits          = diskindex.nBits;
-                pindexNew->nNonce         = diskindex.nNonce;
-                pindexNew->nStatus        = diskindex.nStatus;
-                pindexNew->nTx            = diskindex.nTx;
-
-                // LitecoinCash: Disable PoW Sanity check while loading block index from disk.
-                // We use the sha256 hash for the block index for performance reasons, which is recorded for later use.
-                // CheckProofOfWork() uses the scrypt hash which is discarded after a block is accepted.
-                // While it is technically feasible to verify the PoW, doing so takes several minutes as it
-                // requires recomputing every PoW hash during every LitecoinCash startup.
-                // We opt instead to simply trust the data that is on your local disk.
-                //if (!CheckProofOfWork(pindexNew->GetBlockHash(), pindexNew->nBits, consensusParams))
-                //    return error("%s: CheckProofOfWork failed: %s", __func__, pindexNew->ToString());
-
-                pcursor->Next();
-            } else {
-                return error("%s: failed to read value", __func__);
-            }
-        } else {
-            break;
+        for (const CDiskBlockIndex& diskindex : batch) {
+            // Construct block index object
+            CBlockIndex* pindexNew = insertBlockIndex(diskindex.GetBlockHash());
+            pindexNew->pprev          = insertBlockIndex(diskindex.hashPrev);
+            pindexNew->nHeight        = diskindex.nHeight;
+            pindexNew->nFile          = diskindex.nFile;
+            pindexNew->nDataPos       = diskindex.nDataPos;
+            pindexNew->nUndoPos       = diskindex.nUndoPos;
+            pindexNew->nVersion       = diskindex.nVersion;
+            pindexNew->hashMerkleRoot = diskindex.hashMerkleRoot;
+            pindexNew->nTime          = diskindex.nTime;
+            pindexNew->nBits          = diskindex.nBits;
+            pindexNew->nNonce         = diskindex.nNonce;
+            pindexNew->nStatus        = diskindex.nStatus;
+            pindexNew->nTx            = diskindex.nTx;
+
+            // LitecoinCash: Disable PoW Sanity check while loading block index from disk.
+            // We use the sha256 hash for the block index for performance reasons, which is recorded for later use.
+            // CheckProofOfWork() uses the scrypt hash which is discarded after a block is accepted.
+            // While it is technically feasible to verify the PoW, doing so takes several minutes as it
+            // requires recomputing every PoW hash during every LitecoinCash startup.
+            // We opt instead to simply trust the data that is on your local disk.
+            //if (!CheckProofOfWork(pindexNew->GetBlockHash(), pindexNew->nBits, consensusParams))
+            //    return error("%s: CheckProofOfWork failed: %s", __func__, pindexNew->ToString());
         }
+        nEntries += batch.size();
     }
 
+    if (queue.Failed())
+        return false;
+
+    LogPrintf("%s: read %u block index entries using %d threads in %.2fms\n", __func__, nEntries, nThreads, (GetTimeMicros() - nStart) * 0.001);
     return true;
 }
 
@@ -29,14 +29,24 @@ static const int64_t nDefaultDbBatchSize = 16 << 20;
 static const int64_t nMaxDbCache = sizeof(void*) > 4 ? 16384 : 1024;
 //! min. -dbcache (MiB)
 static const int64_t nMinDbCache = 4;
-//! Max memory allocated to block tree DB specific cache, if no -txindex (MiB)
+//! Max memory allocated to block tree DB specific cache (MiB)
 static const int64_t nMaxBlockDBCache = 2;
-//! Max memory allocated to block tree DB specific cache, if -txindex (MiB)
+//! Max memory allocated to tx index DB specific cache, if -txindex (MiB)
 // Unlike for the UTXO database, for the txindex scenario the leveldb cache make
 // a meaningful difference: https://github.com/bitcoin/bitcoin/pull/8273#issuecomment-229601991
-static const int64_t nMaxBlockDBAndTxIndexCache = 1024;
+static const int64_t nMaxTxIndexCache = 1024;
+//! LitecoinCash: AddressIndex: Max memory allocated to address index DB specific cache, if -addressindex (MiB)
+static const int64_t nMaxAddressIndexCache = 1024;
+//! LitecoinCash: AddressIndex: Max memory allocated to spent index DB specific cache, if -spentindex (MiB)
+static const int64_t nMaxSpentIndexCache = 256;
 //! Max memory allocated to coin DB specific cache (MiB)
 static const int64_t nMaxCoinsDBCache = 8;
+//! LitecoinCash: BlockFilterIndex: Max memory allocated to all block filter index caches combined (MiB)
+static const int64_t nMaxFilterIndexCache = 1024;
+//! LitecoinCash: FastIndexLoad: Max. threads reading the block index at startup
+static const int MAX_BLOCK_INDEX_LOAD_THREADS = 8;
+//! LitecoinCash: FastIndexLoad: Block index entries handed over at a time while loading
+static const size_t BLOCK_INDEX_LOAD_BATCH_SIZE = 1024;
 
 struct CDiskTxPos : public CDiskBlockPos
 {
@@ -119,8 +129,6 @@ public:
     bool ReadLastBlockFile(int &nFile);
     bool WriteReindexing(bool fReindexing);
     bool ReadReindexing(bool &fReindexing);
-    bool ReadTxIndex(const uint256 &txid, CDiskTxPos &pos);
-    bool WriteTxIndex(const std::vector<std::pair<uint256, CDiskTxPos> > &vect);
     bool WriteFlag(const std::string &name, bool fValue);
     bool ReadFlag(const std::string &name, bool &fValue);
     bool LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex);
@@ -37,6 +37,8 @@ CTxMemPoolEntry::CTxMemPoolEntry(const CTransactionRef& _tx, const CAmount& _nFe
     nSizeWithAncestors = GetTxSize();
     nModFeesWithAncestors = nFee;
     nSigOpCostWithAncestors = sigOpCost;
+
+    pcluster = nullptr;
 }
 
 void CTxMemPoolEntry::UpdateFeeDelta(int64_t newFeeDelta)
@@ -143,6 +145,9 @@ void CTxMemPool::UpdateTransactionsFromBlock(const std::vector<uint256> &vHashes
             if (setChildren.insert(childIter).second && !setAlreadyIncluded.count(childHash)) {
                 UpdateChild(it, childIter, true);
                 UpdateParent(childIter, it, true);
+                // LitecoinCash: ClusterMempool: Their clusters are now joined
+                MarkClusterDirty(it);
+                MarkClusterDirty(childIter);
             }
         }
         UpdateForDescendants(it, mapMemPoolDescendantsToUpdate, setAlreadyIncluded);
@@ -405,12 +410,14 @@ bool CTxMemPool::addUnchecked(const uint256& hash, const CTxMemPoolEntry &entry,
     }
     UpdateAncestorsOf(true, newit, setAncestors);
     UpdateEntryForAncestors(newit, setAncestors);
+    AddToClusters(newit);   // LitecoinCash: ClusterMempool
 
     nTransactionsUpdated++;
     totalTxSize += entry.GetTxSize();
     if (minerPolicyEstimator) {minerPolicyEstimator->processTransaction(entry, validFeeEstimate);}
 
-    vTxHashes.emplace_back(tx.GetWitnessHash(), newit);
+    vTxHashes.emplace_back(tx.GetWitnessHash());
+    vTxHashEntries.push_back(newit);
     newit->vTxHashesIdx = vTxHashes.size() - 1;
 
     return true;
@@ -424,13 +431,24 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
         mapNextTx.erase(txin.prevout);
 
     if (vTxHashes.size() > 1) {
-        vTxHashes[it->vTxHashesIdx] = std::move(vTxHashes.back());
-        vTxHashes[it->vTxHashesIdx].second->vTxHashesIdx = it->vTxHashesIdx;
+        vTxHashes[it->vTxHashesIdx] = vTxHashes.back();
+        vTxHashEntries[it->vTxHashesIdx] = vTxHashEntries.back();
+        vTxHashEntries[it->vTxHashesIdx]->vTxHashesIdx = it->vTxHashesIdx;
         vTxHashes.pop_back();
-        if (vTxHashes.size() * 2 < vTxHashes.capacity())
+        vTxHashEntries.pop_back();
+        if (vTxHashes.size() * 2 < vTxHashes.capacity()) {
             vTxHashes.shrink_to_fit();
-    } else
+            vTxHashEntries.shrink_to_fit();
+        }
+    } else {
         vTxHashes.clear();
+        vTxHashEntries.clear();
+    }
+
+    // LitecoinCash: ClusterMempool: What is left of its cluster gets relinearized
+    if (it->pcluster)
+        DissolveCluster(it->pcluster, true);
+    setClusterDirty.erase(it);
 
     totalTxSize -= it->GetTxSize();
     cachedInnerUsage -= it->DynamicMemoryUsage();
@@ -590,9 +608,16 @@ void CTxMemPool::removeForBlock(const std::vector<CTransactionRef>& vtx, unsigne
 
 void CTxMemPool::_clear()
 {
+    setClustersByWorstChunk.clear();
+    mapClusters.clear();
+    setClusterDirty.clear();
+    nNextClusterId = 0;
+    cachedClusterUsage = 0;
     mapLinks.clear();
     mapTx.clear();
     mapNextTx.clear();
+    vTxHashes.clear();
+    vTxHashEntries.clear();
     totalTxSize = 0;
     cachedInnerUsage = 0;
     lastRollingFeeUpdate = GetTime();
@@ -734,6 +759,48 @@ void CTxMemPool::check(const CCoinsViewCache *pcoins) const
         assert(&tx == it->second);
     }
 
+    // LitecoinCash: ClusterMempool: Every transaction is in one cluster or waiting for one, clusters are in a valid
+    // order for a block, and their chunks add up and have decreasing fee rates
+    size_t nInClusters = 0;
+    size_t clusterUsage = 0;
+    for (const auto& entry : mapClusters) {
+        const CTxMemPoolCluster& cluster = *entry.second;
+        assert(entry.first == cluster.nId);
+        assert(setClustersByWorstChunk.count(&cluster));
+        size_t nTx = 0;
+        for (size_t i = 0; i < cluster.vChunks.size(); i++) {
+            const CTxMemPoolCluster::Chunk& chunk = cluster.vChunks[i];
+            assert(chunk.nTxCount > 0);
+            assert(i == 0 || cluster.vChunks[i - 1].HasHigherFeeRate(chunk));
+            CAmount nModFees = 0;
+            uint64_t nSize = 0;
+            int64_t nSigOpCost = 0;
+            for (size_t j = nTx; j < nTx + chunk.nTxCount; j++) {
+                assert(j < cluster.vTxs.size());
+                nModFees += cluster.vTxs[j]->GetModifiedFee();
+                nSize += cluster.vTxs[j]->GetTxSize();
+                nSigOpCost += cluster.vTxs[j]->GetSigOpCost();
+            }
+            assert(nModFees == chunk.nModFees && nSize == chunk.nSize && nSigOpCost == chunk.nSigOpCost);
+            nTx += chunk.nTxCount;
+        }
+        assert(nTx == cluster.vTxs.size());
+        setEntries setEarlier;
+        for (const txiter it : cluster.vTxs) {
+            assert(it->pcluster == &cluster);
+            for (const txiter parent : GetMemPoolParents(it))
+                assert(setEarlier.count(parent));
+            setEarlier.insert(it);
+        }
+        nInClusters += cluster.vTxs.size();
+        clusterUsage += cluster.DynamicMemoryUsage();
+    }
+    for (const txiter it : setClusterDirty)
+        assert(it->pcluster == nullptr);
+    assert(nInClusters + setClusterDirty.size() == mapTx.size());
+    assert(setClustersByWorstChunk.size() == mapClusters.size());
+    assert(clusterUsage == cachedClusterUsage);
+
     assert(totalTxSize == checkTotal);
     assert(innerUsage == cachedInnerUsage);
 }
@@ -856,6 +923,7 @@ void CTxMemPool::PrioritiseTransaction(const uint256& hash, const CAmount& nFeeD
             for (txiter descendantIt : setDescendants) {
                 mapTx.modify(descendantIt, update_ancestor_state(0, nFeeDelta, 0, 0));
             }
+            MarkClusterDirty(it);   // LitecoinCash: ClusterMempool
             ++nTransactionsUpdated;
         }
     }
@@ -907,7 +975,8 @@ bool CCoinsViewMemPool::GetCoin(const COutPoint &outpoint, Coin &coin) const {
 size_t CTxMemPool::DynamicMemoryUsage() const {
     LOCK(cs);
     // Estimate the overhead of mapTx to be 12 pointers + an allocation, as no exact formula for boost::multi_index_contained is implemented.
-    return memusage::MallocUsage(sizeof(CTxMemPoolEntry) + 12 * sizeof(void*)) * mapTx.size() + memusage::DynamicUsage(mapNextTx) + memusage::DynamicUsage(mapDeltas) + memusage::DynamicUsage(mapLinks) + memusage::DynamicUsage(vTxHashes) + cachedInnerUsage;
+    return memusage::MallocUsage(sizeof(CTxMemPoolEntry) + 12 * sizeof(void*)) * mapTx.size() + memusage::DynamicUsage(mapNextTx) + memusage::DynamicUsage(mapDeltas) + memusage::DynamicUsage(mapLinks) + memusage::DynamicUsage(vTxHashes) + memusage::DynamicUsage(vTxHashEntries) + cachedInnerUsage +
+        memusage::DynamicUsage(mapClusters) + memusage::DynamicUsage(setClustersByWorstChunk) + memusage::DynamicUsage(setClusterDirty) + cachedClusterUsage;
 }
 
 void CTxMemPool::RemoveStaged(setEntries &stage, bool updateDescendants, MemPoolRemovalReason reason) {
@@ -1017,22 +1086,39 @@ void CTxMemPool::TrimToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpends
 
     unsigned nTxnRemoved = 0;
     CFeeRate maxFeeRateRemoved(0);
+    // LitecoinCash: ClusterMempool: Clusters are brought up to date before measuring, so their usage is counted as
+    // it will be rather than while they wait to be relinearized
+    UpdateClusters();
+    // Clusters that lost chunks, by id, to be relinearized once trimming is done
+    std::set<uint64_t> setTrimmed;
     while (!mapTx.empty() && DynamicMemoryUsage() > sizelimit) {
-        indexed_transaction_set::index<descendant_score>::type::iterator it = mapTx.get<descendant_score>().begin();
+        // LitecoinCash: ClusterMempool: Evict the chunk with the lowest fee rate as a whole. Nothing earlier in a
+        // linearization spends what comes after it, so the last chunk already holds all of its descendants.
+        CTxMemPoolCluster* cluster = mapClusters.at((*setClustersByWorstChunk.begin())->nId).get();
+        const CTxMemPoolCluster::Chunk chunk = cluster->vChunks.back();
 
         // We set the new mempool min fee to the feerate of the removed set, plus the
         // "minimum reasonable fee rate" (ie some value under which we consider txn
         // to have 0 fee). This way, we don't allow txn to enter mempool with feerate
         // equal to txn which were removed with no block in between.
-        CFeeRate removed(it->GetModFeesWithDescendants(), it->GetSizeWithDescendants());
+        CFeeRate removed(chunk.nModFees, chunk.nSize);
         removed += incrementalRelayFee;
         trackPackageRemoved(removed);
         maxFeeRateRemoved = std::max(maxFeeRateRemoved, removed);
 
-        setEntries stage;
-        CalculateDescendants(mapTx.project<0>(it), stage);
+        setEntries stage(cluster->vTxs.end() - chunk.nTxCount, cluster->vTxs.end());
         nTxnRemoved += stage.size();
 
+        // What comes before the last chunk is still a valid linearization, with the same chunks, so it stays a
+        // cluster as it is rather than being relinearized after every eviction. It may no longer be connected.
+        std::vector<txiter> vRest(cluster->vTxs.begin(), cluster->vTxs.end() - chunk.nTxCount);
+        setTrimmed.erase(cluster->nId);
+        DissolveCluster(cluster, false);
+        if (!vRest.empty()) {
+            setTrimmed.insert(nNextClusterId);
+            AddCluster(std::move(vRest));
+        }
+
         std::vector<CTransaction> txn;
         if (pvNoSpendsRemaining) {
             txn.reserve(stage.size());
@@ -1050,6 +1136,11 @@ void CTxMemPool::TrimToSize(size_t sizelimit, std::vector<COutPoint>* pvNoSpends
         }
     }
 
+    // Relinearize each trimmed cluster once, which also splits those that came apart
+    for (const uint64_t nId : setTrimmed)
+        DissolveCluster(mapClusters.at(nId).get(), true);
+    UpdateClusters();
+
     if (maxFeeRateRemoved > CFeeRate(0)) {
         LogPrint(BCLog::MEMPOOL, "Removed %u txn, rolling minimum fee bumped to %s\n", nTxnRemoved, maxFeeRateRemoved.ToString());
     }
@@ -1062,4 +1153,268 @@ bool CTxMemPool::TransactionWithinChainLimit(const uint256& txid, size_t chainLi
        it->GetCountWithDescendants() < chainLimit);
 }
 
+size_t CTxMemPoolCluster::DynamicMemoryUsage() const
+{
+    return memusage::MallocUsage(sizeof(CTxMemPoolCluster)) + memusage::DynamicUsage(vTxs) + memusage::DynamicUsage(vChunks);
+}
+
+bool CTxMemPool::CompareClusterByWorstChunk::operator()(const CTxMemPoolCluster* a, const CTxMemPoolCluster* b) const
+{
+    if (b->vChunks.back().HasHigherFeeRate(a->vChunks.back()))
+        return true;
+    if (a->vChunks.back().HasHigherFeeRate(b->vChunks.back()))
+        return false;
+    return a->nId < b->nId;
+}
+
+/** LitecoinCash: ClusterMempool: Clusters up to this many transactions get a full ancestor set search */
+static const size_t MAX_CLUSTER_FULL_LINEARIZATION = 64;
+
+/** Split a linearization into chunks: each transaction joins the chunk before it, unless that has a higher fee rate */
+static std::vector<CTxMemPoolCluster::Chunk> ChunkLinearization(const std::vector<CTxMemPool::txiter>& vTxs)
+{
+    std::vector<CTxMemPoolCluster::Chunk> vChunks;
+    for (const CTxMemPool::txiter it : vTxs) {
+        CTxMemPoolCluster::Chunk chunk;
+        chunk.nModFees = it->GetModifiedFee();
+        chunk.nSize = it->GetTxSize();
+        chunk.nSigOpCost = it->GetSigOpCost();
+        chunk.nTxCount = 1;
+        while (!vChunks.empty() && !vChunks.back().HasHigherFeeRate(chunk)) {
+            chunk.nModFees += vChunks.back().nModFees;
+            chunk.nSize += vChunks.back().nSize;
+            chunk.nSigOpCost += vChunks.back().nSigOpCost;
+            chunk.nTxCount += vChunks.back().nTxCount;
+            vChunks.pop_back();
+        }
+        vChunks.push_back(chunk);
+    }
+    return vChunks;
+}
+
+std::vector<CTxMemPool::txiter> CTxMemPool::LinearizeCluster(const std::vector<txiter>& vComponent) const
+{
+    const size_t n = vComponent.size();
+
+    // Topological order first (Kahn), so everything below can work on positions in it
+    std::map<txiter, size_t, CompareIteratorByHash> mapIndex;
+    for (size_t i = 0; i < n; i++)
+        mapIndex.emplace(vComponent[i], i);
+    std::vector<size_t> vParentsLeft(n, 0);
+    std::vector<txiter> vTopo;
+    vTopo.reserve(n);
+    for (size_t i = 0; i < n; i++) {
+        vParentsLeft[i] = GetMemPoolParents(vComponent[i]).size();
+        if (vParentsLeft[i] == 0)
+            vTopo.push_back(vComponent[i]);
+    }
+    for (size_t i = 0; i < vTopo.size(); i++) {
+        for (const txiter child : GetMemPoolChildren(vTopo[i])) {
+            if (--vParentsLeft[mapIndex.at(child)] == 0)
+                vTopo.push_back(child);
+        }
+    }
+    assert(vTopo.size() == n);
+    for (size_t i = 0; i < n; i++)
+        mapIndex[vTopo[i]] = i;
+
+    std::vector<txiter> vResult;
+    vResult.reserve(n);
+    if (n <= MAX_CLUSTER_FULL_LINEARIZATION) {
+        // Repeatedly take the remaining ancestor set with the highest fee rate
+        std::vector<uint64_t> vAncestors(n, 0);
+        for (size_t i = 0; i < n; i++) {
+            vAncestors[i] = uint64_t{1} << i;
+            for (const txiter parent : GetMemPoolParents(vTopo[i]))
+                vAncestors[i] |= vAncestors[mapIndex.at(parent)];
+        }
+        uint64_t nRemaining = n == 64 ? ~uint64_t{0} : (uint64_t{1} << n) - 1;
+        while (nRemaining) {
+            uint64_t nBest = 0;
+            CTxMemPoolCluster::Chunk best = {0, 0, 0, 0};
+            for (size_t i = 0; i < n; i++) {
+                if (!(nRemaining >> i & 1))
+                    continue;
+                const uint64_t nSet = vAncestors[i] & nRemaining;
+                CTxMemPoolCluster::Chunk candidate = {0, 0, 0, 0};
+                for (size_t j = 0; j <= i; j++) {
+                    if (nSet >> j & 1) {
+                        candidate.nModFees += vTopo[j]->GetModifiedFee();
+                        candidate.nSize += vTopo[j]->GetTxSize();
+                    }
+                }
+                if (nBest == 0 || candidate.HasHigherFeeRate(best)) {
+                    nBest = nSet;
+                    best = candidate;
+                }
+            }
+            for (size_t j = 0; j < n; j++) {
+                if (nBest >> j & 1)
+                    vResult.push_back(vTopo[j]);
+            }
+            nRemaining &= ~nBest;
+        }
+    } else {
+        // Too large to search: go by ancestor fee rate, and put each transaction right after its ancestors
+        std::vector<txiter> vByAncestorFee(vTopo);
+        std::sort(vByAncestorFee.begin(), vByAncestorFee.end(), [](const txiter a, const txiter b) {
+            return CompareTxMemPoolEntryByAncestorFee()(*a, *b);
+        });
+        std::vector<bool> vDone(n, false);
+        for (const txiter it : vByAncestorFee) {
+            if (vDone[mapIndex.at(it)])
+                continue;
+            std::vector<size_t> vTodo{mapIndex.at(it)};
+            std::vector<size_t> vAdd;
+            vDone[vTodo.back()] = true;
+            while (!vTodo.empty()) {
+                const size_t i = vTodo.back();
+                vTodo.pop_back();
+                vAdd.push_back(i);
+                for (const txiter parent : GetMemPoolParents(vTopo[i])) {
+                    const size_t j = mapIndex.at(parent);
+                    if (!vDone[j]) {
+                        vDone[j] = true;
+                        vTodo.push_back(j);
+                    }
+                }
+            }
+            std::sort(vAdd.begin(), vAdd.end());
+            for (const size_t i : vAdd)
+                vResult.push_back(vTopo[i]);
+        }
+    }
+    return vResult;
+}
+
+void CTxMemPool::AddCluster(std::vector<txiter>&& vTxs)
+{
+    std::unique_ptr<CTxMemPoolCluster> cluster(new CTxMemPoolCluster);
+    cluster->nId = nNextClusterId++;
+    cluster->vTxs = std::move(vTxs);
+    cluster->vChunks = ChunkLinearization(cluster->vTxs);
+    for (const txiter it : cluster->vTxs)
+        it->pcluster = cluster.get();
+    cachedClusterUsage += cluster->DynamicMemoryUsage();
+    setClustersByWorstChunk.insert(cluster.get());
+    const uint64_t nId = cluster->nId;
+    mapClusters.emplace(nId, std::move(cluster));
+}
+
+void CTxMemPool::DissolveCluster(CTxMemPoolCluster* cluster, bool fMarkDirty)
+{
+    for (const txiter it : cluster->vTxs) {
+        it->pcluster = nullptr;
+        if (fMarkDirty)
+            setClusterDirty.insert(it);
+    }
+    cachedClusterUsage -= cluster->DynamicMemoryUsage();
+    setClustersByWorstChunk.erase(cluster);
+    mapClusters.erase(cluster->nId);
+}
+
+void CTxMemPool::MarkClusterDirty(txiter it)
+{
+    if (it->pcluster)
+        DissolveCluster(it->pcluster, true);
+    else
+        setClusterDirty.insert(it);
+}
+
+void CTxMemPool::AddToClusters(txiter it)
+{
+    // Usually the parents' clusters are few and small, and everything is simply relinearized. Otherwise their
+    // linearizations are merged chunk by chunk (they are independent of each other), and the new one goes last.
+    std::set<CTxMemPoolCluster*> setParentClusters;
+    bool fParentDirty = false;
+    size_t nTotal = 1;
+    for (const txiter parent : GetMemPoolParents(it)) {
+        if (!parent->pcluster)
+            fParentDirty = true;
+        else if (setParentClusters.insert(parent->pcluster).second)
+            nTotal += parent->pcluster->vTxs.size();
+    }
+    if (fParentDirty || nTotal <= MAX_CLUSTER_FULL_LINEARIZATION) {
+        for (CTxMemPoolCluster* cluster : setParentClusters)
+            DissolveCluster(cluster, true);
+        setClusterDirty.insert(it);
+        UpdateClusters();
+        return;
+    }
+
+    struct Cursor {
+        const CTxMemPoolCluster* cluster;
+        size_t nChunk;
+        size_t nTx;
+    };
+    std::vector<Cursor> vCursors;
+    for (const CTxMemPoolCluster* cluster : setParentClusters)
+        vCursors.push_back(Cursor{cluster, 0, 0});
+    std::vector<txiter> vTxs;
+    vTxs.reserve(nTotal);
+    while (true) {
+        Cursor* best = nullptr;
+        for (Cursor& cursor : vCursors) {
+            if (cursor.nChunk == cursor.cluster->vChunks.size())
+                continue;
+            if (!best || cursor.cluster->vChunks[cursor.nChunk].HasHigherFeeRate(best->cluster->vChunks[best->nChunk]))
+                best = &cursor;
+        }
+        if (!best)
+            break;
+        const size_t nCount = best->cluster->vChunks[best->nChunk].nTxCount;
+        vTxs.insert(vTxs.end(), best->cluster->vTxs.begin() + best->nTx, best->cluster->vTxs.begin() + best->nTx + nCount);
+        best->nTx += nCount;
+        best->nChunk++;
+    }
+    vTxs.push_back(it);
+    for (CTxMemPoolCluster* cluster : setParentClusters)
+        DissolveCluster(cluster, false);
+    AddCluster(std::move(vTxs));
+}
+
+void CTxMemPool::UpdateClusters()
+{
+    while (!setClusterDirty.empty()) {
+        // Collect everything connected to a waiting transaction, including any clusters it reaches
+        std::vector<txiter> vComponent{*setClusterDirty.begin()};
+        setEntries setSeen{vComponent.front()};
+        setClusterDirty.erase(setClusterDirty.begin());
+        for (size_t i = 0; i < vComponent.size(); i++) {
+            const txiter it = vComponent[i];
+            if (it->pcluster)
+                DissolveCluster(it->pcluster, false);
+            for (const setEntries* links : {&GetMemPoolParents(it), &GetMemPoolChildren(it)}) {
+                for (const txiter linked : *links) {
+                    if (setSeen.insert(linked).second) {
+                        setClusterDirty.erase(linked);
+                        vComponent.push_back(linked);
+                    }
+                }
+            }
+        }
+        AddCluster(LinearizeCluster(vComponent));
+    }
+}
+
+const std::map<uint64_t, std::unique_ptr<CTxMemPoolCluster>>& CTxMemPool::GetClusters()
+{
+    UpdateClusters();
+    return mapClusters;
+}
+
+uint64_t CTxMemPool::CalculateClusterSize(const setEntries& setAncestors)
+{
+    AssertLockHeld(cs);
+    UpdateClusters();
+    // The ancestors are all in the clusters of the parents, which the new transaction joins together
+    std::set<const CTxMemPoolCluster*> setClusters;
+    uint64_t nCount = 1;
+    for (const txiter it : setAncestors) {
+        if (setClusters.insert(it->pcluster).second)
+            nCount += it->pcluster->vTxs.size();
+    }
+    return nCount;
+}
+
 SaltedTxidHasher::SaltedTxidHasher() : k0(GetRand(std::numeric_limits<uint64_t>::max())), k1(GetRand(std::numeric_limits<uint64_t>::max())) {}
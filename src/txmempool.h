@@ -61,6 +61,8 @@ class CTxMemPool;
  *
  */
 
+class CTxMemPoolCluster;
+
 class CTxMemPoolEntry
 {
 private:
@@ -127,7 +129,8 @@ public:
     CAmount GetModFeesWithAncestors() const { return nModFeesWithAncestors; }
     int64_t GetSigOpCostWithAncestors() const { return nSigOpCostWithAncestors; }
 
-    mutable size_t vTxHashesIdx; //!< Index in mempool's vTxHashes
+    mutable size_t vTxHashesIdx; //!< Index in mempool's vTxHashes and vTxHashEntries
+    mutable CTxMemPoolCluster* pcluster; //!< LitecoinCash: ClusterMempool: Cluster this is in, or nullptr until it is relinearized
 };
 
 // Helpers for modifying CTxMemPool::mapTx, which is a boost multi_index.
@@ -483,7 +486,10 @@ public:
     indexed_transaction_set mapTx;
 
     typedef indexed_transaction_set::nth_index<0>::type::iterator txiter;
-    std::vector<std::pair<uint256, txiter> > vTxHashes; //!< All tx witness hashes/entries in mapTx, in random order
+    // LitecoinCash: CompactBlocks: The hashes are kept apart from their entries, so compact block reconstruction
+    // can walk them as one contiguous array and hash them in bulk
+    std::vector<uint256> vTxHashes; //!< All tx witness hashes in mapTx, in random order
+    std::vector<txiter> vTxHashEntries; //!< The entries of vTxHashes, at the same positions
 
     struct CompareIteratorByHash {
         bool operator()(const txiter &a, const txiter &b) const {
@@ -510,6 +516,31 @@ private:
 
     std::vector<indexed_transaction_set::const_iterator> GetSortedDepthAndScore() const;
 
+    // LitecoinCash: ClusterMempool: Transactions connected through in-mempool spends form a cluster, which is kept
+    // linearized (see CTxMemPoolCluster). Transactions whose cluster was dissolved, because a member left or a
+    // link or fee changed, wait in setClusterDirty until UpdateClusters() forms new ones.
+    struct CompareClusterByWorstChunk {
+        bool operator()(const CTxMemPoolCluster* a, const CTxMemPoolCluster* b) const;
+    };
+    std::map<uint64_t, std::unique_ptr<CTxMemPoolCluster>> mapClusters;
+    std::set<const CTxMemPoolCluster*, CompareClusterByWorstChunk> setClustersByWorstChunk;
+    setEntries setClusterDirty;
+    uint64_t nNextClusterId;
+    size_t cachedClusterUsage; //!< sum of dynamic memory usage of all the clusters (NOT mapClusters itself)
+
+    /** Take over a linearization as a new cluster */
+    void AddCluster(std::vector<txiter>&& vTxs);
+    /** Forget a cluster, leaving its transactions without one. If fMarkDirty, they wait for UpdateClusters() */
+    void DissolveCluster(CTxMemPoolCluster* cluster, bool fMarkDirty);
+    /** Make a transaction's cluster be relinearized on the next UpdateClusters() */
+    void MarkClusterDirty(txiter it);
+    /** Order a connected set of transactions validly for a block, best fee rate chunks first */
+    std::vector<txiter> LinearizeCluster(const std::vector<txiter>& vComponent) const;
+    /** Put a transaction that was just added into a cluster, with those of its parents */
+    void AddToClusters(txiter it);
+    /** Form new clusters for all transactions that are waiting for one */
+    void UpdateClusters();
+
 public:
     indirectmap<COutPoint, const CTransaction*> mapNextTx;
     std::map<uint256, CAmount> mapDeltas;
@@ -606,6 +637,13 @@ public:
       */
     CFeeRate GetMinFee(size_t sizelimit) const;
 
+    /** LitecoinCash: ClusterMempool: All clusters, brought up to date. Only valid while cs is held */
+    const std::map<uint64_t, std::unique_ptr<CTxMemPoolCluster>>& GetClusters();
+
+    /** LitecoinCash: ClusterMempool: Size of the cluster a transaction with these in-mempool ancestors would be in,
+     *  itself included */
+    uint64_t CalculateClusterSize(const setEntries& setAncestors);
+
     /** Remove transactions from the mempool until its dynamic size is <= sizelimit.
       *  pvNoSpendsRemaining, if set, will be populated with the list of outpoints
       *  which are not in mempool which no longer have any spends in this mempool.
@@ -684,6 +722,37 @@ private:
     void removeUnchecked(txiter entry, MemPoolRemovalReason reason = MemPoolRemovalReason::UNKNOWN);
 };
 
+/**
+ * LitecoinCash: ClusterMempool: A set of mempool transactions connected through spends, in an order that is
+ * valid within a block (the linearization), and split into chunks of decreasing fee rate.
+ *
+ * Taking each cluster's chunks in order, and the chunks of all clusters by fee rate, gives the best block the
+ * linearizations allow. Whatever spends a transaction in a cluster's last chunk is in that chunk too, so the
+ * mempool's lowest fee rate last chunk is what can be evicted first.
+ */
+class CTxMemPoolCluster
+{
+public:
+    struct Chunk {
+        CAmount nModFees;
+        uint64_t nSize;
+        int64_t nSigOpCost;
+        size_t nTxCount;
+
+        /** Avoid division by rewriting (a/b > c/d) as (a*d > c*b), like CompareTxMemPoolEntryByAncestorFee */
+        bool HasHigherFeeRate(const Chunk& other) const
+        {
+            return (double)nModFees * other.nSize > (double)other.nModFees * nSize;
+        }
+    };
+
+    uint64_t nId;
+    std::vector<CTxMemPool::txiter> vTxs;   //!< The linearization
+    std::vector<Chunk> vChunks;             //!< Consecutive runs of vTxs, by decreasing fee rate
+
+    size_t DynamicMemoryUsage() const;
+};
+
 /** 
  * CCoinsView that brings transactions from a memorypool into view.
  * It does not check for spendings by memory pool transactions.
@@ -255,6 +255,7 @@ const CLogCategoryDesc LogCategories[] =
     {BCLog::HIVE, "hive"},  // LitecoinCash: Hive
     {BCLog::MINOTAURX, "minotaurx"},  // LitecoinCash: MinotaurX+Hive1.2
     {BCLog::RIALTO, "rialto"},        // LitecoinCash: Rialto
+    {BCLog::STRATUM, "stratum"},      // LitecoinCash: Stratum
     {BCLog::ALL, "1"},
     {BCLog::ALL, "all"},
 };
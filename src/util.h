@@ -106,6 +106,7 @@ namespace BCLog {
         HIVE        = (1 << 21),    // LitecoinCash: Hive logging
         MINOTAURX   = (1 << 22),    // LitecoinCash: MinotaurX+Hive1.2
         RIALTO      = (1 << 23),    // LitecoinCash: Rialto
+        STRATUM     = (1 << 24),    // LitecoinCash: Stratum
         ALL         = ~(uint32_t)0,
     };
 }
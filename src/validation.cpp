@@ -14,8 +14,10 @@
 #include <consensus/merkle.h>
 #include <consensus/tx_verify.h>
 #include <consensus/validation.h>
+#include <crypto/common.h>
 #include <cuckoocache.h>
 #include <hash.h>
+#include <index/txindex.h>  // LitecoinCash: TxIndex
 #include <init.h>
 #include <policy/fees.h>
 #include <policy/policy.h>
@@ -44,8 +46,14 @@
 #include <rpc/server.h>     // LitecoinCash: Rialto
 #include <wallet/wallet.h>  // LitecoinCash: Rialto
 #include <base58.h>         // LitecoinCash: Rialto: for DecodeDestination()
+#include <chainstats.h>     // LitecoinCash: MinotaurX+Hive1.2
+#include <coinsprefetch.h>  // LitecoinCash: CoinsPrefetch
+#include <mappedfile.h>     // LitecoinCash: MappedBlocks
+#include <support/allocators/pool.h> // LitecoinCash: FastIndexLoad
 
 #include <future>
+#include <list>
+#include <thread>
 #include <sstream>
 
 #include <boost/algorithm/string/replace.hpp>
@@ -152,6 +160,13 @@ private:
       */
     std::set<CBlockIndex*> g_failed_blocks;
 
+    /**
+     * LitecoinCash: MsgHandlerThreads: ActivateBestChain releases cs_main between steps and keeps its target
+     * (pindexMostWork) across them, so two callers - message handler workers, RPC, the import thread - must not
+     * interleave or the one with the stale target disconnects what the other just connected.
+     */
+    CCriticalSection m_cs_chainstate;
+
 public:
     CChain chainActive;
     BlockMap mapBlockIndex;
@@ -215,7 +230,7 @@ CConditionVariable cvBlockChange;
 int nScriptCheckThreads = 0;
 std::atomic_bool fImporting(false);
 std::atomic_bool fReindex(false);
-bool fTxIndex = false;
+std::atomic_bool g_is_mempool_loaded(false);
 bool fHavePruned = false;
 bool fPruneMode = false;
 bool fIsBareMultisigStd = DEFAULT_PERMIT_BAREMULTISIG;
@@ -223,6 +238,7 @@ bool fRequireStandard = true;
 bool fCheckBlockIndex = false;
 bool fCheckpointsEnabled = DEFAULT_CHECKPOINTS_ENABLED;
 size_t nCoinCacheUsage = 5000 * 300;
+bool fCoinsBackgroundFlush = DEFAULT_COINS_BACKGROUND_FLUSH;
 uint64_t nPruneTarget = 0;
 int64_t nMaxTipAge = DEFAULT_MAX_TIP_AGE;
 bool fEnableReplacement = DEFAULT_ENABLE_REPLACEMENT;
@@ -285,6 +301,7 @@ CBlockIndex* FindForkInGlobalIndex(const CChain& chain, const CBlockLocator& loc
 }
 
 std::unique_ptr<CCoinsViewDB> pcoinsdbview;
+std::unique_ptr<CCoinsViewPrefetch> pcoinsprefetch;
 std::unique_ptr<CCoinsViewCache> pcoinsTip;
 std::unique_ptr<CBlockTreeDB> pblocktree;
 std::unique_ptr<CRialtoWhitePagesDB> pwhitepages;     // LitecoinCash: Rialto: Global white pages
@@ -747,6 +764,15 @@ static bool AcceptToMemoryPoolWorker(const CChainParams& chainparams, CTxMemPool
             return state.DoS(0, false, REJECT_NONSTANDARD, "too-long-mempool-chain", false, errString);
         }
 
+        // LitecoinCash: ClusterMempool: The ancestor and descendant limits don't bound how many transactions spends can
+        // connect, and each addition relinearizes the cluster it joins, so clusters are limited too
+        const uint64_t nLimitCluster = gArgs.GetArg("-limitclustercount", DEFAULT_CLUSTER_LIMIT);
+        const uint64_t nClusterSize = pool.CalculateClusterSize(setAncestors);
+        if (nClusterSize > nLimitCluster) {
+            return state.DoS(0, false, REJECT_NONSTANDARD, "too-large-cluster", false,
+                strprintf("cluster would have %u transactions, limit %u", nClusterSize, nLimitCluster));
+        }
+
         // A transaction that spends outputs that would be replaced by it is invalid. Now
         // that we have the set of all ancestors we can detect this
         // pathological case by making sure setConflicts and setAncestors don't
@@ -1023,28 +1049,9 @@ bool GetTransaction(const uint256& hash, CTransactionRef& txOut, const Consensus
             return true;
         }
 
-        if (fTxIndex) {
-            CDiskTxPos postx;
-            if (pblocktree->ReadTxIndex(hash, postx)) {
-                CAutoFile file(OpenBlockFile(postx, true), SER_DISK, CLIENT_VERSION);
-                if (file.IsNull())
-                    return error("%s: OpenBlockFile failed", __func__);
-                CBlockHeader header;
-                try {
-                    file >> header;
-                    fseek(file.Get(), postx.nTxOffset, SEEK_CUR);
-                    file >> txOut;
-                } catch (const std::exception& e) {
-                    return error("%s: Deserialize or I/O error - %s", __func__, e.what());
-                }
-                hashBlock = header.GetHash();
-                if (txOut->GetHash() != hash)
-                    return error("%s: txid mismatch", __func__);
-                return true;
-            }
-
-            // transaction not found in index, nothing more can be done
-            return false;
+        // LitecoinCash: TxIndex: If the index is enabled but not found in it, nothing more can be done
+        if (g_txindex) {
+            return g_txindex->FindTx(hash, hashBlock, txOut);
         }
 
         if (fAllowSlow) { // use coin database to locate block that contains transaction, and scan it
@@ -1142,6 +1149,108 @@ bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus
     return true;
 }
 
+// LitecoinCash: MappedBlocks: Memory maps of completed block files, least recently used first
+static CCriticalSection cs_mappedBlockFiles;
+static std::list<std::pair<int, std::shared_ptr<const CMappedFile>>> listMappedBlockFiles;
+
+static std::shared_ptr<const CMappedFile> GetMappedBlockFile(int nFile)
+{
+    LOCK(cs_mappedBlockFiles);
+    for (auto it = listMappedBlockFiles.begin(); it != listMappedBlockFiles.end(); ++it) {
+        if (it->first == nFile) {
+            listMappedBlockFiles.splice(listMappedBlockFiles.end(), listMappedBlockFiles, it);
+            return it->second;
+        }
+    }
+
+    std::shared_ptr<CMappedFile> file = std::make_shared<CMappedFile>();
+    if (!file->Open(GetBlockPosFilename(CDiskBlockPos(nFile, 0), "blk")))
+        return nullptr;
+    // Readers still holding on to an evicted map keep it alive until they're done
+    if (listMappedBlockFiles.size() >= MAX_MAPPED_BLOCK_FILES)
+        listMappedBlockFiles.pop_front();
+    listMappedBlockFiles.emplace_back(nFile, file);
+    return file;
+}
+
+static void ForgetMappedBlockFile(int nFile)
+{
+    LOCK(cs_mappedBlockFiles);
+    listMappedBlockFiles.remove_if([nFile](const std::pair<int, std::shared_ptr<const CMappedFile>>& entry) { return entry.first == nFile; });
+}
+
+bool ReadRawBlockFromDisk(CRawBlock& block, const CDiskBlockPos& pos, const CMessageHeader::MessageStartChars& messageStart)
+{
+    // Every block is preceded by the message start and its size
+    if (pos.IsNull() || pos.nPos < CMessageHeader::MESSAGE_START_SIZE + sizeof(uint32_t))
+        return error("%s: Invalid block position %s", __func__, pos.ToString());
+
+    // Only files we're done writing to are mapped, as a map doesn't grow with the file
+    bool fComplete;
+    {
+        LOCK(cs_LastBlockFile);
+        fComplete = pos.nFile < nLastBlockFile;
+    }
+    std::shared_ptr<const CMappedFile> file;
+    if (fComplete)
+        file = GetMappedBlockFile(pos.nFile);
+    if (file && pos.nPos <= file->size()) {
+        const unsigned char* p = file->data() + pos.nPos;
+        const uint32_t nSize = ReadLE32(p - sizeof(uint32_t));
+        if (memcmp(p - sizeof(uint32_t) - CMessageHeader::MESSAGE_START_SIZE, messageStart, CMessageHeader::MESSAGE_START_SIZE) != 0)
+            return error("%s: Block magic mismatch at %s", __func__, pos.ToString());
+        if (nSize > MAX_BLOCK_SERIALIZED_SIZE || nSize > file->size() - pos.nPos)
+            return error("%s: Block size %u out of range at %s", __func__, nSize, pos.ToString());
+        block = CRawBlock(std::shared_ptr<const unsigned char>(file, p), nSize);
+        return true;
+    }
+
+    // Otherwise read it into a buffer
+    CAutoFile filein(OpenBlockFile(CDiskBlockPos(pos.nFile, pos.nPos - CMessageHeader::MESSAGE_START_SIZE - sizeof(uint32_t)), true), SER_DISK, CLIENT_VERSION);
+    if (filein.IsNull())
+        return error("%s: OpenBlockFile failed for %s", __func__, pos.ToString());
+    try {
+        CMessageHeader::MessageStartChars blockMessageStart;
+        uint32_t nSize;
+        filein >> FLATDATA(blockMessageStart) >> nSize;
+        if (memcmp(blockMessageStart, messageStart, CMessageHeader::MESSAGE_START_SIZE) != 0)
+            return error("%s: Block magic mismatch at %s", __func__, pos.ToString());
+        if (nSize > MAX_BLOCK_SERIALIZED_SIZE)
+            return error("%s: Block size %u out of range at %s", __func__, nSize, pos.ToString());
+        std::shared_ptr<std::vector<unsigned char>> buffer = std::make_shared<std::vector<unsigned char>>(nSize);
+        filein.read(reinterpret_cast<char*>(buffer->data()), nSize);
+        block = CRawBlock(std::shared_ptr<const unsigned char>(buffer, buffer->data()), nSize);
+    } catch (const std::exception& e) {
+        return error("%s: I/O error - %s at %s", __func__, e.what(), pos.ToString());
+    }
+    return true;
+}
+
+bool ReadRawBlockFromDisk(CRawBlock& block, const CBlockIndex* pindex, const CMessageHeader::MessageStartChars& messageStart)
+{
+    CDiskBlockPos blockPos;
+    {
+        LOCK(cs_main);
+        blockPos = pindex->GetBlockPos();
+    }
+
+    if (!ReadRawBlockFromDisk(block, blockPos, messageStart))
+        return false;
+
+    // Without deserializing the whole block, at least make sure it's the one we were after
+    CBlockHeader header;
+    try {
+        CDataStream ssHeader(reinterpret_cast<const char*>(block.data()), reinterpret_cast<const char*>(block.data()) + std::min<size_t>(block.size(), 80), SER_DISK, CLIENT_VERSION);
+        ssHeader >> header;
+    } catch (const std::exception& e) {
+        return error("%s: Deserialize error - %s at %s", __func__, e.what(), blockPos.ToString());
+    }
+    if (header.GetHash() != pindex->GetBlockHash())
+        return error("ReadRawBlockFromDisk(CRawBlock&, CBlockIndex*): GetHash() doesn't match index for %s at %s",
+                pindex->ToString(), blockPos.ToString());
+    return true;
+}
+
 CAmount GetBlockSubsidy(int nHeight, const Consensus::Params& consensusParams)
 {
     // LitecoinCash: Issue premine on 1st post-fork block
@@ -1361,15 +1470,72 @@ int GetSpendHeight(const CCoinsViewCache& inputs)
 static CuckooCache::cache<uint256, SignatureCacheHasher> scriptExecutionCache;
 static uint256 scriptExecutionCacheNonce(GetRandHash());
 
+/** The script execution cache entry of a transaction checked with the given flags */
+static uint256 GetScriptExecutionCacheEntry(const CTransaction& tx, unsigned int flags)
+{
+    uint256 hashCacheEntry;
+    // We only use the first 19 bytes of nonce to avoid a second SHA
+    // round - giving us 19 + 32 + 4 = 55 bytes (+ 8 + 1 = 64)
+    static_assert(55 - sizeof(flags) - 32 >= 128/8, "Want at least 128 bits of nonce for script execution cache");
+    CSHA256().Write(scriptExecutionCacheNonce.begin(), 55 - sizeof(flags) - 32).Write(tx.GetWitnessHash().begin(), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
+    return hashCacheEntry;
+}
+
+static uint32_t nScriptExecutionCacheElems = 0;
+static SignatureCacheStats scriptExecutionCacheStats;   // LitecoinCash: PersistSigCache: Protected by cs_main
+
 void InitScriptExecutionCache() {
     // nMaxCacheSize is unsigned. If -maxsigcachesize is set to zero,
     // setup_bytes creates the minimum possible cache (2 elements).
     size_t nMaxCacheSize = std::min(std::max((int64_t)0, gArgs.GetArg("-maxsigcachesize", DEFAULT_MAX_SIG_CACHE_SIZE) / 2), MAX_MAX_SIG_CACHE_SIZE) * ((size_t) 1 << 20);
     size_t nElems = scriptExecutionCache.setup_bytes(nMaxCacheSize);
+    nScriptExecutionCacheElems = nElems;
     LogPrintf("Using %zu MiB out of %zu/2 requested for script execution cache, able to store %zu elements\n",
             (nElems*sizeof(uint256)) >>20, (nMaxCacheSize*2)>>20, nElems);
 }
 
+bool DumpScriptExecutionCache()
+{
+    int64_t nStart = GetTimeMicros();
+    std::vector<uint256> entries;
+    uint256 nonce;
+    {
+        LOCK(cs_main);
+        LogPrintf("Script execution cache: %u entries loaded at startup, %u hits and %u misses since\n",
+            scriptExecutionCacheStats.nLoaded, scriptExecutionCacheStats.nHits, scriptExecutionCacheStats.nMisses);
+        scriptExecutionCache.for_each([&entries](const uint256& entry) { entries.push_back(entry); });
+        nonce = scriptExecutionCacheNonce;
+    }
+    if (!WriteSignatureCacheFile(GetDataDir() / "scriptcache.dat", nonce, entries))
+        return false;
+    LogPrintf("Dumped %u script execution cache entries: %.2fms\n", entries.size(), (GetTimeMicros() - nStart) * 0.001);
+    return true;
+}
+
+bool LoadScriptExecutionCache()
+{
+    int64_t nStart = GetTimeMicros();
+    uint256 nonce;
+    std::vector<uint256> entries;
+    if (!ReadSignatureCacheFile(GetDataDir() / "scriptcache.dat", nonce, entries, MAX_SIGCACHE_FILE_AGE))
+        return false;
+
+    LOCK(cs_main);
+    scriptExecutionCacheNonce = nonce;
+    const size_t nLoaded = std::min<size_t>(entries.size(), nScriptExecutionCacheElems);
+    for (size_t i = 0; i < nLoaded; i++)
+        scriptExecutionCache.insert(entries[i]);
+    scriptExecutionCacheStats.nLoaded = nLoaded;
+    LogPrintf("Loaded %u of %u saved script execution cache entries: %.2fms\n", nLoaded, entries.size(), (GetTimeMicros() - nStart) * 0.001);
+    return true;
+}
+
+SignatureCacheStats GetScriptExecutionCacheStats()
+{
+    LOCK(cs_main);
+    return scriptExecutionCacheStats;
+}
+
 /**
  * Check whether all inputs of this transaction are valid (no double spends, scripts & sigs, amounts)
  * This does not modify the UTXO set.
@@ -1406,15 +1572,13 @@ bool CheckInputs(const CTransaction& tx, CValidationState &state, const CCoinsVi
             // correct (ie that the transaction hash which is in tx's prevouts
             // properly commits to the scriptPubKey in the inputs view of that
             // transaction).
-            uint256 hashCacheEntry;
-            // We only use the first 19 bytes of nonce to avoid a second SHA
-            // round - giving us 19 + 32 + 4 = 55 bytes (+ 8 + 1 = 64)
-            static_assert(55 - sizeof(flags) - 32 >= 128/8, "Want at least 128 bits of nonce for script execution cache");
-            CSHA256().Write(scriptExecutionCacheNonce.begin(), 55 - sizeof(flags) - 32).Write(tx.GetWitnessHash().begin(), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
+            uint256 hashCacheEntry = GetScriptExecutionCacheEntry(tx, flags);
             AssertLockHeld(cs_main); //TODO: Remove this requirement by making CuckooCache not require external locks
             if (scriptExecutionCache.contains(hashCacheEntry, !cacheFullScriptStore)) {
+                scriptExecutionCacheStats.nHits++;
                 return true;
             }
+            scriptExecutionCacheStats.nMisses++;
 
             for (unsigned int i = 0; i < tx.vin.size(); i++) {
                 const COutPoint &prevout = tx.vin[i].prevout;
@@ -1496,7 +1660,9 @@ bool UndoWriteToDisk(const CBlockUndo& blockundo, CDiskBlockPos& pos, const uint
     return true;
 }
 
-static bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex *pindex)
+} // namespace
+
+bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex)
 {
     CDiskBlockPos pos = pindex->GetUndoPos();
     if (pos.IsNull()) {
@@ -1527,6 +1693,8 @@ static bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex *pindex)
     return true;
 }
 
+namespace {
+
 /** Abort with a message */
 bool AbortNode(const std::string& strMessage, const std::string& userMessage="")
 {
@@ -1684,26 +1852,6 @@ static bool WriteUndoDataForBlock(const CBlockUndo& blockundo, CValidationState&
     return true;
 }
 
-static bool WriteTxIndexDataForBlock(const CBlock& block, CValidationState& state, CBlockIndex* pindex)
-{
-    if (!fTxIndex) return true;
-
-    CDiskTxPos pos(pindex->GetBlockPos(), GetSizeOfCompactSize(block.vtx.size()));
-    std::vector<std::pair<uint256, CDiskTxPos> > vPos;
-    vPos.reserve(block.vtx.size());
-    for (const CTransactionRef& tx : block.vtx)
-    {
-        vPos.push_back(std::make_pair(tx->GetHash(), pos));
-        pos.nTxOffset += ::GetSerializeSize(*tx, SER_DISK, CLIENT_VERSION);
-    }
-
-    if (!pblocktree->WriteTxIndex(vPos)) {
-        return AbortNode(state, "Failed to write transaction index");
-    }
-
-    return true;
-}
-
 static CCheckQueue<CScriptCheck> scriptcheckqueue(128);
 
 void ThreadScriptCheck() {
@@ -1805,7 +1953,35 @@ static unsigned int GetBlockScriptFlags(const CBlockIndex* pindex, const Consens
     return flags;
 }
 
-
+bool IsBlockAssumedValid(const CBlockIndex* pindex, const Consensus::Params& consensusParams)
+{
+    AssertLockHeld(cs_main);
+    if (!hashAssumeValid.IsNull() && pindexBestHeader) {
+        // We've been configured with the hash of a block which has been externally verified to have a valid history.
+        // A suitable default value is included with the software and updated from time to time.  Because validity
+        //  relative to a piece of software is an objective fact these defaults can be easily reviewed.
+        // This setting doesn't force the selection of any particular chain but makes validating some faster by
+        //  effectively caching the result of part of the verification.
+        BlockMap::const_iterator  it = mapBlockIndex.find(hashAssumeValid);
+        if (it != mapBlockIndex.end()) {
+            if (it->second->GetAncestor(pindex->nHeight) == pindex &&
+                pindexBestHeader->GetAncestor(pindex->nHeight) == pindex &&
+                pindexBestHeader->nChainWork >= nMinimumChainWork) {
+                // This block is a member of the assumed verified chain and an ancestor of the best header.
+                // The equivalent time check discourages hash power from extorting the network via DOS attack
+                //  into accepting an invalid block through telling users they must manually set assumevalid.
+                //  Requiring a software change or burying the invalid block, regardless of the setting, makes
+                //  it hard to hide the implication of the demand.  This also avoids having release candidates
+                //  that are hardly doing any signature verification at all in testing without having to
+                //  artificially set the default assumed verified block further back.
+                // The test against nMinimumChainWork prevents the skipping when denied access to any chain at
+                //  least as good as the expected chain.
+                return (GetBlockProofEquivalentTime(*pindexBestHeader, *pindex, *pindexBestHeader, consensusParams) > 60 * 60 * 24 * 7 * 2);
+            }
+        }
+    }
+    return false;
+}
 
 static int64_t nTimeCheck = 0;
 static int64_t nTimeForks = 0;
@@ -1859,31 +2035,7 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
 
     nBlocksTotal++;
 
-    bool fScriptChecks = true;
-    if (!hashAssumeValid.IsNull()) {
-        // We've been configured with the hash of a block which has been externally verified to have a valid history.
-        // A suitable default value is included with the software and updated from time to time.  Because validity
-        //  relative to a piece of software is an objective fact these defaults can be easily reviewed.
-        // This setting doesn't force the selection of any particular chain but makes validating some faster by
-        //  effectively caching the result of part of the verification.
-        BlockMap::const_iterator  it = mapBlockIndex.find(hashAssumeValid);
-        if (it != mapBlockIndex.end()) {
-            if (it->second->GetAncestor(pindex->nHeight) == pindex &&
-                pindexBestHeader->GetAncestor(pindex->nHeight) == pindex &&
-                pindexBestHeader->nChainWork >= nMinimumChainWork) {
-                // This block is a member of the assumed verified chain and an ancestor of the best header.
-                // The equivalent time check discourages hash power from extorting the network via DOS attack
-                //  into accepting an invalid block through telling users they must manually set assumevalid.
-                //  Requiring a software change or burying the invalid block, regardless of the setting, makes
-                //  it hard to hide the implication of the demand.  This also avoids having release candidates
-                //  that are hardly doing any signature verification at all in testing without having to
-                //  artificially set the default assumed verified block further back.
-                // The test against nMinimumChainWork prevents the skipping when denied access to any chain at
-                //  least as good as the expected chain.
-                fScriptChecks = (GetBlockProofEquivalentTime(*pindexBestHeader, *pindex, *pindexBestHeader, chainparams.GetConsensus()) <= 60 * 60 * 24 * 7 * 2);
-            }
-        }
-    }
+    bool fScriptChecks = !IsBlockAssumedValid(pindex, chainparams.GetConsensus());
 
     int64_t nTime1 = GetTimeMicros(); nTimeCheck += nTime1 - nTimeStart;
     LogPrint(BCLog::BENCH, "    - Sanity checks: %.2fms [%.2fs (%.2fms/blk)]\n", MILLI * (nTime1 - nTimeStart), nTimeCheck * MICRO, nTimeCheck * MILLI / nBlocksTotal);
@@ -2057,9 +2209,6 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
         setDirtyBlockIndex.insert(pindex);
     }
 
-    if (!WriteTxIndexDataForBlock(block, state, pindex))
-        return false;
-
     assert(pindex->phashBlock);
     // add this block to the view's block chain
     view.SetBestBlock(pindex->GetBlockHash());
@@ -2073,6 +2222,119 @@ bool CChainState::ConnectBlock(const CBlock& block, CValidationState& state, CBl
     return true;
 }
 
+/**
+ * LitecoinCash: CoinsSync: Writes the dirty entries of the coins cache to the coins database, either
+ * right away or from a background thread, while the cache stays populated. There is at most one write
+ * in flight; Wait() has to be called (with cs_main held) before the cache is synced or evicted again.
+ */
+class CCoinsWriter
+{
+private:
+    std::thread thread;
+    std::unique_ptr<CCoinsMapMemoryResource> pResource;
+    std::unique_ptr<CCoinsMap> pCoins;
+    CCoinsViewCache* pcache = nullptr;
+    size_t nInFlightUsage = 0;
+    bool fOk = true;
+    int64_t nStartTime = 0;
+    int64_t nDuration = 0;
+    uint64_t nHits = 0;
+    uint64_t nMisses = 0;
+    CoinsFlushStats stats;
+
+    void Run(CCoinsView* pbase, uint256 hashBlock)
+    {
+        try {
+            fOk = pbase->BatchWrite(*pCoins, hashBlock);
+        } catch (const std::exception& e) {
+            LogPrintf("%s: %s\n", __func__, e.what());
+            fOk = false;
+        }
+        nDuration = GetTimeMicros() - nStartTime;
+    }
+
+public:
+    ~CCoinsWriter()
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    bool InFlight() const { return pcache != nullptr; }
+
+    /** Memory held by the copy of the dirty entries being written, which comes on top of the cache itself. */
+    size_t InFlightMemoryUsage() const { return nInFlightUsage; }
+
+    const CoinsFlushStats& GetStats() const { return stats; }
+
+    /** Take the dirty entries from cache and write them to base, in the background if requested. */
+    bool Write(CCoinsViewCache& cache, CCoinsView* pbase, bool fBackground)
+    {
+        assert(!InFlight());
+        pResource.reset(new CCoinsMapMemoryResource());
+        pCoins.reset(new CCoinsMap(0, SaltedOutpointHasher(), CCoinsMap::key_equal(), pResource.get()));
+        nHits = cache.GetCacheHits();
+        nMisses = cache.GetCacheMisses();
+        cache.TakeDirtyCoins(*pCoins);
+        nInFlightUsage = pResource->BytesInUse();
+        for (const auto& entry : *pCoins)
+            nInFlightUsage += entry.second.coin.DynamicMemoryUsage();
+        pcache = &cache;
+        stats.nLastCoins = pCoins->size();
+        stats.fLastBackground = fBackground;
+        nStartTime = GetTimeMicros();
+        if (fBackground) {
+            thread = std::thread([this, pbase](uint256 hashBlock) {
+                RenameThread("litecoincash-coinsflush");
+                Run(pbase, hashBlock);
+            }, cache.GetBestBlock());
+            return true;
+        }
+        Run(pbase, cache.GetBestBlock());
+        return Wait();
+    }
+
+    /** Wait for the write in flight, if any, to finish. Returns false if it failed. */
+    bool Wait()
+    {
+        if (!InFlight())
+            return true;
+        if (thread.joinable())
+            thread.join();
+        pcache->SyncDone();
+        pcache = nullptr;
+        nInFlightUsage = 0;
+        pCoins.reset();
+        pResource.reset();
+
+        stats.nLastTime = nStartTime / 1000000;
+        stats.nLastDuration = nDuration;
+        stats.nLastHits = nHits;
+        stats.nLastMisses = nMisses;
+        stats.nFlushes++;
+        LogPrint(BCLog::COINDB, "Coins flush: wrote %u coins in %.2fms (%s), hit rate before the flush %.2f%% (%u hits, %u misses)\n",
+            stats.nLastCoins, nDuration * 0.001, stats.fLastBackground ? "background" : "foreground",
+            nHits + nMisses > 0 ? 100.0 * nHits / (nHits + nMisses) : 0.0, nHits, nMisses);
+        return fOk;
+    }
+
+    void RecordEviction(size_t nEvicted, size_t nUsage)
+    {
+        stats.nLastEvicted = nEvicted;
+        LogPrint(BCLog::COINDB, "Coins cache: evicted %u entries, %.1f MiB in use\n", nEvicted, nUsage * (1.0 / 1048576.0));
+    }
+};
+
+static CCoinsWriter coinsWriter;
+
+CoinsFlushStats GetCoinsFlushStats()
+{
+    LOCK(cs_main);
+    CoinsFlushStats stats = coinsWriter.GetStats();
+    stats.nInFlightUsage = coinsWriter.InFlightMemoryUsage();
+    return stats;
+}
+
 /**
  * Update the on-disk chain state.
  * The caches and indexes are flushed depending on the mode we're called with
@@ -2119,7 +2381,10 @@ bool static FlushStateToDisk(const CChainParams& chainparams, CValidationState &
             nLastSetChain = nNow;
         }
         int64_t nMempoolSizeMax = gArgs.GetArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000;
-        int64_t cacheSize = pcoinsTip->DynamicMemoryUsage();
+        // LitecoinCash: CoinsSync: Memory freed by eviction is kept for reuse, so only count what's live. The copy of
+        // the dirty coins held by a background write counts too, so that a write in flight can't take the coins past
+        // -dbcache; if it would, the flush below turns critical and waits for it.
+        int64_t cacheSize = fCoinsBackgroundFlush ? pcoinsTip->LiveMemoryUsage() + coinsWriter.InFlightMemoryUsage() : pcoinsTip->DynamicMemoryUsage();
         int64_t nTotalSpace = nCoinCacheUsage + std::max<int64_t>(nMempoolSizeMax - nMempoolUsage, 0);
         // The cache is large and we're within 10% and 10 MiB of the limit, but we have time now (not in the middle of a block processing).
         bool fCacheLarge = mode == FLUSH_STATE_PERIODIC && cacheSize > std::max((9 * nTotalSpace) / 10, nTotalSpace - MAX_BLOCK_COINSDB_USAGE * 1024 * 1024);
@@ -2131,6 +2396,11 @@ bool static FlushStateToDisk(const CChainParams& chainparams, CValidationState &
         bool fPeriodicFlush = mode == FLUSH_STATE_PERIODIC && nNow > nLastFlush + (int64_t)DATABASE_FLUSH_INTERVAL * 1000000;
         // Combine all conditions that result in a full cache flush.
         fDoFullFlush = (mode == FLUSH_STATE_ALWAYS) || fCacheLarge || fCacheCritical || fPeriodicFlush || fFlushForPrune;
+        // LitecoinCash: CoinsSync: A periodic flush doesn't wait for the previous background write; try again later.
+        bool fBackgroundFlush = fCoinsBackgroundFlush && mode == FLUSH_STATE_PERIODIC && !fFlushForPrune;
+        if (fBackgroundFlush && fDoFullFlush && coinsWriter.InFlight()) {
+            fDoFullFlush = false;
+        }
         // Write blocks and block index to disk.
         if (fDoFullFlush || fPeriodicWrite) {
             // Depend on nMinDiskSpace to ensure we can write block index
@@ -2171,8 +2441,28 @@ bool static FlushStateToDisk(const CChainParams& chainparams, CValidationState &
             if (!CheckDiskSpace(48 * 2 * 2 * pcoinsTip->GetCacheSize()))
                 return state.Error("out of disk space");
             // Flush the chainstate (which may refer to block index entries).
-            if (!pcoinsTip->Flush())
+            if (fCoinsBackgroundFlush) {
+                // LitecoinCash: CoinsSync: Write only the dirty coins and keep the cache warm. Evict least recently
+                // used coins separately, once the cache is over budget. Unless the state has to be on disk when we
+                // return, the write happens in the background.
+                if (!coinsWriter.Wait())
+                    return AbortNode(state, "Failed to write to coin database");
+                const size_t nTargetUsage = nTotalSpace / 100 * COINS_CACHE_EVICT_PERCENT;
+                // Write through the prefetcher, so that it drops what it read ahead
+                CCoinsView* pcoinsbase = pcoinsprefetch ? static_cast<CCoinsView*>(pcoinsprefetch.get()) : pcoinsdbview.get();
+                if (fBackgroundFlush) {
+                    if (fCacheLarge)
+                        coinsWriter.RecordEviction(pcoinsTip->Evict(nTargetUsage), pcoinsTip->LiveMemoryUsage());
+                    coinsWriter.Write(*pcoinsTip, pcoinsbase, true);
+                } else {
+                    if (!coinsWriter.Write(*pcoinsTip, pcoinsbase, false))
+                        return AbortNode(state, "Failed to write to coin database");
+                    if (fCacheCritical || fCacheLarge)
+                        coinsWriter.RecordEviction(pcoinsTip->Evict(nTargetUsage), pcoinsTip->LiveMemoryUsage());
+                }
+            } else if (!pcoinsTip->Flush()) {
                 return AbortNode(state, "Failed to write to coin database");
+            }
             nLastFlush = nNow;
         }
     }
@@ -2215,6 +2505,9 @@ void static UpdateTip(const CBlockIndex *pindexNew, const CChainParams& chainPar
     // New best block
     mempool.AddTransactionsUpdated(1);
 
+    // LitecoinCash: MinotaurX+Hive1.2: Keep per block type stats in step with the active chain
+    chainTypeStats.SetTip(pindexNew);
+
     cvBlockChange.notify_all();
 
     std::vector<std::string> warningMessages;
@@ -2720,6 +3013,9 @@ bool CChainState::ActivateBestChain(CValidationState &state, const CChainParams&
     // sanely for performance or correctness!
     AssertLockNotHeld(cs_main);
 
+    // LitecoinCash: MsgHandlerThreads: One caller at a time (see m_cs_chainstate)
+    LOCK(m_cs_chainstate);
+
     CBlockIndex *pindexMostWork = nullptr;
     CBlockIndex *pindexNewTip = nullptr;
     int nStopAtHeight = gArgs.GetArg("-stopatheight", DEFAULT_STOPATHEIGHT);
@@ -2932,6 +3228,23 @@ bool ResetBlockFailureFlags(CBlockIndex *pindex) {
     return g_chainstate.ResetBlockFailureFlags(pindex);
 }
 
+// LitecoinCash: FastIndexLoad: Block index entries are only ever freed all at once, so they're carved out of
+// large chunks instead of being allocated one by one. That also keeps entries loaded together close together.
+static_assert(std::is_trivially_destructible<CBlockIndex>::value, "Block index entries are dropped without being destructed");
+static constexpr size_t BLOCK_INDEX_ALIGN = alignof(CBlockIndex) > alignof(void*) ? alignof(CBlockIndex) : alignof(void*);
+typedef PoolResource<(sizeof(CBlockIndex) + BLOCK_INDEX_ALIGN - 1) / BLOCK_INDEX_ALIGN * BLOCK_INDEX_ALIGN, BLOCK_INDEX_ALIGN> BlockIndexArena;
+static std::unique_ptr<BlockIndexArena> blockIndexArena;
+static const size_t BLOCK_INDEX_ARENA_CHUNK_SIZE = 1 << 20;
+
+template <typename... Args>
+static CBlockIndex* NewBlockIndex(Args&&... args)
+{
+    AssertLockHeld(cs_main);
+    if (!blockIndexArena)
+        blockIndexArena.reset(new BlockIndexArena(BLOCK_INDEX_ARENA_CHUNK_SIZE));
+    return new (blockIndexArena->Allocate(sizeof(CBlockIndex), alignof(CBlockIndex))) CBlockIndex(std::forward<Args>(args)...);
+}
+
 CBlockIndex* CChainState::AddToBlockIndex(const CBlockHeader& block)
 {
     // Check for duplicate
@@ -2941,7 +3254,7 @@ CBlockIndex* CChainState::AddToBlockIndex(const CBlockHeader& block)
         return it->second;
 
     // Construct new block index object
-    CBlockIndex* pindexNew = new CBlockIndex(block);
+    CBlockIndex* pindexNew = NewBlockIndex(block);
     // We assign the sequence id to blocks only when the full data is available,
     // to avoid miners withholding blocks but broadcasting headers, to get a
     // competitive advantage.
@@ -3652,16 +3965,36 @@ bool CChainState::AcceptBlockHeader(const CBlockHeader& block, CValidationState&
     return true;
 }
 
+/** LitecoinCash: ScryptBatch: Headers scrypted together ahead of being accepted, as many as the widest batch */
+static const size_t HEADERS_POW_HASH_BATCH = 8;
+
 // Exposed wrapper for AcceptBlockHeader
 bool ProcessNewBlockHeaders(const std::vector<CBlockHeader>& headers, CValidationState& state, const CChainParams& chainparams, const CBlockIndex** ppindex, CBlockHeader *first_invalid)
 {
     if (first_invalid != nullptr) first_invalid->SetNull();
-    {
+
+    // LitecoinCash: ScryptBatch: Scrypt the new pre-fork headers several at a time, without holding cs_main. Each
+    // batch is accepted before the next is hashed, and only headers that connect are hashed ahead, so a message of
+    // junk headers costs at most one batch of hashes, much as it cost one hash when they were checked one by one.
+    for (size_t nStart = 0; nStart < headers.size(); nStart += HEADERS_POW_HASH_BATCH) {
+        const size_t nEnd = std::min(headers.size(), nStart + HEADERS_POW_HASH_BATCH);
+        std::vector<const CBlockHeader*> vNewHeaders;
+        {
+            LOCK(cs_main);
+            for (size_t i = nStart; i < nEnd; i++) {
+                const CBlockHeader& header = headers[i];
+                const bool fConnects = (i > nStart && header.hashPrevBlock == headers[i - 1].GetHash()) || mapBlockIndex.count(header.hashPrevBlock);
+                if (fConnects && !mapBlockIndex.count(header.GetHash()))
+                    vNewHeaders.push_back(&header);
+            }
+        }
+        PrecomputePoWHashes(vNewHeaders);
+
         LOCK(cs_main);
-        for (const CBlockHeader& header : headers) {
+        for (size_t i = nStart; i < nEnd; i++) {
             CBlockIndex *pindex = nullptr; // Use a temp pindex instead of ppindex to avoid a const_cast
-            if (!g_chainstate.AcceptBlockHeader(header, state, chainparams, &pindex)) {
-                if (first_invalid) *first_invalid = header;
+            if (!g_chainstate.AcceptBlockHeader(headers[i], state, chainparams, &pindex)) {
+                if (first_invalid) *first_invalid = headers[i];
                 return false;
             }
             if (ppindex) {
@@ -3792,6 +4125,10 @@ bool ProcessNewBlock(const CChainParams& chainparams, const std::shared_ptr<cons
             // Store to disk
             ret = g_chainstate.AcceptBlock(pblock, state, chainparams, &pindex, fForceProcessing, nullptr, fNewBlock);
         }
+        // LitecoinCash: CoinsPrefetch: Start reading the block's inputs while it waits to be connected
+        if (ret && pcoinsprefetch && pindex && !chainActive.Contains(pindex) && IsInitialBlockDownload()) {
+            pcoinsprefetch->Prefetch(*pblock);
+        }
         if (!ret) {
             GetMainSignals().BlockChecked(*pblock, state);
             return error("%s: AcceptBlock FAILED (%s)", __func__, state.GetDebugMessage());
@@ -3885,6 +4222,7 @@ void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune)
 {
     for (std::set<int>::iterator it = setFilesToPrune.begin(); it != setFilesToPrune.end(); ++it) {
         CDiskBlockPos pos(*it, 0);
+        ForgetMappedBlockFile(*it); // LitecoinCash: MappedBlocks
         fs::remove(GetBlockPosFilename(pos, "blk"));
         fs::remove(GetBlockPosFilename(pos, "rev"));
         LogPrintf("Prune: %s deleted blk/rev (%05u)\n", __func__, *it);
@@ -4042,7 +4380,7 @@ CBlockIndex * CChainState::InsertBlockIndex(const uint256& hash)
         return (*mi).second;
 
     // Create new
-    CBlockIndex* pindexNew = new CBlockIndex();
+    CBlockIndex* pindexNew = NewBlockIndex();
     mi = mapBlockIndex.insert(std::make_pair(hash, pindexNew)).first;
     pindexNew->phashBlock = &((*mi).first);
 
@@ -4055,6 +4393,7 @@ bool CChainState::LoadBlockIndex(const Consensus::Params& consensus_params, CBlo
         return false;
 
     boost::this_thread::interruption_point();
+    int64_t nStart = GetTimeMicros();
 
     // Calculate nChainWork
     std::vector<std::pair<int, CBlockIndex*> > vSortedByHeight;
@@ -4097,14 +4436,17 @@ bool CChainState::LoadBlockIndex(const Consensus::Params& consensus_params, CBlo
         if (pindex->IsValid(BLOCK_VALID_TREE) && (pindexBestHeader == nullptr || CBlockIndexWorkComparator()(pindexBestHeader, pindex)))
             pindexBestHeader = pindex;
     }
+    LogPrintf("%s: computed chain work and skip list for %u entries in %.2fms\n", __func__, vSortedByHeight.size(), (GetTimeMicros() - nStart) * 0.001);
 
     return true;
 }
 
 bool static LoadBlockIndexDB(const CChainParams& chainparams)
 {
+    int64_t nStart = GetTimeMicros();
     if (!g_chainstate.LoadBlockIndex(chainparams.GetConsensus(), *pblocktree))
         return false;
+    LogPrintf("%s: loaded %u block index entries in %.2fms\n", __func__, mapBlockIndex.size(), (GetTimeMicros() - nStart) * 0.001);
 
     // Load block file info
     pblocktree->ReadLastBlockFile(nLastBlockFile);
@@ -4151,10 +4493,6 @@ bool static LoadBlockIndexDB(const CChainParams& chainparams)
     pblocktree->ReadReindexing(fReindexing);
     if(fReindexing) fReindex = true;
 
-    // Check whether we have a transaction index
-    pblocktree->ReadFlag("txindex", fTxIndex);
-    LogPrintf("%s: transaction index %s\n", __func__, fTxIndex ? "enabled" : "disabled");
-
     return true;
 }
 
@@ -4177,6 +4515,7 @@ bool LoadChainTip(const CChainParams& chainparams)
     if (it == mapBlockIndex.end())
         return false;
     chainActive.SetTip(it->second);
+    chainTypeStats.SetTip(it->second);  // LitecoinCash: MinotaurX+Hive1.2
 
     g_chainstate.PruneBlockIndexCandidates();
 
@@ -4497,7 +4836,9 @@ void CChainState::UnloadBlockIndex() {
 void UnloadBlockIndex()
 {
     LOCK(cs_main);
+    coinsWriter.Wait(); // LitecoinCash: CoinsSync: The coins views may go away next
     chainActive.SetTip(nullptr);
+    chainTypeStats.SetTip(nullptr);     // LitecoinCash: MinotaurX+Hive1.2
     pindexBestInvalid = nullptr;
     pindexBestHeader = nullptr;
     mempool.clear();
@@ -4511,10 +4852,9 @@ void UnloadBlockIndex()
         warningcache[b].clear();
     }
 
-    for (BlockMap::value_type& entry : mapBlockIndex) {
-        delete entry.second;
-    }
+    // LitecoinCash: FastIndexLoad: All entries go with the arena
     mapBlockIndex.clear();
+    blockIndexArena.reset();
     fHavePruned = false;
 
     g_chainstate.UnloadBlockIndex();
@@ -4538,9 +4878,6 @@ bool LoadBlockIndex(const CChainParams& chainparams)
         // needs_init.
 
         LogPrintf("Initializing databases...\n");
-        // Use the provided setting for -txindex in the new database
-        fTxIndex = gArgs.GetBoolArg("-txindex", DEFAULT_TXINDEX);
-        pblocktree->WriteFlag("txindex", fTxIndex);
     }
     return true;
 }
@@ -4577,20 +4914,165 @@ bool LoadGenesisBlock(const CChainParams& chainparams)
     return g_chainstate.LoadGenesisBlock(chainparams);
 }
 
-bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskBlockPos *dbp)
+// LitecoinCash: ReindexPipeline: Limits on what the import pipeline holds between reading and connecting. The block
+// count stays well below the pow hash cache size, so the hashes computed by the checkers are still there for AcceptBlock.
+static const size_t LOAD_BLOCK_PIPELINE_MAX_BLOCKS = 2048;
+static const size_t LOAD_BLOCK_PIPELINE_MAX_BYTES = 64 << 20;
+/** LitecoinCash: ReindexPipeline: Maximum number of threads checking blocks while importing or reindexing */
+static const int MAX_LOAD_BLOCK_CHECK_THREADS = 8;
+
+namespace {
+
+//! LitecoinCash: ReindexPipeline: What one stage of the import pipeline did, for the summary in the log
+struct ImportStageStats
 {
-    // Map of disk positions for blocks with unknown parent (only used for reindex)
-    static std::multimap<uint256, CDiskBlockPos> mapBlocksUnknownParent;
-    int64_t nStart = GetTimeMillis();
+    uint64_t nBlocks = 0;
+    uint64_t nBytes = 0;
+    int64_t nBusyMicros = 0;
+    int64_t nWaitMicros = 0;
+};
 
-    int nLoaded = 0;
+//! LitecoinCash: ReindexPipeline: Up to LOAD_BLOCK_BATCH_SIZE consecutive blocks from a file
+struct ImportBatch
+{
+    uint64_t nSeq = 0;
+    size_t nBytes = 0;
+    std::vector<std::pair<CDataStream, CDiskBlockPos>> vRaw;                   //!< As read from the file
+    std::vector<std::pair<std::shared_ptr<CBlock>, CDiskBlockPos>> vBlocks;    //!< After checking
+};
+
+/**
+ * LitecoinCash: ReindexPipeline: Passes batches from the reader to the checkers, and from the checkers on to the
+ * connecting thread in file order. Limits how much is in flight, and keeps track of the time spent in each stage.
+ */
+class ImportPipeline
+{
+private:
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<ImportBatch> toCheck;
+    std::map<uint64_t, ImportBatch> checked;
+    uint64_t nNextSeq;
+    uint64_t nNextConnect;
+    size_t nBlocksInFlight;
+    size_t nBytesInFlight;
+    bool fReaderDone;
+    bool fStop;
+    ImportStageStats read, check, connect;
+
+public:
+    ImportPipeline() : nNextSeq(0), nNextConnect(0), nBlocksInFlight(0), nBytesInFlight(0), fReaderDone(false), fStop(false) {}
+
+    //! Returns false if the reader should give up
+    bool PushRead(ImportBatch&& batch, int64_t nBusyMicros)
+    {
+        const int64_t nWaitStart = GetTimeMicros();
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]{ return fStop || nBlocksInFlight == 0 ||
+            (nBlocksInFlight < LOAD_BLOCK_PIPELINE_MAX_BLOCKS && nBytesInFlight < LOAD_BLOCK_PIPELINE_MAX_BYTES); });
+        read.nWaitMicros += GetTimeMicros() - nWaitStart;
+        if (fStop)
+            return false;
+        read.nBlocks += batch.vRaw.size();
+        read.nBytes += batch.nBytes;
+        read.nBusyMicros += nBusyMicros;
+        nBlocksInFlight += batch.vRaw.size();
+        nBytesInFlight += batch.nBytes;
+        batch.nSeq = nNextSeq++;
+        toCheck.push_back(std::move(batch));
+        cond.notify_all();
+        return true;
+    }
+
+    void ReaderDone()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        fReaderDone = true;
+        cond.notify_all();
+    }
+
+    //! Returns false once the reader is done and everything has been taken
+    bool PopCheck(ImportBatch& batch)
+    {
+        const int64_t nWaitStart = GetTimeMicros();
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]{ return fStop || !toCheck.empty() || fReaderDone; });
+        check.nWaitMicros += GetTimeMicros() - nWaitStart;
+        if (fStop || toCheck.empty())
+            return false;
+        batch = std::move(toCheck.front());
+        toCheck.pop_front();
+        return true;
+    }
+
+    void PushChecked(ImportBatch&& batch, int64_t nBusyMicros)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        check.nBlocks += batch.vBlocks.size();
+        check.nBytes += batch.nBytes;
+        check.nBusyMicros += nBusyMicros;
+        const uint64_t nSeq = batch.nSeq;
+        checked.emplace(nSeq, std::move(batch));
+        cond.notify_all();
+    }
+
+    //! Returns the next batch in file order, or false once all of them have been returned
+    bool PopConnect(ImportBatch& batch)
+    {
+        const int64_t nWaitStart = GetTimeMicros();
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]{ return fStop || checked.count(nNextConnect) || (fReaderDone && nNextConnect == nNextSeq); });
+        connect.nWaitMicros += GetTimeMicros() - nWaitStart;
+        auto it = checked.find(nNextConnect);
+        if (fStop || it == checked.end())
+            return false;
+        batch = std::move(it->second);
+        checked.erase(it);
+        nNextConnect++;
+        nBlocksInFlight -= batch.vRaw.size();
+        nBytesInFlight -= batch.nBytes;
+        cond.notify_all();
+        return true;
+    }
+
+    void ConnectDone(const ImportBatch& batch, int64_t nBusyMicros)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        connect.nBlocks += batch.vBlocks.size();
+        connect.nBytes += batch.nBytes;
+        connect.nBusyMicros += nBusyMicros;
+    }
+
+    void Stop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        fStop = true;
+        cond.notify_all();
+    }
+
+    //! Busy time is what a stage spent working, wait time what it spent blocked on its neighbours
+    void LogStats(int nCheckThreads)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (const auto& stage : {std::make_pair("read", &read), std::make_pair("check", &check), std::make_pair("connect", &connect)}) {
+            const ImportStageStats& stats = *stage.second;
+            LogPrint(BCLog::REINDEX, "Import %s stage%s: %u blocks (%.1f MiB), busy %.2fs (%.0f blocks/s), waiting %.2fs\n",
+                stage.first, stage.second == &check ? strprintf(" (%d threads)", nCheckThreads) : std::string(),
+                stats.nBlocks, stats.nBytes / 1048576.0, stats.nBusyMicros * 0.000001,
+                stats.nBusyMicros > 0 ? stats.nBlocks * 1000000.0 / stats.nBusyMicros : 0.0, stats.nWaitMicros * 0.000001);
+        }
+    }
+};
+
+//! LitecoinCash: ReindexPipeline: Find the blocks in a file, and pass them on without deserializing them
+void ReadImportBlocks(CBufferedFile& blkdat, const CChainParams& chainparams, const CDiskBlockPos* dbp, ImportPipeline& pipeline)
+{
+    RenameThread("litecoincash-loadblk");
     try {
-        // This takes over fileIn and calls fclose() on it in the CBufferedFile destructor
-        CBufferedFile blkdat(fileIn, 2*MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE+8, SER_DISK, CLIENT_VERSION);
         uint64_t nRewind = blkdat.GetPos();
+        ImportBatch batch;
+        int64_t nBusyStart = GetTimeMicros();
         while (!blkdat.eof()) {
-            boost::this_thread::interruption_point();
-
             blkdat.SetPos(nRewind);
             nRewind++; // start one byte further next time, in case of failure
             blkdat.SetLimit(); // remove former limit
@@ -4614,78 +5096,185 @@ bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskB
             try {
                 // read block
                 uint64_t nBlockPos = blkdat.GetPos();
-                if (dbp)
-                    dbp->nPos = nBlockPos;
                 blkdat.SetLimit(nBlockPos + nSize);
                 blkdat.SetPos(nBlockPos);
-                std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
-                CBlock& block = *pblock;
-                blkdat >> block;
+                CDataStream raw(SER_DISK, CLIENT_VERSION);
+                raw.resize(nSize);
+                blkdat.read(&raw[0], nSize);
                 nRewind = blkdat.GetPos();
+                CDiskBlockPos pos;
+                if (dbp)
+                    pos = CDiskBlockPos(dbp->nFile, nBlockPos);
+                batch.nBytes += nSize;
+                batch.vRaw.emplace_back(std::move(raw), pos);
+            } catch (const std::exception& e) {
+                LogPrintf("%s: Deserialize or I/O error - %s\n", __func__, e.what());
+            }
+            if (batch.vRaw.size() == LOAD_BLOCK_BATCH_SIZE) {
+                if (!pipeline.PushRead(std::move(batch), GetTimeMicros() - nBusyStart))
+                    break;
+                batch = ImportBatch();
+                nBusyStart = GetTimeMicros();
+            }
+        }
+        if (!batch.vRaw.empty())
+            pipeline.PushRead(std::move(batch), GetTimeMicros() - nBusyStart);
+    } catch (const std::exception& e) {
+        LogPrintf("%s: %s\n", __func__, e.what());
+    }
+    pipeline.ReaderDone();
+}
 
-                // detect out of order blocks, and store them for later
-                uint256 hash = block.GetHash();
-                if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex.find(block.hashPrevBlock) == mapBlockIndex.end()) {
-                    LogPrint(BCLog::REINDEX, "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
-                            block.hashPrevBlock.ToString());
-                    if (dbp)
-                        mapBlocksUnknownParent.insert(std::make_pair(block.hashPrevBlock, *dbp));
-                    continue;
-                }
+/**
+ * LitecoinCash: ReindexPipeline: Deserialize blocks and do the checks that don't depend on the chain: pow and merkle
+ * root. Blocks that pass are marked fChecked, so AcceptBlock doesn't do them again; blocks that fail are left for
+ * AcceptBlock to reject. Hive proofs need the chain up to the parent, so hive mined blocks are only deserialized.
+ */
+void CheckImportBlocks(const Consensus::Params& consensusParams, ImportPipeline& pipeline)
+{
+    RenameThread("litecoincash-chkblk");
+    ImportBatch batch;
+    while (pipeline.PopCheck(batch)) {
+        const int64_t nBusyStart = GetTimeMicros();
+        std::vector<const CBlockHeader*> vHeaders;
+        for (auto& raw : batch.vRaw) {
+            try {
+                std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
+                raw.first >> *pblock;
+                vHeaders.push_back(pblock.get());
+                batch.vBlocks.emplace_back(pblock, raw.second);
+            } catch (const std::exception& e) {
+                LogPrintf("%s: Deserialize or I/O error - %s\n", __func__, e.what());
+            }
+            raw.first.clear();
+        }
+        PrecomputePoWHashes(vHeaders, true);
+        for (const auto& entry : batch.vBlocks) {
+            if (entry.first->IsHiveMined(consensusParams))
+                continue;
+            CValidationState state;
+            CheckBlock(*entry.first, state, consensusParams);
+        }
+        pipeline.PushChecked(std::move(batch), GetTimeMicros() - nBusyStart);
+        batch = ImportBatch();
+    }
+}
 
-                // process in case the block isn't known yet
-                if (mapBlockIndex.count(hash) == 0 || (mapBlockIndex[hash]->nStatus & BLOCK_HAVE_DATA) == 0) {
-                    LOCK(cs_main);
-                    CValidationState state;
-                    if (g_chainstate.AcceptBlock(pblock, state, chainparams, nullptr, true, dbp, nullptr))
-                        nLoaded++;
-                    if (state.IsError())
-                        break;
-                } else if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex[hash]->nHeight % 1000 == 0) {
-                    LogPrint(BCLog::REINDEX, "Block Import: already had block %s at height %d\n", hash.ToString(), mapBlockIndex[hash]->nHeight);
-                }
+} // namespace
+
+bool LoadExternalBlockFile(const CChainParams& chainparams, FILE* fileIn, CDiskBlockPos *dbp)
+{
+    // Map of disk positions for blocks with unknown parent (only used for reindex)
+    static std::multimap<uint256, CDiskBlockPos> mapBlocksUnknownParent;
+    int64_t nStart = GetTimeMillis();
+
+    int nLoaded = 0;
+    try {
+        // This takes over fileIn and calls fclose() on it in the CBufferedFile destructor
+        CBufferedFile blkdat(fileIn, 2*MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE+8, SER_DISK, CLIENT_VERSION);
+
+        // LitecoinCash: ReindexPipeline: One thread reads the file, a few more deserialize and check the blocks
+        // (see CheckImportBlocks), and this thread gets them back in file order to accept them.
+        const int nCheckThreads = std::max(1, std::min(GetNumCores() - 1, MAX_LOAD_BLOCK_CHECK_THREADS));
+        ImportPipeline pipeline;
+        std::vector<std::thread> vThreads;
+        vThreads.emplace_back(ReadImportBlocks, std::ref(blkdat), std::cref(chainparams), dbp, std::ref(pipeline));
+        for (int i = 0; i < nCheckThreads; i++)
+            vThreads.emplace_back(CheckImportBlocks, std::cref(chainparams.GetConsensus()), std::ref(pipeline));
+
+        // Make sure the other stages are gone before the pipeline and file are, however this returns
+        struct PipelineJoiner {
+            ImportPipeline& pipeline;
+            std::vector<std::thread>& vThreads;
+            ~PipelineJoiner()
+            {
+                pipeline.Stop();
+                for (std::thread& thread : vThreads)
+                    thread.join();
+            }
+        } joiner{pipeline, vThreads};
 
-                // Activate the genesis block so normal node progress can continue
-                if (hash == chainparams.GetConsensus().hashGenesisBlock) {
-                    CValidationState state;
-                    if (!ActivateBestChain(state, chainparams)) {
-                        break;
+        ImportBatch batch;
+        bool fAbort = false;
+        while (!fAbort && pipeline.PopConnect(batch)) {
+            boost::this_thread::interruption_point();
+            const int64_t nBusyStart = GetTimeMicros();
+
+            for (auto& entry : batch.vBlocks) {
+                std::shared_ptr<CBlock> pblock = entry.first;
+                CBlock& block = *pblock;
+                CDiskBlockPos* pblockpos = dbp ? &entry.second : nullptr;
+                try {
+                    // detect out of order blocks, and store them for later
+                    uint256 hash = block.GetHash();
+                    if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex.find(block.hashPrevBlock) == mapBlockIndex.end()) {
+                        LogPrint(BCLog::REINDEX, "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
+                                block.hashPrevBlock.ToString());
+                        if (pblockpos)
+                            mapBlocksUnknownParent.insert(std::make_pair(block.hashPrevBlock, *pblockpos));
+                        continue;
                     }
-                }
 
-                NotifyHeaderTip();
-
-                // Recursively process earlier encountered successors of this block
-                std::deque<uint256> queue;
-                queue.push_back(hash);
-                while (!queue.empty()) {
-                    uint256 head = queue.front();
-                    queue.pop_front();
-                    std::pair<std::multimap<uint256, CDiskBlockPos>::iterator, std::multimap<uint256, CDiskBlockPos>::iterator> range = mapBlocksUnknownParent.equal_range(head);
-                    while (range.first != range.second) {
-                        std::multimap<uint256, CDiskBlockPos>::iterator it = range.first;
-                        std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
-                        if (ReadBlockFromDisk(*pblockrecursive, it->second, chainparams.GetConsensus()))
-                        {
-                            LogPrint(BCLog::REINDEX, "%s: Processing out of order child %s of %s\n", __func__, pblockrecursive->GetHash().ToString(),
-                                    head.ToString());
-                            LOCK(cs_main);
-                            CValidationState dummy;
-                            if (g_chainstate.AcceptBlock(pblockrecursive, dummy, chainparams, nullptr, true, &it->second, nullptr))
+                    // process in case the block isn't known yet
+                    if (mapBlockIndex.count(hash) == 0 || (mapBlockIndex[hash]->nStatus & BLOCK_HAVE_DATA) == 0) {
+                        LOCK(cs_main);
+                        CValidationState state;
+                        if (g_chainstate.AcceptBlock(pblock, state, chainparams, nullptr, true, pblockpos, nullptr))
+                            nLoaded++;
+                        if (state.IsError()) {
+                            fAbort = true;
+                            break;
+                        }
+                    } else if (hash != chainparams.GetConsensus().hashGenesisBlock && mapBlockIndex[hash]->nHeight % 1000 == 0) {
+                        LogPrint(BCLog::REINDEX, "Block Import: already had block %s at height %d\n", hash.ToString(), mapBlockIndex[hash]->nHeight);
+                    }
+
+                    // Activate the genesis block so normal node progress can continue
+                    if (hash == chainparams.GetConsensus().hashGenesisBlock) {
+                        CValidationState state;
+                        if (!ActivateBestChain(state, chainparams)) {
+                            fAbort = true;
+                            break;
+                        }
+                    }
+
+                    NotifyHeaderTip();
+
+                    // Recursively process earlier encountered successors of this block
+                    std::deque<uint256> queue;
+                    queue.push_back(hash);
+                    while (!queue.empty()) {
+                        uint256 head = queue.front();
+                        queue.pop_front();
+                        std::pair<std::multimap<uint256, CDiskBlockPos>::iterator, std::multimap<uint256, CDiskBlockPos>::iterator> range = mapBlocksUnknownParent.equal_range(head);
+                        while (range.first != range.second) {
+                            std::multimap<uint256, CDiskBlockPos>::iterator it = range.first;
+                            std::shared_ptr<CBlock> pblockrecursive = std::make_shared<CBlock>();
+                            if (ReadBlockFromDisk(*pblockrecursive, it->second, chainparams.GetConsensus()))
                             {
-                                nLoaded++;
-                                queue.push_back(pblockrecursive->GetHash());
+                                LogPrint(BCLog::REINDEX, "%s: Processing out of order child %s of %s\n", __func__, pblockrecursive->GetHash().ToString(),
+                                        head.ToString());
+                                LOCK(cs_main);
+                                CValidationState dummy;
+                                if (g_chainstate.AcceptBlock(pblockrecursive, dummy, chainparams, nullptr, true, &it->second, nullptr))
+                                {
+                                    nLoaded++;
+                                    queue.push_back(pblockrecursive->GetHash());
+                                }
                             }
+                            range.first++;
+                            mapBlocksUnknownParent.erase(it);
+                            NotifyHeaderTip();
                         }
-                        range.first++;
-                        mapBlocksUnknownParent.erase(it);
-                        NotifyHeaderTip();
                     }
+                } catch (const std::exception& e) {
+                    LogPrintf("%s: Deserialize or I/O error - %s\n", __func__, e.what());
                 }
-            } catch (const std::exception& e) {
-                LogPrintf("%s: Deserialize or I/O error - %s\n", __func__, e.what());
             }
+            pipeline.ConnectDone(batch, GetTimeMicros() - nBusyStart);
+            batch = ImportBatch();
         }
+        pipeline.LogStats(nCheckThreads);
     } catch (const std::runtime_error& e) {
         AbortNode(std::string("System error: ") + e.what());
     }
@@ -4910,6 +5499,76 @@ int VersionBitsTipStateSinceHeight(const Consensus::Params& params, Consensus::D
 
 static const uint64_t MEMPOOL_DUMP_VERSION = 1;
 
+/** LitecoinCash: MempoolLoad: Saved transactions are read, script checked and accepted this many at a time */
+static const size_t MEMPOOL_LOAD_BATCH_SIZE = 1000;
+
+/**
+ * LitecoinCash: MempoolLoad: Check the scripts of a batch of saved transactions on the script check threads, with
+ * both the standard flags and the current block's flags, as AcceptToMemoryPoolWorker does. Their signatures go into
+ * the signature cache and, if every script passes, the transactions into the script execution cache under both sets
+ * of flags, so accepting them afterwards under cs_main doesn't run their scripts again. Transactions whose inputs
+ * can't be found are left to acceptance to reject. Returns how many transactions were checked.
+ */
+static size_t CheckMempoolLoadScripts(const CChainParams& chainparams, const std::vector<CTransactionRef>& vtx)
+{
+    if (nScriptCheckThreads == 0)
+        return 0;
+
+    // The flags AcceptToMemoryPoolWorker checks with
+    unsigned int flags = STANDARD_SCRIPT_VERIFY_FLAGS;
+    if (!chainparams.RequireStandard()) {
+        flags = gArgs.GetArg("-promiscuousmempoolflags", flags);
+    }
+
+    std::vector<CTransactionRef> vChecked;
+    std::vector<PrecomputedTransactionData> vTxData;
+    vTxData.reserve(vtx.size()); // The script checks point into this, so it must not reallocate
+    std::vector<CScriptCheck> vChecks;
+    unsigned int blockFlags;
+    {
+        LOCK2(cs_main, mempool.cs);
+        blockFlags = GetBlockScriptFlags(chainActive.Tip(), chainparams.GetConsensus());
+        CCoinsViewMemPool viewMemPool(pcoinsTip.get(), mempool);
+        CCoinsViewCache view(&viewMemPool);
+        for (const CTransactionRef& tx : vtx) {
+            bool fHaveInputs = !tx->IsCoinBase();
+            for (const CTxIn& txin : tx->vin) {
+                if (!view.HaveCoin(txin.prevout)) {
+                    fHaveInputs = false;
+                    break;
+                }
+            }
+            if (fHaveInputs) {
+                vTxData.emplace_back(*tx);
+                for (unsigned int i = 0; i < tx->vin.size(); i++) {
+                    vChecks.emplace_back(view.AccessCoin(tx->vin[i].prevout).out, *tx, i, flags, true, &vTxData.back());
+                    if (blockFlags != flags)
+                        vChecks.emplace_back(view.AccessCoin(tx->vin[i].prevout).out, *tx, i, blockFlags, true, &vTxData.back());
+                }
+                vChecked.push_back(tx);
+            }
+            // Saved transactions come after the ones they spend
+            AddCoins(view, *tx, MEMPOOL_HEIGHT, true);
+        }
+    }
+
+    bool fAllValid;
+    {
+        CCheckQueueControl<CScriptCheck> control(&scriptcheckqueue);
+        control.Add(vChecks);
+        fAllValid = control.Wait();
+    }
+    if (!fAllValid)
+        return 0;
+
+    LOCK(cs_main);
+    for (const CTransactionRef& tx : vChecked) {
+        scriptExecutionCache.insert(GetScriptExecutionCacheEntry(*tx, flags));
+        scriptExecutionCache.insert(GetScriptExecutionCacheEntry(*tx, blockFlags));
+    }
+    return vChecked.size();
+}
+
 bool LoadMempool(void)
 {
     const CChainParams& chainparams = Params();
@@ -4925,7 +5584,9 @@ bool LoadMempool(void)
     int64_t expired = 0;
     int64_t failed = 0;
     int64_t already_there = 0;
+    int64_t checked = 0;
     int64_t nNow = GetTime();
+    int64_t nTimeStart = GetTimeMicros();
 
     try {
         uint64_t version;
@@ -4935,22 +5596,41 @@ bool LoadMempool(void)
         }
         uint64_t num;
         file >> num;
-        while (num--) {
-            CTransactionRef tx;
-            int64_t nTime;
-            int64_t nFeeDelta;
-            file >> tx;
-            file >> nTime;
-            file >> nFeeDelta;
-
-            CAmount amountdelta = nFeeDelta;
-            if (amountdelta) {
-                mempool.PrioritiseTransaction(tx->GetHash(), amountdelta);
+        const uint64_t nTotal = num;
+        int nLastProgress = 0;
+        uiInterface.ShowProgress(_("Loading mempool..."), 0, false);
+        while (num) {
+            // LitecoinCash: MempoolLoad: Read a batch, check all its scripts in parallel, then accept it in order
+            std::vector<CTransactionRef> vtx;
+            std::vector<int64_t> vTime;
+            while (num && vtx.size() < MEMPOOL_LOAD_BATCH_SIZE) {
+                --num;
+                CTransactionRef tx;
+                int64_t nTime;
+                int64_t nFeeDelta;
+                file >> tx;
+                file >> nTime;
+                file >> nFeeDelta;
+
+                CAmount amountdelta = nFeeDelta;
+                if (amountdelta) {
+                    mempool.PrioritiseTransaction(tx->GetHash(), amountdelta);
+                }
+                if (nTime + nExpiryTimeout > nNow) {
+                    vtx.push_back(tx);
+                    vTime.push_back(nTime);
+                } else {
+                    ++expired;
+                }
             }
-            CValidationState state;
-            if (nTime + nExpiryTimeout > nNow) {
+
+            checked += CheckMempoolLoadScripts(chainparams, vtx);
+
+            for (size_t i = 0; i < vtx.size(); i++) {
+                const CTransactionRef& tx = vtx[i];
+                CValidationState state;
                 LOCK(cs_main);
-                AcceptToMemoryPoolWithTime(chainparams, mempool, state, tx, nullptr /* pfMissingInputs */, nTime,
+                AcceptToMemoryPoolWithTime(chainparams, mempool, state, tx, nullptr /* pfMissingInputs */, vTime[i],
                                            nullptr /* plTxnReplaced */, false /* bypass_limits */, 0 /* nAbsurdFee */);
                 if (state.IsValid()) {
                     ++count;
@@ -4965,12 +5645,21 @@ bool LoadMempool(void)
                         ++failed;
                     }
                 }
-            } else {
-                ++expired;
             }
-            if (ShutdownRequested())
+
+            const int nProgress = (nTotal - num) * 100 / nTotal;
+            uiInterface.ShowProgress(_("Loading mempool..."), nProgress, false);
+            if (nProgress / 10 > nLastProgress / 10) {
+                LogPrintf("Loading mempool: %d%% (%u of %u transactions)\n", nProgress, nTotal - num, nTotal);
+            }
+            nLastProgress = nProgress;
+
+            if (ShutdownRequested()) {
+                uiInterface.ShowProgress("", 100, false);
                 return false;
+            }
         }
+        uiInterface.ShowProgress("", 100, false);
         std::map<uint256, CAmount> mapDeltas;
         file >> mapDeltas;
 
@@ -4978,11 +5667,12 @@ bool LoadMempool(void)
             mempool.PrioritiseTransaction(i.first, i.second);
         }
     } catch (const std::exception& e) {
+        uiInterface.ShowProgress("", 100, false);
         LogPrintf("Failed to deserialize mempool data on disk: %s. Continuing anyway.\n", e.what());
         return false;
     }
 
-    LogPrintf("Imported mempool transactions from disk: %i succeeded, %i failed, %i expired, %i already there\n", count, failed, expired, already_there);
+    LogPrintf("Imported mempool transactions from disk: %i succeeded, %i failed, %i expired, %i already there (%i checked in parallel, %.2fs)\n", count, failed, expired, already_there, checked, 0.000001 * (GetTimeMicros() - nTimeStart));
     return true;
 }
 
@@ -5059,9 +5749,8 @@ public:
     CMainCleanup() {}
     ~CMainCleanup() {
         // block headers
-        BlockMap::iterator it1 = mapBlockIndex.begin();
-        for (; it1 != mapBlockIndex.end(); it1++)
-            delete (*it1).second;
+        // LitecoinCash: FastIndexLoad: All entries go with the arena
         mapBlockIndex.clear();
+        blockIndexArena.reset();
     }
 } instance_of_cmaincleanup;
@@ -29,11 +29,15 @@
 #include <vector>
 
 #include <atomic>
+#include <memory>
 
 class CBlockIndex;
 class CBlockTreeDB;
+class CBlockUndo;
+struct SignatureCacheStats;
 class CChainParams;
 class CCoinsViewDB;
+class CCoinsViewPrefetch;     // LitecoinCash: CoinsPrefetch
 class CRialtoWhitePagesDB;    // Litecoin Cash: Rialto
 class CInv;
 class CConnman;
@@ -66,6 +70,8 @@ static const unsigned int DEFAULT_ANCESTOR_SIZE_LIMIT = 101;
 static const unsigned int DEFAULT_DESCENDANT_LIMIT = 25;
 /** Default for -limitdescendantsize, maximum kilobytes of in-mempool descendants */
 static const unsigned int DEFAULT_DESCENDANT_SIZE_LIMIT = 101;
+/** LitecoinCash: ClusterMempool: Default for -limitclustercount, max number of transactions in an in-mempool cluster */
+static const unsigned int DEFAULT_CLUSTER_LIMIT = 64;
 /** Default for -mempoolexpiry, expiration time for mempool transactions in hours */
 static const unsigned int DEFAULT_MEMPOOL_EXPIRY = 336;
 /** Maximum kilobytes for transactions to store for processing during reorg */
@@ -76,6 +82,9 @@ static const unsigned int MAX_BLOCKFILE_SIZE = 0x8000000; // 128 MiB
 static const unsigned int BLOCKFILE_CHUNK_SIZE = 0x1000000; // 16 MiB
 /** The pre-allocation chunk size for rev?????.dat files (since 0.8) */
 static const unsigned int UNDOFILE_CHUNK_SIZE = 0x100000; // 1 MiB
+/** LitecoinCash: ScryptBatch: Number of blocks read ahead while importing or reindexing, so that their pow hashes can be batched.
+ *  LitecoinCash: ReindexPipeline: Also the unit of work handed between the stages of the import pipeline */
+static const unsigned int LOAD_BLOCK_BATCH_SIZE = 8;
 
 /** Maximum number of script-checking threads allowed */
 static const int MAX_SCRIPTCHECK_THREADS = 16;
@@ -102,6 +111,10 @@ static const unsigned int BLOCK_DOWNLOAD_WINDOW = 1024;
 static const unsigned int DATABASE_WRITE_INTERVAL = 60 * 60;
 /** Time to wait (in seconds) between flushing chainstate to disk. */
 static const unsigned int DATABASE_FLUSH_INTERVAL = 24 * 60 * 60;
+/** LitecoinCash: CoinsSync: Default for -coinsbackgroundflush */
+static const bool DEFAULT_COINS_BACKGROUND_FLUSH = true;
+/** LitecoinCash: CoinsSync: Once over budget, the coins cache evicts down to this percentage of it */
+static const int64_t COINS_CACHE_EVICT_PERCENT = 75;
 /** Maximum length of reject messages. */
 static const unsigned int MAX_REJECT_MESSAGE_LENGTH = 111;
 /** Average delay between local address broadcasts in seconds. */
@@ -170,13 +183,16 @@ extern CWaitableCriticalSection csBestBlock;
 extern CConditionVariable cvBlockChange;
 extern std::atomic_bool fImporting;
 extern std::atomic_bool fReindex;
+/** LitecoinCash: MempoolLoad: Whether the saved mempool has been loaded (or there was none to load) */
+extern std::atomic_bool g_is_mempool_loaded;
 extern int nScriptCheckThreads;
-extern bool fTxIndex;
 extern bool fIsBareMultisigStd;
 extern bool fRequireStandard;
 extern bool fCheckBlockIndex;
 extern bool fCheckpointsEnabled;
 extern size_t nCoinCacheUsage;
+/** LitecoinCash: CoinsSync: Write dirty coins without emptying the coins cache, in the background where possible */
+extern bool fCoinsBackgroundFlush;
 /** A fee rate smaller than this is considered zero fee (for relaying, mining and transaction creation) */
 extern CFeeRate minRelayTxFee;
 /** Absolute maximum transaction fee (in satoshis) used by wallet and mempool (rejects high fee in sendrawtransaction) */
@@ -301,6 +317,20 @@ void UnlinkPrunedFiles(const std::set<int>& setFilesToPrune);
 
 /** Flush all state, indexes and buffers to disk. */
 void FlushStateToDisk();
+
+/** LitecoinCash: CoinsSync: Statistics about writes of the coins cache to the coins database */
+struct CoinsFlushStats {
+    uint64_t nFlushes = 0;          //!< Completed writes since startup
+    int64_t nLastTime = 0;          //!< Start of the last write (unix time)
+    int64_t nLastDuration = 0;      //!< Duration of the last write in microseconds
+    size_t nLastCoins = 0;          //!< Entries written by the last write
+    bool fLastBackground = false;   //!< Whether the last write happened in the background
+    size_t nLastEvicted = 0;        //!< Entries dropped by the last eviction
+    uint64_t nLastHits = 0;         //!< Cache hits between the two last writes
+    uint64_t nLastMisses = 0;       //!< Cache misses between the two last writes
+    size_t nInFlightUsage = 0;      //!< Memory held by the copy of the coins being written, if a write is in flight
+};
+CoinsFlushStats GetCoinsFlushStats();
 /** Prune block files and flush state to disk. */
 void PruneAndFlush();
 /** Prune block files up to a given height */
@@ -394,17 +424,60 @@ public:
 
 /** Initializes the script-execution cache */
 void InitScriptExecutionCache();
+/** LitecoinCash: PersistSigCache: Save the script execution cache to disk. */
+bool DumpScriptExecutionCache();
+/** LitecoinCash: PersistSigCache: Load the script execution cache from disk, replacing its nonce. Call before any lookups. */
+bool LoadScriptExecutionCache();
+SignatureCacheStats GetScriptExecutionCacheStats();
 
 
 /** Functions for disk access for blocks */
 bool ReadBlockFromDisk(CBlock& block, const CDiskBlockPos& pos, const Consensus::Params& consensusParams);
 bool ReadBlockFromDisk(CBlock& block, const CBlockIndex* pindex, const Consensus::Params& consensusParams);
+/** LitecoinCash: BlockFilterIndex: Read the undo data of a connected block, checking it against its stored hash */
+bool UndoReadFromDisk(CBlockUndo& blockundo, const CBlockIndex* pindex);
+
+/** LitecoinCash: MappedBlocks: Keep at most this many completed block files memory mapped */
+static const size_t MAX_MAPPED_BLOCK_FILES = sizeof(void*) >= 8 ? 64 : 4;
+
+/**
+ * LitecoinCash: MappedBlocks: The serialized bytes of a block as stored on disk, which is also how the block
+ * goes over the wire with witness data. Points into a memory mapped block file, or into a buffer, and keeps
+ * either alive. Serializes as the bytes themselves, so it can be sent without decoding the block.
+ */
+class CRawBlock
+{
+private:
+    std::shared_ptr<const unsigned char> m_data;
+    size_t m_size;
+
+public:
+    CRawBlock() : m_size(0) {}
+    CRawBlock(std::shared_ptr<const unsigned char> data, size_t size) : m_data(std::move(data)), m_size(size) {}
+
+    const unsigned char* data() const { return m_data.get(); }
+    size_t size() const { return m_size; }
+    const std::shared_ptr<const unsigned char>& shared_data() const { return m_data; }
+
+    template<typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s.write(reinterpret_cast<const char*>(m_data.get()), m_size);
+    }
+};
+
+/** LitecoinCash: MappedBlocks: Get a block's serialized bytes without deserializing it. Completed block files are memory mapped. */
+bool ReadRawBlockFromDisk(CRawBlock& block, const CDiskBlockPos& pos, const CMessageHeader::MessageStartChars& messageStart);
+bool ReadRawBlockFromDisk(CRawBlock& block, const CBlockIndex* pindex, const CMessageHeader::MessageStartChars& messageStart);
 
 /** Functions for validating blocks and updating the block tree */
 
 /** Context-independent validity checks */
 bool CheckBlock(const CBlock& block, CValidationState& state, const Consensus::Params& consensusParams, bool fCheckPOW = true, bool fCheckMerkleRoot = true);
 
+/** Check whether a block is a member of the -assumevalid chain and buried deeply enough to skip signature checks (requires cs_main) */
+bool IsBlockAssumedValid(const CBlockIndex* pindex, const Consensus::Params& consensusParams);
+
 /** Check a block is completely valid from start to finish (only works on top of our current best block, with cs_main held) */
 bool TestBlockValidity(CValidationState& state, const CChainParams& chainparams, const CBlock& block, CBlockIndex* pindexPrev, bool fCheckPOW = true, bool fCheckMerkleRoot = true);
 
@@ -479,6 +552,9 @@ extern CChain& chainActive;
 /** Global variable that points to the coins database (protected by cs_main) */
 extern std::unique_ptr<CCoinsViewDB> pcoinsdbview;
 
+/** LitecoinCash: CoinsPrefetch: Reads the inputs of downloaded blocks ahead of time, sits between pcoinsdbview and pcoinsTip */
+extern std::unique_ptr<CCoinsViewPrefetch> pcoinsprefetch;
+
 /** Global variable that points to the active CCoinsView (protected by cs_main) */
 extern std::unique_ptr<CCoinsViewCache> pcoinsTip;
 
@@ -522,7 +598,7 @@ CBlockFileInfo* GetBlockFileInfo(size_t n);
 /** Dump the mempool to disk. */
 bool DumpMempool();
 
-/** Load the mempool from disk. */
+/** Load the mempool from disk. Scripts are checked on the script check threads ahead of acceptance. */
 bool LoadMempool();
 
 #endif // BITCOIN_VALIDATION_H
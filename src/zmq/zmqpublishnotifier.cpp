@@ -170,6 +170,16 @@ bool CZMQPublishRawBlockNotifier::NotifyBlock(const CBlockIndex *pindex)
 {
     LogPrint(BCLog::ZMQ, "zmq: Publish rawblock %s\n", pindex->GetBlockHash().GetHex());
 
+    // LitecoinCash: MappedBlocks: Publish the stored bytes as they are, unless the witness data has to be stripped
+    if (!(RPCSerializationFlags() & SERIALIZE_TRANSACTION_NO_WITNESS)) {
+        CRawBlock block;
+        if (!ReadRawBlockFromDisk(block, pindex, Params().MessageStart())) {
+            zmqError("Can't read block from disk");
+            return false;
+        }
+        return SendMessage(MSG_RAWBLOCK, block.data(), block.size());
+    }
+
     const Consensus::Params& consensusParams = Params().GetConsensus();
     CDataStream ss(SER_NETWORK, PROTOCOL_VERSION | RPCSerializationFlags());
     {
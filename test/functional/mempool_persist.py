@@ -72,6 +72,7 @@ class MempoolPersistTest(BitcoinTestFramework):
         # Give bitcoind a second to reload the mempool
         wait_until(lambda: len(self.nodes[0].getrawmempool()) == 5, timeout=1)
         wait_until(lambda: len(self.nodes[2].getrawmempool()) == 5, timeout=1)
+        wait_until(lambda: self.nodes[0].getmempoolinfo()["loaded"], timeout=1)
         # The others have loaded their mempool. If node_1 loaded anything, we'd probably notice by now:
         assert_equal(len(self.nodes[1].getrawmempool()), 0)
 
@@ -84,6 +85,7 @@ class MempoolPersistTest(BitcoinTestFramework):
         self.start_node(0, extra_args=["-persistmempool=0"])
         # Give bitcoind a second to reload the mempool
         time.sleep(1)
+        assert self.nodes[0].getmempoolinfo()["loaded"]
         assert_equal(len(self.nodes[0].getrawmempool()), 0)
 
         self.log.debug("Stop-start node0. Verify that it has the transactions in its mempool.")
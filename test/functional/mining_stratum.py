@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Litecoin Cash Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the embedded Stratum server
+
+Drives the SHA256d Stratum port with a minimal Stratum client:
+- mining.subscribe / mining.authorize, followed by set_difficulty and notify
+- refusing workers whose username isn't a payout address
+- accepting a share that doesn't meet the block target
+- rejecting duplicate shares and shares for stale jobs
+- submitting a solved block straight to the node, and a new clean job following it"""
+
+import hashlib
+import json
+import socket
+import struct
+
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal, rpc_port, PORT_RANGE, wait_until
+
+def hash256(b):
+    return hashlib.sha256(hashlib.sha256(b).digest()).digest()
+
+class StratumClient():
+    def __init__(self, port):
+        self.sock = socket.create_connection(("127.0.0.1", port), timeout=30)
+        self.buf = b""
+        self.next_id = 1
+        self.notifications = []
+
+    def read_message(self):
+        while b"\n" not in self.buf:
+            data = self.sock.recv(4096)
+            assert data, "stratum connection closed"
+            self.buf += data
+        line, self.buf = self.buf.split(b"\n", 1)
+        return json.loads(line.decode())
+
+    def call(self, method, params):
+        request_id = self.next_id
+        self.next_id += 1
+        self.sock.sendall((json.dumps({"id": request_id, "method": method, "params": params}) + "\n").encode())
+        while True:
+            msg = self.read_message()
+            if msg.get("id") == request_id:
+                return msg
+            self.notifications.append(msg)
+
+    def wait_for_notification(self, method):
+        while True:
+            for i, msg in enumerate(self.notifications):
+                if msg["method"] == method:
+                    return self.notifications.pop(i)
+            self.notifications.append(self.read_message())
+
+    def close(self):
+        self.sock.close()
+
+def stratum_header(job, extranonce1, extranonce2, ntime, nonce):
+    """Build the 80 byte block header for a mining.notify job, as a miner would"""
+    job_id, prevhash, coinb1, coinb2, branch, version, nbits = job[:7]
+    coinbase = bytes.fromhex(coinb1 + extranonce1 + extranonce2 + coinb2)
+    merkle_root = hash256(coinbase)
+    for h in branch:
+        merkle_root = hash256(merkle_root + bytes.fromhex(h))
+    prev = bytes.fromhex(prevhash)
+    prev = b"".join(prev[i:i + 4][::-1] for i in range(0, 32, 4))
+    return struct.pack("<I", int(version, 16)) + prev + merkle_root + struct.pack("<III", int(ntime, 16), int(nbits, 16), nonce)
+
+def grind(job, extranonce1, extranonce2, want_block):
+    """Find a nonce that does (or only doesn't) meet the regtest block target"""
+    nbits = int(job[6], 16)
+    target = (nbits & 0xffffff) << (8 * ((nbits >> 24) - 3))
+    for nonce in range(1 << 16):
+        pow_hash = int.from_bytes(hash256(stratum_header(job, extranonce1, extranonce2, job[7], nonce)), "little")
+        if (pow_hash <= target) == want_block:
+            return "%08x" % nonce
+    raise AssertionError("no nonce found")
+
+class StratumTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.setup_clean_chain = True
+
+    def setup_nodes(self):
+        self.stratum_port = rpc_port(0) + PORT_RANGE
+        # Half the regtest pow limit, so that about half of all shares are not blocks
+        self.add_nodes(self.num_nodes, [["-stratum", "-stratumport=%d" % self.stratum_port, "-stratumminotaurxport=%d" % (self.stratum_port + 1), "-stratumdifficulty=0.5", "-debug=stratum", "-disablewallet"]])
+        self.start_nodes()
+
+    def run_test(self):
+        node = self.nodes[0]
+        address = node.decodescript("51")["p2sh"]
+        # Leave initial block download
+        node.generatetoaddress(1, address)
+
+        self.log.info("Refuse a worker without a payout address")
+        client = StratumClient(self.stratum_port)
+        client.call("mining.subscribe", ["test/1.0"])
+        reply = client.call("mining.authorize", ["notanaddress.worker1", "x"])
+        assert_equal(reply["error"][0], 24)
+        client.close()
+
+        self.log.info("Subscribe and authorize")
+        client = StratumClient(self.stratum_port)
+        reply = client.call("mining.subscribe", ["test/1.0"])
+        assert_equal(reply["error"], None)
+        subscriptions, extranonce1, extranonce2_size = reply["result"]
+        assert_equal(subscriptions[1][0], "mining.notify")
+        assert_equal(len(extranonce1), 8)
+        assert_equal(extranonce2_size, 4)
+        assert_equal(client.wait_for_notification("mining.set_difficulty")["params"], [0.5])
+        reply = client.call("mining.authorize", [address + ".worker1", "x"])
+        assert_equal(reply["result"], True)
+
+        job = client.wait_for_notification("mining.notify")["params"]
+        assert_equal(len(job), 9)
+        assert_equal(job[8], True)
+        tip = node.getbestblockhash()
+        assert_equal(stratum_header(job, extranonce1, "00000000", job[7], 0)[4:36][::-1].hex(), tip)
+
+        self.log.info("Accept a share that isn't a block")
+        extranonce2 = "00000001"
+        nonce = grind(job, extranonce1, extranonce2, False)
+        reply = client.call("mining.submit", ["worker1", job[0], extranonce2, job[7], nonce])
+        assert_equal(reply["result"], True)
+        assert_equal(node.getbestblockhash(), tip)
+
+        self.log.info("Reject a duplicate share")
+        reply = client.call("mining.submit", ["worker1", job[0], extranonce2, job[7], nonce])
+        assert_equal(reply["error"][0], 22)
+
+        self.log.info("Reject malformed and out of range submissions")
+        reply = client.call("mining.submit", ["worker1", job[0], "00", job[7], nonce])
+        assert_equal(reply["error"][0], 20)
+        reply = client.call("mining.submit", ["worker1", job[0], extranonce2, "00000001", nonce])
+        assert_equal(reply["error"][0], 20)
+
+        self.log.info("Submit a block")
+        extranonce2 = "00000002"
+        nonce = grind(job, extranonce1, extranonce2, True)
+        reply = client.call("mining.submit", ["worker1", job[0], extranonce2, job[7], nonce])
+        assert_equal(reply["result"], True)
+        wait_until(lambda: node.getbestblockhash() != tip, timeout=10)
+        block = node.getblock(node.getbestblockhash(), 2)
+        assert_equal(block["previousblockhash"], tip)
+        assert_equal(block["tx"][0]["vout"][0]["scriptPubKey"]["addresses"], [address])
+        assert extranonce1 + extranonce2 in block["tx"][0]["vin"][0]["coinbase"]
+
+        self.log.info("Get a clean job on the new tip, and reject shares for the stale one")
+        new_job = client.wait_for_notification("mining.notify")["params"]
+        assert_equal(new_job[8], True)
+        assert new_job[0] != job[0]
+        reply = client.call("mining.submit", ["worker1", job[0], extranonce2, job[7], nonce])
+        assert_equal(reply["error"][0], 21)
+
+        self.log.info("Get a clean job when the tip moves elsewhere")
+        node.generatetoaddress(1, address)
+        newer_job = client.wait_for_notification("mining.notify")["params"]
+        assert_equal(newer_job[8], True)
+        assert_equal(stratum_header(newer_job, extranonce1, "00000000", newer_job[7], 0)[4:36][::-1].hex(), node.getbestblockhash())
+        client.close()
+
+if __name__ == '__main__':
+    StratumTest().main()
@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Litecoin Cash Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test BIP 157 compact block filters
+
+Tests the block filter index and serving filters to peers:
+- the index catching up with an existing chain, and the getblockfilter RPC
+- getcfcheckpt, getcfheaders and getcfilters, for blocks on the active chain and a stale one
+- disconnecting peers that make invalid requests, or ask a node not serving filters"""
+
+from test_framework.messages import (
+    NODE_COMPACT_FILTERS,
+    hash256,
+    msg_getcfcheckpt,
+    msg_getcfheaders,
+    msg_getcfilters,
+    ser_uint256,
+    uint256_from_str,
+)
+from test_framework.mininode import (
+    P2PInterface,
+    mininode_lock,
+    network_thread_join,
+    network_thread_start,
+)
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal, assert_raises_rpc_error, wait_until
+
+FILTER_TYPE_BASIC = 0
+CFCHECKPT_INTERVAL = 1000
+
+class CFiltersClient(P2PInterface):
+    def __init__(self):
+        super().__init__()
+        # Store the cfilters received.
+        self.cfilters = []
+
+    def pop_cfilters(self):
+        with mininode_lock:
+            cfilters = self.cfilters
+            self.cfilters = []
+            return cfilters
+
+    def on_cfilter(self, message):
+        """Store cfilters received in a list."""
+        self.cfilters.append(message)
+
+class CompactFiltersTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.setup_clean_chain = True
+        self.num_nodes = 1
+        self.extra_args = [["-blockfilterindex", "-peerblockfilters", "-disablewallet"]]
+
+    def filter_ready(self, blockhash):
+        try:
+            self.nodes[0].getblockfilter(blockhash, "basic")
+            return True
+        except Exception:
+            return False
+
+    def run_test(self):
+        node = self.nodes[0]
+        address = node.decodescript("51")["p2sh"]
+
+        self.log.info("Check that the node signals NODE_COMPACT_FILTERS")
+        assert int(node.getnetworkinfo()["localservices"], 16) & NODE_COMPACT_FILTERS
+
+        self.log.info("Index the chain as it is mined")
+        # Regtest blocks are cheap to mine only up to the last scrypt block (height 200), which keeps
+        # the chain short of the first checkpoint.
+        node.generatetoaddress(150, address)
+        tip_hash = node.getbestblockhash()
+        wait_until(lambda: self.filter_ready(tip_hash), timeout=60)
+
+        # Stale block, whose filter remains available after a reorg
+        stale_hash = node.getbestblockhash()
+        node.invalidateblock(stale_hash)
+        # Mine to another address, so that the replacement does not repeat the invalidated block
+        node.generatetoaddress(2, node.decodescript("52")["p2sh"])
+        # Valid again, but on a branch with less work
+        node.reconsiderblock(stale_hash)
+        tip_hash = node.getbestblockhash()
+        tip_height = node.getblockcount()
+        wait_until(lambda: self.filter_ready(tip_hash), timeout=60)
+        assert_equal(node.getblockheader(stale_hash)["confirmations"], -1)
+
+        self.log.info("Check the getblockfilter RPC")
+        genesis_hash = node.getblockhash(0)
+        genesis_filter = node.getblockfilter(genesis_hash)
+        assert_equal(genesis_filter, node.getblockfilter(genesis_hash, "basic"))
+        # The genesis header commits to a zero previous header
+        expected_header = hash256(hash256(bytes.fromhex(genesis_filter["filter"])) + bytes(32))[::-1].hex()
+        assert_equal(genesis_filter["header"], expected_header)
+        assert_raises_rpc_error(-5, "Unknown filtertype", node.getblockfilter, genesis_hash, "unknown")
+        assert_raises_rpc_error(-5, "Block not found", node.getblockfilter, "00" * 32)
+
+        rpc_headers = {}
+        rpc_filters = {}
+        for height in range(tip_height + 1):
+            block_hash = node.getblockhash(height)
+            result = node.getblockfilter(block_hash)
+            rpc_headers[block_hash] = int(result["header"], 16)
+            rpc_filters[block_hash] = bytes.fromhex(result["filter"])
+        stale_filter = node.getblockfilter(stale_hash)
+        assert stale_filter["header"] != node.getblockfilter(node.getblockhash(tip_height - 1))["header"]
+
+        peer = node.add_p2p_connection(CFiltersClient())
+        network_thread_start()
+        peer.wait_for_verack()
+
+        self.log.info("Check that getcfcheckpt returns no headers for a chain short of the first checkpoint")
+        assert tip_height < CFCHECKPT_INTERVAL
+        request = msg_getcfcheckpt(filter_type=FILTER_TYPE_BASIC, stop_hash=int(tip_hash, 16))
+        peer.send_and_ping(request)
+        response = peer.last_message["cfcheckpt"]
+        assert_equal(response.stop_hash, request.stop_hash)
+        assert_equal(response.headers, [])
+
+        self.log.info("Check that getcfheaders returns headers chaining up to the stop block")
+        start_height = 5
+        request = msg_getcfheaders(filter_type=FILTER_TYPE_BASIC, start_height=start_height, stop_hash=int(tip_hash, 16))
+        peer.send_and_ping(request)
+        response = peer.last_message["cfheaders"]
+        assert_equal(response.stop_hash, request.stop_hash)
+        assert_equal(len(response.hashes), tip_height - start_height + 1)
+        header = response.prev_header
+        assert_equal(header, rpc_headers[node.getblockhash(start_height - 1)])
+        for height, filter_hash in enumerate(response.hashes, start_height):
+            header = uint256_from_str(hash256(ser_uint256(filter_hash) + ser_uint256(header)))
+            assert_equal(header, rpc_headers[node.getblockhash(height)])
+
+        self.log.info("Check that getcfilters returns the filters of the requested range")
+        start_height = tip_height - 9
+        request = msg_getcfilters(filter_type=FILTER_TYPE_BASIC, start_height=start_height, stop_hash=int(tip_hash, 16))
+        peer.send_and_ping(request)
+        cfilters = peer.pop_cfilters()
+        assert_equal(len(cfilters), 10)
+        for height, cfilter in enumerate(cfilters, start_height):
+            block_hash = node.getblockhash(height)
+            assert_equal(cfilter.filter_type, FILTER_TYPE_BASIC)
+            assert_equal(cfilter.block_hash, int(block_hash, 16))
+            assert_equal(cfilter.filter_data, rpc_filters[block_hash])
+
+        self.log.info("Check that filters of a recent stale block are served")
+        request = msg_getcfilters(filter_type=FILTER_TYPE_BASIC, start_height=tip_height - 2, stop_hash=int(stale_hash, 16))
+        peer.send_and_ping(request)
+        cfilters = peer.pop_cfilters()
+        assert_equal(len(cfilters), 2)
+        assert_equal(cfilters[0].filter_data, rpc_filters[node.getblockhash(tip_height - 2)])
+        assert_equal(cfilters[1].block_hash, int(stale_hash, 16))
+        assert_equal(cfilters[1].filter_data, bytes.fromhex(stale_filter["filter"]))
+
+        self.log.info("Check that peers making invalid requests are disconnected")
+        requests = [
+            # Start height above the stop block
+            msg_getcfheaders(filter_type=FILTER_TYPE_BASIC, start_height=tip_height, stop_hash=int(node.getblockhash(1), 16)),
+            # Unknown filter type
+            msg_getcfcheckpt(filter_type=255, stop_hash=int(tip_hash, 16)),
+            # Unknown stop block
+            msg_getcfheaders(filter_type=FILTER_TYPE_BASIC, start_height=0, stop_hash=1),
+        ]
+        node.disconnect_p2ps()
+        network_thread_join()
+        for request in requests:
+            peer = node.add_p2p_connection(P2PInterface())
+            network_thread_start()
+            peer.wait_for_verack()
+            peer.send_message(request)
+            peer.wait_for_disconnect()
+            network_thread_join()
+
+        self.log.info("Check that a node that does not serve filters disconnects peers asking for them")
+        self.restart_node(0, ["-blockfilterindex", "-disablewallet"])
+        assert not int(node.getnetworkinfo()["localservices"], 16) & NODE_COMPACT_FILTERS
+        assert_equal(node.getblockfilter(tip_hash)["filter"], rpc_filters[tip_hash].hex())
+        peer = node.add_p2p_connection(P2PInterface())
+        network_thread_start()
+        peer.wait_for_verack()
+        peer.send_message(msg_getcfcheckpt(filter_type=FILTER_TYPE_BASIC, stop_hash=int(tip_hash, 16)))
+        peer.wait_for_disconnect()
+
+        self.log.info("Check that the RPC needs the index")
+        self.restart_node(0, ["-disablewallet"])
+        assert_raises_rpc_error(-1, "Index is not enabled for filtertype basic", node.getblockfilter, tip_hash)
+
+        self.log.info("Check that -peerblockfilters requires the index")
+        self.stop_node(0)
+        self.assert_start_raises_init_error(0, ["-peerblockfilters"], "Error: Cannot set -peerblockfilters without -blockfilterindex.")
+
+if __name__ == '__main__':
+    CompactFiltersTest().main()
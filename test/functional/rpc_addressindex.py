@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Litecoin Cash Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the address and spent output indexes
+
+Tests the RPCs backed by -addressindex and -spentindex:
+- the indexes catching up with an existing chain when enabled later, without a reindex
+- getaddressbalance, getaddressutxos and getaddresshistory, including paging through results
+- getspentinfo
+- both indexes following the chain through a reorg
+- the errors given when the indexes are disabled"""
+
+from test_framework.messages import COutPoint, CTransaction, CTxIn, CTxOut, FromHex, ToHex
+from test_framework.test_framework import BitcoinTestFramework
+from test_framework.util import assert_equal, assert_raises_rpc_error, wait_until
+
+# Spends P2SH(OP_TRUE) outputs by pushing the redeem script
+REDEEM_SCRIPT_SIG = bytes([0x01, 0x51])
+NUM_OUTPUTS = 5
+FEE = 100000
+
+class AddressIndexTest(BitcoinTestFramework):
+    def set_test_params(self):
+        self.setup_clean_chain = True
+        self.num_nodes = 1
+        self.extra_args = [["-disablewallet"]]
+
+    def index_ready(self, address):
+        try:
+            self.nodes[0].getaddressbalance(address)
+            return True
+        except Exception:
+            return False
+
+    def run_test(self):
+        node = self.nodes[0]
+        true_address = node.decodescript("51")["p2sh"]
+        dest_address = node.decodescript("52")["p2sh"]
+        dest_script = node.validateaddress(dest_address)["scriptPubKey"]
+
+        self.log.info("Check that the RPCs need the indexes")
+        node.generatetoaddress(120, true_address)
+        assert_raises_rpc_error(-1, "Address index is not enabled. Use -addressindex", node.getaddressbalance, true_address)
+        assert_raises_rpc_error(-1, "Address index is not enabled. Use -addressindex", node.getaddressutxos, true_address)
+        assert_raises_rpc_error(-1, "Address index is not enabled. Use -addressindex", node.getaddresshistory, true_address)
+        assert_raises_rpc_error(-1, "Spent index is not enabled. Use -spentindex", node.getspentinfo, node.getbestblockhash(), 0)
+
+        self.log.info("Index an existing chain after enabling the indexes")
+        self.restart_node(0, ["-disablewallet", "-addressindex", "-spentindex"])
+        wait_until(lambda: self.index_ready(true_address), timeout=60)
+
+        coinbase_total = 0
+        coinbase_txids = []
+        for height in range(1, node.getblockcount() + 1):
+            coinbase = node.getblock(node.getblockhash(height), 2)["tx"][0]
+            coinbase_txids.append(coinbase["txid"])
+            coinbase_total += coinbase["vout"][0]["value"]
+        balance = node.getaddressbalance(true_address)
+        assert_equal(balance["balance"], coinbase_total)
+        assert_equal(balance["received"], coinbase_total)
+        assert_equal(balance["txcount"], 120)
+
+        self.log.info("Spend a coinbase to several outputs")
+        coinbase = node.getblock(node.getblockhash(1), 2)["tx"][0]
+        coinbase_value = coinbase["vout"][0]["value"]
+        # Amounts are built from the raw transaction, as RPC values are in scaled coins.
+        output_sats = (FromHex(CTransaction(), coinbase["hex"]).vout[0].nValue - FEE) // NUM_OUTPUTS
+        tx = CTransaction()
+        tx.vin.append(CTxIn(COutPoint(int(coinbase["txid"], 16), 0), REDEEM_SCRIPT_SIG))
+        for _ in range(NUM_OUTPUTS):
+            tx.vout.append(CTxOut(output_sats, bytes.fromhex(dest_script)))
+        output_value = node.decoderawtransaction(ToHex(tx))["vout"][0]["value"]
+        spend_txid = node.sendrawtransaction(ToHex(tx))
+        block_hash = node.generatetoaddress(1, true_address)[0]
+        height = node.getblockcount()
+        wait_until(lambda: node.getaddresshistory(dest_address) != [], timeout=60)
+
+        balance = node.getaddressbalance(dest_address)
+        assert_equal(balance["balance"], NUM_OUTPUTS * output_value)
+        assert_equal(balance["received"], NUM_OUTPUTS * output_value)
+        assert_equal(balance["txcount"], 1)
+
+        history = node.getaddresshistory(dest_address)
+        assert_equal(history, [{
+            "txid": spend_txid,
+            "height": height,
+            "blockhash": block_hash,
+            "received": NUM_OUTPUTS * output_value,
+            "sent": 0,
+        }])
+        spender = node.getaddresshistory(true_address, 1, 121)[0]
+        assert_equal(spender["txid"], spend_txid)
+        assert_equal(spender["sent"], coinbase_value)
+
+        self.log.info("Page through unspent outputs and history")
+        utxos = node.getaddressutxos(dest_address)
+        assert_equal(len(utxos), NUM_OUTPUTS)
+        assert_equal(sorted(utxo["vout"] for utxo in utxos), list(range(NUM_OUTPUTS)))
+        for utxo in utxos:
+            assert_equal(utxo["txid"], spend_txid)
+            assert_equal(utxo["amount"], output_value)
+            assert_equal(utxo["height"], height)
+        pages = [node.getaddressutxos(dest_address, 2, skip) for skip in range(0, NUM_OUTPUTS + 2, 2)]
+        assert_equal([len(page) for page in pages], [2, 2, 1, 0])
+        assert_equal(sum(pages, []), utxos)
+
+        history = node.getaddresshistory(true_address, 1000)
+        assert_equal(len(history), 122)
+        assert_equal([entry["txid"] for entry in history[:120]], coinbase_txids)
+        assert_equal(node.getaddresshistory(true_address, 10, 115), history[115:])
+        assert_equal(len(node.getaddressutxos(true_address)), 100)
+        assert coinbase["txid"] not in [utxo["txid"] for utxo in node.getaddressutxos(true_address, 1000)]
+
+        assert_raises_rpc_error(-8, "Count must be between 1 and 1000", node.getaddressutxos, dest_address, 0)
+        assert_raises_rpc_error(-8, "Count must be between 1 and 1000", node.getaddresshistory, dest_address, 1001)
+        assert_raises_rpc_error(-8, "Negative skip", node.getaddressutxos, dest_address, 10, -1)
+        assert_raises_rpc_error(-5, "Invalid address", node.getaddressbalance, "invalid")
+
+        self.log.info("Check getspentinfo")
+        assert_equal(node.getspentinfo(coinbase["txid"], 0), {"txid": spend_txid, "index": 0, "height": height})
+        assert_raises_rpc_error(-5, "Output not found or not spent", node.getspentinfo, spend_txid, 0)
+        assert_raises_rpc_error(-8, "Invalid output number", node.getspentinfo, spend_txid, -1)
+
+        self.log.info("Check that the indexes follow a reorg")
+        node.invalidateblock(block_hash)
+        wait_until(lambda: node.getaddresshistory(dest_address) == [], timeout=60)
+        assert_equal(node.getaddressbalance(dest_address)["balance"], 0)
+        assert_equal(node.getaddressutxos(dest_address), [])
+        assert_equal(node.getaddressbalance(true_address)["balance"], coinbase_total)
+        assert coinbase["txid"] in [utxo["txid"] for utxo in node.getaddressutxos(true_address, 1000)]
+        assert_raises_rpc_error(-5, "Output not found or not spent", node.getspentinfo, coinbase["txid"], 0)
+
+        node.reconsiderblock(block_hash)
+        wait_until(lambda: node.getaddresshistory(dest_address) != [], timeout=60)
+        assert_equal(len(node.getaddressutxos(dest_address)), NUM_OUTPUTS)
+        assert_equal(node.getspentinfo(coinbase["txid"], 0)["txid"], spend_txid)
+
+        self.log.info("Check that the indexes are incompatible with pruning")
+        self.stop_node(0)
+        self.assert_start_raises_init_error(0, ["-prune=550", "-addressindex"], "Error: Prune mode is incompatible with -addressindex.")
+        self.assert_start_raises_init_error(0, ["-prune=550", "-spentindex"], "Error: Prune mode is incompatible with -spentindex.")
+
+if __name__ == '__main__':
+    AddressIndexTest().main()
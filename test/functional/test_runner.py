@@ -102,6 +102,7 @@ BASE_SCRIPTS= [
     'p2p_disconnect_ban.py',
     'rpc_decodescript.py',
     'rpc_blockchain.py',
+    'rpc_addressindex.py',
     'rpc_deprecated.py',
     'wallet_disable.py',
     'rpc_net.py',
@@ -117,6 +118,8 @@ BASE_SCRIPTS= [
     'feature_nulldummy.py',
     'wallet_import_rescan.py',
     'mining_basic.py',
+    'mining_stratum.py',
+    'p2p_blockfilters.py',
     'wallet_bumpfee.py',
     'rpc_named_arguments.py',
     'wallet_listsinceblock.py',